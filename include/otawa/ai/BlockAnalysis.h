@@ -72,6 +72,7 @@ protected:
 		todo.comparator().r = ai::CFG_RANKING_FEATURE.get(ws);
 		intodo = BitVector(cfgs.countBlocks());
 		typename D::t x;
+		int cnt = 0;
 
 		// prepare to-do list
 		Block *v = cfgs.entry()->entry();
@@ -87,6 +88,7 @@ protected:
 
 			// get the next vertex to process
 			v = get();
+			cnt++;
 			OTAWA_AI_PRINT("processing " << v << " of " << v->cfg());
 
 			// join predecessors
@@ -137,6 +139,11 @@ protected:
 
 		}
 
+		// record the statistics
+		if(logFor(LOG_FUN))
+			log << "\t" << cnt << " block iterations\n";
+		if(recordsStats())
+			ITERATION_COUNT(*stats) = cnt;
 	}
 
 	///
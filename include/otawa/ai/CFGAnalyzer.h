@@ -21,6 +21,8 @@
 #ifndef OTAWA_AI_CFGANALYZER_H_
 #define OTAWA_AI_CFGANALYZER_H_
 
+#include <atomic>
+#include <elm/data/HashMap.h>
 #include <elm/io/StructuredOutput.h>
 #include "Domain.h"
 
@@ -48,20 +50,39 @@ public:
 	State *after(Edge *e);
 	State *before(Block *v);
 	inline State *after(Block *v)  { return states[v->id()]; }
-	inline void release(State *s) { in_use.remove(s); }
-	inline void use(State *s) { in_use.add(s); }
+	void release(State *s);
+	void use(State *s);
 
 	inline void collect(state_collector_t f) {
 		f(s0); f(bot); f(top);
 		if(is != nullptr) f(is);
 		if(es != nullptr) f(es);
 		for(auto s: states) if(s != nullptr) f(s);
-		for(auto s: in_use) if(s != nullptr) f(s);
+		for(auto s: in_use.keys()) f(s);
+		if(engine != nullptr) collectSummaries(f);
 	}
 
 	void setTrace(io::StructuredOutput& t);
+	inline void setSummaries(bool enabled) { summaries = enabled; }
+	inline void setWTO(bool enabled) { use_wto = enabled; }
+	inline int iterationCount() const { return icnt; }
+	inline int componentIterationCount() const { return ccnt; }
+	void recordStats(PropList& stats) const;
+	inline int summaryCount() const { return scnt; }
+	inline int analysisCount() const { return acnt; }
+	inline int heldStateCount() const { return live; }
+	inline int maxHeldStateCount() const { return hwm; }
 
 private:
+	class SummaryEngine;
+	friend class SummaryEngine;
+
+	template <class Q> void processGlobal(Q& todo);
+	void collectSummaries(state_collector_t f);
+	void hold(State *s);
+	void drop(State *s);
+	inline void assign(State *&r, State *s) { if(r != s) { hold(s); drop(r); r = s; } }
+	void flush();
 	
 	void beginTrace();
 	void endTrace();
@@ -72,8 +93,12 @@ private:
 	AllocArray<State *> states;
 	State *is, *es, *s0;
 	bool verbose, verbose_inst;
-	List<State *> in_use;
+	HashMap<State *, int> in_use;
 	io::StructuredOutput *trace;
+	bool summaries, use_wto;
+	SummaryEngine *engine;
+	int scnt, acnt, icnt, ccnt;
+	std::atomic<int> live, hwm;
 };
 
 } }	// otawa::ai
@@ -52,6 +52,9 @@ public:
 		inline Successor(const CFGGraph& graph, vertex_t v): Block::EdgeIter(v->outs()) { }
 	};
 
+	inline Successor succs(vertex_t v) const { return Successor(*this, v); }
+	inline Predecessor preds(vertex_t v) const { return Predecessor(*this, v); }
+
 	class Iterator: public CFG::BlockIter {
 	public:
 		inline Iterator(const CFGGraph& g): CFG::BlockIter(g._cfg->blocks()) { }
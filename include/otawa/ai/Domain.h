@@ -43,6 +43,11 @@ public:
 	virtual State *update(Edge *e, State *s) = 0;
 	virtual State *update(Block *v, State *s);
 	virtual State *join(State *s1, State *s2, Edge *e);
+	virtual State *widen(State *s1, State *s2);
+
+	virtual void acquire(State *s);
+	virtual void release(State *s);
+	virtual void flush();
 
 	virtual bool implementsPrinting();
 	virtual void print(State *s, io::Output& out);
@@ -57,6 +62,10 @@ public:
 
 	virtual bool implementsTracing();
 	virtual void printTrace(State *s, io::StructuredOutput& out);
+
+	virtual bool implementsSummaries();
+	virtual t::hash hash(State *s);
+	virtual bool implementsConcurrency();
 };
 
 } }	// otawa::ai
@@ -43,7 +43,8 @@ public:
 
 	RankingAI(A& adapter, R& rank = single<R>()):
 		_adapter(adapter),
-		_rank(rank)
+		_rank(rank),
+		_cnt(0)
 		{ }
 
 	void run(void) {
@@ -54,6 +55,7 @@ public:
 			// process current item
 			vertex_t v = _todo.first();
 			_todo.removeFirst();
+			_cnt++;
 			_adapter.update(v, s);
 
 			// propagate modification
@@ -67,10 +69,12 @@ public:
 	}
 
 	inline int doCompare(vertex_t v1, vertex_t v2) const { return _rank.rankOf(v1) - _rank.rankOf(v2); }
+	inline int iterationCount(void) const { return _cnt; }
 
 private:
 	A& _adapter;
 	R& _rank;
+	int _cnt;
 	SortedList<vertex_t, RankingAI<A, R>> _todo;
 };
 
@@ -23,13 +23,15 @@
 #define INCLUDE_OTAWA_AI_SIMPLEAI_H_
 
 #include "WorkListDriver.h"
+#include "WTODriver.h"
 
 namespace otawa { namespace ai {
 
-template <class A>
+template <class A, class Dr = WorkListDriver<typename A::domain_t, typename A::graph_t, typename A::store_t> >
 class SimpleAI {
 public:
 	typedef A adapter_t;
+	typedef Dr driver_t;
 
 	SimpleAI(A& adapter)
 		: _adapter(adapter), _driver(adapter.domain(), adapter.graph(), adapter.store()) { }
@@ -43,9 +45,11 @@ public:
 		}
 	}
 
+	inline const Dr& driver(void) const { return _driver; }
+
 private:
 	A& _adapter;
-	WorkListDriver<typename A::domain_t, typename A::graph_t, typename A::store_t> _driver;
+	Dr _driver;
 };
 
 template <class A>
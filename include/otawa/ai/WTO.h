@@ -0,0 +1,111 @@
+/*
+ *	WTO class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_AI_WTO_H_
+#define OTAWA_AI_WTO_H_
+
+#include <elm/data/Array.h>
+#include <elm/data/Vector.h>
+#include <elm/io/Output.h>
+#include <elm/util/BitVector.h>
+#include <elm/util/Pair.h>
+
+namespace otawa { namespace ai {
+
+using namespace elm;
+
+class WTO {
+public:
+	WTO(int count);
+	~WTO();
+
+	void add(int v, int w);
+	void build(int entry);
+	template <class G> void make(const G& graph);
+
+	inline int count() const { return _succs.count(); }
+	inline int length() const { return _order.length(); }
+	inline int at(int i) const { return _order[i]; }
+	inline int endOf(int i) const { return _end[i]; }
+	inline int positionOf(int v) const { return _pos[v]; }
+	inline bool contains(int v) const { return _pos[v] >= 0; }
+	inline bool isHead(int v) const { return _heads.bit(v); }
+	void print(io::Output& out) const;
+
+	class Scheduler {
+	public:
+		Scheduler(const WTO& wto);
+		void put(int v);
+		int get();
+		inline bool isEmpty() const { return _pending == 0; }
+		inline operator bool() const { return !isEmpty(); }
+		inline bool isWideningPoint() const { return _widen; }
+		inline int iterationCount() const { return _cnt; }
+		inline int componentIterationCount() const { return _ccnt; }
+	private:
+		const WTO& _wto;
+		BitVector _dirty;
+		Vector<Pair<int, int> > _comps;
+		int _cur, _pending, _cnt, _ccnt;
+		bool _widen;
+	};
+
+private:
+	void flatten(int part);
+
+	AllocArray<Vector<int> > _succs;
+	AllocArray<int> _pos;
+	BitVector _heads;
+	Vector<int> _order, _end;
+	Vector<Vector<int> *> _parts;
+	Vector<int> _partHead;
+};
+
+/**
+ * Build the WTO of a graph, starting from its entry. The graph G must provide
+ * entry(), count(), index(), succs() and sinkOf() (like CFGGraph).
+ * @param graph		Graph to build WTO for.
+ */
+template <class G>
+void WTO::make(const G& graph) {
+	BitVector done(graph.count());
+	Vector<typename G::vertex_t> todo;
+	todo.push(graph.entry());
+	done.set(graph.index(graph.entry()));
+	while(!todo.isEmpty()) {
+		typename G::vertex_t v = todo.pop();
+		for(auto s = graph.succs(v); s(); s++) {
+			typename G::vertex_t w = graph.sinkOf(*s);
+			add(graph.index(v), graph.index(w));
+			if(!done.bit(graph.index(w))) {
+				done.set(graph.index(w));
+				todo.push(w);
+			}
+		}
+	}
+	build(graph.index(graph.entry()));
+}
+
+inline io::Output& operator<<(io::Output& out, const WTO& wto) { wto.print(out); return out; }
+
+} }	// otawa::ai
+
+#endif /* OTAWA_AI_WTO_H_ */
@@ -0,0 +1,135 @@
+/*
+ *	WTODriver class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_AI_WTODRIVER_H_
+#define OTAWA_AI_WTODRIVER_H_
+
+#include "WTO.h"
+
+namespace otawa { namespace ai {
+
+using namespace elm;
+
+class NoWidening {
+public:
+	template <class D>
+	inline typename D::t widen(D& dom, const typename D::t& old, const typename D::t& cur) const { return cur; }
+};
+
+class DomainWidening {
+public:
+	template <class D>
+	inline typename D::t widen(D& dom, const typename D::t& old, const typename D::t& cur) const { return dom.widen(old, cur); }
+};
+
+template <class D, class G, class S, class W = NoWidening>
+class WTODriver: public PreIterator<WTODriver<D, G, S, W>, typename G::vertex_t > {
+public:
+	typedef typename G::vertex_t vertex_t;
+	typedef typename D::t t;
+
+	WTODriver(D& dom, const G& graph, S& store, const W& widening = W())
+	: _dom(dom), _graph(graph), _store(store), _widening(widening), _wto(graph.count()),
+	  _verts(graph.count()), _sched(nullptr), end(false) {
+		_wto.make(graph);
+		for(typename G::Iterator v(graph); v(); v++)
+			_verts[graph.index(*v)] = *v;
+		_sched = new WTO::Scheduler(_wto);
+		store.set(_graph.entry(), dom.init());
+		for(auto succ = graph.succs(graph.entry()); succ(); succ++)
+			_sched->put(graph.index(graph.sinkOf(*succ)));
+		next();
+	}
+
+	~WTODriver() { delete _sched; }
+
+	inline bool ended(void) { return end; }
+
+	inline void next(void) {
+		while(!_sched->isEmpty()) {
+			cur = _verts[_sched->get()];
+			if(cur != _graph.exit())
+				return;
+		}
+		end = true;
+	}
+
+	inline vertex_t item(void) { return cur; }
+
+	inline void change(void) {
+		for(auto succ = _graph.succs(cur); succ(); succ++)
+			_sched->put(_graph.index(_graph.sinkOf(*succ)));
+	}
+
+	inline void change(t s) {
+		_store.set(cur, s);
+		change();
+	}
+
+	inline void check(t s) {
+		t ps = _store.get(cur);
+		if(_sched->isWideningPoint())
+			s = _widening.widen(_dom, ps, s);
+		if(!_dom.equals(s, ps))
+			change(s);
+	}
+
+	inline t input(void) { return input(cur); }
+
+	inline t input(vertex_t vertex) {
+		t s = _dom.bot();
+		for(typename G::Predecessor pred(_graph, vertex); pred(); pred++)
+			s = _dom.join(s, _store.get(*pred));
+		return s;
+	}
+
+	inline bool isWideningPoint(void) const { return _sched->isWideningPoint(); }
+	inline int iterationCount(void) const { return _sched->iterationCount(); }
+	inline int componentIterationCount(void) const { return _sched->componentIterationCount(); }
+	inline const WTO& wto(void) const { return _wto; }
+
+private:
+	D& _dom;
+	const G& _graph;
+	S& _store;
+	W _widening;
+	WTO _wto;
+	AllocArray<vertex_t> _verts;
+	WTO::Scheduler *_sched;
+	vertex_t cur;
+	bool end;
+};
+
+
+template <class G>
+class WTORanking {
+public:
+	WTORanking(const G& graph): _graph(graph), _wto(graph.count()) { _wto.make(graph); }
+	inline int rankOf(typename G::vertex_t v) const { return _wto.positionOf(_graph.index(v)); }
+	inline const WTO& wto(void) const { return _wto; }
+private:
+	const G& _graph;
+	WTO _wto;
+};
+
+} }	// otawa::ai
+
+#endif /* OTAWA_AI_WTODRIVER_H_ */
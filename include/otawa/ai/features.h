@@ -48,6 +48,10 @@ public:
 extern p::id<int> RANK_OF;
 extern p::feature RANKING_FEATURE;
 
+// statistics
+extern p::id<int> ITERATION_COUNT;
+extern p::id<int> COMPONENT_ITERATION_COUNT;
+
 } }		// otawa::ai
 
 #endif /* INCLUDE_OTAWA_AI_FEATURES_H_ */
@@ -63,7 +63,7 @@ protected:
 	virtual void work(const string& entry, PropList &props);
 	virtual void complete(PropList& props);
 
-	inline WorkSpace *workspace(void) const { return ws; }
+	WorkSpace *workspace(void) const;
 	void require(const AbstractFeature&  feature);
 	void exit(int code = 0);
 	void run(Processor *p);
@@ -76,6 +76,8 @@ protected:
 	void stats();
 	void startTask(const string& entry);
 	void completeTask();
+	void result(const string& value);
+	inline bool isParallel(void) const { return parallel_tasks && _args.count() > 1; }
 
 	const Vector<string>& arguments(void) const { return _args; }
 	Address parseAddress(const string& s);
@@ -84,6 +86,11 @@ protected:
 	void run() override;
 
 private:
+	class Task;
+	class TaskRunner;
+	void workAll(PropList& props);
+	void runTask(Task& task, TaskRunner& runner);
+
 	option::SwitchOption /*help,*/ verbose, dump;
 	option::ListOption<string> sets;
 	option::ListOption<string> params;
@@ -93,12 +100,15 @@ private:
 	option::SwitchOption record_stats;
 	option::ListOption<string> log_for;
 	option::ListOption<string> dump_for;
+	option::SwitchOption parallel_tasks;
+	option::ListOption<string> share;
 	LogOption log_level;
 	elm::sys::Path path;
 	Vector<string> _args;
 	PropList props;
 	PropList *props2;
 	WorkSpace *ws;
+	static thread_local Task *cur_task;
 };
 
 }	// otawa
@@ -44,6 +44,7 @@ class BHGEdge;
 class BHGNode;
 class BBHG;
 class BBHGNode;
+class VarTable;
 
 class BPredProcessor: public CFGProcessor {
 public:
@@ -77,27 +78,27 @@ private:
 	inline int getBit(int v,int n) { return ((v & 1 << n)>0)?1:0; }
 	inline void setBit(int&v, int n) { 	v |= (1<<n); }
 	String BitSet_to_String(const dfa::BitSet& bs);
-	dfa::BitSet lshift_BitSet(dfa::BitSet bs,int dec,bool val_in=false);
+	dfa::BitSet lshift_BitSet(const dfa::BitSet& bs,int dec,bool val_in=false);
 	void setMitraInit(const char* binary_histo);
 	
 	// Global 1bit
-	void CS__Global1b_mitra(WorkSpace *fw, CFG *cfg, BBHG *bhg, elm::HashMap<String ,ilp::Var*>& ht_vars );
-	void CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg, BBHG *bbhg,elm::Vector<BCG*> &bcgs, elm::HashMap<String ,ilp::Var*>& ht_vars );
+	void CS__Global1b_mitra(WorkSpace *fw, CFG *cfg, BBHG *bhg, VarTable& ht_vars );
+	void CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg, BBHG *bbhg,elm::Vector<BCG*> &bcgs, VarTable& ht_vars );
 	void processCFG__Global1B(WorkSpace *ws,CFG* cfg);
 	void generateBBHG(CFG* cfg,BBHG& bbhg);
-	bool contains(const elm::Vector< BBHGNode* >& v, BBHGNode& n, BBHGNode * &contained);
+	bool contains(const elm::HashMap<t::uint64, BBHGNode* >& v, BBHGNode& n, BBHGNode * &contained);
 	bool isBranch(Block* bb);
 	
 	// Global 2bits
-	void CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector<BCG*> &graphs ,	elm::HashMap<String ,ilp::Var*>& ht_vars) ;
-	void CS__Global2b(WorkSpace *fw, CFG *cfg, BHG *bhg, elm::Vector<BCG*> &graphs,elm::HashMap<String ,ilp::Var*>& ht_vars );
+	void CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector<BCG*> &graphs ,	VarTable& ht_vars) ;
+	void CS__Global2b(WorkSpace *fw, CFG *cfg, BHG *bhg, elm::Vector<BCG*> &graphs,VarTable& ht_vars );
 	bool isClassEntry(BHG* bhg, BHGNode* src);
 	bool isClassExit(BHG* bhg, BHGNode* src, bool& src_withT,bool& src_withNT);
-	bool contains(const elm::Vector< BHGNode* >& v, BHGNode& n, BHGNode * &contained);
+	bool contains(const elm::HashMap<t::uint64, BHGNode* >& v, BHGNode& n, BHGNode * &contained);
 	void historyPlusOne(dfa::BitSet& h);
 	bool isLinked(BHGEdge* dir, BHGNode* dest, dfa::BitSet& h, elm::HashMap<BHGNode* , BHGNode*>& visited_nodes);
 	Block* getFirstBranch(Block *bb, CFG* cfg);
-	void getBranches(Block* bb,dfa::BitSet bs, elm::Vector<BHGNode* >& suivants, CFG* cfg, Block* entryBr);
+	void getBranches(Block* bb,const dfa::BitSet& bs, elm::Vector<BHGNode* >& suivants, CFG* cfg, Block* entryBr);
 	void generateBHG(CFG* cfg,BHG& bhg);
 	void generateBCGs(elm::Vector<BCG*>& bcgs, BHG& bhg);
 	void processCFG__Global2B(WorkSpace *ws,CFG* cfg);
@@ -26,6 +26,9 @@
 #include <otawa/proc/Feature.h>
 #include <elm/data/Vector.h>
 #include <elm/data/Array.h>
+#include <elm/data/HashMap.h>
+#include <elm/sys/Thread.h>
+#include <elm/util/Pair.h>
 
 namespace otawa {
 
@@ -38,21 +41,50 @@ namespace cache {
 
 // LBlockBuilder class
 class LBlockBuilder: public BBProcessor {
+	friend class LBlockScanner;
 public:
 	static p::declare reg;
 	LBlockBuilder(AbstractRegistration& r = reg);
 
 protected:
+	void processAll(WorkSpace *ws) override;
 	virtual void processBB(WorkSpace *fw, CFG *cfg, Block *bb);
 	virtual void cleanup(WorkSpace *fw);
 	virtual void setup(WorkSpace *fw);
 
 private:
+	typedef enum {
+		CACHED,
+		NO_BANK,
+		NOT_CACHED
+	} status_t;
+
+	class Item {
+	public:
+		Inst *inst;
+		Address addr;
+		t::uint32 size;
+		ot::mask block;
+		int set;
+		status_t status;
+	};
+
+	class Scan {
+	public:
+		void clear(void) { bbs.clear(); items.clear(); }
+		Vector<Pair<BasicBlock *, int> > bbs;
+		Vector<Item> items;
+	};
+
+	void scan(BasicBlock *bb, Scan& scan);
+	void addItem(BasicBlock *bb, Inst *inst, Address addr, Scan& scan);
+	void build(const Scan& scan);
+
 	LBlockSet **lbsets;
 	const hard::Cache *cache;
 	const hard::Memory *mem;
 	HashMap<ot::mask, int> block_map;
-	void addLBlock(BasicBlock *bb, Inst *inst, int& index, AllocArray<LBlock *> *lblocks, Address addr);
+	sys::Mutex *mutex;
 };
 
 } }	// otawa::cachze
@@ -50,12 +50,15 @@ public:
 	
 	// Methods
 	LBlockSet(int row, const hard::Cache *cache);
+	~LBlockSet(void);
 	int add(LBlock *node);
 	inline int count(void) { return listelbc.length(); }
 	inline int cacheBlockCount(void) { return listelbc.length(); }
 	inline LBlock *lblock(int i) { return listelbc[i]; }
 	inline int set(void) { return linenumber; }
 	inline const hard::Cache *cache(void) const { return _cache; }
+	void reserve(int n);
+	void *alloc(void);
 
 	// deprecated
 	int line(void) { return linenumber; }
@@ -65,6 +68,9 @@ private:
 	elm::Vector<LBlock *> listelbc;
 	int cblock_count;
 	const hard::Cache *_cache;
+	Vector<char *> chunks;
+	char *_free;
+	int _avail;
 };
 
 } }	// otawa::cache
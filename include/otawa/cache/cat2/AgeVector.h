@@ -0,0 +1,135 @@
+/*
+ *	AgeVector class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef CACHE_AGEVECTOR_H_
+#define CACHE_AGEVECTOR_H_
+
+#include <string.h>
+#include <type_traits>
+#include <elm/types.h>
+
+namespace otawa {
+
+using namespace elm;
+
+class AgeVector {
+public:
+	typedef t::int8 age_t;
+	typedef int wide_t;
+	static const int max_assoc = 126;
+
+	inline AgeVector(void): _b(nullptr), _w(nullptr) { }
+
+	inline void make(int size, int A, int init) {
+		if(A <= max_assoc)
+			{ _b = static_cast<age_t *>(alloc(size)); fill(size, init); }
+		else
+			{ _w = static_cast<wide_t *>(alloc(size * sizeof(wide_t))); fill(size, init); }
+	}
+	inline void copy(const AgeVector& v, int size) {
+		if(v._b != nullptr)
+			_b = static_cast<age_t *>(alloc(size));
+		else
+			_w = static_cast<wide_t *>(alloc(size * sizeof(wide_t)));
+		assign(v, size);
+	}
+	inline void free(int size) {
+		if(_b != nullptr)
+			release(_b, size);
+		else if(_w != nullptr)
+			release(_w, size * sizeof(wide_t));
+		_b = nullptr;
+		_w = nullptr;
+	}
+
+	inline int operator[](int i) const { return _b != nullptr ? _b[i] : _w[i]; }
+	inline void set(int i, int a) { if(_b != nullptr) _b[i] = a; else _w[i] = a; }
+
+	inline void fill(int size, int init)
+		{ if(_b != nullptr) memset(_b, init, size); else for(int i = 0; i < size; i++) _w[i] = init; }
+	inline void assign(const AgeVector& v, int size)
+		{ if(_b != nullptr) memcpy(_b, v._b, size); else memcpy(_w, v._w, size * sizeof(wide_t)); }
+	inline bool equals(const AgeVector& v, int size) const
+		{ return _b != nullptr ? memcmp(_b, v._b, size) == 0 : memcmp(_w, v._w, size * sizeof(wide_t)) == 0; }
+
+	inline void minAge(const AgeVector& v, int size)
+		{ if(_b != nullptr) minAge(_b, v._b, size); else minAge(_w, v._w, size); }
+	inline void maxAge(const AgeVector& v, int size)
+		{ if(_b != nullptr) maxAge(_b, v._b, size); else maxAge(_w, v._w, size); }
+	inline void maxKnown(const AgeVector& v, int size)
+		{ if(_b != nullptr) maxKnown(_b, v._b, size); else maxKnown(_w, v._w, size); }
+	inline void ageAll(int size, int A)
+		{ if(_b != nullptr) ageAll(_b, size, A); else ageAll(_w, size, A); }
+	inline void ageYounger(int size, int limit)
+		{ if(_b != nullptr) ageYounger(_b, size, limit); else ageYounger(_w, size, limit); }
+	inline void ageKept(int size, int limit, int A)
+		{ if(_b != nullptr) ageKept(_b, size, limit, A); else ageKept(_w, size, limit, A); }
+
+private:
+	static void *alloc(int bytes);
+	static void release(void *p, int bytes);
+
+	template <class T> static inline void minAge(T * __restrict a, const T * __restrict b, int size) {
+		typedef typename std::make_unsigned<T>::type U;
+		for(int i = 0; i < size; i++) {
+			U x = a[i], y = b[i];
+			a[i] = x < y ? x : y;
+		}
+	}
+
+	template <class T> static inline void maxAge(T * __restrict a, const T * __restrict b, int size) {
+		typedef typename std::make_unsigned<T>::type U;
+		for(int i = 0; i < size; i++) {
+			U x = a[i], y = b[i];
+			a[i] = x > y ? x : y;
+		}
+	}
+
+	template <class T> static inline void maxKnown(T * __restrict a, const T * __restrict b, int size) {
+		for(int i = 0; i < size; i++)
+			a[i] = a[i] > b[i] ? a[i] : b[i];
+	}
+
+	template <class T> static inline void ageAll(T *a, int size, int A) {
+		for(int i = 0; i < size; i++) {
+			T x = a[i] + (a[i] != -1);
+			a[i] = x == A ? -1 : x;
+		}
+	}
+
+	template <class T> static inline void ageYounger(T *a, int size, int limit) {
+		typedef typename std::make_unsigned<T>::type U;
+		for(int i = 0; i < size; i++)
+			a[i] += U(a[i]) < U(limit);
+	}
+
+	template <class T> static inline void ageKept(T *a, int size, int limit, int A) {
+		for(int i = 0; i < size; i++)
+			a[i] += (a[i] < limit) & (a[i] != -1) & (a[i] != A);
+	}
+
+	age_t *_b;
+	wide_t *_w;
+};
+
+}	// otawa
+
+#endif /* CACHE_AGEVECTOR_H_ */
@@ -31,6 +31,7 @@
 #include <otawa/cache/LBlockSet.h>
 #include <otawa/hard/Cache.h>
 #include <otawa/cfg/BasicBlock.h>
+#include <otawa/cache/cat2/AgeVector.h>
 
 using namespace otawa::cache;
 
@@ -56,46 +57,32 @@ class MUSTProblem {
 			inline Domain(const int _size, const int _A)
 			: A (_A), size(_size)
 			{
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = 0;
+				age.make(size, A, 0);
 			}
 			
 			inline ~Domain() {
-				delete [] age;
+				age.free(size);
 			}
 			
 			inline Domain(const Domain &source) : A(source.A), size(source.size) {
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = source.age[i];
-
+				age.copy(source.age, size);
 			} 
 		
 			inline Domain& operator=(const Domain &src) {
 				ASSERT((A == src.A) && (size == src.size));
-				for (int i = 0; i < size ; i++)
-					age[i] = src.age[i];
+				age.assign(src.age, size);
 				return(*this);
 				
 			}
 			 
 			inline void glb(const Domain &dom) {
 				ASSERT((A == dom.A) && (size == dom.size));
-				
-				for (int i = 0; i < size; i++) {
-					if (((age[i] > dom.age[i]) && (dom.age[i] != -1)) || (age[i] == -1))
-						age[i] = dom.age[i];
-				}
+				age.minAge(dom.age, size);
 			}
 			
 			inline void lub(const Domain &dom) {
 				ASSERT((A == dom.A) && (size == dom.size));
-
-				for (int i = 0; i < size; i++) {
-					if (((age[i] < dom.age[i]) && (age[i] != -1))|| (dom.age[i] == -1))
-						age[i] = dom.age[i];
-				}
+				age.maxAge(dom.age, size);
 			}
 			
 			inline int getSize(void) {
@@ -106,23 +93,17 @@ class MUSTProblem {
 				ASSERT((id >= 0) && (id < size));
 				if (age[id] == -1)
 					return;
-				age[id] += damage;
-				if (age[id] >= A)
-					age[id] = -1;
+				int a = age[id] + damage;
+				age.set(id, (a >= A) ? -1 : a);
 			}
 			
 			inline bool equals(const Domain &dom) const {
 				ASSERT((A == dom.A) && (size == dom.size));
-				for (int i = 0; i < size; i++)
-					if (age[i] != dom.age[i])
-						return false;
-				return true;
+				return age.equals(dom.age, size);
 			}
 			
 			inline void empty() {
-				for (int i = 0; i < size; i++)
-					age[i] = -1;
-				
+				age.fill(size, -1);
 			}
 			
 			inline bool contains(const int id) {
@@ -132,21 +113,11 @@ class MUSTProblem {
 			
 			
 			inline void inject(const int id) {
-				if (contains(id)) {
-					for (int i = 0; i < size; i++) {
-						if ((age[i] < age[id]) && (age[i] != -1))
-							age[i]++;						
-					}
-					age[id] = 0;
-				} else {
-					for (int i = 0; i < size; i++) {
-						if (age[i] != -1) 
-							age[i]++;
-						if (age[i] == A)
-							age[i] = -1;
-					}
-				}
-				age[id] = 0;				
+				if (contains(id))
+					age.ageYounger(size, age[id]);
+				else
+					age.ageAll(size, A);
+				age.set(id, 0);
 			}
 			
 			inline void print(elm::io::Output &output) const {
@@ -177,7 +148,7 @@ class MUSTProblem {
 			inline void setAge(const int id, const int _age) {
 				ASSERT(id < size);
 				ASSERT((_age < A) || (_age == -1));
-				age[id] = _age;
+				age.set(id, _age);
 			}
 			
 		
@@ -186,7 +157,7 @@ class MUSTProblem {
 			 * age[block] represents its age, from 0 (newest) to A-1 (oldest).
 			 * The value -1 means that the block is not in the set.
 			 */  
-			int *age;
+			AgeVector age;
 	};
 	
 	private:
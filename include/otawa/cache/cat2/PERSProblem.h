@@ -31,6 +31,7 @@
 #include <otawa/hard/Cache.h>
 #include <otawa/cfg/BasicBlock.h>
 #include <otawa/dfa/hai/HalfAbsInt.h>
+#include <otawa/cache/cat2/AgeVector.h>
 
 
 namespace otawa {
@@ -46,26 +47,20 @@ class PERSProblem {
 			inline Item(const int _size, const int _A)
 			: A (_A), size(_size)
 			{
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = -1;
+				age.make(size, A, -1);
 			}
 			
 			inline ~Item() {
-				delete [] age;
+				age.free(size);
 			}
 			
 			inline Item(const Item &source) : A(source.A), size(source.size) {
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = source.age[i];
-
+				age.copy(source.age, size);
 			} 
 			
 			inline Item& operator=(const Item &src) {
 				ASSERT((A == src.A) && (size == src.size));		
-				for (int i = 0; i < size ; i++)
-					age[i] = src.age[i];
+				age.assign(src.age, size);
 				return *this;
 			}
 			
@@ -73,30 +68,21 @@ class PERSProblem {
 				ASSERT((id >= 0) && (id < size));
 				
 				if ((newage != -1) && ((age[id] > newage) || (age[id] == -1)))
-					age[id] = newage;
+					age.set(id, newage);
 			}
 			
 			inline void lub(const Item &dom) {
 				/* ASSERT((A == dom.A) && (size == dom.size)); */
-
-				for (int i = 0; i < size; i++) {					
-					if ((age[i] == -1) || ((age[i] < dom.age[i]) && (dom.age[i] != -1)) )
-						age[i] = dom.age[i];
-				}
+				age.maxKnown(dom.age, size);
 			}
 			
 			inline bool equals(const Item &dom) const {
 				ASSERT((A == dom.A) && (size == dom.size));
-				for (int i = 0; i < size; i++)
-					if (age[i] != dom.age[i])
-						return false;
-				return true;
+				return age.equals(dom.age, size);
 			}
 			
 			inline void empty() {
-				for (int i = 0; i < size; i++)
-					age[i] = -1;
-				
+				age.fill(size, -1);
 			}
 			
 			inline bool contains(const int id) {
@@ -105,19 +91,11 @@ class PERSProblem {
 			}
 			
 			inline void inject(MUSTProblem::Domain *must, const int id) {
-				if (must->contains(id)) {
-					for (int i = 0; i < size; i++) {
-						if ((age[i] < age[id]) && (age[i] != -1) && (age[i] != A))
-							age[i]++;						
-					}
-					age[id] = 0;
-				} else {
-					for (int i = 0; i < size; i++) {
-						if ((age[i] != -1) && (age[i] != A)) 
-							age[i]++;
-					}
-				}
-				age[id] = 0;				
+				if (must->contains(id))
+					age.ageKept(size, age[id], A);
+				else
+					age.ageKept(size, A + 1, A);
+				age.set(id, 0);
 			}
 			
 			inline bool isWiped(const int id) {
@@ -136,9 +114,8 @@ class PERSProblem {
 				ASSERT((id >= 0) && (id < size));
 				if (age[id] == -1)
 					return;
-				age[id] += damage;
-				if (age[id] > A)
-					age[id] = A;
+				int a = age[id] + damage;
+				age.set(id, (a > A) ? A : a);
 			}
 			
 			inline void print(elm::io::Output &output) const {
@@ -162,7 +139,7 @@ class PERSProblem {
 			 * age[block] represents its age, from 0 (newest) to A-1 (oldest).
 			 * The value -1 means that the block is not in the set.
 			 */  
-			int *age;
+			AgeVector age;
 	};
 	
 	class Domain {
@@ -202,7 +179,9 @@ class PERSProblem {
 					int sdl = src.data.length();
 					int dl = data.length();
 					int minl = (sdl > dl) ? dl : sdl;
-					data.setLength((sdl > dl) ? dl : sdl);
+					for (int i = minl; i < dl; i++)
+						delete data[i];
+					data.setLength(minl);
 					
 					for (int i = 0; i < minl; i++)
 						*data[i] = *src.data[i];
@@ -244,6 +223,7 @@ class PERSProblem {
 				}
 
 				for (int i = 0; i < dl - length; i++) {
+					delete data[0];
 					data.remove(0);
 				}
 				whole.lub(dom.whole);
@@ -366,9 +346,7 @@ class PERSProblem {
 			
 			inline void enterContext() {
 				ASSERT(!isBottom);
-				Item item(size, A);
-				item.empty();
-				data.push(new Item(item));
+				data.push(new Item(size, A));
 				
 			}
 			
@@ -23,6 +23,7 @@
 
 #include <elm/data/FragTable.h>
 #include <elm/data/ListQueue.h>
+#include <elm/data/Vector.h>
 #include <elm/data/HashMap.h>
 #include <otawa/cfg/features.h>
 #include <otawa/proc/Processor.h>
@@ -75,7 +76,7 @@ private:
 	CFGMaker *cur;
 	FragTable<CFGMaker *> makers;
 	HashMap<CFG *, CFGMaker *> cmap;
-	HashMap<Block *, Block *> bmap;
+	Vector<Block *> bmap;
 	bool no_unknown;
 	CFGCollection *coll;
 };
@@ -53,7 +53,7 @@ public:
 
 	inline const List<Loop *>& subLoops() const { return _c; }
 
-	inline const Vector<Edge *>& exitEdges() const { return **EXIT_LIST(_h); }
+	inline const Vector<Edge *>& exitEdges() const { return _f->exitsOf(_h); }
 
 	class BlockIter: public PreIterator<BlockIter, Block *> {
 	public:
@@ -141,6 +141,7 @@ public:
 	static p::id<Loop *> ID;
 private:
 	Block *_h;
+	LoopForest *_f;
 	Loop *_p;
 	int _d;
 	List<Loop *> _c;
@@ -47,13 +47,14 @@ private:
 	bool reduce(CFGMaker& G, loops_t& L);
 	Block *clone(CFGMaker& G, Block *b, bool duplicate = false);
 	void computeInLoops(CFGMaker& maker, loops_t& L);
+	inline dfa::BitSet *inLoops(Block *v) const { return in_loops[v->index()]; }
 
 	Vector<CFGMaker *> vcfgvec;
 	CFGCollection *coll;
+	Vector<dfa::BitSet *> in_loops;
 
 	static Identifier<bool> MARK;
 	static Identifier<Block*> DUPLICATE_OF;
-	static Identifier<dfa::BitSet*> IN_LOOPS;
 };
 
 }	// otawa
@@ -22,11 +22,11 @@
 #define OTAWA_CFG_POSTDOMINANCE_H
 
 #include <otawa/cfg/features.h>
-#include <otawa/proc/CFGProcessor.h>
+#include <otawa/proc/ConcurrentCFGProcessor.h>
 
 namespace otawa {
 
-class PostDominance: public CFGProcessor, public PostDomInfo {
+class PostDominance: public ConcurrentCFGProcessor, public PostDomInfo {
 public:
 	static p::declare reg;
 	PostDominance(p::declare& r = reg);
@@ -152,6 +152,28 @@ extern p::id<Block *> LOOP_EXIT;
 extern p::id<Block*>& LOOP_EXIT_EDGE;
 extern p::id<elm::Vector<Edge*> *> EXIT_LIST;
 extern p::feature LOOP_INFO_FEATURE;
+class Loop;
+class LoopForest {
+	friend class LoopInfoBuilder;
+public:
+	LoopForest(CFG *cfg);
+	~LoopForest();
+	inline CFG *cfg() const { return _cfg; }
+	inline Block *headerOf(Block *v) const { return _hdr[v->index()]; }
+	inline Block *parentOf(Block *h) const { return _parent[h->index()]; }
+	inline int depthOf(Block *v) const { Block *h = _hdr[v->index()]; return h == nullptr ? 0 : _depth[h->index()]; }
+	inline const elm::Vector<Edge *>& exitsOf(Block *h) const { return *_exits[h->index()]; }
+	inline Loop *loopOf(Block *v) const
+		{ Block *h = _hdr[v->index()]; return _loops[h == nullptr ? _cfg->entry()->index() : h->index()]; }
+	inline void setLoop(Block *h, Loop *l) { _loops[h->index()] = l; }
+private:
+	CFG *_cfg;
+	AllocArray<Block *> _hdr, _parent;
+	AllocArray<int> _depth;
+	AllocArray<elm::Vector<Edge *> *> _exits;
+	AllocArray<Loop *> _loops;
+};
+extern p::id<LoopForest *> LOOP_FOREST;
 class LoopIter: public PreIterator<LoopIter, Block *> {
 public:
 	inline LoopIter(void): h(0) { }
@@ -198,7 +220,6 @@ namespace dfa { class BitSet; }
 extern p::interfaced_feature<PostDomInfo> POSTDOMINANCE_FEATURE;
 
 // Loop support
-class Loop;
 class LoopManager {
 public:
 	virtual ~LoopManager();
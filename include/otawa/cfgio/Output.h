@@ -22,7 +22,7 @@
 #define OTAWA_CFGIO_OUTPUT_H_
 
 #include <elm/avl/Set.h>
-#include <elm/xom.h>
+#include <elm/string/StringBuffer.h>
 #include <otawa/cfg.h>
 #include <otawa/cfgio/features.h>
 #include <otawa/proc/BBProcessor.h>
@@ -35,21 +35,25 @@ class Output: public BBProcessor {
 public:
 	static p::declare reg;
 	Output(void);
+	static const int binary_version = 1;
 protected:
 	virtual void configure(const PropList& props);
 	virtual void processWorkSpace(WorkSpace *ws);
 	virtual void processCFG(WorkSpace *ws, CFG *cfg);
 	virtual void processBB(WorkSpace *ws, CFG *cfg, Block *b);
-	string id(CFG *cfg);
-	string id(Block *bb);
-	void processProps(xom::Element *parent, const PropList& props);
-	xom::Element *root, *cfg_node;
-	int last_bb;
+	void id(io::Output& out, CFG *cfg);
+	void id(io::Output& out, Block *bb);
+	void escape(io::Output& out, cstring s);
+	void processProps(io::Output& out, const PropList& props, int indent);
+	void writeBinary(io::OutStream& stream, const CFGCollection& coll);
+	io::Output *out;
+	StringBuffer edges;
 	avl::Set<const AbstractIdentifier *> ids;
 	Path path;
 	bool all;
 	bool no_insts;
 	bool line_info;
+	bool binary;
 };
 
 } }	// otawa::cfgio
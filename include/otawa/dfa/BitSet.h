@@ -22,7 +22,7 @@
 #ifndef OTAWA_DFA_BITSET_H
 #define OTAWA_DFA_BITSET_H
 
-#define OTAWA_BITSET_SIZE
+//#define OTAWA_BITSET_SIZE
 //#define OTAWA_BITSET_BOTH
 
 #if defined(OTAWA_BITSET_WAH) || defined(OTAWA_BITSET_BOTH)
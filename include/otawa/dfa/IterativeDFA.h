@@ -22,8 +22,10 @@
 #define OTAWA_UTIL_ITERATIVE_DFA_H
 
 #include <elm/assert.h>
-#include <elm/data/VectorQueue.h>
+#include <elm/data/Array.h>
+#include <elm/data/Vector.h>
 #include <elm/util/BitVector.h>
+#include <elm/util/Pair.h>
 #include <otawa/graph/DiGraph.h>
 
 #ifdef OTAWA_IDFA_DEBUG
@@ -78,10 +80,12 @@ public:
 	inline Set *killSet(typename G::vertex_t *bb);
 
 private:
+	void order(AllocArray<typename G::vertex_t *>& rpo, AllocArray<int>& rank);
+
 	Problem& prob;
 	G *_g;
 	int cnt;
-	Set **ins, **outs, **gens, **kills;
+	Set **sets, **ins, **outs, **gens, **kills;
 	typename G::vertex_t *_entry;
 };
 
@@ -90,10 +94,11 @@ private:
 template <class Problem, class Set, class G, class Iter>
 inline IterativeDFA<Problem, Set, G, Iter>::IterativeDFA(Problem& problem, G *g, typename G::vertex_t *entry)
 : prob(problem), _g(g), cnt(g->count()), _entry(entry) {
-	ins = new Set *[cnt];
-	outs = new Set *[cnt];
-	gens = new Set *[cnt];
-	kills = new Set *[cnt];
+	sets = new Set *[4 * cnt];
+	ins = sets;
+	outs = sets + cnt;
+	gens = sets + 2 * cnt;
+	kills = sets + 3 * cnt;
 	for(auto v: *_g) {
 		int idx = v->index();
 		ins[idx] = prob.empty();
@@ -115,10 +120,7 @@ inline IterativeDFA<Problem, Set, G, Iter>::~IterativeDFA(void) {
 		prob.free(gens[i]);
 		prob.free(kills[i]);
 	}
-	delete [] ins;
-	delete [] outs;
-	delete [] gens;
-	delete [] kills;
+	delete [] sets;
 }
 
 
@@ -150,64 +152,107 @@ inline Set *IterativeDFA<Problem, Set, G, Iter>::killSet(typename G::vertex_t *b
 }
 
 
+// IterativeDFA::order() inline
+template <class Problem, class Set, class G, class Iter>
+inline void IterativeDFA<Problem, Set, G, Iter>::order(AllocArray<typename G::vertex_t *>& rpo, AllocArray<int>& rank) {
+	typedef typename G::vertex_t vertex_t;
+
+	// depth-first post-order along the propagation direction
+	BitVector done(cnt);
+	Vector<Pair<vertex_t *, bool> > todo;
+	int r = cnt;
+	todo.push(pair(_entry, false));
+	while(todo) {
+		Pair<vertex_t *, bool> p = todo.pop();
+		if(p.snd) {
+			rpo[--r] = p.fst;
+			continue;
+		}
+		if(done.bit(p.fst->index()))
+			continue;
+		done.set(p.fst->index());
+		todo.push(pair(p.fst, true));
+		for(typename Iter::Forward next(p.fst); next(); next++)
+			if(!done.bit(next->index()))
+				todo.push(pair(static_cast<vertex_t *>(*next), false));
+	}
+
+	// unreachable vertices come last
+	if(r != 0) {
+		int i = 0;
+		for(int j = r; j < cnt; j++)
+			rpo[i++] = rpo[j];
+		for(auto v: *_g)
+			if(!done.bit(v->index()))
+				rpo[i++] = v;
+	}
+	for(int i = 0; i < cnt; i++)
+		rank[rpo[i]->index()] = i;
+}
+
+
 // IterativeDFA::compute() inline
 template <class Problem, class Set, class G, class Iter>
 inline void IterativeDFA<Problem, Set, G, Iter>::compute(void) {
 
 	// initialization
-	VectorQueue<typename G::vertex_t *> todo;
-	BitVector present(_g->count());
+	AllocArray<typename G::vertex_t *> rpo(cnt);
+	AllocArray<int> rank(cnt);
+	order(rpo, rank);
+	BitVector todo(cnt, true);
+	int pending = cnt;
 	Set *comp = prob.empty(), *ex;
-	for(auto bb: *_g) {
-			OTAWA_IDFA_TRACE("\tDFA: push BB" << bb->index());
-			todo.put(bb);
-			present.set(bb->index());
-		}
 
-	// perform until no change
-	while(todo) {
-		typename G::vertex_t *bb = todo.get();
-		int idx = bb->index();
-		ASSERT(idx >= 0);
-		present.clear(idx);
-		OTAWA_IDFA_TRACE("DFA: processing BB" << idx);
-
-		// IN = union OUT of predecessors
-		prob.reset(ins[idx]);
-		for(Iter pred(bb); pred(); pred++) {
-			typename G::vertex_t *bb_pred = static_cast<typename G::vertex_t *>(*pred);
-			int pred_idx = bb_pred->index();
-			ASSERT(pred_idx >= 0);
-			prob.merge(ins[idx], outs[pred_idx]);
-		}
-
-		// OUT = IN \ KILL U GEN
-		prob.set(comp, ins[idx]);
-		OTAWA_IDFA_DUMP("\tIN", comp);
-		prob.diff(comp, kills[idx]);
-		OTAWA_IDFA_DUMP("\tKILL", kills[idx]);
-		prob.add(comp, gens[idx]);
-		OTAWA_IDFA_DUMP("\tGEN", gens[idx]);
-		OTAWA_IDFA_DUMP("\tOUT", comp);
-
-		// Any modification ?
-		if(!prob.equals(comp, outs[idx])) {
-
-			// record new out
-			ex = outs[idx];
-			outs[idx] = comp;
-			comp = ex;
-
-			// add successors
-			for(typename Iter::Forward next(bb); next(); next++)
-				if(!present.bit(next->index())) {
-					OTAWA_IDFA_TRACE("\tDFA: push BB" << next->index());
-					todo.put(static_cast<typename G::vertex_t *>(*next));
-					present.set(next->index());
+	// perform until no change, sweeping in reverse post-order
+	while(pending)
+		for(int r = 0; r < cnt; r++) {
+			if(!todo.bit(r))
+				continue;
+			todo.clear(r);
+			pending--;
+			typename G::vertex_t *bb = rpo[r];
+			int idx = bb->index();
+			ASSERT(idx >= 0);
+			OTAWA_IDFA_TRACE("DFA: processing BB" << idx);
+
+			// IN = union OUT of predecessors
+			prob.reset(ins[idx]);
+			for(Iter pred(bb); pred(); pred++) {
+				typename G::vertex_t *bb_pred = static_cast<typename G::vertex_t *>(*pred);
+				int pred_idx = bb_pred->index();
+				ASSERT(pred_idx >= 0);
+				prob.merge(ins[idx], outs[pred_idx]);
+			}
+
+			// OUT = IN \ KILL U GEN
+			prob.set(comp, ins[idx]);
+			OTAWA_IDFA_DUMP("\tIN", comp);
+			prob.diff(comp, kills[idx]);
+			OTAWA_IDFA_DUMP("\tKILL", kills[idx]);
+			prob.add(comp, gens[idx]);
+			OTAWA_IDFA_DUMP("\tGEN", gens[idx]);
+			OTAWA_IDFA_DUMP("\tOUT", comp);
+
+			// Any modification ?
+			if(!prob.equals(comp, outs[idx])) {
+
+				// record new out
+				ex = outs[idx];
+				outs[idx] = comp;
+				comp = ex;
+
+				// add successors
+				for(typename Iter::Forward next(bb); next(); next++) {
+					int nr = rank[next->index()];
+					if(!todo.bit(nr)) {
+						OTAWA_IDFA_TRACE("\tDFA: push BB" << next->index());
+						todo.set(nr);
+						pending++;
+					}
 				}
+			}
+			prob.reset(comp);
 		}
-		prob.reset(comp);
-	}
 
 	// cleanup
 	prob.free(comp);
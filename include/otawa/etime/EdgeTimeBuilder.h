@@ -25,6 +25,7 @@
 #include <otawa/parexegraph/GraphBBTime.h>
 #include <otawa/etime/EventCollector.h>
 #include <otawa/etime/Config.h>
+#include <otawa/etime/MaxPlusGraph.h>
 #include "features.h"
 
 namespace otawa { namespace etime {
@@ -82,6 +83,7 @@ protected:
 	inline Vector<Resource *> *ressources(void) { return &_hw_resources; }
 
 private:
+	static const int enum_limit = 16;
 
 	class EventComparator {
 	public:
@@ -97,6 +99,8 @@ private:
 	void rollback(Event *event, ParExeInst *inst);
 	EventCollector *get(Event *event);
 	void genForOneCost(ot::time cost, Edge *edge, event_list_t& events);
+	void addConf(config_list_t& confs, ot::time cost);
+	void computeSymbolic(config_list_t& confs, const MaxPlusGraph& mpg, event_list_t& free);
 	ParExeNode *getBranchNode(void);
 	int splitConfs(const config_list_t& confs, const event_list_t& events, bool& lower);
 	void sortEvents(event_list_t& events, BasicBlock *bb, place_t place, Edge *edge = 0);
@@ -133,6 +137,7 @@ private:
 
 	// configuration
 	bool record;
+	bool symbolic;
 	t::uint32 event_mask;
 };
 
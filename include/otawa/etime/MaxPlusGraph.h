@@ -0,0 +1,105 @@
+/*
+ *	MaxPlusGraph class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_ETIME_MAXPLUSGRAPH_H_
+#define OTAWA_ETIME_MAXPLUSGRAPH_H_
+
+#include <elm/data/Array.h>
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <otawa/parexegraph/ParExeGraph.h>
+
+namespace otawa { namespace etime {
+
+using namespace elm;
+
+class MaxPlusGraph {
+public:
+	typedef t::uint64 mask_t;
+	static const int max_events = 64;
+
+	class Term {
+	public:
+		inline Term(void): req(0), var(0), base(0) { }
+		inline Term(mask_t r, mask_t v, int b): req(r), var(v), base(b) { }
+		inline bool dominates(const Term& t) const
+			{ return (req & ~t.req) == 0 && (t.var & ~var) == 0 && base >= t.base; }
+		mask_t req, var;
+		int base;
+	};
+
+	class Poly {
+	public:
+		inline bool isEmpty(void) const { return _terms.isEmpty(); }
+		inline int count(void) const { return _terms.length(); }
+		inline void clear(void) { _terms.clear(); }
+		void add(const Term& t);
+		void join(const Poly& p);
+		void mul(const Poly& p, const Poly& q);
+		bool isDefined(mask_t conf) const;
+		int eval(mask_t conf, const AllocArray<int>& w) const;
+		int lower(mask_t lo, mask_t hi, const AllocArray<int>& w) const;
+	private:
+		Vector<Term> _terms;
+	};
+
+	MaxPlusGraph(ParExeGraph *g, int events, int max_terms = 256);
+
+	void probe(int event);
+	bool build(void);
+	inline int eventCount(void) const { return _w.count(); }
+	inline int termCount(void) const { return _tcnt; }
+	ot::time evaluate(mask_t conf) const;
+	ot::time bound(mask_t lo, mask_t hi) const;
+
+private:
+	class XEdge {
+	public:
+		inline XEdge(void): src(-1), snk(-1), solid(true), lat(0), req(0), var(0) { }
+		inline XEdge(int s, int t, bool so, int l): src(s), snk(t), solid(so), lat(l), req(0), var(0) { }
+		int src, snk;
+		bool solid;
+		int lat;
+		mask_t req, var;
+	};
+
+	void latency(int n, Poly& p) const;
+	int delta(int r, mask_t lo, mask_t hi) const;
+	inline int nodeAt(ParExeNode *n) const { return _at[n->index()]; }
+
+	ParExeGraph *_g;
+	int _max, _tcnt;
+	bool _failed;
+	Vector<ParExeNode *> _nodes;
+	AllocArray<int> _at, _lat;
+	AllocArray<mask_t> _nvar;
+	Vector<XEdge> _edges;
+	HashMap<ParExeEdge *, int> _emap;
+	AllocArray<int> _w;
+
+	// closed form
+	int _last, _lp;
+	AllocArray<Poly> _ldel, _pdel;
+	Poly _llat;
+};
+
+} }	// otawa::etime
+
+#endif /* OTAWA_ETIME_MAXPLUSGRAPH_H_ */
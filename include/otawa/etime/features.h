@@ -130,6 +130,7 @@ extern p::id<ot::time> LTS_TIME;
 extern p::id<Pair<ot::time, ilp::Var *> > HTS_CONFIG;
 extern p::id<bool> ONLY_START;
 extern p::id<bool> NO_ILP_OBJECTIVE;
+extern p::id<bool> SYMBOLIC_TIMING;
 
 } }	// otawa::etime
 
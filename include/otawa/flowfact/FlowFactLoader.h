@@ -22,6 +22,7 @@
 #ifndef OTAWA_UTIL_FLOW_FACT_LOADER_H
 #define OTAWA_UTIL_FLOW_FACT_LOADER_H
 #include <otawa/flowfact/conflict.h>
+#include <elm/data/HashMap.h>
 #include <elm/data/Vector.h>
 #include <elm/io.h>
 #include <elm/string.h>
@@ -37,7 +38,7 @@
 
 // Externals
 namespace otawa  { class FlowFactLoader; }
-namespace elm { namespace xom { class Element; class Node; } }
+namespace elm { namespace xom { class Document; class Element; class Node; } }
 int util_fft_parse(otawa::FlowFactLoader *loader);
 void util_fft_error(otawa::FlowFactLoader *loader, const char *msg);
 
@@ -48,6 +49,7 @@ using namespace elm;
 // Extern class
 class ContextualPath;
 class File;
+class Symbol;
 class WorkSpace;
 
 // FlowFactLoader abstract class
@@ -117,12 +119,28 @@ private:
 	bool intoConflictPath; 
 
 
+	// address index
+	HashMap<String, MemArea> line_index;
+
+	// loop bounds applied in bulk
+	class LoopBound {
+	public:
+		inline LoopBound(void): max(-1), total(-1), min(-1) { }
+		int max, total, min;
+	};
+	HashMap<Inst *, LoopBound> loops;
+	void applyLoop(Inst *inst, const LoopBound& bound);
+	void applyLoops(void);
+	void release(void);
+
 	// F4 support
 	void loadF4(const string& path);
 
 	// XML support
 	void load(WorkSpace *ws, const Path& path);
 	void loadXML(const string& path);
+	void parseAll(void);
+	HashMap<String, xom::Document *> parsed;
 	void scanXState(xom::Element *element);
 	void scanXState(xom::Element *element, ContextualPath& path);
 	void scanXLoop(xom::Element *element, ContextualPath& path);
@@ -22,6 +22,7 @@
 #ifndef OTAWA_ILP_H
 #define OTAWA_ILP_H
 
+#include <otawa/ilp/Desc.h>
 #include <otawa/ilp/Var.h>
 #include <otawa/ilp/Constraint.h>
 #include <otawa/ilp/System.h>
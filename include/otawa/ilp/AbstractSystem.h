@@ -45,6 +45,7 @@ public:
 	virtual dyndata::AbstractIter<Term> *terms(void);
 	virtual void setComparator(comparator_t comp);
 	virtual void setLabel(const string& label);
+	void setConstant(double k) override;
 
 	class TermIter: public Expression::Iter {
 	public:
@@ -75,6 +75,17 @@ public:
 	// interface 1.2.1
 	virtual void reset(void) = 0;
 
+	// incremental resolution
+	virtual void setConstant(double k);
+	virtual void setCoefficient(Var *var, double coef);
+
+	// lazy naming
+	inline const Desc& desc(void) const { return _desc; }
+	inline void setDesc(const Desc& desc) { _desc = desc; }
+	void printLabel(io::Output& out) const;
+
+private:
+	Desc _desc;
 };
 
 io::Output& operator<<(io::Output& out, Constraint::comparator_t comp);
@@ -0,0 +1,76 @@
+/*
+ *	ilp::Desc class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_ILP_DESC_H
+#define OTAWA_ILP_DESC_H
+
+#include <elm/io.h>
+#include <elm/string.h>
+
+namespace otawa { namespace ilp {
+
+using namespace elm;
+
+// Desc class
+class Desc {
+public:
+
+	class Kind {
+	public:
+		virtual ~Kind(void);
+		virtual void print(io::Output& out, const Desc& desc) const = 0;
+	};
+
+	inline Desc(void): _kind(nullptr), _fst(-1), _snd(-1) { }
+	inline Desc(const Kind& kind, int fst, int snd = -1, const string& ctx = "")
+		: _kind(&kind), _fst(fst), _snd(snd), _ctx(ctx) { }
+	inline Desc(const Kind& kind, int fst, const string& ctx)
+		: _kind(&kind), _fst(fst), _snd(-1), _ctx(ctx) { }
+
+	inline const Kind *kind(void) const { return _kind; }
+	inline int first(void) const { return _fst; }
+	inline int second(void) const { return _snd; }
+	inline const string& context(void) const { return _ctx; }
+	inline bool isNull(void) const { return !_kind; }
+	inline operator bool(void) const { return !isNull(); }
+
+	inline void print(io::Output& out) const { if(_kind) _kind->print(out, *this); }
+	string make(void) const;
+
+private:
+	const Kind *_kind;
+	int _fst, _snd;
+	string _ctx;
+};
+
+inline io::Output& operator<<(io::Output& out, const Desc& desc) { desc.print(out); return out; }
+
+// Format-driven description kind
+class FormatKind: public Desc::Kind {
+public:
+	FormatKind(cstring format);
+	void print(io::Output& out, const Desc& desc) const override;
+private:
+	cstring _fmt;
+};
+
+} } // otawa::ilp
+
+#endif	// OTAWA_ILP_DESC_H
@@ -0,0 +1,75 @@
+/*
+ *	ilp::Exporter class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_ILP_EXPORTER_H
+#define OTAWA_ILP_EXPORTER_H
+
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <elm/io.h>
+#include <elm/sys/Path.h>
+#include <otawa/ilp/features.h>
+
+namespace otawa { namespace ilp {
+
+using namespace elm;
+
+class Constraint;
+class System;
+class Var;
+
+// Exporter class
+class Exporter {
+public:
+	static const int default_buffer_size = 1 << 20;
+
+	Exporter(System *sys, format_t format = CPLEX, int buffer_size = default_buffer_size);
+
+	inline format_t format(void) const { return _fmt; }
+	inline void setFormat(format_t format) { _fmt = format; }
+
+	void write(io::OutStream& out);
+	void write(const sys::Path& path);
+
+	static format_t formatOf(const sys::Path& path);
+	static bool isCompressed(const sys::Path& path);
+	static bool supportsCompression(void);
+
+private:
+	void writeLPSolve(io::Output& out);
+	void writeCPlex(io::Output& out);
+	void writeMPS(io::Output& out, bool free);
+	void checkFixedMPS(void);
+	void writeName(io::Output& out, Var *var);
+	void writeTerm(io::Output& out, Var *var, double coef, bool fst);
+	void writeValue(io::Output& out, double val);
+	bool isBound(Constraint *cons, Var *& var);
+	int index(Var *var);
+
+	System *_sys;
+	format_t _fmt;
+	int _size;
+	HashMap<Var *, int> _index;
+	Vector<Var *> _vars;
+};
+
+} } // otawa::ilp
+
+#endif	// OTAWA_ILP_EXPORTER_H
@@ -72,6 +72,12 @@ public:
 	// 1.3 interface
 	virtual void remove(ilp::Constraint *c) = 0;
 
+	// 1.4 interface (incremental resolution)
+	virtual double objectCoef(Var *var);
+	virtual void setObjectCoef(Var *var, double coef);
+	virtual bool resolve(WorkSpace *ws, otawa::Monitor& mon);
+	virtual bool supportsWarmStart(void);
+
 	// object function
 	inline void addObject(const Term& t) { addObjectFunction(t.snd, t.fst); }
 	inline void subObject(const Term& t) { addObjectFunction(-t.snd, t.fst); }
@@ -23,6 +23,7 @@
 #define OTAWA_ILP_VAR_H
 
 #include <elm/io.h>
+#include <otawa/ilp/Desc.h>
 
 namespace otawa { namespace ilp {
 
@@ -45,6 +46,8 @@ public:
 	virtual ~Var(void);
 	inline const string& name(void) const { return _name; }
 	inline type_t type(void) const { return _type; }
+	inline const Desc& desc(void) const { return _desc; }
+	inline void setDesc(const Desc& desc) { _desc = desc; }
 	virtual void print(io::Output& out);
 	virtual Alias *toAlias(void);
 	virtual double eval(System *sys);
@@ -57,6 +60,7 @@ protected:
 private:
 	string _name;
 	type_t _type;
+	Desc _desc;
 };
 
 // Alias class
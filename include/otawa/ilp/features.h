@@ -30,7 +30,9 @@ typedef enum format_t {
 	DEFAULT = 0,
 	LP_SOLVE = 1,
 	CPLEX = 2,
-	MOSEK = 3
+	MOSEK = 3,
+	FIXED_MPS = 4,
+	FREE_MPS = 5
 } format_t;
 
 // Output feature
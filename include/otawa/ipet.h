@@ -32,5 +32,6 @@
 #include <otawa/cache/cat2/CAT2NCBuilder.h>
 #include <otawa/cache/cat2/LinkedBlocksDetector.h>
 #include <otawa/ipet/WCETCountRecorder.h>
+#include <otawa/ipet/WhatIf.h>
 
 #endif /* OTAWA_IPET_H */
@@ -43,6 +43,7 @@ public:
 protected:
 	virtual void processBB(WorkSpace *ws, CFG *cfg, Block *bb);
 	virtual void setup(WorkSpace *ws);
+	void cleanup(WorkSpace *ws) override;
 private:
 	ilp::System *system;
 	bool _explicit;
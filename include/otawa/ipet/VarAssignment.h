@@ -41,12 +41,14 @@ public:
 
 protected:
 	virtual void processBB(WorkSpace *fw, CFG *cfg, Block *bb);
+	void processCFG(WorkSpace *ws, CFG *cfg) override;
 	virtual void setup(WorkSpace *ws);
 	virtual void cleanup(WorkSpace *ws);
 
 private:
 	bool _explicit, _recursive;
 	ilp::System *sys;
+	string _label;
 	String makeNodeVar(Block *bb, CFG *cfg);
 	String makeEdgeVar(Edge *edge, CFG *cfg);
 };
@@ -0,0 +1,103 @@
+/*
+ *	ipet::WhatIf class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_IPET_WHATIF_H
+#define OTAWA_IPET_WHATIF_H
+
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <otawa/base.h>
+#include <otawa/proc/Monitor.h>
+
+namespace otawa {
+
+class Block;
+class Edge;
+class WorkSpace;
+namespace ilp { class Constraint; class System; class Var; }
+
+namespace ipet {
+
+// WhatIf class
+class WhatIf {
+public:
+
+	class Query {
+		friend class WhatIf;
+	public:
+		Query(const string& name = "");
+		inline const string& name(void) const { return _name; }
+		inline bool isEmpty(void) const { return _changes.isEmpty(); }
+		Query& setTime(Block *b, ot::time t);
+		Query& setTime(Edge *e, ot::time t);
+		Query& setMaxBound(Block *h, int max);
+		Query& setTotalBound(Block *h, int total);
+	private:
+		typedef enum { BLOCK_TIME, EDGE_TIME, MAX_BOUND, TOTAL_BOUND } kind_t;
+		class Change {
+		public:
+			inline Change(void): kind(BLOCK_TIME), block(nullptr), edge(nullptr), val(0) { }
+			inline Change(kind_t k, Block *b, Edge *e, t::int64 v): kind(k), block(b), edge(e), val(v) { }
+			kind_t kind;
+			Block *block;
+			Edge *edge;
+			t::int64 val;
+		};
+		string _name;
+		Vector<Change> _changes;
+	};
+
+	WhatIf(WorkSpace *ws, Monitor& mon = Monitor::null);
+	inline ilp::System *system(void) const { return _sys; }
+	inline int solveCount(void) const { return _cnt; }
+
+	ot::time solve(const Query& query);
+	void solve(const Vector<Query>& queries, Vector<ot::time>& wcets);
+
+private:
+	class Undo {
+	public:
+		inline Undo(void): cons(nullptr), var(nullptr), val(0) { }
+		inline Undo(ilp::Constraint *c, ilp::Var *v, double k): cons(c), var(v), val(k) { }
+		ilp::Constraint *cons;
+		ilp::Var *var;
+		double val;
+	};
+
+	void apply(const Query::Change& change);
+	void setEntryCoefs(ilp::Constraint *cons, Block *h, double k);
+	void set(ilp::Constraint *cons, ilp::Var *var, double k);
+	void index(void);
+	void setObject(ilp::Var *var, double k);
+	void restore(void);
+	ot::time resolve(void);
+
+	WorkSpace *_ws;
+	ilp::System *_sys;
+	Monitor& _mon;
+	Vector<Undo> _undo;
+	HashMap<ilp::Var *, double> _obj;
+	bool _indexed;
+	int _cnt;
+};
+
+} }	// otawa::ipet
+
+#endif	// OTAWA_IPET_WHATIF_H
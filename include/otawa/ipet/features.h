@@ -66,6 +66,9 @@ extern p::feature CONTROL_CONSTRAINTS_FEATURE;
 extern Identifier<otawa::ilp::Constraint *> CALLING_CONSTRAINT;
 
 extern p::feature FLOW_FACTS_CONSTRAINTS_FEATURE;
+extern p::id<ilp::Constraint *> MAX_CONSTRAINT;
+extern p::id<ilp::Constraint *> TOTAL_CONSTRAINT;
+extern p::id<ilp::Constraint *> TOTAL_ZERO_CONSTRAINT;
 
 extern p::feature FLOW_FACTS_CONFLICT_CONSTRAINTS_FEATURE;  // conflict MDM
 
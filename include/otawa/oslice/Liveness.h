@@ -0,0 +1,93 @@
+/*
+ *	Liveness class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef __OTAWA_OSLICE_LIVENESS_H__
+#define __OTAWA_OSLICE_LIVENESS_H__
+
+#include <elm/data/Array.h>
+#include <elm/data/Vector.h>
+#include <elm/util/BitVector.h>
+#include <otawa/cfg.h>
+#include <otawa/cfg/features.h>
+#include <otawa/dfa/MemorySet.h>
+
+namespace otawa { namespace oslice {
+
+class Liveness {
+public:
+	Liveness(WorkSpace *ws, const CFGCollection& coll, bool with_mems, bool verbose = false);
+	virtual ~Liveness(void);
+
+	void seed(Block *v, Inst *inst, const BitVector& regs, dfa::MemorySet::t mems);
+	void run(void);
+	void ignore(int reg);
+
+	inline const BitVector& regsAtEnd(Block *v) const { return _states[v->id()].regs_end; }
+	inline const BitVector& regsAtBegin(Block *v) const { return _states[v->id()].regs_begin; }
+	inline dfa::MemorySet::t memsAtEnd(Block *v) const { return _states[v->id()].mems_end; }
+	inline dfa::MemorySet::t memsAtBegin(Block *v) const { return _states[v->id()].mems_begin; }
+	inline int processedCount(void) const { return _cnt; }
+
+protected:
+	virtual bool isUseful(Inst *inst, const BitVector& regs, const BitVector& defs, dfa::MemorySet::t mems, dfa::MemorySet::t writes);
+	virtual void keep(BasicBlock *bb, Inst *inst);
+
+private:
+	class InstInfo {
+	public:
+		inline InstInfo(void): inst(nullptr), reads(0), writes(0) { }
+		Inst *inst;
+		BitVector uses, defs, idefs;
+		dfa::MemorySet::t reads, writes;
+	};
+
+	class State {
+	public:
+		inline State(void): mems_end(0), mems_begin(0), done(false), insts(nullptr) { }
+		BitVector regs_end, regs_begin;
+		dfa::MemorySet::t mems_end, mems_begin;
+		bool done;
+		Vector<InstInfo> *insts;
+	};
+
+	void rank(const CFGCollection& coll);
+	Vector<InstInfo>& infos(BasicBlock *bb);
+	void transfer(BasicBlock *bb, int i, BitVector& regs, dfa::MemorySet::t& mems);
+	void propagate(Block *v, const BitVector& regs, dfa::MemorySet::t mems);
+	void predecessors(Block *v, Vector<Block *>& preds);
+	void put(Block *v);
+	Block *get(void);
+
+	int _rcnt;
+	bool _mems, _verbose;
+	BitVector _ignored;
+	AllocArray<State> _states;
+	AllocArray<int> _rank;
+	AllocArray<Block *> _byRank;
+	Vector<int> _heap;
+	BitVector _pending;
+	Vector<Block *> _preds;
+	dfa::MemorySet _ms;
+	int _cnt;
+};
+
+} }	// otawa::oslice
+
+#endif	// __OTAWA_OSLICE_LIVENESS_H__
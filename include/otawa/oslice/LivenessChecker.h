@@ -68,8 +68,8 @@ protected:
 	virtual bool interestingRegs(elm::BitVector const & a, elm::BitVector const & b);
 
 private:
+	class Engine;
 
- 	void processWorkingList(Vector<WorkingElement*>& workingList);
  	void initIdentifiersForEachBB(const CFGCollection& coll);
 
  	void clearAddrs(BasicBlock* bb);
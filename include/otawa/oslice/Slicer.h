@@ -49,7 +49,6 @@ protected:
 
 	virtual void slicing(void);
 
- 	void processWorkingList(elm::Vector<WorkingElement*>& workingList);
  	void initIdentifiersForEachBB(const CFGCollection& coll);
 
 
@@ -62,9 +61,6 @@ protected:
     HashMap<CFG *, CFGMaker *> map;
     FragTable<CFGMaker *> makers;
 
-    bool interestingAddrs(otawa::dfa::MemorySet::t const & a, otawa::dfa::MemorySet::t const & b);
-	bool interestingRegs(elm::BitVector const & a, elm::BitVector const & b);
-
     // used for debugging
     String _slicingCFGOutputPath;
     String _slicedCFGOutputPath;
@@ -72,6 +68,9 @@ protected:
     t::uint32 _debugLevel;
     bool _outputCFG;
     bool _lightSlicing;
+
+private:
+    class Engine;
 };
 
 
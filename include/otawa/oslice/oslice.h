@@ -85,17 +85,6 @@ public:
 	inline BasicBlock* getBB() { return _bb; }
 };
 
-class WorkingElement {
-public:
-	Block* _bb;
-	elm::BitVector _workingRegs;
-	Inst* _inst;
-	otawa::dfa::MemorySet::t _workingMems;
-	inline WorkingElement(Block* bb, Inst* inst, elm::BitVector bv, otawa::dfa::MemorySet::t & rd) :
-			_bb(bb), _workingRegs(bv), _inst(inst), _workingMems(rd) {
-	}
-};
-
 class MemoryAccessInformation {
 public:
 	inline MemoryAccessInformation(Inst* _i = 0, clp::Value _c = 0, int _s = 0): inst(_i), clpValue(_c), size(_s) { }
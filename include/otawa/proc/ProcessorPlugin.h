@@ -56,6 +56,7 @@ public:
 
 private:
 	static void init(void);
+	static ProcessorPlugin *plug(string name);
 };
 
 }	// otawa
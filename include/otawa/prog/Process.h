@@ -22,16 +22,20 @@
 #ifndef OTAWA_PROGRAM_PROCESS_H
 #define OTAWA_PROGRAM_PROCESS_H
 
+#include <atomic>
+#include <elm/data/HashMap.h>
 #include <elm/data/List.h>
 #include <elm/data/Vector.h>
 #include <elm/stree/Tree.h>
 #include <elm/string.h>
 #include <elm/sys/Path.h>
+#include <elm/sys/Thread.h>
 #include <elm/util/LockPtr.h>
 
 #include <otawa/instruction.h>
 #include <otawa/proc/Feature.h>
 #include <otawa/prog/features.h>
+#include <otawa/prog/Segment.h>
 
 namespace elm { namespace xom {
 	class Element;
@@ -172,6 +176,8 @@ public:
 	virtual void get(Address at, long double& val);
 	virtual void get(Address at, string& str);
 	virtual void get(Address at, char *buf, int size);
+	template <class T> inline bool read(Address at, T& val) const
+		{ Segment *seg = findSegmentAt(at); return seg != nullptr && seg->read(at, val); }
 
 	// LineNumber feature
 	virtual Option<Pair<cstring, int> > getSourceLine(Address addr);
@@ -201,11 +207,18 @@ protected:
 	void provide(AbstractFeature& feature);
 
 private:
+	void indexSymbols(void);
+	void indexUnmangled(void);
+	void clearIndex(void);
+
 	Vector<File *> _files;
 	List<AbstractFeature *> provided;
 	File *prog;
 	Manager *man;
 	stree::Tree<Address::offset_t, Symbol *> *smap;
+	HashMap<String, Symbol *> snames, unames;
+	sys::Mutex *smutex;
+	std::atomic<bool> sindexed, uindexed;
 };
 
 
@@ -21,6 +21,7 @@
 #ifndef OTAWA_PROG_SEGMENT_H
 #define OTAWA_PROG_SEGMENT_H
 
+#include <string.h>
 #include <elm/types.h>
 #include <elm/PreIterator.h>
 #include <elm/inhstruct/DLList.h>
@@ -62,6 +63,29 @@ public:
 	Inst *findInstAt(const Address& addr);
 	inline bool contains(const Address& addr) const { return address() <= addr && addr < topAddress(); }
 
+	// Raw bytes access
+	void setBytes(const t::uint8 *bytes, ot::size length, bool big_endian);
+	inline const t::uint8 *bytes(void) const { return _bytes; }
+	inline ot::size bytesLength(void) const { return _blen; }
+	inline bool hasBytes(void) const { return _bytes != nullptr; }
+	template <class T> inline bool read(const Address& addr, T& val) const {
+		if(_bytes == nullptr || addr.page() != _address.page() || addr.offset() < _address.offset()
+		|| t::uint64(addr.offset() - _address.offset()) + sizeof(T) > t::uint64(_blen))
+			return false;
+		const t::uint8 *p = _bytes + (addr.offset() - _address.offset());
+		if(!_swap)
+			memcpy(&val, p, sizeof(T));
+		else {
+			t::uint8 b[sizeof(T)];
+			for(int i = 0; i < int(sizeof(T)); i++)
+				b[i] = p[sizeof(T) - 1 - i];
+			memcpy(&val, b, sizeof(T));
+		}
+		return true;
+	}
+	inline bool read(const Address& addr, Address& val) const
+		{ Address::offset_t o; if(!read(addr, o)) return false; val = Address(addr.page(), o); return true; }
+
 	// ItemIter class	
 	class ItemIter: public PreIterator<ItemIter, ProgItem *> {
 	public:
@@ -100,6 +124,9 @@ private:
 	ot::size _size;
 	inhstruct::DLList _items;
 	ProgItem **map;
+	const t::uint8 *_bytes;
+	ot::size _blen;
+	bool _swap;
 };
 
 };	// namespace otawa
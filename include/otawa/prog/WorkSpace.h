@@ -107,6 +107,8 @@ public:
 	Processor *getImpl(const AbstractFeature& feature) const;
 	bool provides(const AbstractFeature& feature);
 	bool provides(cstring name);
+	void provided(Vector<const AbstractFeature *>& features) const;
+	void share(const AbstractFeature& feature);
 	inline bool implements(const AbstractFeature& feature) { return provides(feature); }
 
 	// cancellation management
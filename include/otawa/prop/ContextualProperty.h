@@ -19,6 +19,7 @@
 #ifndef OTAWA_PROP_CONTEXTUALPROPERTY_H_
 #define OTAWA_PROP_CONTEXTUALPROPERTY_H_
 
+#include <elm/data/HashMap.h>
 #include <elm/inhstruct/Tree.h>
 #include <elm/io.h>
 #include <elm/ptr.h>
@@ -84,6 +85,22 @@ class ContextualProperty: public Property {
 		ContextualStep step;
 	};
 
+	// Key class (parent node, step)
+	class Key {
+	public:
+		inline Key(void): parent(nullptr) { }
+		inline Key(const Node *p, const ContextualStep& s): parent(p), step(s) { }
+		const Node *parent;
+		ContextualStep step;
+	};
+	class KeyHash {
+	public:
+		inline t::hash computeHash(const Key& k) const
+			{ return (t::hash)k.parent * 31 + t::hash(k.step.kind()) * 7 + HashKey<Address>().computeHash(k.step.address()); }
+		inline bool isEqual(const Key& k1, const Key& k2) const
+			{ return k1.parent == k2.parent && k1.step == k2.step; }
+	};
+
 public:
 	ContextualProperty(void);
 
@@ -99,8 +116,12 @@ private:
 	PropList& makeProps(const ContextualPath& path);
 	PropList& refProps(PropList& props, const ContextualPath& path, const AbstractIdentifier& id);
 	void printRec(io::Output& out, const Node& node, int indent = 0) const;
+	inline Node *child(const Node *parent, const ContextualStep& step) const
+		{ return children.get(Key(parent, step), nullptr); }
+	Node *makeChild(Node *parent, const ContextualStep& step);
 
 	Node root;
+	HashMap<Key, Node *, KeyHash> children;
 	static AbstractIdentifier ID;
 };
 
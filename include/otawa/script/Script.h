@@ -28,6 +28,7 @@
 #include <elm/util/ErrorHandler.h>
 
 namespace elm { namespace xom {
+	class Document;
 	class Node;
 	class Element;
 	class XSLTransform;
@@ -93,10 +94,12 @@ private:
 	void onError(xom::Node *node, const string& msg);
 	void onWarning(xom::Node *node, const string& msg);
 	void makeConfig(xom::Element *elem, PropList& props);
-	elm::sys::Path path;
+	elm::sys::Path cacheFile(void);
+	void store(const elm::sys::Path& file, xom::Document *res);
+	elm::sys::Path path, cache_path;
 	PropList props;
 	Vector<ScriptItem *> items;
-	bool only_config, timed;
+	bool only_config, timed, use_cache;
 	int _version;
 };
 
@@ -107,6 +110,8 @@ extern Identifier<xom::Element *> SCRIPT;
 extern Identifier<xom::Element *> PLATFORM;
 extern Identifier<bool> ONLY_CONFIG;
 extern Identifier<bool> TIME_STAT;
+extern Identifier<bool> CACHE;
+extern Identifier<elm::sys::Path> CACHE_PATH;
 
 } } // otawa::script
 
@@ -0,0 +1,72 @@
+/*
+ *	MultiCacheDriver class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_SIM_MULTICACHEDRIVER_H
+#define OTAWA_SIM_MULTICACHEDRIVER_H
+
+#include <elm/data/Vector.h>
+#include <otawa/sim/CacheDriver.h>
+
+namespace otawa {
+
+// External classes
+namespace hard {
+	class Cache;
+} // hard
+
+namespace sim {
+
+// MultiCacheDriver class
+class MultiCacheDriver: public CacheDriver {
+public:
+	MultiCacheDriver(void);
+	virtual ~MultiCacheDriver(void);
+
+	int add(const hard::Cache *cache);
+	inline int count(void) const { return _confs.length(); }
+	inline const hard::Cache *cache(int i) const { return _confs[i].cache; }
+
+	virtual result_t access(address_t address, size_t size, action_t action);
+	result_t result(int i) const;
+	t::uint64 hitCount(int i) const;
+	inline t::uint64 missCount(int i) const { return _cnt - hitCount(i); }
+	inline t::uint64 accessCount(void) const { return _cnt; }
+	void reset(void);
+
+private:
+	class Stack;
+	class FIFO;
+	class Conf {
+	public:
+		inline Conf(void): cache(nullptr), stack(nullptr), fifo(nullptr) { }
+		const hard::Cache *cache;
+		Stack *stack;
+		FIFO *fifo;
+	};
+
+	Vector<Conf> _confs;
+	Vector<Stack *> _stacks;
+	Vector<FIFO *> _fifos;
+	t::uint64 _cnt;
+};
+
+} } // otawa::sim
+
+#endif	// OTAWA_SIM_MULTICACHEDRIVER_H
@@ -46,6 +46,7 @@ public:
 	virtual int cycle(void) = 0;
 	virtual void reset(void) = 0;
 	virtual Process *process(void) = 0;
+	virtual void release(void);
 };
 
 } } // otawa::sim
@@ -140,6 +140,7 @@ private:
 class Iter: public sem::StateIter<Manager> {
 public:
 	Iter(WorkSpace *ws);
+	Iter(Manager& manager);
 	inline Value getReg(int i) { return man->getReg(state(), i); }
 	inline Value getMem(Value addr, int size) { return man->getMem(state(), addr, size); }
 private:
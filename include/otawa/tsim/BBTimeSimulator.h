@@ -21,23 +21,33 @@
 #ifndef OTAWA_TSIM_BBTIMESIMULATOR_H_
 #define OTAWA_TSIM_BBTIMESIMULATOR_H_
 
+#include <elm/data/Vector.h>
+#include <elm/sys/Thread.h>
 #include <otawa/proc/BBProcessor.h>
 #include <otawa/sim/State.h>
 
 namespace otawa { namespace tsim {
 
 class BBTimeSimulator: public BBProcessor {
+	friend class BBTimeRunner;
 public:
 	static p::declare reg;
 	BBTimeSimulator(p::declare& r = reg);
 
 protected:
 	void setup(WorkSpace *ws) override;
+	void processAll(WorkSpace *ws) override;
 	void processBB(WorkSpace *fw, CFG *cfg, Block *bb) override;
 	void cleanup(WorkSpace *ws) override;
 
 private:
+	sim::State *take(void);
+	void give(sim::State *s);
+	int simulate(sim::State *s, BasicBlock *bb);
+
 	sim::State *state;
+	Vector<sim::State *> pool;
+	sys::Mutex *mutex;
 };
 
 } }		//otawa::tsim
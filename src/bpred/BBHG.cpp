@@ -21,6 +21,7 @@
  */
 #include <otawa/platform.h>
 #include "BBHG.h"
+#include "BHG.h"
 #include <iostream>
 using namespace otawa;
 using namespace elm;
@@ -58,6 +59,7 @@ BBHGNode::BBHGNode(otawa::Block* cfg_bb,const otawa::dfa::BitSet &bs, bool branc
 	this->m_history = new otawa::dfa::BitSet(bs);
 	this->m_history_size = bs.size();
 	this->m_branch = branch;
+	this->m_key = (t::uint64(cfg_bb->index()) << 32) | packHistory(bs);
 }
 
 BBHGNode::~BBHGNode() {
@@ -106,7 +108,7 @@ otawa::dfa::BitSet& BBHGNode::getHistory() {
 
 
 bool BBHGNode::equals(const BBHGNode& b) {
-	return (this->m_bb->index() == b.m_bb->index() && *(this->m_history) == *(b.m_history));
+	return this->m_key == b.m_key;
 }
 
 void BBHGNode::setExit(bool isExit,bool withT , bool withNT ) {
@@ -77,6 +77,7 @@ public:
 	bool isBranch();
 	bool isSuccessor(BBHGNode* succ,bool& withT, bool& withNT);
 	bool equals(const BBHGNode& b);
+	inline t::uint64 key() const { return m_key; }
 	void setExit(bool isExit, bool withT = false, bool withNT = false);
 
 private:
@@ -88,6 +89,7 @@ private:
 	otawa::dfa::BitSet *m_history;
 	otawa::Block *m_bb;
 	int m_history_size;
+	t::uint64 m_key;
 };
 
 } }		// otawa::bpred
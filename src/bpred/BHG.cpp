@@ -54,6 +54,7 @@ BHGNode::BHGNode(otawa::Block* cfg_bb,const otawa::dfa::BitSet &bs,bool entry, b
 	this->m_exit_NT = exit_NT;
 	this->m_history = new otawa::dfa::BitSet(bs);
 	this->m_history_size = bs.size();
+	this->m_key = (t::uint64(cfg_bb->index()) << 32) | packHistory(bs);
 }
 
 BHGNode::~BHGNode() {
@@ -98,7 +99,7 @@ otawa::dfa::BitSet& BHGNode::getHistory() {
 
 
 bool BHGNode::equals(const BHGNode& b) {
-	return (this->m_bb->index() == b.m_bb->index() && *(this->m_history) == *(b.m_history));
+	return this->m_key == b.m_key;
 }
 
 void BHGNode::setExit(bool withT , bool withNT ) {
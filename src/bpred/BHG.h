@@ -62,6 +62,16 @@ private:
 
 
 
+// packed form of a history (at most 32 bits)
+inline t::uint32 packHistory(const otawa::dfa::BitSet& h) {
+	ASSERTP(h.size() <= 32, "bpred: history too big");
+	t::uint32 r = 0;
+	for(int i = 0; i < h.size(); i++)
+		if(h.contains(i))
+			r |= t::uint32(1) << i;
+	return r;
+}
+
 class BHGNode : public otawa::graph::GenVertex<BHGNode, BHGEdge> {
 public:
 	BHGNode(otawa::Block* cfg_bb,const otawa::dfa::BitSet& bs, bool entry=false, bool exit=false, bool exit_T=false, bool exit_NT=false);
@@ -75,6 +85,7 @@ public:
 	bool exitsWithNT();
 	bool isSuccessor(BHGNode* succ,bool& withT, bool& withNT);
 	bool equals(const BHGNode& b);
+	inline t::uint64 key() const { return m_key; }
 	void setExit(bool withT = false, bool withNT = false);
 
 private:
@@ -85,6 +96,7 @@ private:
 	otawa::dfa::BitSet *m_history;
 	otawa::Block *m_bb;
 	int m_history_size;
+	t::uint64 m_key;
 };
 
 } }		// otawa::bpred
@@ -244,21 +244,15 @@ String BPredProcessor::BitSet_to_String(const dfa::BitSet& bs) {
  *
  * @return A new BitSet corresponding to the left shift applied to the given BitSet.
  */
-dfa::BitSet BPredProcessor::lshift_BitSet(dfa::BitSet bs,int dec,bool val_in) {
-//	cerr << "{ " << BitSet_to_String(bs) << "<<" << dec << " avec " << ((val_in)?"1":"0") << " => ";
-	dfa::BitSet _bs=bs;
-	bs.empty();
-	for(int i = _bs.size()-1,j = _bs.size()-1-dec;j>=0;--i,--j) {
-		if(_bs.contains(j)) {
-			bs.add(i);
-		}
-	}
-	for(int i=dec-1;i>=0;--i) {
-		if(val_in)
-			bs.add(i);
-	}
-//	cerr << BitSet_to_String(bs) << " }\n";
-	return bs;
+dfa::BitSet BPredProcessor::lshift_BitSet(const dfa::BitSet& bs,int dec,bool val_in) {
+	dfa::BitSet r(bs.size());
+	for(int i = bs.size() - 1; i >= dec; --i)
+		if(bs.contains(i - dec))
+			r.add(i);
+	if(val_in)
+		for(int i = dec - 1; i >= 0; --i)
+			r.add(i);
+	return r;
 }
 
 /**
@@ -25,6 +25,7 @@
 #include "BCGDrawer.h"
 #include "BSets.h"
 #include "BCG.h"
+#include "VarTable.h"
 #include <otawa/ipet/BasicConstraintsBuilder.h>
 #include <otawa/ipet/IPET.h>
 #include <otawa/ipet/ILPSystemGetter.h>
@@ -44,19 +45,9 @@ namespace otawa { namespace bpred {
 													ASSERT(cons_name);
 
 #define NEW_VAR_FROM_BUFF(var_name,buff_expr)	{ \
-													StringBuffer sb##var_name; \
-													sb##var_name << buff_expr; \
-													String s##var_name = sb##var_name.toString(); \
-													if(ht_vars.exists(s##var_name)) { \
-														var_name = ht_vars.get(s##var_name); \
-														ASSERT(var_name); \
-													} \
-													else { \
-														if(this->explicit_mode) var_name = system->newVar(s##var_name); \
-														else var_name = system->newVar(String("")); \
-														ASSERT(var_name); \
-														ht_vars.put(s##var_name,var_name); \
-													} \
+													VarTable::Key k##var_name(ht_vars); \
+													k##var_name << buff_expr; \
+													var_name = ht_vars.make(k##var_name); \
 												}
 // AVCTIVER(>0) / DESACTIVER(0) LES BLOCS DE CONTRAINTES
 #define ALL_C 1
@@ -113,7 +104,7 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 	// Recuperation de l'ensemble des contraintes
 	System *system = ipet::SYSTEM(fw);
 	ASSERT(system);
-	HashMap<String , Var*> ht_vars;
+	VarTable ht_vars(system, this->explicit_mode);
 
 	elm::Vector<int> l_addr;
 	bs.get_all_addr(l_addr);
@@ -147,10 +138,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 			BCGNode *n = getBCGNode(l_bb[b],bcg);
 			if(n->isEntry()) {
 				Var *C00s, *C01s, *C10s, *C11s;
-				NEW_VAR_FROM_BUFF(C00s,Xi->name() << "A" << l_addr[i] << "C00start");
-				NEW_VAR_FROM_BUFF(C01s,Xi->name() << "A" << l_addr[i] << "C01start");
-				NEW_VAR_FROM_BUFF(C10s,Xi->name() << "A" << l_addr[i] << "C10start");
-				NEW_VAR_FROM_BUFF(C11s,Xi->name() << "A" << l_addr[i] << "C11start");
+				NEW_VAR_FROM_BUFF(C00s,Xi << "A" << l_addr[i] << "C00start");
+				NEW_VAR_FROM_BUFF(C01s,Xi << "A" << l_addr[i] << "C01start");
+				NEW_VAR_FROM_BUFF(C10s,Xi << "A" << l_addr[i] << "C10start");
+				NEW_VAR_FROM_BUFF(C11s,Xi << "A" << l_addr[i] << "C11start");
 				Cs->addLeft(1,C00s);
 				Cs->addLeft(1,C01s);
 				Cs->addLeft(1,C10s);
@@ -159,10 +150,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 			
 			if(n->isExit()) {
 				Var *C00e, *C01e, *C10e, *C11e;
-				NEW_VAR_FROM_BUFF(C00e,Xi->name() << "A" << l_addr[i] << "C00end");
-				NEW_VAR_FROM_BUFF(C01e,Xi->name() << "A" << l_addr[i] << "C01end");
-				NEW_VAR_FROM_BUFF(C10e,Xi->name() << "A" << l_addr[i] << "C10end");
-				NEW_VAR_FROM_BUFF(C11e,Xi->name() << "A" << l_addr[i] << "C11end");
+				NEW_VAR_FROM_BUFF(C00e,Xi << "A" << l_addr[i] << "C00end");
+				NEW_VAR_FROM_BUFF(C01e,Xi << "A" << l_addr[i] << "C01end");
+				NEW_VAR_FROM_BUFF(C10e,Xi << "A" << l_addr[i] << "C10end");
+				NEW_VAR_FROM_BUFF(C11e,Xi << "A" << l_addr[i] << "C11end");
 				Ce->addLeft(1,C00e);
 				Ce->addLeft(1,C01e);
 				Ce->addLeft(1,C10e);
@@ -213,10 +204,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				for(auto s = br->outs(); s(); s++) {
 					if( s->isTaken() == t ) {
 						Var *C00,*C01,*C10,*C11;
-						NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << bcg->getClass() << "C00D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << bcg->getClass() << "C01D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << bcg->getClass() << "C10D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << bcg->getClass() << "C11D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C00,Xi << "A" << bcg->getClass() << "C00D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C01,Xi << "A" << bcg->getClass() << "C01D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C10,Xi << "A" << bcg->getClass() << "C10D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C11,Xi << "A" << bcg->getClass() << "C11D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
 						B21->addLeft(1,C00);
 						B21->addLeft(1,C01);
 						B21->addLeft(1,C10);
@@ -226,10 +217,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				
 				if(br->isExit() && ( (br->exitsWithT() == t) || (br->exitsWithNT() == !t ) )){
 					Var *C00,*C01,*C10,*C11;
-					NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << bcg->getClass() << "C00D" << cpt << "end");
-					NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << bcg->getClass() << "C01D" << cpt << "end");
-					NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << bcg->getClass() << "C10D" << cpt << "end");
-					NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << bcg->getClass() << "C11D" << cpt << "end");
+					NEW_VAR_FROM_BUFF(C00,Xi << "A" << bcg->getClass() << "C00D" << cpt << "end");
+					NEW_VAR_FROM_BUFF(C01,Xi << "A" << bcg->getClass() << "C01D" << cpt << "end");
+					NEW_VAR_FROM_BUFF(C10,Xi << "A" << bcg->getClass() << "C10D" << cpt << "end");
+					NEW_VAR_FROM_BUFF(C11,Xi << "A" << bcg->getClass() << "C11D" << cpt << "end");
 					B21->addLeft(1,C00);
 					B21->addLeft(1,C01);
 					B21->addLeft(1,C10);
@@ -261,10 +252,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						BasicBlock* bb_pred=getBB(p->source()->getCorrespondingBBNumber(), cfg);
 						Var *Xj = ipet::VAR( bb_pred);
 						ASSERT(Xj);
-						NEW_VAR_FROM_BUFF(C00,Xj->name() << "A" << bcg->getClass() << "C00S" << br->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C01,Xj->name() << "A" << bcg->getClass() << "C01S" << br->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C10,Xj->name() << "A" << bcg->getClass() << "C10S" << br->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C11,Xj->name() << "A" << bcg->getClass() << "C11S" << br->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C00,Xj << "A" << bcg->getClass() << "C00S" << br->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C01,Xj << "A" << bcg->getClass() << "C01S" << br->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C10,Xj << "A" << bcg->getClass() << "C10S" << br->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C11,Xj << "A" << bcg->getClass() << "C11S" << br->getCorrespondingBBNumber());
 						B22_pred->addRight(1,C00);
 						B22_pred->addRight(1,C01);
 						B22_pred->addRight(1,C10);
@@ -276,10 +267,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				// s'il s'agit d'une entrée on ajoute les variables correspondantes
 				if(br->isEntry()) {
 					Var *C00,*C01,*C10,*C11;
-					NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << bcg->getClass() << "C00start");
-					NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << bcg->getClass() << "C01start");
-					NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << bcg->getClass() << "C10start");
-					NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << bcg->getClass() << "C11start");
+					NEW_VAR_FROM_BUFF(C00,Xi << "A" << bcg->getClass() << "C00start");
+					NEW_VAR_FROM_BUFF(C01,Xi << "A" << bcg->getClass() << "C01start");
+					NEW_VAR_FROM_BUFF(C10,Xi << "A" << bcg->getClass() << "C10start");
+					NEW_VAR_FROM_BUFF(C11,Xi << "A" << bcg->getClass() << "C11start");
 					B22_pred->addRight(1,C00);
 					B22_pred->addRight(1,C01);
 					B22_pred->addRight(1,C10);
@@ -296,10 +287,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				for(auto s = br->outs(); s() ; s++ ) {
 					if(var_added[s->sink()->getCorrespondingBBNumber()]==0) {
 						Var *C00,*C01,*C10,*C11;
-						NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << bcg->getClass() << "C00S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << bcg->getClass() << "C01S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << bcg->getClass() << "C10S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << bcg->getClass() << "C11S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C00,Xi << "A" << bcg->getClass() << "C00S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C01,Xi << "A" << bcg->getClass() << "C01S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C10,Xi << "A" << bcg->getClass() << "C10S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(C11,Xi << "A" << bcg->getClass() << "C11S" << s->sink()->getCorrespondingBBNumber());
 						B22_succ->addRight(1,C00);
 						B22_succ->addRight(1,C01);
 						B22_succ->addRight(1,C10);
@@ -311,10 +302,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				// s'il s'agit d'une sortie on ajoute les variables correspondantes
 				if(br->isExit()) {
 					Var *C00,*C01,*C10,*C11;
-					NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << bcg->getClass() << "C00end");
-					NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << bcg->getClass() << "C01end");
-					NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << bcg->getClass() << "C10end");
-					NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << bcg->getClass() << "C11end");
+					NEW_VAR_FROM_BUFF(C00,Xi << "A" << bcg->getClass() << "C00end");
+					NEW_VAR_FROM_BUFF(C01,Xi << "A" << bcg->getClass() << "C01end");
+					NEW_VAR_FROM_BUFF(C10,Xi << "A" << bcg->getClass() << "C10end");
+					NEW_VAR_FROM_BUFF(C11,Xi << "A" << bcg->getClass() << "C11end");
 					B22_succ->addRight(1,C00);
 					B22_succ->addRight(1,C01);
 					B22_succ->addRight(1,C10);
@@ -342,10 +333,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						NEW_SPECIAL_CONSTRAINT(B23_11,EQ,0);
 						Var *v00, *v01, *v10, *v11;
 	
-						NEW_VAR_FROM_BUFF(v00,Xi->name() << "A" << bcg->getClass() << "C00S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(v01,Xi->name() << "A" << bcg->getClass() << "C01S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(v10,Xi->name() << "A" << bcg->getClass() << "C10S" << s->sink()->getCorrespondingBBNumber());
-						NEW_VAR_FROM_BUFF(v11,Xi->name() << "A" << bcg->getClass() << "C11S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(v00,Xi << "A" << bcg->getClass() << "C00S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(v01,Xi << "A" << bcg->getClass() << "C01S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(v10,Xi << "A" << bcg->getClass() << "C10S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(v11,Xi << "A" << bcg->getClass() << "C11S" << s->sink()->getCorrespondingBBNumber());
 						B23_00->addLeft(1,v00);
 						B23_01->addLeft(1,v01);
 						B23_10->addLeft(1,v10);
@@ -355,10 +346,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						br->isSuccessor(s->sink(),withT,withNT);
 						if(withT) {
 							Var *T00,*T01,*T10,*T11;
-							NEW_VAR_FROM_BUFF(T00,Xi->name() << "A" << bcg->getClass() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(T01,Xi->name() << "A" << bcg->getClass() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(T10,Xi->name() << "A" << bcg->getClass() << "C10D1S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(T11,Xi->name() << "A" << bcg->getClass() << "C11D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(T00,Xi << "A" << bcg->getClass() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(T01,Xi << "A" << bcg->getClass() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(T10,Xi << "A" << bcg->getClass() << "C10D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(T11,Xi << "A" << bcg->getClass() << "C11D1S" << s->sink()->getCorrespondingBBNumber());
 							B23_00->addRight(1,T00);
 							B23_01->addRight(1,T01);
 							B23_10->addRight(1,T10);
@@ -366,10 +357,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						}
 						if(withNT) {
 							Var *NT00,*NT01,*NT10,*NT11;
-							NEW_VAR_FROM_BUFF(NT00,Xi->name() << "A" << bcg->getClass() << "C00D0S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(NT01,Xi->name() << "A" << bcg->getClass() << "C01D0S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(NT10,Xi->name() << "A" << bcg->getClass() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(NT11,Xi->name() << "A" << bcg->getClass() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(NT00,Xi << "A" << bcg->getClass() << "C00D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(NT01,Xi << "A" << bcg->getClass() << "C01D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(NT10,Xi << "A" << bcg->getClass() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(NT11,Xi << "A" << bcg->getClass() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
 							B23_00->addRight(1,NT00);
 							B23_01->addRight(1,NT01);
 							B23_10->addRight(1,NT10);
@@ -390,10 +381,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 					
 					
 					Var *v00end, *v01end, *v10end, *v11end;
-					NEW_VAR_FROM_BUFF(v00end,Xi->name() << "A" << bcg->getClass() << "C00end");
-					NEW_VAR_FROM_BUFF(v01end,Xi->name() << "A" << bcg->getClass() << "C01end");
-					NEW_VAR_FROM_BUFF(v10end,Xi->name() << "A" << bcg->getClass() << "C10end");
-					NEW_VAR_FROM_BUFF(v11end,Xi->name() << "A" << bcg->getClass() << "C11end");
+					NEW_VAR_FROM_BUFF(v00end,Xi << "A" << bcg->getClass() << "C00end");
+					NEW_VAR_FROM_BUFF(v01end,Xi << "A" << bcg->getClass() << "C01end");
+					NEW_VAR_FROM_BUFF(v10end,Xi << "A" << bcg->getClass() << "C10end");
+					NEW_VAR_FROM_BUFF(v11end,Xi << "A" << bcg->getClass() << "C11end");
 					B23_exit00->addLeft(1,v00end);
 					B23_exit01->addLeft(1,v01end);
 					B23_exit10->addLeft(1,v10end);
@@ -401,10 +392,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 
 					if(br->exitsWithT()) {
 						Var *eT00,*eT01,*eT10,*eT11;
-						NEW_VAR_FROM_BUFF(eT00,Xi->name() << "A" << bcg->getClass() << "C00D1end");
-						NEW_VAR_FROM_BUFF(eT01,Xi->name() << "A" << bcg->getClass() << "C01D1end");
-						NEW_VAR_FROM_BUFF(eT10,Xi->name() << "A" << bcg->getClass() << "C10D1end");
-						NEW_VAR_FROM_BUFF(eT11,Xi->name() << "A" << bcg->getClass() << "C11D1end");
+						NEW_VAR_FROM_BUFF(eT00,Xi << "A" << bcg->getClass() << "C00D1end");
+						NEW_VAR_FROM_BUFF(eT01,Xi << "A" << bcg->getClass() << "C01D1end");
+						NEW_VAR_FROM_BUFF(eT10,Xi << "A" << bcg->getClass() << "C10D1end");
+						NEW_VAR_FROM_BUFF(eT11,Xi << "A" << bcg->getClass() << "C11D1end");
 						B23_exit00->addRight(1,eT00);
 						B23_exit01->addRight(1,eT01);
 						B23_exit10->addRight(1,eT10);
@@ -412,10 +403,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 					}
 					if(br->exitsWithNT()) {
 						Var *eNT00,*eNT01,*eNT10,*eNT11;
-						NEW_VAR_FROM_BUFF(eNT00,Xi->name() << "A" << bcg->getClass() << "C00D0end");
-						NEW_VAR_FROM_BUFF(eNT01,Xi->name() << "A" << bcg->getClass() << "C01D0end");
-						NEW_VAR_FROM_BUFF(eNT10,Xi->name() << "A" << bcg->getClass() << "C10D0end");
-						NEW_VAR_FROM_BUFF(eNT11,Xi->name() << "A" << bcg->getClass() << "C11D0end");
+						NEW_VAR_FROM_BUFF(eNT00,Xi << "A" << bcg->getClass() << "C00D0end");
+						NEW_VAR_FROM_BUFF(eNT01,Xi << "A" << bcg->getClass() << "C01D0end");
+						NEW_VAR_FROM_BUFF(eNT10,Xi << "A" << bcg->getClass() << "C10D0end");
+						NEW_VAR_FROM_BUFF(eNT11,Xi << "A" << bcg->getClass() << "C11D0end");
 						B23_exit00->addRight(1,eNT00);
 						B23_exit01->addRight(1,eNT01);
 						B23_exit10->addRight(1,eNT10);
@@ -441,10 +432,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				NEW_SPECIAL_CONSTRAINT(C11_2,EQ,0);
 
 				Var *v00, *v01, *v10, *v11;
-				NEW_VAR_FROM_BUFF(v00,Xi->name() << "A" << bcg->getClass() << "C00");
-				NEW_VAR_FROM_BUFF(v01,Xi->name() << "A" << bcg->getClass() << "C01");
-				NEW_VAR_FROM_BUFF(v10,Xi->name() << "A" << bcg->getClass() << "C10");
-				NEW_VAR_FROM_BUFF(v11,Xi->name() << "A" << bcg->getClass() << "C11");
+				NEW_VAR_FROM_BUFF(v00,Xi << "A" << bcg->getClass() << "C00");
+				NEW_VAR_FROM_BUFF(v01,Xi << "A" << bcg->getClass() << "C01");
+				NEW_VAR_FROM_BUFF(v10,Xi << "A" << bcg->getClass() << "C10");
+				NEW_VAR_FROM_BUFF(v11,Xi << "A" << bcg->getClass() << "C11");
 				C00_1->addLeft(1,v00);
 				C00_2->addLeft(1,v00);
 				C01_1->addLeft(1,v01);
@@ -469,10 +460,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						p->source()->isSuccessor(br,withT,withNT);
 						if(withT) {
 							Var *x00d1, *x01d1, *x10d1, *x11d1;
-							NEW_VAR_FROM_BUFF(x00d1,Xj->name() << "A" << bcg->getClass() << "C00D1S" << br->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x01d1,Xj->name() << "A" << bcg->getClass() << "C01D1S" << br->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x10d1,Xj->name() << "A" << bcg->getClass() << "C10D1S" << br->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x11d1,Xj->name() << "A" << bcg->getClass() << "C11D1S" << br->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x00d1,Xj << "A" << bcg->getClass() << "C00D1S" << br->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x01d1,Xj << "A" << bcg->getClass() << "C01D1S" << br->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x10d1,Xj << "A" << bcg->getClass() << "C10D1S" << br->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x11d1,Xj << "A" << bcg->getClass() << "C11D1S" << br->getCorrespondingBBNumber());
 							C01_1->addRight(1,x00d1);
 							C10_1->addRight(1,x01d1);
 							C11_1->addRight(1,x10d1);
@@ -480,10 +471,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						}
 						if(withNT) {
 							Var *x00d0, *x01d0, *x10d0, *x11d0;
-							NEW_VAR_FROM_BUFF(x00d0,Xj->name() << "A" << bcg->getClass() << "C00D0S" << br->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x01d0,Xj->name() << "A" << bcg->getClass() << "C01D0S" << br->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x10d0,Xj->name() << "A" << bcg->getClass() << "C10D0S" << br->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x11d0,Xj->name() << "A" << bcg->getClass() << "C11D0S" << br->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x00d0,Xj << "A" << bcg->getClass() << "C00D0S" << br->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x01d0,Xj << "A" << bcg->getClass() << "C01D0S" << br->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x10d0,Xj << "A" << bcg->getClass() << "C10D0S" << br->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x11d0,Xj << "A" << bcg->getClass() << "C11D0S" << br->getCorrespondingBBNumber());
 							C00_1->addRight(1,x00d0);
 							C00_1->addRight(1,x01d0);
 							C01_1->addRight(1,x10d0);
@@ -495,10 +486,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				}
 				if(br->isEntry()) {
 					Var *x00start,*x01start,*x10start,*x11start;
-					NEW_VAR_FROM_BUFF(x00start,Xi->name() << "A" << bcg->getClass() << "C00start");
-					NEW_VAR_FROM_BUFF(x01start,Xi->name() << "A" << bcg->getClass() << "C01start");
-					NEW_VAR_FROM_BUFF(x10start,Xi->name() << "A" << bcg->getClass() << "C10start");
-					NEW_VAR_FROM_BUFF(x11start,Xi->name() << "A" << bcg->getClass() << "C11start");
+					NEW_VAR_FROM_BUFF(x00start,Xi << "A" << bcg->getClass() << "C00start");
+					NEW_VAR_FROM_BUFF(x01start,Xi << "A" << bcg->getClass() << "C01start");
+					NEW_VAR_FROM_BUFF(x10start,Xi << "A" << bcg->getClass() << "C10start");
+					NEW_VAR_FROM_BUFF(x11start,Xi << "A" << bcg->getClass() << "C11start");
 					C00_1->addRight(1,x00start);
 					C01_1->addRight(1,x01start);
 					C10_1->addRight(1,x10start);
@@ -513,10 +504,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						br->isSuccessor(s->sink(),withT,withNT);
 						if(withT) {
 							Var *x00_d1, *x01_d1, *x10_d1, *x11_d1;
-							NEW_VAR_FROM_BUFF(x00_d1,Xi->name() << "A" << bcg->getClass() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x01_d1,Xi->name() << "A" << bcg->getClass() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x10_d1,Xi->name() << "A" << bcg->getClass() << "C10D1S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x11_d1,Xi->name() << "A" << bcg->getClass() << "C11D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x00_d1,Xi << "A" << bcg->getClass() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x01_d1,Xi << "A" << bcg->getClass() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x10_d1,Xi << "A" << bcg->getClass() << "C10D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x11_d1,Xi << "A" << bcg->getClass() << "C11D1S" << s->sink()->getCorrespondingBBNumber());
 							C00_2->addRight(1,x00_d1);
 							C01_2->addRight(1,x01_d1);
 							C10_2->addRight(1,x10_d1);
@@ -524,10 +515,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						}
 						if(withNT) {
 							Var *x00_d0, *x01_d0, *x10_d0, *x11_d0;
-							NEW_VAR_FROM_BUFF(x00_d0,Xi->name() << "A" << bcg->getClass() << "C00D0S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x01_d0,Xi->name() << "A" << bcg->getClass() << "C01D0S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x10_d0,Xi->name() << "A" << bcg->getClass() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(x11_d0,Xi->name() << "A" << bcg->getClass() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x00_d0,Xi << "A" << bcg->getClass() << "C00D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x01_d0,Xi << "A" << bcg->getClass() << "C01D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x10_d0,Xi << "A" << bcg->getClass() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(x11_d0,Xi << "A" << bcg->getClass() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
 							C00_2->addRight(1,x00_d0);
 							C01_2->addRight(1,x01_d0);
 							C10_2->addRight(1,x10_d0);
@@ -540,10 +531,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				if(br->isExit()) {
 					if(br->exitsWithT()) {
 						Var *e00_d1,*e01_d1,*e10_d1,*e11_d1;
-						NEW_VAR_FROM_BUFF(e00_d1,Xi->name() << "A" << bcg->getClass() << "C00D1end");
-						NEW_VAR_FROM_BUFF(e01_d1,Xi->name() << "A" << bcg->getClass() << "C01D1end");
-						NEW_VAR_FROM_BUFF(e10_d1,Xi->name() << "A" << bcg->getClass() << "C10D1end");
-						NEW_VAR_FROM_BUFF(e11_d1,Xi->name() << "A" << bcg->getClass() << "C11D1end");
+						NEW_VAR_FROM_BUFF(e00_d1,Xi << "A" << bcg->getClass() << "C00D1end");
+						NEW_VAR_FROM_BUFF(e01_d1,Xi << "A" << bcg->getClass() << "C01D1end");
+						NEW_VAR_FROM_BUFF(e10_d1,Xi << "A" << bcg->getClass() << "C10D1end");
+						NEW_VAR_FROM_BUFF(e11_d1,Xi << "A" << bcg->getClass() << "C11D1end");
 						C00_2->addRight(1,e00_d1);
 						C01_2->addRight(1,e01_d1);
 						C10_2->addRight(1,e10_d1);
@@ -551,10 +542,10 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 					}
 					if(br->exitsWithNT()) {
 						Var *e00_d0,*e01_d0,*e10_d0,*e11_d0;
-						NEW_VAR_FROM_BUFF(e00_d0,Xi->name() << "A" << bcg->getClass() << "C00D0end");
-						NEW_VAR_FROM_BUFF(e01_d0,Xi->name() << "A" << bcg->getClass() << "C01D0end");
-						NEW_VAR_FROM_BUFF(e10_d0,Xi->name() << "A" << bcg->getClass() << "C10D0end");
-						NEW_VAR_FROM_BUFF(e11_d0,Xi->name() << "A" << bcg->getClass() << "C11D0end");
+						NEW_VAR_FROM_BUFF(e00_d0,Xi << "A" << bcg->getClass() << "C00D0end");
+						NEW_VAR_FROM_BUFF(e01_d0,Xi << "A" << bcg->getClass() << "C01D0end");
+						NEW_VAR_FROM_BUFF(e10_d0,Xi << "A" << bcg->getClass() << "C10D0end");
+						NEW_VAR_FROM_BUFF(e11_d0,Xi << "A" << bcg->getClass() << "C11D0end");
 						C00_2->addRight(1,e00_d0);
 						C01_2->addRight(1,e01_d0);
 						C10_2->addRight(1,e10_d0);
@@ -597,15 +588,15 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 						br->isSuccessor(s->sink(),withT,withNT);
 						if(withT) {
 							Var *v00, *v01;
-							NEW_VAR_FROM_BUFF(v00, Xi->name() << "A" << bcg->getClass() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(v01, Xi->name() << "A" << bcg->getClass() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(v00, Xi << "A" << bcg->getClass() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(v01, Xi << "A" << bcg->getClass() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
 							M_T->addRight(1,v00);
 							M_T->addRight(1,v01);
 						}
 						if(withNT) {
 							Var *v10, *v11;
-							NEW_VAR_FROM_BUFF(v10, Xi->name() << "A" << bcg->getClass() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
-							NEW_VAR_FROM_BUFF(v11, Xi->name() << "A" << bcg->getClass() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(v10, Xi << "A" << bcg->getClass() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(v11, Xi << "A" << bcg->getClass() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
 							M_NT->addRight(1,v10);
 							M_NT->addRight(1,v11);
 							
@@ -616,15 +607,15 @@ void BPredProcessor::CS__BiModal(WorkSpace *fw, CFG *cfg, BSets& bs, elm::Vector
 				if(br->isExit()) {
 					if(br->exitsWithT()) {
 						Var *e00_d1,*e01_d1;
-						NEW_VAR_FROM_BUFF(e00_d1,Xi->name() << "A" << bcg->getClass() << "C00D1end");
-						NEW_VAR_FROM_BUFF(e01_d1,Xi->name() << "A" << bcg->getClass() << "C01D1end");
+						NEW_VAR_FROM_BUFF(e00_d1,Xi << "A" << bcg->getClass() << "C00D1end");
+						NEW_VAR_FROM_BUFF(e01_d1,Xi << "A" << bcg->getClass() << "C01D1end");
 						M_T->addRight(1,e00_d1);
 						M_T->addRight(1,e01_d1);
 					}
 					if(br->exitsWithNT()) {
 						Var *e10_d0,*e11_d0;
-						NEW_VAR_FROM_BUFF(e10_d0,Xi->name() << "A" << bcg->getClass() << "C10D0end");
-						NEW_VAR_FROM_BUFF(e11_d0,Xi->name() << "A" << bcg->getClass() << "C11D0end");
+						NEW_VAR_FROM_BUFF(e10_d0,Xi << "A" << bcg->getClass() << "C10D0end");
+						NEW_VAR_FROM_BUFF(e11_d0,Xi << "A" << bcg->getClass() << "C11D0end");
 						M_NT->addRight(1,e10_d0);
 						M_NT->addRight(1,e11_d0);													
 					}
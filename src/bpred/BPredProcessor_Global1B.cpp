@@ -22,6 +22,7 @@
 #include <otawa/bpred/BPredProcessor.h>
 #include "BHG.h"
 #include "BBHG.h"
+#include "VarTable.h"
 #include "BBHGDrawer.h"
 #include "BHGDrawer.h"
 #include "BCG.h"
@@ -48,19 +49,9 @@ using namespace elm;
 													ASSERT(cons_name);
 
 #define NEW_VAR_FROM_BUFF(var_name,buff_expr)	{ \
-													StringBuffer sb##var_name; \
-													sb##var_name << buff_expr; \
-													String s##var_name = sb##var_name.toString(); \
-													if(ht_vars.exists(s##var_name)) { \
-														var_name = ht_vars.get(s##var_name); \
-														ASSERT(var_name); \
-													} \
-													else { \
-														if(this->explicit_mode) var_name = system->newVar(s##var_name); \
-														else var_name = system->newVar(String("")); \
-														ASSERT(var_name); \
-														ht_vars.put(s##var_name,var_name); \
-													} \
+													VarTable::Key k##var_name(ht_vars); \
+													k##var_name << buff_expr; \
+													var_name = ht_vars.make(k##var_name); \
 												}
 //////////////////////////////////////////////////
 
@@ -93,7 +84,7 @@ using namespace elm;
  * @param bcgs		Vector containg the BCGs (Branch Conflict Graphs) generated from the BHG.
  * @param ht_vars	Hash Table used to ensure unicity of the variables.
  */
-void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg, elm::Vector<BCG*> &bcgs,elm::HashMap<String ,ilp::Var*>& ht_vars ) {
+void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg, elm::Vector<BCG*> &bcgs,VarTable& ht_vars ) {
 	// Recuperation de l'ensemble des contraintes
 	System *system = ipet::SYSTEM(fw);
 	ASSERT(system);
@@ -134,7 +125,7 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 			
 			for(int i = 0 ;  i < v.length() ; i++) {
 				Var *XbApi;
-				NEW_VAR_FROM_BUFF(XbApi, Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()));
+				NEW_VAR_FROM_BUFF(XbApi, Xb << "A" << v[i]->getHistory());
 				
 			////////
 			// C11:
@@ -147,7 +138,7 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 					
 					for(auto s: v[i]->outEdges()) {
 						Var *XbApiSs;
-						NEW_VAR_FROM_BUFF(XbApiSs,XbApi->name() << "S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(XbApiSs,XbApi << "S" << s->sink()->getCorrespondingBBNumber());
 						if(!added_vars.exists(XbApiSs)) {
 							C11->addRight(1,XbApiSs);
 							added_vars.add(XbApiSs,XbApiSs);
@@ -155,7 +146,7 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 					}
 					if(v[i]->isExit()) {
 						Var *XbApiEnd;
-						NEW_VAR_FROM_BUFF(XbApiEnd,XbApi->name() << "end");
+						NEW_VAR_FROM_BUFF(XbApiEnd,XbApi << "end");
 						C11->addRight(1,XbApiEnd);					
 					}
 				}
@@ -173,7 +164,7 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 					for(auto p: v[i]->inEdges()) {
 						Var *XpApiSb;
 						Var *Xp = ipet::VAR(getBB(p->source()->getCorrespondingBBNumber(), cfg));
-						NEW_VAR_FROM_BUFF(XpApiSb,Xp->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "S" << bb->index());
+						NEW_VAR_FROM_BUFF(XpApiSb,Xp << "A" << v[i]->getHistory() << "S" << bb->index());
 						if(!added_vars.exists(XpApiSb)) {
 							C12->addRight(1,XpApiSb);
 							added_vars.add(XpApiSb,XpApiSb);
@@ -181,7 +172,7 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 					}
 					if(v[i]->isEntry()) {
 						Var *XbApiStart;
-						NEW_VAR_FROM_BUFF(XbApiStart,XbApi->name() << "start");
+						NEW_VAR_FROM_BUFF(XbApiStart,XbApi << "start");
 						C12->addRight(1,XbApiStart);					
 					}
 				}
@@ -201,17 +192,17 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 								if(v[i]->isSuccessor(n,withT,withNT)) {
 									NEW_SPECIAL_CONSTRAINT(C21,EQ,0);
 									Var *XbApiSs;
-									NEW_VAR_FROM_BUFF(XbApiSs,XbApi->name() << "S" << n->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(XbApiSs,XbApi << "S" << n->getCorrespondingBBNumber());
 									C21->addLeft(1,XbApiSs);
 		
 									if(withT) {
 										Var *XbApiSsD1;
-										NEW_VAR_FROM_BUFF(XbApiSsD1,XbApi->name() << "D1S" << n->getCorrespondingBBNumber());
+										NEW_VAR_FROM_BUFF(XbApiSsD1,XbApi << "D1S" << n->getCorrespondingBBNumber());
 										C21->addRight(1,XbApiSsD1);
 									}
 									if(withNT) {
 										Var *XbApiSsD0;
-										NEW_VAR_FROM_BUFF(XbApiSsD0, XbApi->name() << "D0S" << n->getCorrespondingBBNumber());								
+										NEW_VAR_FROM_BUFF(XbApiSsD0, XbApi << "D0S" << n->getCorrespondingBBNumber());								
 										C21->addRight(1,XbApiSsD0);
 									}							
 								}
@@ -219,16 +210,16 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 							if(v[i]->isExit()) {
 								NEW_SPECIAL_CONSTRAINT(C21,EQ,0);
 								Var *XbApiEnd;
-								NEW_VAR_FROM_BUFF(XbApiEnd,XbApi->name() << "end");
+								NEW_VAR_FROM_BUFF(XbApiEnd,XbApi << "end");
 								C21->addLeft(1,XbApiEnd);
 								if(v[i]->exitsWithT()) {
 									Var *XbApiD1End;
-									NEW_VAR_FROM_BUFF(XbApiD1End,XbApi->name() << "D1end");
+									NEW_VAR_FROM_BUFF(XbApiD1End,XbApi << "D1end");
 									C21->addRight(1,XbApiD1End);							
 								}
 								if(v[i]->exitsWithNT()) {
 									Var *XbApiD0End;
-									NEW_VAR_FROM_BUFF(XbApiD0End,XbApi->name() << "D0end");
+									NEW_VAR_FROM_BUFF(XbApiD0End,XbApi << "D0end");
 									C21->addRight(1,XbApiD0End);														
 								}
 							}
@@ -257,24 +248,24 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 				for(int i=0;i<v.length();i++) {
 					NEW_SPECIAL_CONSTRAINT(C22,EQ,0);
 					Var *Eb_sdApi;
-					NEW_VAR_FROM_BUFF(Eb_sdApi, Eb_sd->name() << "A" << BitSet_to_String(v[i]->getHistory()));
+					NEW_VAR_FROM_BUFF(Eb_sdApi, Eb_sd << "A" << v[i]->getHistory());
 					C22->addRight(1,Eb_sdApi);
 					
 					for(auto s: v[i]->outEdges()) {
 						if(s->isTaken() == (d==1)) {
 							Var *XbApiDdSs;
-							NEW_VAR_FROM_BUFF(XbApiDdSs,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D" << d << "S" << s->sink()->getCorrespondingBBNumber());
+							NEW_VAR_FROM_BUFF(XbApiDdSs,Xb << "A" << v[i]->getHistory() << "D" << d << "S" << s->sink()->getCorrespondingBBNumber());
 							C22->addLeft(1,XbApiDdSs);
 						}
 					}
 					if(v[i]->isExit() && v[i]->exitsWithT()==(d==1) && d==1) {
 						Var *XbApiDdend;
-						NEW_VAR_FROM_BUFF(XbApiDdend,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D" << d << "end");
+						NEW_VAR_FROM_BUFF(XbApiDdend,Xb << "A" << v[i]->getHistory() << "D" << d << "end");
 						C22->addLeft(1,XbApiDdend);						
 					}
 					if(v[i]->isExit() && v[i]->exitsWithNT()==(d==0) && d==0) {
 						Var *XbApiDdend;
-						NEW_VAR_FROM_BUFF(XbApiDdend,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D" << d << "end");
+						NEW_VAR_FROM_BUFF(XbApiDdend,Xb << "A" << v[i]->getHistory() << "D" << d << "end");
 						C22->addLeft(1,XbApiDdend);						
 					}
 					
@@ -297,12 +288,12 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 			ASSERT(Xb);
 			if(n->isEntry()) {
 				Var *XbApiStart;
-				NEW_VAR_FROM_BUFF(XbApiStart,Xb->name() << "A" << BitSet_to_String(n->getHistory()) << "start");
+				NEW_VAR_FROM_BUFF(XbApiStart,Xb << "A" << n->getHistory() << "start");
 				C3_start->addLeft(1,XbApiStart);
 			}
 			if(n->isExit()) {
 				Var *XbApiEnd;
-				NEW_VAR_FROM_BUFF(XbApiEnd,Xb->name() << "A" << BitSet_to_String(n->getHistory()) << "end");				
+				NEW_VAR_FROM_BUFF(XbApiEnd,Xb << "A" << n->getHistory() << "end");				
 				C3_end->addLeft(1,XbApiEnd);
 			}
 		}
@@ -321,13 +312,13 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 				for(Block::EdgeIter edge = bb->outs();edge();edge++) {
 					Var* Mb_dApi;
 					NEW_SPECIAL_CONSTRAINT(P1,EQ,0);
-					NEW_VAR_FROM_BUFF(Mb_dApi, "m" << bb->index() << "_" << edge->target()->index() << "A" << BitSet_to_String(v[i]->getHistory()) );
+					NEW_VAR_FROM_BUFF(Mb_dApi, "m" << bb->index() << "_" << edge->target()->index() << "A" << v[i]->getHistory() );
 					P1->addRight(1,Mb_dApi);
 				}
 				if(*bb == cfg->exit()) {
 					Var* Mb_endApi;
 					NEW_SPECIAL_CONSTRAINT(P1,EQ,0);
-					NEW_VAR_FROM_BUFF(Mb_endApi, "m" << bb->index() << "_endA" << BitSet_to_String(v[i]->getHistory()) );
+					NEW_VAR_FROM_BUFF(Mb_endApi, "m" << bb->index() << "_endA" << v[i]->getHistory() );
 					P1->addRight(1,Mb_endApi);
 				}
 			}
@@ -354,12 +345,12 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 				for(Block::EdgeIter edge = bb->outs();edge();edge++) {
 
 					if(edge->isTaken()) {
-						NEW_VAR_FROM_BUFF(Mb_sApiD1, "m" << bb->index() << "_" << edge->target()->index() << "A" << BitSet_to_String(v[i]->getHistory()));
+						NEW_VAR_FROM_BUFF(Mb_sApiD1, "m" << bb->index() << "_" << edge->target()->index() << "A" << v[i]->getHistory());
 						P23->addLeft(1,Mb_sApiD1);
 						P24->addLeft(1,Mb_sApiD1);
 					}
 					else {
-						NEW_VAR_FROM_BUFF(Mb_sApiD0, "m" << bb->index() << "_" << edge->target()->index() << "A" << BitSet_to_String(v[i]->getHistory()));
+						NEW_VAR_FROM_BUFF(Mb_sApiD0, "m" << bb->index() << "_" << edge->target()->index() << "A" << v[i]->getHistory());
 						P21->addLeft(1,Mb_sApiD0);
 						P22->addLeft(1,Mb_sApiD0);
 					}
@@ -367,36 +358,36 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 				// exit
 				if(v[i]->isExit() && v[i]->exitsWithT()) {
 					Var *XbApiD1End;
-					NEW_VAR_FROM_BUFF(XbApiD1End,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D1end");
+					NEW_VAR_FROM_BUFF(XbApiD1End,Xb << "A" << v[i]->getHistory() << "D1end");
 					P23->addRight(1,XbApiD1End);
 				}
 				if(v[i]->isExit() && v[i]->exitsWithNT()) {
 					Var *XbApiD0End;
-					NEW_VAR_FROM_BUFF(XbApiD0End,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D0end");
+					NEW_VAR_FROM_BUFF(XbApiD0End,Xb << "A" << v[i]->getHistory() << "D0end");
 					P21->addRight(1,XbApiD0End);							
 				}
 
 				//entry
 				if(v[i]->isEntry() && this->mitraInit->contains(0)) {
 					Var *XbApiD1Start;
-					NEW_VAR_FROM_BUFF(XbApiD1Start,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "start");
+					NEW_VAR_FROM_BUFF(XbApiD1Start,Xb << "A" << v[i]->getHistory() << "start");
 					P22->addRight(1,XbApiD1Start);
 				}
 				if(v[i]->isEntry() && !this->mitraInit->contains(0)) {
 					Var *XbApiStart;
-					NEW_VAR_FROM_BUFF(XbApiStart,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "start");
+					NEW_VAR_FROM_BUFF(XbApiStart,Xb << "A" << v[i]->getHistory() << "start");
 					P24->addRight(1,XbApiStart);
 				}
 
 				for(auto s: v[i]->outEdges()) {
 					if(s->isTaken()) {
 						Var *XbApiD1Ss;
-						NEW_VAR_FROM_BUFF(XbApiD1Ss,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D1S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(XbApiD1Ss,Xb << "A" << v[i]->getHistory() << "D1S" << s->sink()->getCorrespondingBBNumber());
 						P23->addRight(1,XbApiD1Ss);
 					}
 					else {
 						Var *XbApiD0Ss;
-						NEW_VAR_FROM_BUFF(XbApiD0Ss,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D0S" << s->sink()->getCorrespondingBBNumber());
+						NEW_VAR_FROM_BUFF(XbApiD0Ss,Xb << "A" << v[i]->getHistory() << "D0S" << s->sink()->getCorrespondingBBNumber());
 						P21->addRight(1,XbApiD0Ss);
 					}
 				}
@@ -405,12 +396,12 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 					Var *Xp=ipet::VAR(getBB(p->source()->getCorrespondingBBNumber(),cfg));
 					if(p->isTaken()) {
 						Var *XpApiD1Sb;
-						NEW_VAR_FROM_BUFF(XpApiD1Sb,Xp->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D1S" << bb->index());
+						NEW_VAR_FROM_BUFF(XpApiD1Sb,Xp << "A" << v[i]->getHistory() << "D1S" << bb->index());
 						P22->addRight(1,XpApiD1Sb);
 					}
 					else {
 						Var *XpApiD0Sb;
-						NEW_VAR_FROM_BUFF(XpApiD0Sb,Xp->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D0S" << bb->index());
+						NEW_VAR_FROM_BUFF(XpApiD0Sb,Xp << "A" << v[i]->getHistory() << "D0S" << bb->index());
 						P24->addRight(1,XpApiD0Sb);
 					}
 				}
@@ -441,7 +432,7 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 						elm::Vector<BCGNode*> v = BB_classes.get(*bb);
 						for(int i = 0 ; i<v.length();++i) {
 							Var *Mb_sApi;
-							NEW_VAR_FROM_BUFF(Mb_sApi,Mb_s->name() << "A" << BitSet_to_String(v[i]->getHistory()));
+							NEW_VAR_FROM_BUFF(Mb_sApi,Mb_s << "A" << v[i]->getHistory());
 							P3->addRight(1,Mb_sApi);
 						}
 					}
@@ -456,7 +447,7 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 						elm::Vector<BCGNode*> v = BB_classes.get(*bb);
 						for(int i = 0 ; i<v.length();++i) {
 							Var *Mb_sApi;
-							NEW_VAR_FROM_BUFF(Mb_sApi,Mb_s->name() << "A" << BitSet_to_String(v[i]->getHistory()));
+							NEW_VAR_FROM_BUFF(Mb_sApi,Mb_s << "A" << v[i]->getHistory());
 							P3->addRight(1,Mb_sApi);
 						}
 					}
@@ -484,8 +475,8 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
 				for(Block::EdgeIter edge = v[i]->getCorrespondingBB()->outs();edge();edge++) {
 					NEW_SPECIAL_CONSTRAINT(H5,LE,0);
 					Var *XbApi, *MbApi;
-					NEW_VAR_FROM_BUFF(XbApi,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()));
-					NEW_VAR_FROM_BUFF(MbApi,"m" << edge->source()->index() << "_" << edge->target()->index() << "A" << BitSet_to_String(v[i]->getHistory()));
+					NEW_VAR_FROM_BUFF(XbApi,Xb << "A" << v[i]->getHistory());
+					NEW_VAR_FROM_BUFF(MbApi,"m" << edge->source()->index() << "_" << edge->target()->index() << "A" << v[i]->getHistory());
 					H5->addRight(1,XbApi);
 					H5->addLeft(1,MbApi);
 				}
@@ -506,7 +497,7 @@ void BPredProcessor::CS__Global1b(WorkSpace *fw, CFG *cfg, BHG *bhg,BBHG *bbhg,
  * @param bcgs		Vector containg the BCGs (Branch Conflict Graphs) generated from the BHG.
  * @param ht_vars	Hash Table used to ensure unicity of the variables.
  */
-void BPredProcessor::CS__Global1b_mitra(WorkSpace *fw, CFG *cfg, BBHG* bbhg, HashMap<String ,Var*>& ht_vars) {
+void BPredProcessor::CS__Global1b_mitra(WorkSpace *fw, CFG *cfg, BBHG* bbhg, VarTable& ht_vars) {
 	// Recuperation de l'ensemble des contraintes
 	System *system = ipet::SYSTEM(fw);
 	ASSERT(system);
@@ -540,7 +531,7 @@ void BPredProcessor::CS__Global1b_mitra(WorkSpace *fw, CFG *cfg, BBHG* bbhg, Has
 	
 			for(int i=0;i<v.length();++i) {
 				Var *XbApi;
-				NEW_VAR_FROM_BUFF(XbApi,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()));
+				NEW_VAR_FROM_BUFF(XbApi,Xb << "A" << v[i]->getHistory());
 				H1->addRight(1,XbApi);
 			}
 
@@ -568,18 +559,18 @@ void BPredProcessor::CS__Global1b_mitra(WorkSpace *fw, CFG *cfg, BBHG* bbhg, Has
 				NEW_SPECIAL_CONSTRAINT(H41,EQ,0);
 //				HashTable<Var* , Var*> hist_done;
 				Var *XbApi;
-				NEW_VAR_FROM_BUFF(XbApi,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()));
+				NEW_VAR_FROM_BUFF(XbApi,Xb << "A" << v[i]->getHistory());
 				
 				H41->addLeft(1,XbApi);
 				if(v[i]->isEntry()) {
 					Var *XpApi;
-					NEW_VAR_FROM_BUFF(XpApi,"estart" << "_" << bb->index() << "A" << BitSet_to_String(v[i]->getHistory()));
+					NEW_VAR_FROM_BUFF(XpApi,"estart" << "_" << bb->index() << "A" << v[i]->getHistory());
 					H41->addRight(1,XpApi);
 				}
 				for(auto p: v[i]->inEdges()) {
 
 					Var *XpApi;
-					NEW_VAR_FROM_BUFF(XpApi,"e" << p->source()->getCorrespondingBB()->index() << "_" << bb->index() << "A" << BitSet_to_String(p->source()->getHistory()));
+					NEW_VAR_FROM_BUFF(XpApi,"e" << p->source()->getCorrespondingBB()->index() << "_" << bb->index() << "A" << p->source()->getHistory());
 //					if(!hist_done.exists(XpApi)) {
 						H41->addRight(1,XpApi);
 //						hist_done.add(XpApi,XpApi);
@@ -605,16 +596,16 @@ void BPredProcessor::CS__Global1b_mitra(WorkSpace *fw, CFG *cfg, BBHG* bbhg, Has
 			for(int i=0;i<v.length();++i) {
 				NEW_SPECIAL_CONSTRAINT(H42,EQ,0);
 				Var *XbApi;
-				NEW_VAR_FROM_BUFF(XbApi,Xb->name() << "A" << BitSet_to_String(v[i]->getHistory()));
+				NEW_VAR_FROM_BUFF(XbApi,Xb << "A" << v[i]->getHistory());
 				H42->addLeft(1,XbApi);
 				if(v[i]->isExit()) {
 					Var *XpApi;
-					NEW_VAR_FROM_BUFF(XpApi,"e" << v[i]->getCorrespondingBB()->index() << "_end" << "A" << BitSet_to_String(v[i]->getHistory()));
+					NEW_VAR_FROM_BUFF(XpApi,"e" << v[i]->getCorrespondingBB()->index() << "_end" << "A" << v[i]->getHistory());
 					H42->addRight(1,XpApi);
 				}
 				for(auto s: v[i]->outEdges()) {
 					Var *XsApi;
-					NEW_VAR_FROM_BUFF(XsApi,"e" << bb->index() << "_" << s->sink()->getCorrespondingBB()->index() << "A" << BitSet_to_String(v[i]->getHistory()));
+					NEW_VAR_FROM_BUFF(XsApi,"e" << bb->index() << "_" << s->sink()->getCorrespondingBB()->index() << "A" << v[i]->getHistory());
 					H42->addRight(1,XsApi);
 					
 				}
@@ -657,7 +648,7 @@ void BPredProcessor::CS__Global1b_mitra(WorkSpace *fw, CFG *cfg, BBHG* bbhg, Has
 					for(auto s: v[i]->outEdges()) {
 						if(s->sink()->getCorrespondingBB()->index() == edge->target()->index()) {
 							Var *eb_sApi;
-							NEW_VAR_FROM_BUFF(eb_sApi,"e" << bb->index() << "_" << s->sink()->getCorrespondingBB()->index() << "A" << BitSet_to_String(v[i]->getHistory()));
+							NEW_VAR_FROM_BUFF(eb_sApi,"e" << bb->index() << "_" << s->sink()->getCorrespondingBB()->index() << "A" << v[i]->getHistory());
 							if(!hist_done.exists(eb_sApi)) {
 								H2->addRight(1,eb_sApi);
 								hist_done.add(eb_sApi,eb_sApi);
@@ -693,21 +684,15 @@ bool BPredProcessor::isBranch(Block* bb) {
  * Tests if a similar BBHG Node is contained in a given vector of BHG Nodes and returns the BBHG Node found.
  * Two BBHG Nodes are similar if they have same hisotry and comes from the same BasicBlock.
  * 
- * @param v			Vector containing the BHG Nodes.
- * @param n			BBHG Node to compare with those contained in the vector.
+ * @param v			Map of the BBHG Nodes by key (block, packed history).
+ * @param n			BBHG Node to look for.
  * @param contained If any similar BBHG Node is found, then it will contains the found BBHG Node, else it will contains a NULL pointer.
  * 
  * @return returns a boolean value set to True if a similar BBHG Node has been found.
  */
-bool BPredProcessor::contains(const elm::Vector< BBHGNode* >& v, BBHGNode& n, BBHGNode * &contained) {
-	for(int i=0;i<v.length();++i) {
-		if(n.equals(*(v[i])) ) {
-			contained = v[i];
-			return true;
-		}
-	}
-	contained = NULL;
-	return false;
+bool BPredProcessor::contains(const elm::HashMap<t::uint64, BBHGNode* >& v, BBHGNode& n, BBHGNode * &contained) {
+	contained = v.get(n.key(), NULL);
+	return contained != NULL;
 }
 
 /**
@@ -717,7 +702,7 @@ bool BPredProcessor::contains(const elm::Vector< BBHGNode* >& v, BBHGNode& n, BB
  * @param bbhg	Reference to the BBHG to fill.
  */
 void BPredProcessor::generateBBHG(CFG* cfg,BBHG& bbhg) {
-	elm::Vector< BBHGNode* > final_nodes; 	// => S dans l'algo
+	elm::HashMap<t::uint64, BBHGNode* > final_nodes; 	// => S dans l'algo
 	elm::Vector< BBHGNode* > todo_nodes; 	// => F dans l'algo
 	elm::Vector< BBHGEdge* > final_edges;	// => E dans l'algo
 
@@ -735,7 +720,7 @@ void BPredProcessor::generateBBHG(CFG* cfg,BBHG& bbhg) {
 
 		BBHGNode *tmp;
 		if(!contains(final_nodes,*n,tmp)) {
-			final_nodes.add(n);
+			final_nodes.put(n->key(), n);
 			todo_nodes.add(n);
 			builder.add(n);
 	
@@ -769,7 +754,7 @@ void BPredProcessor::generateBBHG(CFG* cfg,BBHG& bbhg) {
 						//bool todo_n=false;
 						bool final_n=false;
 						if(!(final_n=contains(final_nodes,*s,cs))) {
-							final_nodes.add(s);
+							final_nodes.put(s->key(), s);
 							builder.add(s);
 							
 							todo_nodes.add(s);
@@ -827,7 +812,7 @@ void BPredProcessor::processCFG__Global1B(WorkSpace *ws,CFG* cfg) {
 		BBHGDrawer drawer(&bbhg, filename);
 		drawer.display();
 	}
-	HashMap<String ,Var*> ht_vars;
+	VarTable ht_vars(ipet::SYSTEM(ws), this->explicit_mode);
 
 	BHG bhg(this->BHG_history_size);
 
@@ -27,6 +27,7 @@
 #include "BCG.h"
 #include "BHG.h"
 #include "BBHG.h"
+#include "VarTable.h"
 
 #include <otawa/ipet/BasicConstraintsBuilder.h>
 #include <otawa/ipet/IPET.h>
@@ -49,19 +50,9 @@ using namespace elm;
 		ASSERT(cons_name);
 
 #define NEW_VAR_FROM_BUFF(var_name,buff_expr)	{ \
-													StringBuffer sb##var_name; \
-													sb##var_name << buff_expr; \
-													String s##var_name = sb##var_name.toString(); \
-													if(ht_vars.exists(s##var_name)) { \
-														var_name = ht_vars.get(s##var_name); \
-														ASSERT(var_name); \
-													} \
-													else { \
-														if(this->explicit_mode) var_name = system->newVar(s##var_name); \
-														else var_name = system->newVar(String("")); \
-														ASSERT(var_name); \
-														ht_vars.put(s##var_name,var_name); \
-													} \
+													VarTable::Key k##var_name(ht_vars); \
+													k##var_name << buff_expr; \
+													var_name = ht_vars.make(k##var_name); \
 												}
 //////////////////////////////////////////////////
 
@@ -94,7 +85,7 @@ using namespace elm;
  * @param graphs	Vector containg the BCGs (Branch Conflict Graphs) generated from the BHG.
  * @param ht_vars	Hash Table used to ensure unicity of the variables.
  */
-void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector<BCG*> &graphs , HashMap<String ,Var*>& ht_vars) {
+void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector<BCG*> &graphs , VarTable& ht_vars) {
 	// Recuperation de l'ensemble des contraintes
 	System *system = ipet::SYSTEM(fw);
 	ASSERT(system);
@@ -137,10 +128,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 
 			if(n->isEntry()) {
 				Var *C00s, *C01s, *C10s, *C11s;
-				NEW_VAR_FROM_BUFF(C00s,Xi->name() << "A" << BitSet_to_String(bcg->getHistory()) << "C00start");
-				NEW_VAR_FROM_BUFF(C01s,Xi->name() << "A" << BitSet_to_String(bcg->getHistory()) << "C01start");
-				NEW_VAR_FROM_BUFF(C10s,Xi->name() << "A" << BitSet_to_String(bcg->getHistory()) << "C10start");
-				NEW_VAR_FROM_BUFF(C11s,Xi->name() << "A" << BitSet_to_String(bcg->getHistory()) << "C11start");
+				NEW_VAR_FROM_BUFF(C00s,Xi << "A" << bcg->getHistory() << "C00start");
+				NEW_VAR_FROM_BUFF(C01s,Xi << "A" << bcg->getHistory() << "C01start");
+				NEW_VAR_FROM_BUFF(C10s,Xi << "A" << bcg->getHistory() << "C10start");
+				NEW_VAR_FROM_BUFF(C11s,Xi << "A" << bcg->getHistory() << "C11start");
 				Cs->addLeft(1,C00s);
 				Cs->addLeft(1,C01s);
 				Cs->addLeft(1,C10s);
@@ -149,10 +140,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 			
 			if(n->isExit()) {
 				Var *C00e, *C01e, *C10e, *C11e;
-				NEW_VAR_FROM_BUFF(C00e,Xi->name() << "A" << BitSet_to_String(bcg->getHistory()) << "C00end");
-				NEW_VAR_FROM_BUFF(C01e,Xi->name() << "A" << BitSet_to_String(bcg->getHistory()) << "C01end");
-				NEW_VAR_FROM_BUFF(C10e,Xi->name() << "A" << BitSet_to_String(bcg->getHistory()) << "C10end");
-				NEW_VAR_FROM_BUFF(C11e,Xi->name() << "A" << BitSet_to_String(bcg->getHistory()) << "C11end");
+				NEW_VAR_FROM_BUFF(C00e,Xi << "A" << bcg->getHistory() << "C00end");
+				NEW_VAR_FROM_BUFF(C01e,Xi << "A" << bcg->getHistory() << "C01end");
+				NEW_VAR_FROM_BUFF(C10e,Xi << "A" << bcg->getHistory() << "C10end");
+				NEW_VAR_FROM_BUFF(C11e,Xi << "A" << bcg->getHistory() << "C11end");
 				Ce->addLeft(1,C00e);
 				Ce->addLeft(1,C01e);
 				Ce->addLeft(1,C10e);
@@ -185,7 +176,7 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						elm::Vector<BCGNode*> v = classes_of_BB.get(*bb);
 						for(int i = 0 ; i < v.length();++i) {
 							Var *m;
-							NEW_VAR_FROM_BUFF(m,"m" << bb->index() << "_" << edge->target()->index() << "A" << BitSet_to_String(v[i]->getHistory()))
+							NEW_VAR_FROM_BUFF(m,"m" << bb->index() << "_" << edge->target()->index() << "A" << v[i]->getHistory())
 							M_T->addRight(1,m);
 						}
 					}
@@ -196,7 +187,7 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						elm::Vector<BCGNode*> v = classes_of_BB.get(*bb);
 						for(int i = 0 ; i < v.length();++i) {
 							Var *m;
-							NEW_VAR_FROM_BUFF(m,"m" << bb->index() << "_" << edge->target()->index() << "A" << BitSet_to_String(v[i]->getHistory()))
+							NEW_VAR_FROM_BUFF(m,"m" << bb->index() << "_" << edge->target()->index() << "A" << v[i]->getHistory())
 							M_NT->addRight(1,m);
 						}
 					}
@@ -237,10 +228,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						for(auto s: br->outEdges()) {
 							if(s->isTaken() == t) {
 								Var *C00,*C01,*C10,*C11;
-								NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << BitSet_to_String(s->sink()->getHistory()) << "C00D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << BitSet_to_String(s->sink()->getHistory()) << "C01D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << BitSet_to_String(s->sink()->getHistory()) << "C10D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << BitSet_to_String(s->sink()->getHistory()) << "C11D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C00,Xi << "A" << s->sink()->getHistory() << "C00D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C01,Xi << "A" << s->sink()->getHistory() << "C01D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C10,Xi << "A" << s->sink()->getHistory() << "C10D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C11,Xi << "A" << s->sink()->getHistory() << "C11D" << cpt << "S" << s->sink()->getCorrespondingBBNumber());
 								B21->addLeft(1,C00);
 								B21->addLeft(1,C01);
 								B21->addLeft(1,C10);
@@ -250,10 +241,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						
 						if(br->isExit() && ( (br->exitsWithT() == t ) || (br->exitsWithNT() == t ) )){
 							Var *C00,*C01,*C10,*C11;
-							NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "C00D" << cpt << "end");
-							NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "C01D" << cpt << "end");
-							NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "C10D" << cpt << "end");
-							NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "C11D" << cpt << "end");
+							NEW_VAR_FROM_BUFF(C00,Xi << "A" << v[i]->getHistory() << "C00D" << cpt << "end");
+							NEW_VAR_FROM_BUFF(C01,Xi << "A" << v[i]->getHistory() << "C01D" << cpt << "end");
+							NEW_VAR_FROM_BUFF(C10,Xi << "A" << v[i]->getHistory() << "C10D" << cpt << "end");
+							NEW_VAR_FROM_BUFF(C11,Xi << "A" << v[i]->getHistory() << "C11D" << cpt << "end");
 							B21->addLeft(1,C00);
 							B21->addLeft(1,C01);
 							B21->addLeft(1,C10);
@@ -287,7 +278,7 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						
 						NEW_SPECIAL_CONSTRAINT(B22_pred,EQ,0);
 						Var *Xb_Api;
-						NEW_VAR_FROM_BUFF(Xb_Api,Xi->name() << "A" << BitSet_to_String(br->getHistory()) );
+						NEW_VAR_FROM_BUFF(Xb_Api,Xi << "A" << br->getHistory() );
 						//Var* v_pred;
 						B22_pred->addLeft(1,Xb_Api);
 						
@@ -298,10 +289,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								BasicBlock* bb_pred=getBB(p->source()->getCorrespondingBBNumber(), cfg);
 								Var *Xj = ipet::VAR( bb_pred);
 								ASSERT(Xj);
-								NEW_VAR_FROM_BUFF(C00,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C00S" << br->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C01,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C01S" << br->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C10,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C10S" << br->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C11,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C11S" << br->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C00,Xj << "A" << br->getHistory() << "C00S" << br->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C01,Xj << "A" << br->getHistory() << "C01S" << br->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C10,Xj << "A" << br->getHistory() << "C10S" << br->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C11,Xj << "A" << br->getHistory() << "C11S" << br->getCorrespondingBBNumber());
 								B22_pred->addRight(1,C00);
 								B22_pred->addRight(1,C01);
 								B22_pred->addRight(1,C10);
@@ -313,10 +304,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						// s'il s'agit d'une entrée on ajoute les variables correspondantes
 						if(br->isEntry()) {
 							Var *C00,*C01,*C10,*C11;
-							NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00start");
-							NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01start");
-							NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10start");
-							NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11start");
+							NEW_VAR_FROM_BUFF(C00,Xi << "A" << br->getHistory() << "C00start");
+							NEW_VAR_FROM_BUFF(C01,Xi << "A" << br->getHistory() << "C01start");
+							NEW_VAR_FROM_BUFF(C10,Xi << "A" << br->getHistory() << "C10start");
+							NEW_VAR_FROM_BUFF(C11,Xi << "A" << br->getHistory() << "C11start");
 							B22_pred->addRight(1,C00);
 							B22_pred->addRight(1,C01);
 							B22_pred->addRight(1,C10);
@@ -334,10 +325,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						for(auto s: br->outEdges()) {
 							if(var_added[s->sink()->getCorrespondingBBNumber()]==0) {
 								Var *C00,*C01,*C10,*C11;
-								NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C00,Xi << "A" << br->getHistory() << "C00S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C01,Xi << "A" << br->getHistory() << "C01S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C10,Xi << "A" << br->getHistory() << "C10S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(C11,Xi << "A" << br->getHistory() << "C11S" << s->sink()->getCorrespondingBBNumber());
 								B22_succ->addRight(1,C00);
 								B22_succ->addRight(1,C01);
 								B22_succ->addRight(1,C10);
@@ -349,10 +340,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						// s'il s'agit d'une sortie on ajoute les variables correspondantes
 						if(br->isExit()) {
 							Var *C00,*C01,*C10,*C11;
-							NEW_VAR_FROM_BUFF(C00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00end");
-							NEW_VAR_FROM_BUFF(C01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01end");
-							NEW_VAR_FROM_BUFF(C10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10end");
-							NEW_VAR_FROM_BUFF(C11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11end");
+							NEW_VAR_FROM_BUFF(C00,Xi << "A" << br->getHistory() << "C00end");
+							NEW_VAR_FROM_BUFF(C01,Xi << "A" << br->getHistory() << "C01end");
+							NEW_VAR_FROM_BUFF(C10,Xi << "A" << br->getHistory() << "C10end");
+							NEW_VAR_FROM_BUFF(C11,Xi << "A" << br->getHistory() << "C11end");
 							B22_succ->addRight(1,C00);
 							B22_succ->addRight(1,C01);
 							B22_succ->addRight(1,C10);
@@ -379,10 +370,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								NEW_SPECIAL_CONSTRAINT(B23_11,EQ,0);
 								Var *v00, *v01, *v10, *v11;
 			
-								NEW_VAR_FROM_BUFF(v00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(v01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(v10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10S" << s->sink()->getCorrespondingBBNumber());
-								NEW_VAR_FROM_BUFF(v11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(v00,Xi << "A" << br->getHistory() << "C00S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(v01,Xi << "A" << br->getHistory() << "C01S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(v10,Xi << "A" << br->getHistory() << "C10S" << s->sink()->getCorrespondingBBNumber());
+								NEW_VAR_FROM_BUFF(v11,Xi << "A" << br->getHistory() << "C11S" << s->sink()->getCorrespondingBBNumber());
 								B23_00->addLeft(1,v00);
 								B23_01->addLeft(1,v01);
 								B23_10->addLeft(1,v10);
@@ -392,10 +383,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								br->isSuccessor(s->sink(),withT,withNT);
 								if(withT) {
 									Var *T00,*T01,*T10,*T11;
-									NEW_VAR_FROM_BUFF(T00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D1S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(T01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D1S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(T10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D1S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(T11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(T00,Xi << "A" << br->getHistory() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(T01,Xi << "A" << br->getHistory() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(T10,Xi << "A" << br->getHistory() << "C10D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(T11,Xi << "A" << br->getHistory() << "C11D1S" << s->sink()->getCorrespondingBBNumber());
 									B23_00->addRight(1,T00);
 									B23_01->addRight(1,T01);
 									B23_10->addRight(1,T10);
@@ -403,10 +394,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								}
 								if(withNT) {
 									Var *NT00,*NT01,*NT10,*NT11;
-									NEW_VAR_FROM_BUFF(NT00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D0S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(NT01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D0S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(NT10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D0S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(NT11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(NT00,Xi << "A" << br->getHistory() << "C00D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(NT01,Xi << "A" << br->getHistory() << "C01D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(NT10,Xi << "A" << br->getHistory() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(NT11,Xi << "A" << br->getHistory() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
 									B23_00->addRight(1,NT00);
 									B23_01->addRight(1,NT01);
 									B23_10->addRight(1,NT10);
@@ -427,10 +418,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 							
 							
 							Var *v00end, *v01end, *v10end, *v11end;
-							NEW_VAR_FROM_BUFF(v00end,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00end");
-							NEW_VAR_FROM_BUFF(v01end,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01end");
-							NEW_VAR_FROM_BUFF(v10end,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10end");
-							NEW_VAR_FROM_BUFF(v11end,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11end");
+							NEW_VAR_FROM_BUFF(v00end,Xi << "A" << br->getHistory() << "C00end");
+							NEW_VAR_FROM_BUFF(v01end,Xi << "A" << br->getHistory() << "C01end");
+							NEW_VAR_FROM_BUFF(v10end,Xi << "A" << br->getHistory() << "C10end");
+							NEW_VAR_FROM_BUFF(v11end,Xi << "A" << br->getHistory() << "C11end");
 							B23_exit00->addLeft(1,v00end);
 							B23_exit01->addLeft(1,v01end);
 							B23_exit10->addLeft(1,v10end);
@@ -438,10 +429,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 		
 							if(br->exitsWithT()) {
 								Var *eT00,*eT01,*eT10,*eT11;
-								NEW_VAR_FROM_BUFF(eT00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D1end");
-								NEW_VAR_FROM_BUFF(eT01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D1end");
-								NEW_VAR_FROM_BUFF(eT10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D1end");
-								NEW_VAR_FROM_BUFF(eT11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D1end");
+								NEW_VAR_FROM_BUFF(eT00,Xi << "A" << br->getHistory() << "C00D1end");
+								NEW_VAR_FROM_BUFF(eT01,Xi << "A" << br->getHistory() << "C01D1end");
+								NEW_VAR_FROM_BUFF(eT10,Xi << "A" << br->getHistory() << "C10D1end");
+								NEW_VAR_FROM_BUFF(eT11,Xi << "A" << br->getHistory() << "C11D1end");
 								B23_exit00->addRight(1,eT00);
 								B23_exit01->addRight(1,eT01);
 								B23_exit10->addRight(1,eT10);
@@ -449,10 +440,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 							}
 							if(br->exitsWithNT()) {
 								Var *eNT00,*eNT01,*eNT10,*eNT11;
-								NEW_VAR_FROM_BUFF(eNT00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D0end");
-								NEW_VAR_FROM_BUFF(eNT01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D0end");
-								NEW_VAR_FROM_BUFF(eNT10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D0end");
-								NEW_VAR_FROM_BUFF(eNT11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D0end");
+								NEW_VAR_FROM_BUFF(eNT00,Xi << "A" << br->getHistory() << "C00D0end");
+								NEW_VAR_FROM_BUFF(eNT01,Xi << "A" << br->getHistory() << "C01D0end");
+								NEW_VAR_FROM_BUFF(eNT10,Xi << "A" << br->getHistory() << "C10D0end");
+								NEW_VAR_FROM_BUFF(eNT11,Xi << "A" << br->getHistory() << "C11D0end");
 								B23_exit00->addRight(1,eNT00);
 								B23_exit01->addRight(1,eNT01);
 								B23_exit10->addRight(1,eNT10);
@@ -478,10 +469,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						NEW_SPECIAL_CONSTRAINT(C11_2,EQ,0);
 		
 						Var *v00, *v01, *v10, *v11;
-						NEW_VAR_FROM_BUFF(v00,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00");
-						NEW_VAR_FROM_BUFF(v01,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01");
-						NEW_VAR_FROM_BUFF(v10,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10");
-						NEW_VAR_FROM_BUFF(v11,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11");
+						NEW_VAR_FROM_BUFF(v00,Xi << "A" << br->getHistory() << "C00");
+						NEW_VAR_FROM_BUFF(v01,Xi << "A" << br->getHistory() << "C01");
+						NEW_VAR_FROM_BUFF(v10,Xi << "A" << br->getHistory() << "C10");
+						NEW_VAR_FROM_BUFF(v11,Xi << "A" << br->getHistory() << "C11");
 						C00_1->addLeft(1,v00);
 						C00_2->addLeft(1,v00);
 						C01_1->addLeft(1,v01);
@@ -506,10 +497,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								p->source()->isSuccessor(br,withT,withNT);
 								if(withT) {
 									Var *x00d1, *x01d1, *x10d1, *x11d1;
-									NEW_VAR_FROM_BUFF(x00d1,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D1S" << br->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x01d1,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D1S" << br->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x10d1,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D1S" << br->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x11d1,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D1S" << br->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x00d1,Xj << "A" << br->getHistory() << "C00D1S" << br->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x01d1,Xj << "A" << br->getHistory() << "C01D1S" << br->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x10d1,Xj << "A" << br->getHistory() << "C10D1S" << br->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x11d1,Xj << "A" << br->getHistory() << "C11D1S" << br->getCorrespondingBBNumber());
 									C01_1->addRight(1,x00d1);
 									C10_1->addRight(1,x01d1);
 									C11_1->addRight(1,x10d1);
@@ -517,10 +508,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								}
 								if(withNT) {
 									Var *x00d0, *x01d0, *x10d0, *x11d0;
-									NEW_VAR_FROM_BUFF(x00d0,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D0S" << br->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x01d0,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D0S" << br->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x10d0,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D0S" << br->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x11d0,Xj->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D0S" << br->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x00d0,Xj << "A" << br->getHistory() << "C00D0S" << br->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x01d0,Xj << "A" << br->getHistory() << "C01D0S" << br->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x10d0,Xj << "A" << br->getHistory() << "C10D0S" << br->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x11d0,Xj << "A" << br->getHistory() << "C11D0S" << br->getCorrespondingBBNumber());
 									C00_1->addRight(1,x00d0);
 									C00_1->addRight(1,x01d0);
 									C01_1->addRight(1,x10d0);
@@ -532,10 +523,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						}
 						if(br->isEntry()) {
 							Var *x00start,*x01start,*x10start,*x11start;
-							NEW_VAR_FROM_BUFF(x00start,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00start");
-							NEW_VAR_FROM_BUFF(x01start,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01start");
-							NEW_VAR_FROM_BUFF(x10start,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10start");
-							NEW_VAR_FROM_BUFF(x11start,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11start");
+							NEW_VAR_FROM_BUFF(x00start,Xi << "A" << br->getHistory() << "C00start");
+							NEW_VAR_FROM_BUFF(x01start,Xi << "A" << br->getHistory() << "C01start");
+							NEW_VAR_FROM_BUFF(x10start,Xi << "A" << br->getHistory() << "C10start");
+							NEW_VAR_FROM_BUFF(x11start,Xi << "A" << br->getHistory() << "C11start");
 							C00_1->addRight(1,x00start);
 							C01_1->addRight(1,x01start);
 							C10_1->addRight(1,x10start);
@@ -550,10 +541,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								br->isSuccessor(s->sink(),withT,withNT);
 								if(withT) {
 									Var *x00_d1, *x01_d1, *x10_d1, *x11_d1;
-									NEW_VAR_FROM_BUFF(x00_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D1S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x01_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D1S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x10_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D1S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x11_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x00_d1,Xi << "A" << br->getHistory() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x01_d1,Xi << "A" << br->getHistory() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x10_d1,Xi << "A" << br->getHistory() << "C10D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x11_d1,Xi << "A" << br->getHistory() << "C11D1S" << s->sink()->getCorrespondingBBNumber());
 									C00_2->addRight(1,x00_d1);
 									C01_2->addRight(1,x01_d1);
 									C10_2->addRight(1,x10_d1);
@@ -561,10 +552,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								}
 								if(withNT) {
 									Var *x00_d0, *x01_d0, *x10_d0, *x11_d0;
-									NEW_VAR_FROM_BUFF(x00_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D0S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x01_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D0S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x10_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D0S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(x11_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x00_d0,Xi << "A" << br->getHistory() << "C00D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x01_d0,Xi << "A" << br->getHistory() << "C01D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x10_d0,Xi << "A" << br->getHistory() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(x11_d0,Xi << "A" << br->getHistory() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
 									C00_2->addRight(1,x00_d0);
 									C01_2->addRight(1,x01_d0);
 									C10_2->addRight(1,x10_d0);
@@ -577,10 +568,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						if(br->isExit()) {
 							if(br->exitsWithT()) {
 								Var *e00_d1,*e01_d1,*e10_d1,*e11_d1;
-								NEW_VAR_FROM_BUFF(e00_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D1end");
-								NEW_VAR_FROM_BUFF(e01_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D1end");
-								NEW_VAR_FROM_BUFF(e10_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D1end");
-								NEW_VAR_FROM_BUFF(e11_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D1end");
+								NEW_VAR_FROM_BUFF(e00_d1,Xi << "A" << br->getHistory() << "C00D1end");
+								NEW_VAR_FROM_BUFF(e01_d1,Xi << "A" << br->getHistory() << "C01D1end");
+								NEW_VAR_FROM_BUFF(e10_d1,Xi << "A" << br->getHistory() << "C10D1end");
+								NEW_VAR_FROM_BUFF(e11_d1,Xi << "A" << br->getHistory() << "C11D1end");
 								C00_2->addRight(1,e00_d1);
 								C01_2->addRight(1,e01_d1);
 								C10_2->addRight(1,e10_d1);
@@ -588,10 +579,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 							}
 							if(br->exitsWithNT()) {
 								Var *e00_d0,*e01_d0,*e10_d0,*e11_d0;
-								NEW_VAR_FROM_BUFF(e00_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D0end");
-								NEW_VAR_FROM_BUFF(e01_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D0end");
-								NEW_VAR_FROM_BUFF(e10_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D0end");
-								NEW_VAR_FROM_BUFF(e11_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D0end");
+								NEW_VAR_FROM_BUFF(e00_d0,Xi << "A" << br->getHistory() << "C00D0end");
+								NEW_VAR_FROM_BUFF(e01_d0,Xi << "A" << br->getHistory() << "C01D0end");
+								NEW_VAR_FROM_BUFF(e10_d0,Xi << "A" << br->getHistory() << "C10D0end");
+								NEW_VAR_FROM_BUFF(e11_d0,Xi << "A" << br->getHistory() << "C11D0end");
 								C00_2->addRight(1,e00_d0);
 								C01_2->addRight(1,e01_d0);
 								C10_2->addRight(1,e10_d0);
@@ -612,10 +603,10 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						Var *m0, *m1;
 						for(Block::EdgeIter edge = bb->outs(); edge() ; edge++ ) {
 							if(edge->isTaken()) { // WARNING ces accolades sont IMPERATIVES car NEW_VAR_FROM_BUFF definit un bloc
-								NEW_VAR_FROM_BUFF(m1,	"m" << bb->index() << "_" << edge->target()->index() << "A" << BitSet_to_String(br->getHistory()) )
+								NEW_VAR_FROM_BUFF(m1,	"m" << bb->index() << "_" << edge->target()->index() << "A" << br->getHistory() )
 							}
 							else if(edge->isNotTaken()) {// WARNING ces accolades sont IMPERATIVES car NEW_VAR_FROM_BUFF definit un bloc
-								NEW_VAR_FROM_BUFF(m0,	"m" << bb->index() << "_" << edge->target()->index() << "A" << BitSet_to_String(br->getHistory()))
+								NEW_VAR_FROM_BUFF(m0,	"m" << bb->index() << "_" << edge->target()->index() << "A" << br->getHistory())
 							}
 						}
 						M_T->addLeft(1,m1);
@@ -632,15 +623,15 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 								br->isSuccessor(s->sink(),withT,withNT);
 								if(withT) {
 									Var *v00, *v01;
-									NEW_VAR_FROM_BUFF(v00, Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D1S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(v01, Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(v00, Xi << "A" << br->getHistory() << "C00D1S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(v01, Xi << "A" << br->getHistory() << "C01D1S" << s->sink()->getCorrespondingBBNumber());
 									M_T->addRight(1,v00);
 									M_T->addRight(1,v01);
 								}
 								if(withNT) {
 									Var *v10, *v11;
-									NEW_VAR_FROM_BUFF(v10, Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D0S" << s->sink()->getCorrespondingBBNumber());
-									NEW_VAR_FROM_BUFF(v11, Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(v10, Xi << "A" << br->getHistory() << "C10D0S" << s->sink()->getCorrespondingBBNumber());
+									NEW_VAR_FROM_BUFF(v11, Xi << "A" << br->getHistory() << "C11D0S" << s->sink()->getCorrespondingBBNumber());
 									M_NT->addRight(1,v10);
 									M_NT->addRight(1,v11);
 									
@@ -651,15 +642,15 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
 						if(br->isExit()) {
 							if(br->exitsWithT()) {
 								Var *e00_d1,*e01_d1;
-								NEW_VAR_FROM_BUFF(e00_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C00D1end");
-								NEW_VAR_FROM_BUFF(e01_d1,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C01D1end");
+								NEW_VAR_FROM_BUFF(e00_d1,Xi << "A" << br->getHistory() << "C00D1end");
+								NEW_VAR_FROM_BUFF(e01_d1,Xi << "A" << br->getHistory() << "C01D1end");
 								M_T->addRight(1,e00_d1);
 								M_T->addRight(1,e01_d1);
 							}
 							if(br->exitsWithNT()) {
 								Var *e10_d0,*e11_d0;
-								NEW_VAR_FROM_BUFF(e10_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C10D0end");
-								NEW_VAR_FROM_BUFF(e11_d0,Xi->name() << "A" << BitSet_to_String(br->getHistory()) << "C11D0end");
+								NEW_VAR_FROM_BUFF(e10_d0,Xi << "A" << br->getHistory() << "C10D0end");
+								NEW_VAR_FROM_BUFF(e11_d0,Xi << "A" << br->getHistory() << "C11D0end");
 								M_NT->addRight(1,e10_d0);
 								M_NT->addRight(1,e11_d0);													
 							}
@@ -686,7 +677,7 @@ void BPredProcessor::CS__Global2b(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector
  * @param bcgs		Vector containg the BCGs (Branch Conflict Graphs) generated from the BHG.
  * @param ht_vars	Hash Table used to ensure unicity of the variables.
  */
-void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector<BCG*> &graphs, HashMap<String ,Var*>& ht_vars) {
+void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, elm::Vector<BCG*> &graphs, VarTable& ht_vars) {
 	// Recuperation de l'ensemble des contraintes
 	System *system = ipet::SYSTEM(fw);
 	ASSERT(system);
@@ -722,7 +713,7 @@ void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, e
 			elm::Vector<BCGNode*> v=classes_of_BB.get(*bb);
 			for(int i = 0 ; i<v.length();++i) {
 				Var *XbApi;
-				NEW_VAR_FROM_BUFF(XbApi, Xi->name() << "A" << BitSet_to_String(v[i]->getHistory()));
+				NEW_VAR_FROM_BUFF(XbApi, Xi << "A" << v[i]->getHistory());
 				H11->addRight(1,XbApi);
 			}
 		}
@@ -761,11 +752,11 @@ void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, e
 					Var *XbApi;
 					int d= edge->isTaken();
 					if(v[i]->isExit() && (v[i]->exitsWithT()==(d==1))) {
-						NEW_VAR_FROM_BUFF(XbApi, Xi->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "end");
+						NEW_VAR_FROM_BUFF(XbApi, Xi << "A" << v[i]->getHistory() << "end");
 						H12->addRight(1,XbApi);						
 					}
 					else {
-						NEW_VAR_FROM_BUFF(XbApi, Xi->name() << "A" << BitSet_to_String(v[i]->getHistory()) << "D" << d);
+						NEW_VAR_FROM_BUFF(XbApi, Xi << "A" << v[i]->getHistory() << "D" << d);
 						H12->addRight(1,XbApi);
 					}
 				}
@@ -797,7 +788,7 @@ void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, e
 //		{
 //			NEW_SPECIAL_CONSTRAINT(H41,LE,0);
 //			Var *XbApi;
-//			NEW_VAR_FROM_BUFF(XbApi,Xi->name() << "A" << BitSet_to_String(node->getHistory()));
+//			NEW_VAR_FROM_BUFF(XbApi,Xi << "A" << node->getHistory());
 //			H41->addLeft(1,XbApi);
 //			
 //			for(BHG::Predecessor p(node);p;p++) {
@@ -805,20 +796,20 @@ void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, e
 //				ASSERT(Xj);
 //				
 //					Var* XsbApi;
-//					NEW_VAR_FROM_BUFF(XsbApi,Xj->name() << "A" << BitSet_to_String(p->getHistory()));
+//					NEW_VAR_FROM_BUFF(XsbApi,Xj << "A" << p->getHistory());
 //					H41->addRight(1,XsbApi);
 //				
 //			}
 //			if(node->isEntry()) {
 //				Var *XbApistart;
-//				NEW_VAR_FROM_BUFF(XbApistart,Xi->name() << "A" << BitSet_to_String(node->getHistory()) << "start");
+//				NEW_VAR_FROM_BUFF(XbApistart,Xi << "A" << node->getHistory() << "start");
 //				H41->addRight(1,XbApistart);
 //			}
 //		}
 		{
 			NEW_SPECIAL_CONSTRAINT(H41,EQ,0);
 			Var *XbApi;
-			NEW_VAR_FROM_BUFF(XbApi,Xi->name() << "A" << BitSet_to_String(node->getHistory()));
+			NEW_VAR_FROM_BUFF(XbApi,Xi << "A" << node->getHistory());
 			H41->addLeft(1,XbApi);
 			
 			for(auto p: node->inEdges()) {
@@ -826,13 +817,13 @@ void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, e
 				ASSERT(Xj);
 					int d = (p->isTaken())?1:0;
 					Var* XsbApi;
-					NEW_VAR_FROM_BUFF(XsbApi,Xj->name() << "A" << BitSet_to_String(p->source()->getHistory()) << "D" << d);
+					NEW_VAR_FROM_BUFF(XsbApi,Xj << "A" << p->source()->getHistory() << "D" << d);
 					H41->addRight(1,XsbApi);
 				
 			}
 			if(node->isEntry()) {
 				Var *XbApistart;
-				NEW_VAR_FROM_BUFF(XbApistart,Xi->name() << "A" << BitSet_to_String(node->getHistory()) << "start");
+				NEW_VAR_FROM_BUFF(XbApistart,Xi << "A" << node->getHistory() << "start");
 				H41->addRight(1,XbApistart);
 			}
 		}
@@ -845,20 +836,20 @@ void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, e
 		{
 			NEW_SPECIAL_CONSTRAINT(H42,EQ,0);
 			Var *XbApi;
-			NEW_VAR_FROM_BUFF(XbApi,Xi->name() << "A" << BitSet_to_String(node->getHistory()));
+			NEW_VAR_FROM_BUFF(XbApi,Xi << "A" << node->getHistory());
 			H42->addLeft(1,XbApi);
 			
 			for(auto s: node->outEdges()) {
 				int d = (s->isTaken())?1:0;
 				
 				Var* XsbApi;
-				NEW_VAR_FROM_BUFF(XsbApi,Xi->name() << "A" << BitSet_to_String(node->getHistory()) << "D" << d);
+				NEW_VAR_FROM_BUFF(XsbApi,Xi << "A" << node->getHistory() << "D" << d);
 				H42->addRight(1,XsbApi);
 				
 			}
 			if(node->isExit()) {
 				Var *XbApiend;
-				NEW_VAR_FROM_BUFF(XbApiend,Xi->name() << "A" << BitSet_to_String(node->getHistory()) << "end");
+				NEW_VAR_FROM_BUFF(XbApiend,Xi << "A" << node->getHistory() << "end");
 				H42->addRight(1,XbApiend);
 			}
 		}
@@ -872,12 +863,12 @@ void BPredProcessor::CS__Global2b_not_mitra(WorkSpace *fw, CFG *cfg, BHG* bhg, e
 			elm::Vector<BCGNode*> v=classes_of_BB.get(node->getCorrespondingBB());
 			if(node->isEntry()) {
 				Var* XbApistart;
-				NEW_VAR_FROM_BUFF(XbApistart,Xi->name() << "A" << BitSet_to_String(node->getHistory()) << "start");
+				NEW_VAR_FROM_BUFF(XbApistart,Xi << "A" << node->getHistory() << "start");
 				H2->addLeft(1,XbApistart);
 			}
 			if(node->isExit()) {
 				Var* XbApiend;
-				NEW_VAR_FROM_BUFF(XbApiend,Xi->name() << "A" << BitSet_to_String(node->getHistory()) << "end");
+				NEW_VAR_FROM_BUFF(XbApiend,Xi << "A" << node->getHistory() << "end");
 				H3->addLeft(1,XbApiend);
 			}
 		}
@@ -925,7 +916,7 @@ Block* BPredProcessor::getFirstBranch(Block* bb,CFG* cfg) {
  * @param cfg		CFG of the BasicBlock bb.
  * @param entryBr	First branch of the CFG.
  */
-void BPredProcessor::getBranches(Block* bb,dfa::BitSet history,elm::Vector<BHGNode* >& suivants,CFG* cfg,Block* entryBr) {
+void BPredProcessor::getBranches(Block* bb,const dfa::BitSet& history,elm::Vector<BHGNode* >& suivants,CFG* cfg,Block* entryBr) {
 	for(Block::EdgeIter edge = bb->outs(); edge() ; edge++ ) {
 		if(edge->isTaken()) {
 			dfa::BitSet h=lshift_BitSet(history,1,true);
@@ -957,21 +948,15 @@ void BPredProcessor::getBranches(Block* bb,dfa::BitSet history,elm::Vector<BHGNo
  * Tests if a similar BHG Node is contained in a given vector of BHG Nodes and returns the BHG Node found.
  * Two BHG Nodes are similar if they have same hisotry and comes from the same BasicBlock.
  * 
- * @param v			Vector containing the BHG Nodes.
- * @param n			BHG Node to compare with those contained in the vector.
+ * @param v			Map of the BHG Nodes by key (block, packed history).
+ * @param n			BHG Node to look for.
  * @param contained If any similar BHG Node is found, then it will contains the found BHG Node, else it will contains a NULL pointer.
  * 
  * @return returns a boolean value set to True if a similar BHG Node has been found.
  */
-bool BPredProcessor::contains(const elm::Vector< BHGNode* >& v, BHGNode& n, BHGNode * &contained) {
-	for(int i=0;i<v.length();++i) {
-		if(n.equals(*(v[i])) ) {
-			contained = v[i];
-			return true;
-		}
-	}
-	contained = NULL;
-	return false;
+bool BPredProcessor::contains(const elm::HashMap<t::uint64, BHGNode* >& v, BHGNode& n, BHGNode * &contained) {
+	contained = v.get(n.key(), NULL);
+	return contained != NULL;
 }
 
 /**
@@ -981,7 +966,7 @@ bool BPredProcessor::contains(const elm::Vector< BHGNode* >& v, BHGNode& n, BHGN
  * @param bhg	Reference to the BHG to fill.
  */
 void BPredProcessor::generateBHG(CFG* cfg,BHG& bhg) {
-	elm::Vector< BHGNode* > final_nodes; 	// => S dans l'algo
+	elm::HashMap<t::uint64, BHGNode* > final_nodes; 	// => S dans l'algo
 	elm::Vector< BHGNode* > todo_nodes; 	// => F dans l'algo
 	elm::Vector< BHGEdge* > final_edges;	// => E dans l'algo
 	graph::GenDiGraphBuilder<BHGNode, BHGEdge> builder(&bhg);
@@ -999,7 +984,7 @@ void BPredProcessor::generateBHG(CFG* cfg,BHG& bhg) {
 
 		BHGNode *tmp;
 		if(!contains(final_nodes,*n,tmp)) {
-			final_nodes.add(n);
+			final_nodes.put(n->key(), n);
 			todo_nodes.add(n);
 			bhg.add(n);
 	
@@ -1016,7 +1001,7 @@ void BPredProcessor::generateBHG(CFG* cfg,BHG& bhg) {
 						//bool todo_n=false;
 						bool final_n=false;
 						if(!(final_n=contains(final_nodes,*s,cs))) {
-							final_nodes.add(s);
+							final_nodes.put(s->key(), s);
 							bhg.add(s);
 							
 							todo_nodes.add(s);
@@ -1457,7 +1442,7 @@ void BPredProcessor::processCFG__Global2B(WorkSpace *ws,CFG* cfg) {
 			this->stat_hist.add(bs);
 		}
 	}
-	HashMap<String ,Var*> ht_vars;
+	VarTable ht_vars(ipet::SYSTEM(ws), this->explicit_mode);
 	if(this->withMitra) {
 		BBHG bbhg(this->BHG_history_size);
 		generateBBHG(cfg,bbhg);
@@ -39,10 +39,11 @@ namespace otawa { namespace bpred {
 #define NEW_SPECIAL_CONSTRAINT(cons_name,op,val) 	Constraint *cons_name = system->newConstraint(Constraint::op, val); \
 		ASSERT(cons_name);
 
-#define NEW_VAR_FROM_BUFF(var_name,buff_expr)	{StringBuffer sb##var_name; \
-												sb##var_name << buff_expr; \
-												String s##var_name = sb##var_name.toString(); \
-												if(this->explicit_mode) var_name = system->newVar(s##var_name); \
+#define NEW_VAR_FROM_BUFF(var_name,buff_expr)	{if(this->explicit_mode) { \
+													StringBuffer sb##var_name; \
+													sb##var_name << buff_expr; \
+													var_name = system->newVar(sb##var_name.toString()); \
+												} \
 												else var_name = system->newVar(String("")); \
 												ASSERT(var_name);}
 ////////////////////////////////////////////
@@ -0,0 +1,251 @@
+/*
+ *	VarTable class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <string.h>
+#include "VarTable.h"
+
+namespace otawa { namespace bpred {
+
+// tags of the non-textual parts of a key
+static const char VAR_TAG = '\x01';
+static const char HIST_TAG = '\x02';
+
+/**
+ * @class VarTable
+ * Table ensuring the unicity of the ILP variables built by the branch
+ * prediction models.
+ *
+ * The variables are identified by a key describing them in the same way
+ * as their former textual name (node, history and counter state) but
+ * built without allocation: literals and integers are stored as characters,
+ * histories are packed as bits and foreign variables (like the block
+ * variables of IPET) are identified by their address instead of their name.
+ * The keys of variables created by the table are recorded so that a key
+ * built from such a variable is the same as the key built from its parts.
+ *
+ * The textual names of the variables are only computed in explicit mode,
+ * that is, when the ILP system has to be dumped.
+ */
+
+
+/**
+ * Build a variable table.
+ * @param system			ILP system to create variables in.
+ * @param explicit_names	True to give explicit names to the variables.
+ */
+VarTable::VarTable(ilp::System *system, bool explicit_names): _sys(system), _explicit(explicit_names) {
+}
+
+
+/**
+ * Get or create the variable matching the given key.
+ * @param key	Variable key.
+ * @return		Matching variable.
+ */
+ilp::Var *VarTable::make(const Key& key) {
+	ilp::Var *v = _vars.get(key, nullptr);
+	if(v == nullptr) {
+		v = _sys->newVar(key.name());
+		ASSERT(v);
+		_vars.put(key, v);
+		_keys.put(v, key);
+	}
+	return v;
+}
+
+
+/**
+ * @class VarTable::Key
+ * Key of a variable in a VarTable, built by appending its parts with
+ * operator<<.
+ */
+
+
+/**
+ * Build an empty key for the given table.
+ * @param table		Owner table.
+ */
+VarTable::Key::Key(VarTable& table): len(0), cap(inline_size), buf(ibuf), named(nullptr), tab(&table) {
+	if(table.isExplicit())
+		named = new StringBuffer();
+}
+
+
+/**
+ */
+VarTable::Key::Key(const Key& key): len(0), cap(inline_size), buf(ibuf), named(nullptr), tab(key.tab) {
+	set(key);
+}
+
+
+/**
+ */
+VarTable::Key::~Key(void) {
+	if(buf != ibuf)
+		delete [] buf;
+	if(named != nullptr)
+		delete named;
+}
+
+
+/**
+ * Copy a key (the name under construction is not copied).
+ */
+VarTable::Key& VarTable::Key::operator=(const Key& key) {
+	if(&key != this) {
+		len = 0;
+		set(key);
+		tab = key.tab;
+	}
+	return *this;
+}
+
+
+/**
+ * Replace the content of the key by the content of the given key.
+ * @param key	Copied key.
+ */
+void VarTable::Key::set(const Key& key) {
+	while(cap < key.len)
+		grow();
+	len = key.len;
+	memcpy(buf, key.buf, len);
+}
+
+
+/**
+ * Double the capacity of the key: the keys are stored in place up to
+ * inline_size characters and in the heap beyond.
+ */
+void VarTable::Key::grow(void) {
+	char *nbuf = new char[cap * 2];
+	memcpy(nbuf, buf, len);
+	if(buf != ibuf)
+		delete [] buf;
+	buf = nbuf;
+	cap *= 2;
+}
+
+
+/**
+ * Append a literal to the key.
+ */
+VarTable::Key& VarTable::Key::operator<<(const char *s) {
+	for(const char *p = s; *p != '\0'; p++)
+		put(*p);
+	if(named != nullptr)
+		*named << s;
+	return *this;
+}
+
+
+/**
+ * Append an integer to the key.
+ */
+VarTable::Key& VarTable::Key::operator<<(int i) {
+	char tmp[16];
+	int n = 0;
+	unsigned int u = i < 0 ? -i : i;
+	do {
+		tmp[n++] = '0' + u % 10;
+		u /= 10;
+	} while(u != 0);
+	if(i < 0)
+		put('-');
+	while(n > 0)
+		put(tmp[--n]);
+	if(named != nullptr)
+		*named << i;
+	return *this;
+}
+
+
+/**
+ * Append a boolean to the key (as it is displayed).
+ */
+VarTable::Key& VarTable::Key::operator<<(bool b) {
+	return *this << (b ? "true" : "false");
+}
+
+
+/**
+ * Append a history to the key.
+ */
+VarTable::Key& VarTable::Key::operator<<(const dfa::BitSet& h) {
+	int s = h.size();
+	put(HIST_TAG);
+	for(int i = 0; i < int(sizeof(s)); i++)
+		put(char(s >> (8 * i)));
+	for(int i = 0; i < s; i += 8) {
+		char c = 0;
+		for(int j = 0; j < 8 && i + j < s; j++)
+			if(h.contains(i + j))
+				c |= 1 << j;
+		put(c);
+	}
+	if(named != nullptr)
+		for(int i = s - 1; i >= 0; i--)
+			*named << (h.contains(i) ? '1' : '0');
+	return *this;
+}
+
+
+/**
+ * Append a variable to the key: if the variable has been built by the table,
+ * its own key is appended, else its identity.
+ */
+VarTable::Key& VarTable::Key::operator<<(ilp::Var *v) {
+	Key k = tab->_keys.get(v, Key());
+	if(k.len != 0)
+		for(int i = 0; i < k.len; i++)
+			put(k.buf[i]);
+	else {
+		put(VAR_TAG);
+		unsigned long p = (unsigned long)v;
+		for(int i = 0; i < int(sizeof(p)); i++) {
+			put(char(p & 0xff));
+			p >>= 8;
+		}
+	}
+	if(named != nullptr)
+		*named << v->name();
+	return *this;
+}
+
+
+/**
+ * Compute the hash code of the key.
+ */
+t::hash VarTable::Key::hash(void) const {
+	t::hash h = 2166136261u;
+	for(int i = 0; i < len; i++)
+		h = (h ^ (unsigned char)buf[i]) * 16777619u;
+	return h;
+}
+
+
+/**
+ * Test if two keys are equal.
+ */
+bool VarTable::Key::equals(const Key& k) const {
+	return len == k.len && memcmp(buf, k.buf, len) == 0;
+}
+
+} }	// otawa::bpred
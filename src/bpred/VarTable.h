@@ -0,0 +1,84 @@
+/*
+ *	VarTable class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef BPRED_VARTABLE_H_
+#define BPRED_VARTABLE_H_
+
+#include <elm/data/HashMap.h>
+#include <otawa/dfa/BitSet.h>
+#include <otawa/ilp/System.h>
+
+namespace otawa { namespace bpred {
+
+using namespace elm;
+
+class VarTable {
+public:
+	static const int inline_size = 128;
+
+	class Key {
+	public:
+		inline Key(void): len(0), cap(inline_size), buf(ibuf), named(nullptr), tab(nullptr) { }
+		Key(VarTable& table);
+		Key(const Key& key);
+		~Key(void);
+		Key& operator=(const Key& key);
+
+		Key& operator<<(const char *s);
+		Key& operator<<(int i);
+		Key& operator<<(bool b);
+		Key& operator<<(const dfa::BitSet& h);
+		Key& operator<<(ilp::Var *v);
+
+		t::hash hash(void) const;
+		bool equals(const Key& k) const;
+		inline String name(void) const { return named == nullptr ? String("") : named->toString(); }
+
+	private:
+		inline void put(char c) { if(len == cap) grow(); buf[len++] = c; }
+		void grow(void);
+		void set(const Key& key);
+		int len, cap;
+		char *buf;
+		char ibuf[inline_size];
+		StringBuffer *named;
+		VarTable *tab;
+	};
+
+	class KeyHash {
+	public:
+		inline t::hash computeHash(const Key& k) const { return k.hash(); }
+		inline bool isEqual(const Key& k1, const Key& k2) const { return k1.equals(k2); }
+	};
+
+	VarTable(ilp::System *system, bool explicit_names);
+	ilp::Var *make(const Key& key);
+	inline bool isExplicit(void) const { return _explicit; }
+
+private:
+	ilp::System *_sys;
+	bool _explicit;
+	HashMap<Key, ilp::Var *, KeyHash> _vars;
+	HashMap<ilp::Var *, Key> _keys;
+};
+
+} }	// otawa::bpred
+
+#endif /* BPRED_VARTABLE_H_ */
@@ -353,6 +353,7 @@ EdgeTimeBuilder::EdgeTimeBuilder(p::declare& r)
  	source(0),
  	target(0),
 	record(false),
+	symbolic(false),
 	event_mask(0)
 { }
 
@@ -363,6 +364,7 @@ void EdgeTimeBuilder::configure(const PropList& props) {
 	predump = PREDUMP(props);
 	event_th = EVENT_THRESHOLD(props);
 	record = RECORD_TIME(props);
+	symbolic = SYMBOLIC_TIMING(props);
 	_props = props;
 }
 
@@ -739,11 +741,6 @@ void EdgeTimeBuilder::processSequence(void) {
 				<< " " << events[i].snd << io::endl;
 	}
 
-	// check number of events limit
-	// TODO	fall back: analyze the block alone, split the block
-	if(events.count() >= 32)
-		throw ProcessorException(*this, _ << "too many events on edge " << edge);
-
 	// simple trivial case
 	if(events.isEmpty()) {
 
@@ -767,56 +764,71 @@ void EdgeTimeBuilder::processSequence(void) {
 		return;
 	}
 
-	// compute all cases
-	t::uint32 prev = 0;
-	Vector<ConfigSet> confs;
+	// symbolic form of the graph (required above the enumeration limit)
+	MaxPlusGraph *mpg = nullptr;
 	custom.clear();
-	for(event_mask = 0; event_mask < t::uint32(1 << events.count()); event_mask++) {
-
-		// adjust the graph
+	bool too_many = events.count() >= 32;
+	if((symbolic || too_many) && !_do_output_graphs && events.count() <= MaxPlusGraph::max_events) {
+		mpg = new MaxPlusGraph(graph, events.count());
 		for(int i = 0; i < events.count(); i++) {
-			if((prev & (1 << i)) != (event_mask & (1 << i))) {
-				if(event_mask & (1 << i))
-					apply(events[i].fst, insts[i]);
-				else
-					rollback(events[i].fst, insts[i]);
-			}
+			apply(events[i].fst, insts[i]);
+			mpg->probe(i);
+			rollback(events[i].fst, insts[i]);
 		}
-		prev = event_mask;
+		if(!mpg->build()) {
+			delete mpg;
+			mpg = nullptr;
+		}
+	}
+	if(too_many && mpg == nullptr)
+		throw ProcessorException(*this, _ << "too many events on edge " << edge);
 
-		// predump implementation
-		if(_do_output_graphs && predump)
-			outputGraph(graph, 666, 666, 666, _ << source << " -> " << target);
+	// compute all cases
+	Vector<ConfigSet> confs;
+	event_list_t free_events;
+	if(mpg != nullptr)
+		computeSymbolic(confs, *mpg, free_events);
+	else {
+		t::uint32 prev = 0;
+		for(event_mask = 0; event_mask < t::uint32(1 << events.count()); event_mask++) {
+
+			// adjust the graph
+			for(int i = 0; i < events.count(); i++) {
+				if((prev & (1 << i)) != (event_mask & (1 << i))) {
+					if(event_mask & (1 << i))
+						apply(events[i].fst, insts[i]);
+					else
+						rollback(events[i].fst, insts[i]);
+				}
+			}
+			prev = event_mask;
 
-		// compute and store the new value
-		ot::time cost = graph->analyze();
+			// predump implementation
+			if(_do_output_graphs && predump)
+				outputGraph(graph, 666, 666, 666, _ << source << " -> " << target);
 
-		// dump it if needed
-		if(_do_output_graphs) {
-			if (source)
-				outputGraph(graph, target->index(), source->index(), event_mask,
-						_ << source << " -> " << target << " (cost = " << cost << ")");
-			else
-				outputGraph(graph, target->index(), 0, event_mask, _ << target << " (cost = " << cost << ")");
-		}
+			// compute and store the new value
+			ot::time cost = graph->analyze();
 
-		// add the new time
-		int j;
-		for(j = 0; j < confs.length(); j++)
-			if(cost == confs[j].time())
-				break;
-			else if(cost < confs[j].time()) {
-				confs.insert(j, ConfigSet(cost));
-				break;
+			// dump it if needed
+			if(_do_output_graphs) {
+				if (source)
+					outputGraph(graph, target->index(), source->index(), event_mask,
+							_ << source << " -> " << target << " (cost = " << cost << ")");
+				else
+					outputGraph(graph, target->index(), 0, event_mask, _ << target << " (cost = " << cost << ")");
 			}
-		if(j >= confs.length())
-			confs.add(ConfigSet(cost));
-		confs[j].add(Config(event_mask));
+
+			// add the new time
+			addConf(confs, cost);
+		}
 	}
 
 	//if(isVerbose())
 	if(logFor(LOG_BB))
 		displayConfs(confs, events);
+	if(mpg != nullptr)
+		delete mpg;
 	delete graph;
 
 	// trivial case: 1 time
@@ -825,11 +837,102 @@ void EdgeTimeBuilder::processSequence(void) {
 		return;
 	}
 
-	// generate constraints
+	// generate constraints (the free events do not participate to the split)
+	for(auto e: free_events) {
+		get(e.fst)->contribute(make(e.fst, e.snd, true), 0);
+		get(e.fst)->contribute(make(e.fst, e.snd, false), 0);
+	}
 	processTimes(confs);
 }
 
 
+/**
+ * Build the configuration times from the symbolic form of the graph.
+ * Only the enum_limit events with the biggest impact on the time are
+ * enumerated: the other events are left free, removed from the event list
+ * and the times are upper bounds for any value of these events.
+ * @param confs		Filled with the configuration times.
+ * @param mpg		Built symbolic form (the event i matches the event i of events).
+ * @param free		Filled with the free events.
+ */
+void EdgeTimeBuilder::computeSymbolic(config_list_t& confs, const MaxPlusGraph& mpg, event_list_t& free) {
+	typedef MaxPlusGraph::mask_t smask_t;
+	int n = events.count();
+	smask_t all = n == MaxPlusGraph::max_events ? ~smask_t(0) : (smask_t(1) << n) - 1;
+	if(logFor(LOG_BB))
+		log << "\t\t\t\tsymbolic form: " << mpg.termCount() << " terms\n";
+
+	// select the enumerated events
+	Vector<int> bits;
+	if(n <= enum_limit)
+		for(int i = 0; i < n; i++)
+			bits.add(i);
+	else {
+		ot::time top = mpg.bound(0, all);
+		AllocArray<ot::time> impact(n);
+		for(int i = 0; i < n; i++) {
+			smask_t b = smask_t(1) << i;
+			impact[i] = top - max(mpg.bound(0, all & ~b), mpg.bound(b, all));
+		}
+		smask_t sel = 0;
+		while(bits.length() < enum_limit) {
+			int m = -1;
+			for(int i = 0; i < n; i++)
+				if(!(sel & (smask_t(1) << i)) && (m < 0 || impact[i] > impact[m]))
+					m = i;
+			sel |= smask_t(1) << m;
+			bits.add(m);
+		}
+		if(logFor(LOG_BB))
+			log << "\t\t\t\t" << (n - enum_limit) << " events left free\n";
+	}
+	smask_t fmask = all;
+	for(auto b: bits)
+		fmask &= ~(smask_t(1) << b);
+
+	// evaluate the configurations
+	for(event_mask = 0; event_mask < t::uint32(1 << bits.length()); event_mask++) {
+		smask_t conf = 0;
+		for(int j = 0; j < bits.length(); j++)
+			if(event_mask & (1 << j))
+				conf |= smask_t(1) << bits[j];
+		addConf(confs, fmask == 0 ? mpg.evaluate(conf) : mpg.bound(conf, conf | fmask));
+	}
+
+	// keep only the enumerated events (bit j of the configurations)
+	if(fmask != 0) {
+		event_list_t enums;
+		for(auto b: bits)
+			enums.add(events[b]);
+		for(int i = 0; i < n; i++)
+			if(fmask & (smask_t(1) << i))
+				free.add(events[i]);
+		events = enums;
+	}
+}
+
+
+/**
+ * Add the current configuration (event_mask) to the configuration sets
+ * sorted by increasing time.
+ * @param confs		Configuration sets.
+ * @param cost		Time of the current configuration.
+ */
+void EdgeTimeBuilder::addConf(config_list_t& confs, ot::time cost) {
+	int j;
+	for(j = 0; j < confs.length(); j++)
+		if(cost == confs[j].time())
+			break;
+		else if(cost < confs[j].time()) {
+			confs.insert(j, ConfigSet(cost));
+			break;
+		}
+	if(j >= confs.length())
+		confs.add(ConfigSet(cost));
+	confs[j].add(Config(event_mask));
+}
+
+
 /**
  * Generate the constraints when only one cost is considered for the edge.
  * @param cost		Edge cost.
@@ -1743,6 +1846,7 @@ void EdgeTimeBuilder::contributeConst(void) {
  * @li @ref ONLY_START
  * @li @ref PREDUMP
  * @li @ref RECORD_TIME
+ * @li @ref SYMBOLIC_TIMING
  *
  * @p Properties
  * @li @ref LTS_TIME
@@ -0,0 +1,477 @@
+/*
+ *	MaxPlusGraph class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <otawa/etime/MaxPlusGraph.h>
+
+namespace otawa { namespace etime {
+
+/**
+ * Compute the sum of the weights of the events of a mask.
+ * @param m		Event mask.
+ * @param w		Event weights.
+ * @return		Sum of weights.
+ */
+static inline int sum(MaxPlusGraph::mask_t m, const AllocArray<int>& w) {
+	int s = 0;
+	for(int i = 0; m != 0; i++, m >>= 1)
+		if(m & 1)
+			s += w[i];
+	return s;
+}
+
+
+/**
+ * @class MaxPlusGraph
+ * Symbolic (closed form) timing of a ParExeGraph according to its dynamic events.
+ *
+ * ParExeGraph::analyze() only uses max and + on the latencies of nodes and edges
+ * and the events only add latencies to nodes or edges (or add an edge). Therefore
+ * the delay of a node relatively to a resource is a max-plus polynomial of the
+ * event activations. This class propagates these polynomials once through the graph
+ * and then evaluates the cost of any event configuration from the polynomials of the
+ * last node and of the last prologue node, without re-analyzing the graph.
+ *
+ * A polynomial is a set of terms (req, var, base) whose value, for a configuration
+ * C of activated events, is the maximum, for the terms whose events req are all in C,
+ * of base plus the weights of the events of var in C. req represents events adding
+ * edges and var events adding latencies. Dominated terms are removed.
+ *
+ * The graph is prepared with the events inactivated and each event is then applied
+ * alone and recorded with probe(), allowing to re-use the event application code of
+ * the time builders. If an event has an effect not representable (several places
+ * changed, latency decrease) or the polynomials grow too much, build() fails and the
+ * caller has to fall back to the enumeration of configurations.
+ *
+ * The closed form is exact except when several events change the latency of the same
+ * node of latency 1. As an event may either replace this latency (EdgeTimeBuilder::addLatency())
+ * or add to it, the latency of the node is computed as max(1, sum of the latencies set by each
+ * event alone). This is exact for events replacing the latency but, for k events adding to
+ * the latency (like the memory accesses of the execution stage), it over-estimates the
+ * latency of their combination by k-1 cycles.
+ *
+ * @ingroup etime
+ */
+
+
+/**
+ * Build the max-plus graph. The graph must be in its state where all dynamic
+ * events are inactivated.
+ * @param g			Analyzed graph.
+ * @param events	Number of dynamic events.
+ * @param max_terms	Maximum number of terms in a polynomial.
+ */
+MaxPlusGraph::MaxPlusGraph(ParExeGraph *g, int events, int max_terms):
+	_g(g),
+	_max(max_terms),
+	_tcnt(0),
+	_failed(events > max_events),
+	_at(g->count()),
+	_lat(g->count()),
+	_nvar(g->count()),
+	_w(events),
+	_last(-1),
+	_lp(-1),
+	_ldel(g->numResources()),
+	_pdel(g->numResources())
+{
+	for(int i = 0; i < _at.count(); i++) {
+		_at[i] = -1;
+		_nvar[i] = 0;
+	}
+	for(int i = 0; i < _w.count(); i++)
+		_w[i] = 0;
+
+	// record the nodes
+	for(ParExeGraph::PreorderIterator node(g); node(); node++) {
+		_at[node->index()] = _nodes.length();
+		_lat[_nodes.length()] = node->latency();
+		_nodes.add(*node);
+	}
+
+	// record the edges
+	for(int i = 0; i < _nodes.length(); i++)
+		for(ParExeGraph::Successor succ(_nodes[i]); succ(); succ++) {
+			_emap.put(succ.edge(), _edges.length());
+			_edges.add(XEdge(i, nodeAt(*succ), succ.edge()->type() == ParExeEdge::SOLID, succ.edge()->latency()));
+		}
+}
+
+
+/**
+ * Record the effect of an event. The event must be applied alone to the graph.
+ * @param event		Number of the event (in [0, event count)).
+ */
+void MaxPlusGraph::probe(int event) {
+	if(_failed)
+		return;
+	mask_t bit = mask_t(1) << event;
+	int places = 0;
+
+	for(int i = 0; i < _nodes.length(); i++) {
+
+		// latency change
+		int l = _nodes[i]->latency();
+		if(l != _lat[i]) {
+			places++;
+			_nvar[i] |= bit;
+			_w[event] = _lat[i] == 1 ? l : l - _lat[i];
+		}
+
+		// edge change
+		for(ParExeGraph::Successor succ(_nodes[i]); succ(); succ++) {
+			int e = _emap.get(succ.edge(), -1);
+			if(e < 0) {
+				int t = nodeAt(*succ);
+				if(t < 0) {
+					_failed = true;
+					return;
+				}
+				XEdge x(i, t, succ.edge()->type() == ParExeEdge::SOLID, succ.edge()->latency());
+				x.req = bit;
+				_edges.add(x);
+				places++;
+			}
+			else if(succ.edge()->latency() != _edges[e].lat) {
+				places++;
+				_edges[e].var |= bit;
+				_w[event] = succ.edge()->latency() - _edges[e].lat;
+			}
+		}
+	}
+
+	if(places > 1 || _w[event] < 0)
+		_failed = true;
+}
+
+
+/**
+ * Build the latency polynomial of a node.
+ * @param n		Node number.
+ * @param p		Polynomial to fill.
+ */
+void MaxPlusGraph::latency(int n, Poly& p) const {
+	p.clear();
+	if(_nvar[n] == 0)
+		p.add(Term(0, 0, _lat[n]));
+	else if(_lat[n] == 1) {
+		p.add(Term(0, 0, 1));
+		p.add(Term(0, _nvar[n], 0));
+	}
+	else
+		p.add(Term(0, _nvar[n], _lat[n]));
+}
+
+
+/**
+ * Propagate the polynomials through the graph, following ParExeGraph::propagate().
+ * @return	True if the closed form has been built, false if the caller
+ * 			has to fall back to the enumeration of configurations.
+ */
+bool MaxPlusGraph::build(void) {
+	if(_failed)
+		return false;
+	int nc = _nodes.length(), rc = _g->numResources();
+
+	// topological order (Kahn)
+	AllocArray<Vector<int> > out(nc);
+	AllocArray<int> deg(nc);
+	for(int i = 0; i < nc; i++)
+		deg[i] = 0;
+	for(int i = 0; i < _edges.length(); i++) {
+		out[_edges[i].src].add(i);
+		deg[_edges[i].snk]++;
+	}
+	Vector<int> todo, topo;
+	for(int i = 0; i < nc; i++)
+		if(deg[i] == 0)
+			todo.push(i);
+	while(!todo.isEmpty()) {
+		int n = todo.pop();
+		topo.add(n);
+		for(auto e: out[n])
+			if(--deg[_edges[e].snk] == 0)
+				todo.push(_edges[e].snk);
+	}
+	if(topo.length() != nc)
+		return false;
+
+	// initial delays
+	AllocArray<Poly> del(nc * rc);
+	_g->clearDelays();
+	_g->initDelays();
+	for(int i = 0; i < nc; i++)
+		for(int r = 0; r < rc && r < _nodes[i]->delayLength(); r++)
+			if(_nodes[i]->delay(r) == 0)
+				del[i * rc + r].add(Term());
+	_g->clearDelays();
+
+	// propagate
+	Poly lat, el, ep, tmp;
+	for(auto n: topo) {
+		latency(n, lat);
+		for(auto e: out[n]) {
+			const XEdge& x = _edges[e];
+			el.clear();
+			if(x.solid) {
+				ep.clear();
+				ep.add(Term(x.req, x.var, x.lat));
+				el.mul(lat, ep);
+			}
+			else
+				el.add(Term(x.req, 0, 0));
+			for(int r = 0; r < rc; r++)
+				if(!del[n * rc + r].isEmpty()) {
+					tmp.mul(del[n * rc + r], el);
+					Poly& d = del[x.snk * rc + r];
+					d.join(tmp);
+					if(d.count() > _max)
+						return false;
+				}
+		}
+	}
+
+	// record the closed form
+	_last = nodeAt(_g->lastNode());
+	if(_g->lastPrologueNode() != nullptr)
+		_lp = nodeAt(_g->lastPrologueNode());
+	for(int r = 0; r < rc; r++) {
+		_ldel[r].join(del[_last * rc + r]);
+		if(_lp >= 0)
+			_pdel[r].join(del[_lp * rc + r]);
+	}
+	latency(_last, _llat);
+	for(int i = 0; i < del.count(); i++)
+		_tcnt += del[i].count();
+	return true;
+}
+
+
+/**
+ * @fn int MaxPlusGraph::eventCount(void) const;
+ * Get the number of dynamic events.
+ * @return	Dynamic event count.
+ */
+
+/**
+ * @fn int MaxPlusGraph::termCount(void) const;
+ * Get the total number of terms of the polynomials built by build()
+ * (useful to evaluate the cost of the symbolic resolution).
+ * @return	Term count.
+ */
+
+
+/**
+ * Compute the cost of the graph for an event configuration,
+ * as ParExeGraph::analyze() would do.
+ * @param conf	Configuration (bit i set if event i is activated).
+ * @return		Graph cost.
+ */
+ot::time MaxPlusGraph::evaluate(mask_t conf) const {
+	return bound(conf, conf);
+}
+
+
+/**
+ * Compute an upper bound on the cost of the graph for all configurations C
+ * such that lo ⊆ C ⊆ hi. As the polynomials increase with the activated events,
+ * the delays of the last node are bounded by their value for hi and the delays of the
+ * last prologue node by their value for lo. If lo == hi, the result is exact.
+ * @param lo	Lower configuration.
+ * @param hi	Upper configuration.
+ * @return		Upper bound on the cost.
+ */
+ot::time MaxPlusGraph::bound(mask_t lo, mask_t hi) const {
+	ASSERT(_last >= 0);
+	if(_lp < 0)
+		return _ldel[0].eval(hi, _w) + _llat.eval(hi, _w);
+
+	int wcc = delta(0, lo, hi);
+	for(int r = 0; r < _g->numResources(); r++) {
+		Resource *res = _g->resource(r);
+		if(res->type() == Resource::BLOCK_START)
+			continue;
+		if(res->type() == Resource::QUEUE) {
+			auto qres = static_cast<QueueResource *>(res);
+			int u = qres->uid();
+			if(_ldel[r].isDefined(lo) && _ldel[u].isDefined(lo)
+			&& _ldel[r].eval(hi, _w) <= _ldel[u].eval(lo, _w) + qres->offset())
+				continue;
+		}
+		wcc = max(wcc, delta(r, lo, hi));
+	}
+	return wcc;
+}
+
+
+/**
+ * Compute an upper bound of ParExeGraph::delta() between the last node
+ * and the last prologue node for the configurations between lo and hi.
+ * @param r		Resource index.
+ * @param lo	Lower configuration.
+ * @param hi	Upper configuration.
+ * @return		Upper bound on the delta.
+ */
+int MaxPlusGraph::delta(int r, mask_t lo, mask_t hi) const {
+	const Poly& ln = _ldel[r];
+	if(!ln.isDefined(hi))
+		return 0;
+	int v = ln.eval(hi, _w);
+	int d = type_info<int>::min;
+
+	// prologue node depending on the resource
+	const Poly& lp = _pdel[r];
+	if(lp.isDefined(hi))
+		d = v - lp.lower(lo, hi, _w);
+
+	// prologue node not depending on the resource: upper bound on the availability
+	if(!lp.isDefined(lo)) {
+		Resource *res = _g->resource(r);
+		int ub = _pdel[_g->numResources() - 1].eval(lo, _w);
+		if(res->type() == Resource::STAGE)
+			ub += _g->getMicroprocessor()->pipeline()->numStages() - static_cast<StageResource *>(res)->stage()->index();
+		else if(res->type() == Resource::QUEUE) {
+			auto qres = static_cast<QueueResource *>(res);
+			if(_pdel[qres->uid()].isDefined(hi)) {
+				int diff = _pdel[qres->uid()].lower(lo, hi, _w) + qres->offset();
+				if(diff < ub)
+					ub = diff;
+			}
+		}
+		d = max(d, v - ub);
+	}
+
+	// last node may not depend on the resource
+	if(!ln.isDefined(lo))
+		d = max(d, 0);
+	return d;
+}
+
+
+/**
+ * @class MaxPlusGraph::Term
+ * Term of a max-plus polynomial.
+ */
+
+/**
+ * @fn bool MaxPlusGraph::Term::dominates(const Term& t) const;
+ * Test if the current term is greater or equal to t for any configuration.
+ * @param t		Compared term.
+ * @return		True if the current term dominates t.
+ */
+
+
+/**
+ * @class MaxPlusGraph::Poly
+ * Max-plus polynomial of the event activations.
+ */
+
+/**
+ * Add a term to the polynomial (max operation).
+ * @param t		Added term.
+ */
+void MaxPlusGraph::Poly::add(const Term& t) {
+	for(const auto& u: _terms)
+		if(u.dominates(t))
+			return;
+	for(int i = 0; i < _terms.length();)
+		if(t.dominates(_terms[i])) {
+			_terms[i] = _terms.top();
+			_terms.pop();
+		}
+		else
+			i++;
+	_terms.add(t);
+}
+
+
+/**
+ * Compute the maximum of the current polynomial and of p.
+ * @param p		Joined polynomial.
+ */
+void MaxPlusGraph::Poly::join(const Poly& p) {
+	for(const auto& t: p._terms)
+		add(t);
+}
+
+
+/**
+ * Set the current polynomial to the product (sum in max-plus) of p and q.
+ * The current polynomial must not be p or q.
+ * @param p		First polynomial.
+ * @param q		Second polynomial.
+ */
+void MaxPlusGraph::Poly::mul(const Poly& p, const Poly& q) {
+	ASSERT(this != &p && this != &q);
+	clear();
+	for(const auto& t: p._terms)
+		for(const auto& u: q._terms)
+			add(Term(t.req | u.req, t.var | u.var, t.base + u.base));
+}
+
+
+/**
+ * Test if the polynomial has a value for the given configuration
+ * (equivalent to a delay different from -1).
+ * @param conf	Configuration.
+ * @return		True if the polynomial is defined.
+ */
+bool MaxPlusGraph::Poly::isDefined(mask_t conf) const {
+	for(const auto& t: _terms)
+		if((t.req & ~conf) == 0)
+			return true;
+	return false;
+}
+
+
+/**
+ * Evaluate the polynomial for the given configuration.
+ * @param conf	Configuration.
+ * @param w		Event weights.
+ * @return		Polynomial value or -1 if it is not defined.
+ */
+int MaxPlusGraph::Poly::eval(mask_t conf, const AllocArray<int>& w) const {
+	int v = -1;
+	for(const auto& t: _terms)
+		if((t.req & ~conf) == 0)
+			v = max(v, t.base + sum(t.var & conf, w));
+	return v;
+}
+
+
+/**
+ * Compute a lower bound of the polynomial for the configurations
+ * C such that lo ⊆ C ⊆ hi and the polynomial is defined for C.
+ * @param lo	Lower configuration.
+ * @param hi	Upper configuration.
+ * @param w		Event weights.
+ * @return		Lower bound or -1 if the polynomial is never defined.
+ */
+int MaxPlusGraph::Poly::lower(mask_t lo, mask_t hi, const AllocArray<int>& w) const {
+	if(isDefined(lo))
+		return eval(lo, w);
+	int v = type_info<int>::max;
+	for(const auto& t: _terms)
+		if((t.req & ~hi) == 0)
+			v = min(v, t.base + sum(t.var & lo, w));
+	return v == type_info<int>::max ? -1 : v;
+}
+
+} }	// otawa::etime
@@ -25,6 +25,9 @@
 
 namespace otawa { namespace etime {
 
+// lazy variable naming
+static ilp::FormatKind hts_kind("e_%1_%2_%c_hts");
+
 /**
  * @class ILPGenerator
  *
@@ -427,6 +430,9 @@ void StandardILPGenerator::contributeTime(ot::time t) {
 	}
 	//_x_hTS is used as 'current' i.e. last variable created by contributeTime
 	_x_hts = system()->newVar(hts_name);
+	if(!hts_name)
+		_x_hts->setDesc(ilp::Desc(hts_kind,
+			_edge->source()->index(), _edge->sink()->index(), _edge->sink()->cfg()->label()));
 
 	// wcet += time_lts x_edge + (time_hts - time_lts) x_hts
 	system()->addObjectFunction(t - _t_lts , _x_hts);
@@ -434,7 +440,8 @@ void StandardILPGenerator::contributeTime(ot::time t) {
 		HTS_CONFIG(_edge).add(pair(t - _t_lts, _x_hts));
 
 	// 0 <= x_hts <= x_edge
-	ilp::Constraint *cons = system()->newConstraint("0 <= x", ilp::Constraint::LE);
+	static string bound_label = "0 <= x";
+	ilp::Constraint *cons = system()->newConstraint(bound_label, ilp::Constraint::LE);
 	cons->addRight(1, _x_hts);
 	_partitionVars.push(_x_hts);
 	//cons = system()->newConstraint("x_hts <= x_edge", ilp::Constraint::LE);
@@ -494,7 +501,8 @@ void StandardILPGenerator::finish(const Vector<EventCase>& events) {
 
 
 	if (!_partitionVars.isEmpty()){
-	ilp::Constraint* cons = system()->newConstraint("sum(x) = x_edge", ilp::Constraint::LE);
+	static string sum_label = "sum(x) = x_edge";
+	ilp::Constraint* cons = system()->newConstraint(sum_label, ilp::Constraint::LE);
 	cons->addRight(1, _x_e);
 	for (auto v: _partitionVars){
 		cons->addLeft(1, v);
@@ -23,6 +23,7 @@
 #include <elm/data/quicksort.h>
 #include <elm/sys/System.h>
 #include <otawa/etime/AbstractTimeBuilder.h>
+#include <otawa/etime/MaxPlusGraph.h>
 
 namespace otawa { namespace etime {
 
@@ -109,16 +110,32 @@ void XGraphSolver::configure(const PropList& props) {
  * Simple implementation of an execution graph based on:
  * * topological traversal of the graph to extract maximum time for
  * instruction and resources,
- * * each event configuration is tested in turn,
+ * * each event configuration is evaluated in turn, from the symbolic
+ * form of the graph (MaxPlusGraph) or by analyzing again the graph,
  * * LTS/HTS scheme of time production.
  *
+ * With the symbolic form, only the enum_limit events with the biggest impact on
+ * the time are enumerated: the other events are left free and the times are upper
+ * bounds for any value of these events (they are not used to bound the HTS).
+ *
+ * @par Configuration
+ * @li @ref SYMBOLIC_TIMING
+ *
  * @ingroup etime
  */
 class StandardXGraphSolver: public XGraphSolver {
 public:
 	typedef t::uint32 mask_t;
+	static const int enum_limit = 16;
 
-	StandardXGraphSolver(Monitor& mon): XGraphSolver(mon), bedge(nullptr), no_ilp(false) {
+	StandardXGraphSolver(Monitor& mon): XGraphSolver(mon), bedge(nullptr), no_ilp(false), symbolic(true) {
+	}
+
+	/**
+	 */
+	void configure(const PropList& props) override {
+		XGraphSolver::configure(props);
+		symbolic = SYMBOLIC_TIMING(props);
 	}
 
 	/**
@@ -179,6 +196,24 @@ public:
 			return;
 		}
 
+		// symbolic resolution
+		if(symbolic && dumpDir().isEmpty() && events.count() <= MaxPlusGraph::max_events) {
+			MaxPlusGraph mpg(g, events.count());
+			for(int i = 0; i < events.count(); i++) {
+				apply(events[i].event(), insts[i], g);
+				mpg.probe(i);
+				rollback(events[i].event(), insts[i], g);
+			}
+			if(mpg.build()) {
+				computeSymbolic(entity, events, mpg);
+				return;
+			}
+			if(logFor(LOG_BB))
+				log << "\t\t\tno closed form: configurations enumerated\n";
+		}
+		if(events.count() >= 32)
+			throw otawa::Exception(_ << "too many dynamic events (" << events.count() << ")");
+
 		// compute all cases
 		t::uint32 prev = 0;
 		Vector<ConfigSet> confs;
@@ -239,37 +274,106 @@ public:
 			}
 
 			// insert the time
-			if(times.isEmpty()) {
-				ConfigSet *set = new ConfigSet(cost);
-				set->add(Config(event_mask));
-				times.add(set);
+			insert(times, cost, event_mask);
+		}
+
+		// process the times
+		if(!no_ilp)
+			split(entity, events, times);
+	}
+
+	/**
+	 * Compute the times from the symbolic form of the graph.
+	 * @param entity	Computed entity.
+	 * @param events	Dynamic events.
+	 * @param mpg		Built symbolic form.
+	 */
+	void computeSymbolic(const PropList *entity, const Vector<EventCase>& events, const MaxPlusGraph& mpg) {
+		typedef MaxPlusGraph::mask_t smask_t;
+		int n = events.count();
+		smask_t all = n == MaxPlusGraph::max_events ? ~smask_t(0) : (smask_t(1) << n) - 1;
+		if(logFor(LOG_BB))
+			log << "\t\t\tsymbolic form: " << mpg.termCount() << " terms\n";
+
+		// select the enumerated events
+		Vector<int> bits;
+		if(n <= enum_limit)
+			for(int i = 0; i < n; i++)
+				bits.add(i);
+		else {
+			ot::time top = mpg.bound(0, all);
+			AllocArray<ot::time> impact(n);
+			for(int i = 0; i < n; i++) {
+				smask_t b = smask_t(1) << i;
+				impact[i] = top - max(mpg.bound(0, all & ~b), mpg.bound(b, all));
 			}
-			else {
-				bool done = false;
-				List<ConfigSet *>::Iter prev;
-				for(auto cur = times.begin(); cur(); prev = cur, cur++) {
-					if(cur->time() == cost) {
-						cur->add(Config(event_mask));
-						done = true;
-						break;
-					}
-					else if(cur->time() > cost)
-						break;
-				}
-				if(!done) {
-					ConfigSet *set = new ConfigSet(cost);
-					set->add(Config(event_mask));
-					if(!prev)
-						times.addFirst(set);
-					else
-						times.addAfter(prev, set);
-				}
+			smask_t sel = 0;
+			while(bits.length() < enum_limit) {
+				int m = -1;
+				for(int i = 0; i < n; i++)
+					if(!(sel & (smask_t(1) << i)) && (m < 0 || impact[i] > impact[m]))
+						m = i;
+				sel |= smask_t(1) << m;
+				bits.add(m);
 			}
+			if(logFor(LOG_BB))
+				log << "\t\t\t" << (n - enum_limit) << " events left free\n";
+		}
+		Vector<EventCase> enums;
+		smask_t free = all;
+		for(auto b: bits) {
+			enums.add(events[b]);
+			free &= ~(smask_t(1) << b);
+		}
+
+		// evaluate the configurations
+		List<ConfigSet *> times;
+		for(mask_t m = 0; m < mask_t(1 << bits.length()); m++) {
+			smask_t conf = 0;
+			for(int j = 0; j < bits.length(); j++)
+				if(m & (1 << j))
+					conf |= smask_t(1) << bits[j];
+			insert(times, mpg.bound(conf, conf | free), m);
 		}
 
 		// process the times
 		if(!no_ilp)
-			split(entity, all_events, times);
+			split(entity, enums, times);
+	}
+
+	/**
+	 * Insert a configuration time in the list of times sorted by increasing time.
+	 * @param times		List of times.
+	 * @param cost		Time of the configuration.
+	 * @param mask		Configuration.
+	 */
+	void insert(List<ConfigSet *>& times, ot::time cost, mask_t mask) {
+		if(times.isEmpty()) {
+			ConfigSet *set = new ConfigSet(cost);
+			set->add(Config(mask));
+			times.add(set);
+		}
+		else {
+			bool done = false;
+			List<ConfigSet *>::Iter prev;
+			for(auto cur = times.begin(); cur(); prev = cur, cur++) {
+				if(cur->time() == cost) {
+					cur->add(Config(mask));
+					done = true;
+					break;
+				}
+				else if(cur->time() > cost)
+					break;
+			}
+			if(!done) {
+				ConfigSet *set = new ConfigSet(cost);
+				set->add(Config(mask));
+				if(!prev)
+					times.addFirst(set);
+				else
+					times.addAfter(prev, set);
+			}
+		}
 	}
 
 	/**
@@ -627,24 +731,21 @@ public:
 	 * producing a LTS time and an HTS time.
 	 *
 	 * @param entity		Computed entity.
-	 * @param all_events	Event of the sequence.
+	 * @param events		Dynamic events (event i matches bit i of the configurations).
 	 * @param times			Found times.
 	 */
-	void split(const PropList *entity, const Vector<EventCase>& all_events, const List<ConfigSet *>& times) {
+	void split(const PropList *entity, const Vector<EventCase>& events, const List<ConfigSet *>& times) {
 		ASSERT(0 < times.count());
-		displayTimes(times, all_events);
+		displayTimes(times, events);
 
 		// mono-time case
 		if(times.count() == 1) {
-			genForOneCost(times.first()->time(), all_events);
+			genForOneCost(times.first()->time(), events);
 			return;
 		}
 
 		// count dynamic events
-		int dyn_cnt = 0;
-		for(auto e = *all_events; e(); e++)
-			if((*e).event()->occurrence() == SOMETIMES)
-				dyn_cnt++;
+		int dyn_cnt = events.count();
 		ASSERTP(times.count() <= (1 << dyn_cnt), times.count() << " events");
 
 		// put all configurations in a vector
@@ -685,14 +786,14 @@ public:
 			ot::time x_hts = 0;
 
 			// x^c_hts = sum{e in E_i /\ (\E c in HTS /\ e in c) /\ (\E c in HTS /\ e not in c)} w_e
-			for(auto ev = *all_events; ev(); ev++)
-				if((*ev).index() >= 0 && (split.com & (1 << (*ev).index())) != 0)
-					x_hts += (*ev).event()->weight();
+			for(int i = 0; i < events.count(); i++)
+				if((split.com & (1 << i)) != 0)
+					x_hts += events[i].event()->weight();
 
 			// x^p_hts = max{e in E_i /\ (\A c in HTS -> e in c)} w_e
-			for(auto ev = *all_events; ev(); ev++)
-				if((*ev).index() >= 0 && (split.pos & (1 << (*ev).index())) != 0)
-					x_hts = max(x_hts, ot::time((*ev).event()->weight()));
+			for(int i = 0; i < events.count(); i++)
+				if((split.pos & (1 << i)) != 0)
+					x_hts = max(x_hts, ot::time(events[i].event()->weight()));
 			// x_hts = max(x^c_hts, x^p_hts)
 
 			// cost = x_hts t_hts + (x_i - x_hts) t_lts
@@ -726,7 +827,7 @@ public:
 				<< io::endl;
 
 		// contribute
-		contributeSplit(entity, all_events, split);
+		contributeSplit(entity, events, split);
 	}
 
 	/**
@@ -778,11 +879,10 @@ public:
 	 * Contribute to WCET estimation in split way, x_HTS and x_LTS,
 	 * with two sets of times.
 	 * @param e			Evaluated edge.
-	 * @param events	Dynamic event list.
+	 * @param events	Dynamic event list (event i matches bit i of the configurations).
 	 * @param split		Split result.
 	 */
 	void contributeSplit(const PropList *entity, const Vector<EventCase>& events, const Split& split) {
-		Vector<EventCase> exact, imprec;
 
 		// contribute LTS
 		contributeBase(split.lts_time);
@@ -791,16 +891,15 @@ public:
 		contributeTime(split.hts_time);
 
 		// build effects of events
-		for(auto ev = *events; ev(); ev++)
-			if((*ev).event()->occurrence() == SOMETIMES) {
+		for(int i = 0; i < events.count(); i++) {
 
 			// positive contribution
-			if((split.pos & (1 << ev.index())) != 0)
-				contributePositive(*ev, false);
+			if((split.pos & (1 << i)) != 0)
+				contributePositive(events[i], false);
 
 			// else if e in neg_events then C^e_p += x_edge - x_hts / p = prefix if e in prefix, block
-			else if((split.neg & (1 << ev.index())) != 0)
-				contributeNegative(*ev, false);
+			else if((split.neg & (1 << i)) != 0)
+				contributeNegative(events[i], false);
 		}
 
 	}
@@ -826,6 +925,7 @@ public:
 	// TODO so ugly
 	ParExeEdge *bedge;
 	bool no_ilp;
+	bool symbolic;
 };
 
 /**
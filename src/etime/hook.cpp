@@ -325,6 +325,22 @@ p::id<bool> ONLY_START("otawa::etime::ONLY_START");
 p::id<bool> NO_ILP_OBJECTIVE("otawa::etime::NO_ILP_OBJECTIVE");
 
 
+/**
+ * Configuration for EDGE_TIME_FEATURE selecting the symbolic resolution of
+ * execution graphs (see MaxPlusGraph): the graph is analyzed once as max-plus
+ * polynomials of the events and the event configurations are evaluated from
+ * the polynomials instead of analyzing again the graph for each configuration.
+ * If false, or if the graphs are dumped, each configuration is analyzed in turn.
+ * As k events adding latency to a node of latency 1 are over-estimated by k-1
+ * cycles, it is disabled by default. Whatever its value, the symbolic form is
+ * used on edges with 32 events or more: only the 16 events with the biggest
+ * impact are then enumerated and the other ones are bounded.
+ *
+ * @ingroup etime
+ */
+p::id<bool> SYMBOLIC_TIMING("otawa::etime::SYMBOLIC_TIMING", false);
+
+
 ///
 class Plugin: public ProcessorPlugin {
 public:
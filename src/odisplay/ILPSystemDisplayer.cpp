@@ -303,6 +303,8 @@ string ILPSystemDisplayer::nameOf(ilp::Var *var) {
 	string name = names.get(var, "");
 	if(!name) {
 		name = var->name();
+		if(!name)
+			name = var->desc().make();
 		if(!name)
 			name = _ << "_x" << cnt++;
 		names.put(var, name);
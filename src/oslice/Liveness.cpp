@@ -0,0 +1,379 @@
+/*
+ *	Liveness class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#include <otawa/oslice/Liveness.h>
+#include <otawa/oslice/LivenessChecker.h>
+#include <otawa/prog/WorkSpace.h>
+
+namespace otawa { namespace oslice {
+
+/**
+ * @class Liveness
+ * Backward liveness engine shared by LivenessChecker and Slicer.
+ *
+ * The live registers are represented as dense bit vectors and the live memory
+ * as interval sets (dfa::MemorySet). Only one state is kept per block (live
+ * at the end and live at the beginning, joined over all visits): the blocks
+ * are processed from a worklist ordered by post-order of the call-aware CFG
+ * so that, on acyclic parts, a block is processed once all its successors are
+ * stable. The use/def registers and the read/written memories of each
+ * instruction are computed once per block and re-used by the following visits.
+ *
+ * The instruction filtering (for slicing) is customized by overloading
+ * isUseful() and keep().
+ *
+ * @ingroup oslice
+ */
+
+
+/**
+ * Build the liveness engine.
+ * @param ws		Current workspace.
+ * @param coll		Analyzed CFG collection.
+ * @param with_mems	True to track memory liveness (requires LivenessChecker::clpManager).
+ * @param verbose	True to display the processing stages.
+ */
+Liveness::Liveness(WorkSpace *ws, const CFGCollection& coll, bool with_mems, bool verbose)
+:	_rcnt(ws->platform()->regCount()),
+	_mems(with_mems),
+	_verbose(verbose),
+	_ignored(_rcnt),
+	_states(coll.countBlocks()),
+	_rank(coll.countBlocks()),
+	_byRank(coll.countBlocks()),
+	_pending(coll.countBlocks()),
+	_cnt(0)
+{
+	for(int i = 0; i < _states.count(); i++) {
+		_states[i].regs_end = BitVector(_rcnt);
+		_states[i].regs_begin = BitVector(_rcnt);
+	}
+	rank(coll);
+}
+
+
+/**
+ */
+Liveness::~Liveness(void) {
+	for(int i = 0; i < _states.count(); i++)
+		if(_states[i].insts)
+			delete _states[i].insts;
+}
+
+
+/**
+ * Ignore the given register when the usefulness of an instruction is evaluated
+ * (it is still killed and generated as usual).
+ * @param reg	Platform number of the ignored register.
+ */
+void Liveness::ignore(int reg) {
+	if(reg < _rcnt)
+		_ignored.set(reg);
+}
+
+
+/**
+ * Add a starting point to the analysis.
+ * @param v		Starting block.
+ * @param inst	Starting instruction in v (processed backward starting from this
+ * 				instruction included) or null to start at the end of v.
+ * @param regs	Registers live at the starting point.
+ * @param mems	Memory live at the starting point.
+ */
+void Liveness::seed(Block *v, Inst *inst, const BitVector& regs, dfa::MemorySet::t mems) {
+	if(!v->isBasic() || inst == nullptr) {
+		State& s = _states[v->id()];
+		s.regs_end.applyOr(regs);
+		if(_mems)
+			s.mems_end = _ms.join(s.mems_end, mems);
+		put(v);
+	}
+	else {
+		BasicBlock *bb = v->toBasic();
+		Vector<InstInfo>& is = infos(bb);
+		int i = 0;
+		while(is[i].inst != inst)
+			i++;
+		BitVector r = regs;
+		transfer(bb, i, r, mems);
+		propagate(v, r, mems);
+	}
+}
+
+
+/**
+ * Compute the fix point from the current seeds.
+ */
+void Liveness::run(void) {
+	while(!_heap.isEmpty()) {
+		Block *v = get();
+		State& s = _states[v->id()];
+		s.done = true;
+		_cnt++;
+		if(_verbose)
+			elm::cerr << "\tprocessing CFG " << v->cfg()->index() << ", " << v << " with regs = " << s.regs_end << io::endl;
+		BitVector regs = s.regs_end;
+		dfa::MemorySet::t mems = s.mems_end;
+		if(v->isBasic())
+			transfer(v->toBasic(), 0, regs, mems);
+		propagate(v, regs, mems);
+	}
+}
+
+
+/**
+ * Test if an instruction is useful, that is, if it participates to the live state
+ * of its successors. Default implementation returns always true (pure liveness).
+ * @param inst		Tested instruction.
+ * @param regs		Registers live after the instruction.
+ * @param defs		Registers written by the instruction (minus the ignored ones).
+ * @param mems		Memory live after the instruction.
+ * @param writes	Memory written by the instruction.
+ * @return			True if the instruction is useful, false else.
+ */
+bool Liveness::isUseful(Inst *inst, const BitVector& regs, const BitVector& defs, dfa::MemorySet::t mems, dfa::MemorySet::t writes) {
+	return true;
+}
+
+
+/**
+ * Called each time a useful instruction is found.
+ * Default implementation does nothing.
+ * @param bb	Block containing the instruction.
+ * @param inst	Useful instruction.
+ */
+void Liveness::keep(BasicBlock *bb, Inst *inst) {
+}
+
+
+/**
+ * Compute the processing rank of blocks as post-order of a depth-first
+ * traversal where a call block is followed by the entry of its callee.
+ * @param coll	CFG collection.
+ */
+void Liveness::rank(const CFGCollection& coll) {
+	BitVector visited(coll.countBlocks());
+	Vector<Pair<Block *, int> > stack;
+	int r = 0;
+	for(int i = 0; i < coll.count(); i++)
+		for(CFG::BlockIter v = coll[i]->blocks(); v(); v++) {
+			Block *b = *v;
+			if(visited.bit(b->id()))
+				continue;
+			visited.set(b->id());
+			stack.push(pair(b, 0));
+			while(!stack.isEmpty()) {
+				Pair<Block *, int>& top = stack[stack.length() - 1];
+				Block *w = top.fst;
+				int n = top.snd++;
+				Block *s = nullptr;
+				if(w->isSynth() && w->toSynth()->callee()) {
+					if(n == 0)
+						s = w->toSynth()->callee()->entry();
+					n--;
+				}
+				if(s == nullptr)
+					for(auto e: w->outEdges()) {
+						if(n == 0) {
+							s = e->sink();
+							break;
+						}
+						n--;
+					}
+				if(s == nullptr) {
+					_rank[w->id()] = r;
+					_byRank[r] = w;
+					r++;
+					stack.pop();
+				}
+				else if(!visited.bit(s->id())) {
+					visited.set(s->id());
+					stack.push(pair(s, 0));
+				}
+			}
+		}
+}
+
+
+/**
+ * Get the instruction information of a block, in reverse order.
+ * @param bb	Looked block.
+ * @return		Instruction information.
+ */
+Vector<Liveness::InstInfo>& Liveness::infos(BasicBlock *bb) {
+	State& s = _states[bb->id()];
+	if(!s.insts) {
+		s.insts = new Vector<InstInfo>(bb->count());
+		if(_mems)
+			LivenessChecker::identifyAddrs(bb);
+		int ri = 0, wi = 0;
+		for(Inst *i = bb->last(); ; i = i->prevInst()) {
+			InstInfo info;
+			info.inst = i;
+			info.uses = BitVector(_rcnt);
+			info.defs = BitVector(_rcnt);
+			LivenessChecker::provideRegisters(i, info.uses, 0);
+			LivenessChecker::provideRegisters(i, info.defs, 1);
+			info.idefs = info.defs;
+			info.idefs.applyReset(_ignored);
+			if(_mems) {
+				LivenessChecker::getMems(bb, i, ri, info.reads, 0);
+				LivenessChecker::getMems(bb, i, wi, info.writes, 1);
+			}
+			s.insts->add(info);
+			if(i == bb->first())
+				break;
+		}
+	}
+	return *s.insts;
+}
+
+
+/**
+ * Apply the backward transfer function of a block.
+ * @param bb	Processed block.
+ * @param i		Index (in reverse order) of the first processed instruction.
+ * @param regs	Live registers (in: after, out: before).
+ * @param mems	Live memory (in: after, out: before).
+ */
+void Liveness::transfer(BasicBlock *bb, int i, BitVector& regs, dfa::MemorySet::t& mems) {
+	Vector<InstInfo>& is = infos(bb);
+	for(; i < is.length(); i++) {
+		InstInfo& info = is[i];
+		if(isUseful(info.inst, regs, info.idefs, mems, info.writes)) {
+			regs.applyReset(info.defs);
+			regs.applyOr(info.uses);
+			if(_mems)
+				LivenessChecker::updateAddrsFromInstruction(mems, info.reads, info.writes, 0);
+			keep(bb, info.inst);
+		}
+	}
+}
+
+
+/**
+ * Record the state at the beginning of a block and propagate it
+ * to the predecessors.
+ * @param v		Current block.
+ * @param regs	Registers live at the beginning of v.
+ * @param mems	Memory live at the beginning of v.
+ */
+void Liveness::propagate(Block *v, const BitVector& regs, dfa::MemorySet::t mems) {
+	State& s = _states[v->id()];
+	s.regs_begin.applyOr(regs);
+	if(_mems)
+		s.mems_begin = _ms.join(s.mems_begin, mems);
+
+	_preds.clear();
+	predecessors(v, _preds);
+	for(auto w: _preds) {
+		State& ws = _states[w->id()];
+		bool changed = !ws.done;
+		if(!ws.regs_end.includes(regs)) {
+			ws.regs_end.applyOr(regs);
+			changed = true;
+		}
+		if(_mems && !LivenessChecker::containsAllAddrs(ws.mems_end, mems)) {
+			ws.mems_end = _ms.join(ws.mems_end, mems);
+			changed = true;
+		}
+		if(changed)
+			put(w);
+	}
+}
+
+
+/**
+ * Collect the predecessors of a block, crossing calls: the predecessors
+ * of an entry are the predecessors of its callers and the predecessor
+ * of a return from a call is the exit of the callee.
+ * @param v		Current block.
+ * @param preds	Filled with the predecessors.
+ */
+void Liveness::predecessors(Block *v, Vector<Block *>& preds) {
+	if(v->isEntry()) {
+		for(auto caller: v->cfg()->callers())
+			for(auto e: caller->inEdges())
+				preds.add(e->source());
+		return;
+	}
+	for(auto e: v->inEdges()) {
+		Block *w = e->source();
+		if(w->isSynth()) {
+			if(w->toSynth()->callee())
+				preds.add(w->toSynth()->callee()->exit());
+		}
+		else
+			preds.add(w);
+	}
+}
+
+
+/**
+ * Put a block in the worklist (if not already present).
+ * @param v		Block to put.
+ */
+void Liveness::put(Block *v) {
+	if(_pending.bit(v->id()))
+		return;
+	_pending.set(v->id());
+	int r = _rank[v->id()];
+	int i = _heap.length();
+	_heap.add(r);
+	while(i > 0) {
+		int p = (i - 1) / 2;
+		if(_heap[p] <= r)
+			break;
+		_heap[i] = _heap[p];
+		i = p;
+	}
+	_heap[i] = r;
+}
+
+
+/**
+ * Get the block of lowest rank from the worklist.
+ * @return	Next block to process.
+ */
+Block *Liveness::get(void) {
+	int r = _heap[0];
+	int x = _heap.pop();
+	int n = _heap.length();
+	if(n != 0) {
+		int i = 0;
+		while(true) {
+			int c = 2 * i + 1;
+			if(c >= n)
+				break;
+			if(c + 1 < n && _heap[c + 1] < _heap[c])
+				c++;
+			if(x <= _heap[c])
+				break;
+			_heap[i] = _heap[c];
+			i = c;
+		}
+		_heap[i] = x;
+	}
+	Block *v = _byRank[r];
+	_pending.clear(v->id());
+	return v;
+}
+
+} }	// otawa::oslice
@@ -18,6 +18,7 @@
  *	along with OTAWA; if not, write to the Free Software
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
+#include <otawa/oslice/Liveness.h>
 #include <otawa/oslice/LivenessChecker.h>
 #include <otawa/util/Bag.h>
 #include <elm/util/Pair.h>
@@ -72,6 +73,23 @@ void LivenessChecker::configure(const PropList &props) {
  * @ingroup oslice
  */
 
+/**
+ * Liveness engine of the checker: usefulness of instructions is delegated
+ * to LivenessChecker::interestingRegs() and LivenessChecker::interestingAddrs().
+ */
+class LivenessChecker::Engine: public Liveness {
+public:
+	Engine(LivenessChecker& checker, const CFGCollection& coll)
+		: Liveness(checker.workspace(), coll, true, _debugLevel & DISPLAY_LIVENESS_STAGES), _checker(checker) { }
+protected:
+	bool isUseful(Inst *inst, const BitVector& regs, const BitVector& defs, dfa::MemorySet::t mems, dfa::MemorySet::t writes) override {
+		return _checker.interestingAddrs(mems, writes) | _checker.interestingRegs(regs, defs);
+	}
+private:
+	LivenessChecker& _checker;
+};
+
+
 /**
  * Processing the workspace.
  * @param fw		Current workspace.
@@ -80,96 +98,27 @@ void LivenessChecker::processWorkSpace(WorkSpace *fw) {
 	_defaultRegisters = BitVector(workspace()->platform()->regCount(), false);
 	const CFGCollection& coll = **otawa::INVOLVED_CFGS(workspace());
 
-	// the main CFG
-	CFG *cfg = coll[0];
-	// now lets find the program exit block
-	Block* programExit = cfg->exit();
-
-#ifdef ORIG
-	// we have a list of blocks which will go to the end of the program ?
-	interested_instructions_t *interestedInstructions = new interested_instructions_t();
-	for (Block::EdgeIter edge = programExit->ins(); edge; edge++) {
-		if(!edge->source()->isBasic())
-			continue;
-		InterestedInstruction* interestedInstruction = new InterestedInstruction(edge->source()->toBasic()->last(), edge->source()->toBasic());
-		interestedInstructions->add(interestedInstruction);
-	}
-	// DBG: list a list of BBs
-	if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-		for(interested_instructions_t::Iterator iter(*interestedInstructions); iter; ++iter)
-			elm::cerr << __SOURCE_INFO__ << "Block to start: BB " << iter->getBB()->index() << " @ " << iter->getBB()->address() << ", ends with instruction " << iter->getInst() << " @ " << iter->getBB()->address() << io::endl;
-#endif
-
 	// we need to get the CLP information in order to do address access
 	clpManager = new clp::Manager(workspace());
 
-#ifdef ORIG
-	buildReverseSynthLink(coll);
-	initIdentifiersForEachBB(coll);
-	if (interestedInstructions) {
-		if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-			elm::cerr << __SOURCE_INFO__<< "The list of interested instructions: " << io::endl;
-
-		// now we look into each of these instructions
-		for(interested_instructions_t::Iterator currentII(*interestedInstructions); currentII; currentII++) {
-			if(_debugLevel & DISPLAY_LIVENESS_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << "    " << currentII->getInst() << " @ " << currentII->getInst()->address() << " from BB " << currentII->getBB()->index() << io::endl;
-				elm::cerr << __SOURCE_INFO__ << "Popping interested instruction " << currentII->getInst() << " @ " << currentII->getInst()->address() << io::endl;
-			}
-			Inst* currentInst = currentII->getInst();
-			BasicBlock* currentBB = currentII->getBB();
-
-			elm::BitVector workingRegs(workspace()->platform()->regCount(), false);
-			provideRegisters(currentInst, workingRegs, 0);
+	// at the end of the program, no register and no memory address is used
+	Engine engine(*this, coll);
+	engine.seed(coll[0]->exit(), nullptr, BitVector(workspace()->platform()->regCount(), false), dfa::MemorySet::empty);
+	engine.run();
+	if(logFor(LOG_FUN))
+		log << "\t" << engine.processedCount() << " block visits\n";
 
-			// obtain the working register
-			if(_debugLevel & DISPLAY_LIVENESS_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << "Creating the initial Regs from " << currentInst << " @ " << currentInst->address() << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Working regs = " << workingRegs << io::endl;
-			}
-
-			// obtain the working memory
-			// first identify all the access of the address of the current BB
-			identifyAddrs(currentBB);
-			// then find out if the instruction access the memory
-			//clp_value_set_t workingMems;
-			dfa::MemorySet::t workingMems(0);
-			int currentReadMemIndex = 0;
-			LivenessChecker::getMems(currentBB, currentInst, currentReadMemIndex, workingMems, 0);
-
-			// workingMem is going to be different for each working element, therefore we allocate the memory
-			if(_debugLevel & DISPLAY_LIVENESS_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Working mems = "; displayAddrs(elm::cerr, workingMems); elm::cerr << io::endl;
+	// record the results
+	initIdentifiersForEachBB(coll);
+	for(auto g: coll)
+		for(CFG::BlockIter v = g->blocks(); v(); v++)
+			if(v->isBasic()) {
+				REG_BB_END_IN(*v) = engine.regsAtEnd(*v);
+				REG_BB_BEGIN_OUT(*v) = engine.regsAtBegin(*v);
+				*MEM_BB_END_IN(*v) = engine.memsAtEnd(*v);
+				*MEM_BB_BEGIN_OUT(*v) = engine.memsAtBegin(*v);
 			}
 
-			// define the working list of BB
-			Vector<WorkingElement*> workingList;
-
-			// first we put the current BB in to the list
-			workingList.add(new WorkingElement(currentBB, currentInst, workingRegs, workingMems));
-
-			// process the working list
-			processWorkingList(workingList);
-		}
-	} // end if (interestedInstructions)
-
-	// finished using interestedInstructions, free it
-	for(interested_instructions_t::Iterator iter(*interestedInstructions); iter; ++iter)
-		delete (*iter);
-	interestedInstructions->clear();
-	delete interestedInstructions;
-#else
-	// get the working register
-	elm::BitVector workingRegs(workspace()->platform()->regCount(), false);
-	// at the end of the program, no memory address will be used
-	dfa::MemorySet::t workingMems(0);
-	// define the working list of BB
-	Vector<WorkingElement*> workingList;
-	// the first element of the list is the exit block
-	workingList.add(new WorkingElement(programExit, 0, workingRegs, workingMems));
-	// process the working list
-	processWorkingList(workingList);
-#endif
 	// end of using manager
 	delete clpManager;
 } // processWorkSpace
@@ -202,201 +151,6 @@ void LivenessChecker::provideRegisters(Inst* inst, elm::BitVector& regsToModify,
 		regsToModify.set(currReg->platformNumber());
 }
 
-void LivenessChecker::processWorkingList(Vector<WorkingElement*>& workingList) {
-	// while the list is not empty
-	while(workingList.count())
-	{
-		// pop the first element to process
-		WorkingElement* we = workingList.pop();
-		Block* currentBB_wl = we->_bb;
-		elm::BitVector currentRegs_wl = we->_workingRegs;
-		dfa::MemorySet::t currentMems_wl(we->_workingMems); // load the memory access set
-		Inst* currentInst_wl = we->_inst;
-		if(_debugLevel & DISPLAY_LIVENESS_STAGES) {
-			elm::cerr << __SOURCE_INFO__ << __RED__ << "Popping new working element out: CFG " << currentBB_wl->cfg()->index() << ", " <<  currentBB_wl << __RESET__ << io::endl;
-			elm::cerr << __SOURCE_INFO__ << __TAB__ << "with working Regs  = " << currentRegs_wl << io::endl;
-			elm::cerr << __SOURCE_INFO__ << __TAB__ << "with working MEM   = "; displayAddrs(elm::cerr, currentMems_wl); elm::cerr << io::endl;
-		}
-		delete we;
-
-		int currentReadMemIndex = 0;
-		int currentWriteMemIndex = 0;
-		bool reachFirstInstCurrentBB_wl = true;
-
-		if(currentBB_wl->isBasic()) {
-			reachFirstInstCurrentBB_wl = false;
-			// here we fill the memory access information for each instruction
-			identifyAddrs(currentBB_wl->toBasic());
-		}
-
-		while(!reachFirstInstCurrentBB_wl) // only comes in when the block fetched in is a Basic Block with instructions
-		{
-			if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-				elm::cerr << __SOURCE_INFO__ << __CYAN__ << "Processing " << currentInst_wl << " @ " << currentInst_wl->address() << __RESET__ << io::endl;
-			elm::BitVector currentRegsDef(workspace()->platform()->regCount(), false);
-			elm::BitVector currentRegsUse(workspace()->platform()->regCount(), false);
-			provideRegisters(currentInst_wl, currentRegsUse, 0);
-			provideRegisters(currentInst_wl, currentRegsDef, 1);
-
-			// for memory access
-			dfa::MemorySet::t addressInstRead(0), addressInstWrite(0);
-			LivenessChecker::getMems(currentBB_wl->toBasic(), currentInst_wl, currentReadMemIndex, addressInstRead, 0);
-			LivenessChecker::getMems(currentBB_wl->toBasic(), currentInst_wl, currentWriteMemIndex, addressInstWrite, 1);
-
-			if(_debugLevel & DISPLAY_LIVENESS_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Reg Def       = " << currentRegsDef << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Reg Use       = " << currentRegsUse << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Mem Def       = "; displayAddrs(elm::cerr, addressInstWrite); elm::cerr << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Mem Use       = "; displayAddrs(elm::cerr, addressInstRead); elm::cerr << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "RegSet Before = " << currentRegs_wl << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "MemSet Before = "; displayAddrs(elm::cerr, currentMems_wl); elm::cerr << io::endl;
-			}
-
-			// check if the def address is over lap with the working addrs
-			bool memInterested = interestingAddrs(currentMems_wl, addressInstWrite);
-
-			// if working Regs & def Regs is not zero, that means this instruction provides
-			// the registers that we are interested
-			bool regInsterested = interestingRegs(currentRegs_wl, currentRegsDef); // !(currentRegs_wl & currentRegsDef).isEmpty();
-
-			if(memInterested | regInsterested) {
-				// update the working Regs
-				currentRegs_wl = (currentRegs_wl - currentRegsDef) | currentRegsUse;
-				// update the current working memory
-				updateAddrsFromInstruction(currentMems_wl, addressInstRead, addressInstWrite, _debugLevel);
-			}
-
-			if(_debugLevel & DISPLAY_LIVENESS_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "RegSet After  = " << currentRegs_wl << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "MemSet After  = "; displayAddrs(elm::cerr, currentMems_wl); elm::cerr << io::endl;
-			}
-
-			if(currentInst_wl == currentBB_wl->toBasic()->first())
-				reachFirstInstCurrentBB_wl = true;
-			else
-				currentInst_wl = currentInst_wl->prevInst();
-		} // reaches the beginning of the BB
-
-		// merge current working state with the previous state at the beginning of the BB
-		elm::BitVector t1 = REG_BB_BEGIN_OUT(currentBB_wl);
-		if(!t1.size()) // if t1 is empty that means there is no info about the register
-			REG_BB_BEGIN_OUT(currentBB_wl) = currentRegs_wl;
-		else
-			REG_BB_BEGIN_OUT(currentBB_wl) = t1 | currentRegs_wl;
-
-		dfa::MemorySet::t *temp = MEM_BB_BEGIN_OUT(currentBB_wl);
-		if(!temp) {
-			temp = new dfa::MemorySet::t(0);
-			MEM_BB_BEGIN_OUT(currentBB_wl) = temp;
-		}
-		*temp = dfa::MemorySet().join(*temp, currentMems_wl);
-
-		// here reaches the beginning of the BB, now we need to list the list of incoming edges
-		// so we can keep trace back the previous BB
-		// first we find the predecessors of the BB to process
-		Vector<Block *> predecessors;
-
-		for (Block::EdgeIter e = currentBB_wl->ins(); e(); e++) {
-			Block* b = e->source(); // find the source of the edge, the predecessor of current BB
-			if (b->isEntry()) {
-				// then get the set of the callers
-				for(auto caller: b->cfg()->callers()) {
-					if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-						elm::cerr << __SOURCE_INFO__ << "Found a caller @ CFG " << caller->cfg()->index() << ", BB " << caller->index() << io::endl;
-
-					for(Block::EdgeIter bei = caller->ins(); bei(); bei++) {
-						if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-							elm::cerr << __SOURCE_INFO__ << __TAB__ << __GREEN__ << "Adding the block @ CFG " << bei->source()->cfg()->index() << ", " << bei->source() << __RESET__ << io::endl;
-						predecessors.add(bei->source());
-					}
-				}
-			} // end of handling the entry block
-			else if (b->isBasic()) {
-				// we put the BB here into the working list with given
-				if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-					elm::cerr << __SOURCE_INFO__ << "Found predecessor BB @ " << b->toBasic()->address() << io::endl;
-				predecessors.add(b->toBasic());
-			} // end of handling the basic block
-			else if (b->isSynth()) {
-				// this means that we reach current BB from the returning of a function
-				// we obtain the exit block of the function that it returns from
-
-				if(_debugLevel & DISPLAY_LIVENESS_STAGES) {
-					elm::cerr << __SOURCE_INFO__ << "Found a Synth block with the callee to " << b->toSynth()->callee()->label() << io::endl;
-				}
-
-				// find the BB which is the last block before the exit block of the callee
-				if(!b->toSynth()->callee())
-					continue;
-				Block* end = b->toSynth()->callee()->exit();
-				// each edge to the exit block is a possible BB which will goes to the current block
-				for (Block::EdgeIter EdgeToExit = end->ins(); EdgeToExit(); EdgeToExit++) {
-					Block* BB_BeforeReturn = EdgeToExit->source();
-					if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-						elm::cerr << __SOURCE_INFO__ << __GREEN__ << "Adding block CFG " << BB_BeforeReturn->cfg()->index() << ", " << BB_BeforeReturn << __RESET__ << io::endl;
-					predecessors.add(BB_BeforeReturn);
-				}
-
-			} // end of handling the synth block
-			else {
-				if (b->isEntry())
-					elm::cerr << "ENTRY" << io::endl;
-				else if (b->isExit())
-					elm::cerr << "EXIT" << io::endl;
-				else if (b->isUnknown())
-					elm::cerr << "unknown" << io::endl;
-				ASSERTP(false, "Encounter an unexpected block");
-			}
-		} // end of finding predecessors of the current BB
-
-		if(predecessors.count() == 0)
-			if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-				elm::cerr << __SOURCE_INFO__ << __RED__ << "No predecessor for BB @ " << currentBB_wl->address() << __RESET__ << io::endl;
-
-		// process the collected BBs
-		// now we need to see if the input (register and memory uses) feed from the successor matches totally or a subset of the pred BB
-		for(Vector<Block *>::Iter predecessor(predecessors); predecessor(); ++predecessor) {
-			BitVector bv = REG_BB_END_IN(*predecessor);
-			if(!bv.size()) {
-				bv = BitVector(workspace()->platform()->regCount(), false);
-				REG_BB_END_IN(*predecessor) = bv;
-			}
-			dfa::MemorySet::t* memIn = MEM_BB_END_IN(*predecessor);
-			if(!memIn) {
-				memIn = new dfa::MemorySet::t(0);
-				MEM_BB_END_IN(*predecessor) = memIn;
-			}
-
-			bool notContainsAllRegs = !bv.includes(currentRegs_wl);
-			bool notContainsAllMems = !containsAllAddrs(*memIn, currentMems_wl);
-
-			if(_debugLevel & DISPLAY_LIVENESS_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "for BB @ " << predecessor->address() << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << __TAB__ << "Register used: " << bv << " contains all of " << currentRegs_wl << " ? "<< !notContainsAllRegs << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << __TAB__ << "Mem      used: "; displayAddrs(elm::cerr, *memIn); elm::cerr << " contains all of "; displayAddrs(elm::cerr, currentMems_wl); elm::cerr << "? " << !notContainsAllMems << io::endl;
-			}
-
-			if(notContainsAllRegs | notContainsAllMems | !currentBB_wl->isBasic()) {
-				if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-					elm::cerr << __SOURCE_INFO__ << __GREEN__ << "Adding BB @ CFG " << predecessor->cfg()->index() << ", " << *predecessor << " to the working list." << __RESET__ << io::endl;
-				bv = bv | currentRegs_wl;
-				REG_BB_END_IN(*predecessor) = bv;
-				//memIn->addAll(currentMems_wl);
-				*memIn = dfa::MemorySet().join(*memIn, currentMems_wl);
-				MEM_BB_END_IN(*predecessor) = memIn;
-				Inst* lastInstruction = 0;
-				if(predecessor->isBasic())
-					lastInstruction = predecessor->toBasic()->last();
-				WorkingElement *we = new WorkingElement(*predecessor, lastInstruction, currentRegs_wl, currentMems_wl);
-				workingList.add(we);
-			}
-			else
-				if(_debugLevel & DISPLAY_LIVENESS_STAGES)
-					elm::cerr << __SOURCE_INFO__ << __RED__ << "NOT adding BB @ " << predecessor->address() << " to the working list." << __RESET__ << io::endl;
-		}
-	} // end of the current working list
-}
-
 void LivenessChecker::clearAddrs(BasicBlock* bb) {
 }
 
@@ -20,23 +20,13 @@
  */
 #include <elm/sys/System.h>
 
+#include <otawa/oslice/Liveness.h>
 #include <otawa/oslice/Slicer.h>
 #include <otawa/program.h>
 #include "../../include/otawa/display/CFGDecorator.h"
 
 namespace otawa { namespace oslice {
 
-
-static Identifier<otawa::dfa::MemorySet::t* > SLICER_MEM_BB_END("otawa::oslice::SLICER_MEM_BB_END", 0);
-static Identifier<BitVector> SLICER_REG_BB_END("otawa::oslice::SLICER_REG_BB_END");
-
-static Identifier<bool> TO_REMOVE("", false);
-typedef Pair<Block*, t::uint32> predecessor_t;
-typedef Vector<predecessor_t> predecessor_list_t;
-static Identifier<Vector<Pair<Block*, t::uint32 /* flag of the edge */ > >*> ARTIFICIAL_PREDECESSORS("");
-static Identifier<Vector<Block*>*> ARTIFICIAL_SUCCESSORS("");
-
-
 p::declare Slicer::reg = p::init("otawa::oslice::Slicer", Version(16, 5, 3116))
        .maker<Slicer>()
 	   .use(otawa::clp::CLP_ANALYSIS_FEATURE)
@@ -156,6 +146,42 @@ private:
 #endif
 
 
+/*
+ * Liveness engine of the slicer: an instruction is kept if it defines
+ * a live register or a live memory area (any store for light slicing).
+ */
+class Slicer::Engine: public Liveness {
+public:
+	Engine(Slicer& slicer, const CFGCollection& coll)
+	:	Liveness(slicer.workspace(), coll, !slicer._lightSlicing, slicer._debugLevel & DISPLAY_SLICING_STAGES),
+		_light(slicer._lightSlicing)
+	{
+		// ignore PC and LR (ARM)
+		ignore(15);
+		ignore(14);
+	}
+
+protected:
+	bool isUseful(Inst *inst, const BitVector& regs, const BitVector& defs, dfa::MemorySet::t mems, dfa::MemorySet::t writes) override {
+		if(regs.meets(defs))
+			return true;
+		if(_light)
+			return inst->isStore();
+		for(dfa::MemorySet::Iter a = writes.areas(); a(); a++)
+			if(dfa::MemorySet::meets(mems, *a))
+				return true;
+		return false;
+	}
+
+	void keep(BasicBlock *bb, Inst *inst) override {
+		SET_OF_REMAINED_INSTRUCTIONS(bb)->add(inst);
+	}
+
+private:
+	bool _light;
+};
+
+
 /**
  */
 Slicer::Slicer(AbstractRegistration& _reg)
@@ -234,6 +260,7 @@ void Slicer::processWorkSpace(WorkSpace *fw) {
 		}
 
 		// now we look into each of these instructions
+		Engine engine(*this, coll);
 		for(interested_instructions_t::Iter currentII(*interestedInstructions); currentII(); currentII++) {
 			if(_debugLevel & DISPLAY_SLICING_STAGES) {
 				elm::cerr << __SOURCE_INFO__ << "Popping interested instruction " << currentII->getInst() << " @ " << currentII->getInst()->address() << io::endl;
@@ -263,12 +290,13 @@ void Slicer::processWorkSpace(WorkSpace *fw) {
 				}
 			}
 
-			// define the working list of BB
-			elm::Vector<WorkingElement*> workingList;
-			// first we put the current BB in to the list
-			workingList.add(new WorkingElement(currentBB, currentInst, workingRegs, workingMems));
-			processWorkingList(workingList);
+			engine.seed(currentBB, currentInst, workingRegs, workingMems);
 		}
+
+		// all seeds are propagated together
+		engine.run();
+		if(logFor(LOG_FUN))
+			log << "\t" << engine.processedCount() << " block visits\n";
 	}
 
 	// now try to dump the CFG here
@@ -358,15 +386,60 @@ void Slicer::processWorkSpace(WorkSpace *fw) {
 
 } // end of function Slicer::work
 
+typedef Vector<Pair<Block *, t::uint32> > targets_t;
+
+/*
+ * Add a target to the edges of a sliced block, merging the flags
+ * if the target is already present.
+ */
+static void addTarget(targets_t& targets, Block *b, t::uint32 flags) {
+	for(int i = 0; i < targets.length(); i++)
+		if(targets[i].fst == b) {
+			targets[i].snd |= flags;
+			return;
+		}
+	targets.add(pair(b, flags));
+}
+
+/*
+ * Collect the kept blocks reachable from the removed block b only through
+ * removed blocks. The created edges get the flags of the edge entering b.
+ */
+static void bypass(Block *b, t::uint32 flags, const BitVector& removed, BitVector& seen, Vector<Block *>& todo, targets_t& targets) {
+	Vector<Block *> visited;
+	seen.set(b->index());
+	visited.add(b);
+	todo.push(b);
+	while(!todo.isEmpty()) {
+		Block *w = todo.pop();
+		// only one out-going edge to itself (infinite loop waiting for interrupts): link it with the exit
+		if(w->countOuts() == 1 && w->outs()->sink() == w)
+			addTarget(targets, w->cfg()->exit(), flags);
+		for(auto e: w->outEdges()) {
+			Block *s = e->sink();
+			if(!removed.bit(s->index()))
+				addTarget(targets, s, flags);
+			else if(!seen.bit(s->index())) {
+				seen.set(s->index());
+				visited.add(s);
+				todo.push(s);
+			}
+		}
+	}
+	for(auto w: visited)
+		seen.clear(w->index());
+}
+
 /**
- * Build the virtual CFG.
- * @param cfg          CFG to inline into.
+ * Build the sliced CFG. The blocks whose instructions are all sliced away
+ * are removed and their predecessors are directly linked to their successors.
+ * @param cfg		Original CFG.
+ * @param maker		Maker of the sliced CFG.
  */
 void Slicer::make(CFG *cfg, CFGMaker& maker) {
 	ASSERT(cfg);
 	HashMap<Block *, Block *> bmap;
-	Vector<Block*> workingList;
-	Vector<Block*> blocksToRemove;
+	BitVector removed(cfg->count());
 
 	// add initial blocks
 	bmap.put(cfg->entry(), maker.entry());
@@ -380,13 +453,18 @@ void Slicer::make(CFG *cfg, CFGMaker& maker) {
 			  continue;
 		 else if(v->isBasic()) {
 			  BasicBlock *bb = v->toBasic();
-			  if(TO_REMOVE(bb))
+			  InstSet* setInst = SET_OF_REMAINED_INSTRUCTIONS(bb);
+
+			  // all instructions are sliced: remove the block
+			  if(setInst->count() == 0) {
+				  if(_debugLevel & DISPLAY_CFG_CREATION)
+					  elm::cerr << __SOURCE_INFO__<< "all instructions are sliced in BB" << bb->index() << " @ " << bb->address() << io::endl;
+				  removed.set(bb->index());
 				  continue;
+			  }
 
-			  InstSet* setInst = SET_OF_REMAINED_INSTRUCTIONS(bb);
-			  Vector<Inst *> insts(setInst->count());
-			  
 			  // only add the non-sliced instruction to the vector insts
+			  Vector<Inst *> insts(setInst->count());
 			  for(BasicBlock::InstIter i = bb->insts(); i(); i++) {
 				   if(setInst->contains(*i))
 					    insts.add(*i);
@@ -413,81 +491,25 @@ void Slicer::make(CFG *cfg, CFGMaker& maker) {
 		 }
 	}
 
-	// add edges
+	// add edges, bypassing the removed blocks
+	BitVector seen(cfg->count());
+	Vector<Block *> todo;
+	targets_t targets;
 	for(CFG::BlockIter v = cfg->blocks(); v(); v++) {
-		if (_debugLevel & DISPLAY_CFG_CREATION)
-			elm::cerr << __SOURCE_INFO__<< "looking at the BB " << v->index() << " of CFG " << cfg->index() << io::endl;
-
-		if(TO_REMOVE(*v))
-		{
-			if(_debugLevel & DISPLAY_CFG_CREATION)
-			elm::cerr << __SOURCE_INFO__ << __TAB__ << "this node is removed, ignored" << io::endl;
-			TO_REMOVE(*v).remove();
-			Vector<Block* > *edgeTargets = ARTIFICIAL_SUCCESSORS(*v);
-			if(edgeTargets)
-			delete edgeTargets;
-			ARTIFICIAL_SUCCESSORS(*v).remove();
-			predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(*v);
-			if(edgeSources)
-			delete edgeSources;
-			ARTIFICIAL_PREDECESSORS(*v).remove();
+		if(removed.bit(v->index()))
 			continue;
+		targets.clear();
+		for(auto e: v->outEdges()) {
+			if(!removed.bit(e->sink()->index()))
+				targets.add(pair(e->sink(), t::uint32(e->flags())));
+			else
+				bypass(e->sink(), e->flags(), removed, seen, todo, targets);
 		}
-
-		for(BasicBlock::EdgeIter e = v->outs(); e(); e++) {
+		for(int i = 0; i < targets.length(); i++) {
 			if(_debugLevel & DISPLAY_CFG_CREATION)
-			elm::cerr << __SOURCE_INFO__ << __TAB__ << e->source()->index() << " to " << e->sink()->index() << io::endl;
-			if(TO_REMOVE(*e)) {
-				if(_debugLevel & DISPLAY_CFG_CREATION)
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << __TAB__ << "this edge is removed, ignored" << io::endl;
-				TO_REMOVE(*v).remove();
-				continue;
-			}
-			Block* source = bmap.get(e->source());
-			Block* target = bmap.get(e->sink());
-			maker.add(source, target, new Edge(e->flags()));
-		} // end for(BasicBlock::EdgeIter e = v->outs(); e; e++) {
-
-		 // linking the artificial edge
-		predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(*v);
-		if(edgeSources) { // for each edge
-			for(predecessor_list_t::Iter plti(*edgeSources); plti(); plti++) {
-				if(_debugLevel & DISPLAY_CFG_CREATION) {
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << "In CFG " << v->cfg() << ", " << (*plti).fst->index() << " to " << v->index() << io::endl;
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << __TAB__ << "this edge is created due to BB removal" << io::endl;
-				}
-				Block* source = bmap.get((*plti).fst);
-				Block* target = bmap.get(*v);
-				maker.add(source, target, new Edge((*plti).snd));
-			}
-			delete edgeSources;
+				elm::cerr << __SOURCE_INFO__ << __TAB__ << "In CFG " << cfg->index() << ", " << v->index() << " to " << targets[i].fst->index() << io::endl;
+			maker.add(bmap.get(*v), bmap.get(targets[i].fst), new Edge(targets[i].snd));
 		}
-		ARTIFICIAL_PREDECESSORS(*v).remove();
-		Vector<Block* > *edgeTargets = ARTIFICIAL_SUCCESSORS(*v);
-		if(edgeTargets)
-			delete edgeTargets;
-		ARTIFICIAL_SUCCESSORS(*v).remove();
-
-		// removed because for artificial edges we use incoming edges instead of the out-going ones.
-		/*
-		Vector<Block* > *edgeTargets = ARTIFICIAL_SUCCESSORS(*v);
-		if(edgeTargets) {
-			for(Vector<Block* >::Iterator i(*edgeTargets); i; i++) {
-				if(_debugLevel & DISPLAY_CFG_CREATION) {
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << v->index() << " to " << i->index() << io::endl;
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << __TAB__ << "this edge is created due to BB removal" << io::endl;
-				}
-				maker.add(bmap.get(*v), bmap.get(*i), new Edge());
-			}
-			delete edgeTargets;
-		}
-		ARTIFICIAL_SUCCESSORS(*v).remove();
-		predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(*v);
-		if(edgeSources)
-			delete edgeSources;
-		ARTIFICIAL_PREDECESSORS(*v).remove();
-		*/
-		continue;
 	}
 }
 
@@ -561,467 +583,16 @@ void Slicer::initIdentifiersForEachBB(const CFGCollection& coll) {
 			if(!v->isBasic())
 				continue;
 			SET_OF_REMAINED_INSTRUCTIONS(*v) = new InstSet();
-			SLICER_REG_BB_END(*v) = BitVector(workspace()->platform()->regCount(), false);
-			SLICER_MEM_BB_END(*v) = new otawa::dfa::MemorySet::t(0);
 		} // end for (CFG::BlockIter v = cfg->blocks(); v; v++) {
 	} // end for (int i = 0; i < coll.count(); i++) {
 }
 
-void Slicer::processWorkingList(elm::Vector<WorkingElement*>& workingList) {
-	// while the list is not empty
-	while(workingList.count())
-	{
-		// pop the first element to process
-		WorkingElement* we = workingList.pop();
-		Block* currentBB_wl = we->_bb;
-		elm::BitVector currentRegs_wl = we->_workingRegs;
-		// load the memory access set
-		otawa::dfa::MemorySet::t currentMems_wl(we->_workingMems);
-		Inst* currentInst_wl = we->_inst;
-
-		if(_debugLevel & DISPLAY_SLICING_STAGES) {
-			elm::cerr << __SOURCE_INFO__ << __RED__ << "Popping new working element out: BB " << currentBB_wl->index() << " @ " <<  currentBB_wl->address() << __RESET__ << io::endl;
-			elm::cerr << __SOURCE_INFO__ << __TAB__ << "Starting witt " << currentInst_wl << " @ " << currentInst_wl->address() << io::endl;
-			elm::cerr << __SOURCE_INFO__ << __TAB__ << "with working Regs  = " << currentRegs_wl << io::endl;
-			if(!_lightSlicing) {
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "with working MEM   = ";
-				otawa::oslice::displayAddrs(elm::cerr, currentMems_wl);
-				elm::cerr << io::endl;
-			}
-		}
-		delete we;
-
-		int currentReadMemIndex = 0;
-		int currentWriteMemIndex = 0;
-		bool reachFirstInstCurrentBB_wl = true;
-
-		if(currentBB_wl->isBasic()) {
-			reachFirstInstCurrentBB_wl = false;
-			// here we fill the memory access information for each instruction
-			if(!_lightSlicing)
-				LivenessChecker::identifyAddrs(currentBB_wl->toBasic());
-		}
-
-		while(!reachFirstInstCurrentBB_wl)
-		{
-			if(_debugLevel & DISPLAY_SLICING_STAGES)
-				elm::cerr << __SOURCE_INFO__ << __YELLOW__ << "Processing " << currentInst_wl << " @ " << currentInst_wl->address() << __RESET__ << io::endl;
-			elm::BitVector currentRegsDef(workspace()->platform()->regCount(), false);
-			elm::BitVector currentRegsUse(workspace()->platform()->regCount(), false);
-			LivenessChecker::provideRegisters(currentInst_wl, currentRegsUse, 0);
-			LivenessChecker::provideRegisters(currentInst_wl, currentRegsDef, 1);
-
-			// for memory access
-			otawa::dfa::MemorySet::t addressInstRead(0), addressInstWrite(0);
-			if(!_lightSlicing) {
-				LivenessChecker::getMems(currentBB_wl->toBasic(), currentInst_wl, currentReadMemIndex, addressInstRead, 0);
-				LivenessChecker::getMems(currentBB_wl->toBasic(), currentInst_wl, currentWriteMemIndex, addressInstWrite, 1);
-			}
-
-			if(_debugLevel & DISPLAY_SLICING_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Reg Def       = " << currentRegsDef << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Reg Use       = " << currentRegsUse << io::endl;
-				if(!_lightSlicing) {
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << "Mem Def       = "; otawa::oslice::displayAddrs(elm::cerr, addressInstWrite); elm::cerr << io::endl;
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << "Mem Use       = "; otawa::oslice::displayAddrs(elm::cerr, addressInstRead); elm::cerr << io::endl;
-				}
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "RegSet Before = " << currentRegs_wl << io::endl;
-				if(!_lightSlicing) {
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << "MemSet Before = ";  otawa::oslice::displayAddrs(elm::cerr, currentMems_wl);  elm::cerr << io::endl;
-				}
-			}
-
-			// check if the def address is over lap with the working addrs
-			bool memInterested = false;
-			if(!_lightSlicing)
-				memInterested = interestingAddrs(currentMems_wl, addressInstWrite);
-			else
-				memInterested = currentInst_wl->isStore();
-
-			// if working Regs & def Regs is not zero, that means this instruction provides
-			// the registers that we are interested
-			bool regInsterested = interestingRegs(currentRegs_wl, currentRegsDef); // !(currentRegs_wl & currentRegsDef).isEmpty();
-
-			if(memInterested | regInsterested) {
-
-				if(_debugLevel & DISPLAY_SLICING_STAGES)
-					elm::cerr << __SOURCE_INFO__ << __GREEN__ << __TAB__ << "We are interested in instruction " << currentInst_wl << __RESET__ << io::endl;
-
-				// update the working Regs
-				currentRegs_wl = (currentRegs_wl - currentRegsDef) | currentRegsUse;
-				// update the current working memory
-				if(!_lightSlicing)
-					LivenessChecker::updateAddrsFromInstruction(currentMems_wl, addressInstRead, addressInstWrite, _debugLevel);
-				// do something with the instruction
-				SET_OF_REMAINED_INSTRUCTIONS(currentBB_wl)->add(currentInst_wl);
-			}
-			else
-				if(_debugLevel & DISPLAY_SLICING_STAGES)
-					elm::cerr << __SOURCE_INFO__ << __RED__ << __TAB__ << "We slice away instruction " << currentInst_wl << __RESET__ << io::endl;
-
-			if(_debugLevel & DISPLAY_SLICING_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "RegSet After  = " << currentRegs_wl << io::endl;
-				if(!_lightSlicing) {
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << "MemSet After  = "; otawa::oslice::displayAddrs(elm::cerr, currentMems_wl); elm::cerr << io::endl;
-				}
-			}
-
-			if(currentInst_wl == currentBB_wl->toBasic()->first())
-				reachFirstInstCurrentBB_wl = true;
-			else
-				currentInst_wl = currentInst_wl->prevInst();
-		} // reaches the beginning of the BB
-
-		// here reaches the beginning of the BB, now we need to list the list of incoming edges
-		// so we can keep trace back the previous BB
-		// first we find the predecessors of the BB to process
-		elm::Vector<Block *> predecessors;
-
-		for (Block::EdgeIter e = currentBB_wl->ins(); e(); e++) {
-			Block* b = e->source(); // find the source of the edge, the predecessor of current BB
-
-			if (b->isEntry()) {
-				// then get the set of the callers
-				for(auto caller: b->cfg()->callers()) {
-					if(_debugLevel & DISPLAY_SLICING_STAGES)
-						elm::cerr << __SOURCE_INFO__ << "Found a caller @ CFG " << caller->cfg()->index() << ", BB " << caller->index() << io::endl;
-
-					for(Block::EdgeIter bei = caller->ins(); bei(); bei++) {
-						if(_debugLevel & DISPLAY_SLICING_STAGES)
-							elm::cerr << __SOURCE_INFO__ << __TAB__ << __GREEN__ << "Adding the block @ CFG " << bei->source()->cfg()->index() << ", " << bei->source() << __RESET__ << io::endl;
-						predecessors.add(bei->source());
-					}
-				}
-			} // end of handling the entry block
-			else if (b->isBasic()) {
-				// we put the BB here into the working list with given
-				if(_debugLevel & DISPLAY_SLICING_STAGES)
-					elm::cerr << __SOURCE_INFO__ << "Found predecessor BB @ " << b->toBasic()->address() << io::endl;
-				predecessors.add(b->toBasic());
-			} // end of handling the basic block
-			else if (b->isSynth()) {
-				if(!b->toSynth()->callee())
-					continue;
-				// this means that we reach current BB from the returning of a function
-				// we obtain the exit block of the function that it returns from
-				if(_debugLevel & DISPLAY_SLICING_STAGES) {
-					elm::cerr << __SOURCE_INFO__ << "Found a Synth block with the callee to " << b->toSynth()->callee()->label() << io::endl;
-				}
-				Block* end = b->toSynth()->callee()->exit();
-				// each edge to the exit block is a possible BB which will goes to the current block
-				for (Block::EdgeIter EdgeToExit = end->ins(); EdgeToExit(); EdgeToExit++) {
-					Block* BB_BeforeReturn = EdgeToExit->source();
-					if(_debugLevel & DISPLAY_SLICING_STAGES)
-						elm::cerr << __SOURCE_INFO__ << __GREEN__ << "Adding block CFG " << BB_BeforeReturn->cfg()->index() << ", " << BB_BeforeReturn << __RESET__ << io::endl;
-					predecessors.add(BB_BeforeReturn);
-				}
-			} // end of handling the synth block
-			else {
-				if (b->isEntry())
-					elm::cerr << "ENTRY" << io::endl;
-				else if (b->isExit())
-					elm::cerr << "EXIT" << io::endl;
-				else if (b->isUnknown())
-					elm::cerr << "unknown" << io::endl;
-				ASSERTP(false, "Encounter an unexpected block");
-			}
-		} // end of finding predecessors of the current BB
-
-		if(predecessors.count() == 0)
-			if(_debugLevel & DISPLAY_SLICING_STAGES)
-				elm::cerr << __SOURCE_INFO__ << __RED__ << "No predecessor for BB @ " << currentBB_wl->address() << __RESET__ << io::endl;
-
-		// process the collected BBs
-		// now we need to see if the input (register and memory uses) feed from the successor matches totally or a subset of the pred BB
-		for(elm::Vector<Block *>::Iter predecessor(predecessors); predecessor(); ++predecessor) {
-			BitVector bv = SLICER_REG_BB_END(*predecessor);
-			//clp_value_set_t* memIn = SLICER_MEM_BB_END(predecessor);
-			otawa::dfa::MemorySet::t *memIn = SLICER_MEM_BB_END(*predecessor);
-
-			bool notContainsAllRegs = !bv.includes(currentRegs_wl);
-			bool notContainsAllMems = false;
-
-			if(!_lightSlicing)
-				notContainsAllMems = !LivenessChecker::containsAllAddrs(*memIn, currentMems_wl);
-
-			if(_debugLevel & DISPLAY_SLICING_STAGES) {
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "for BB @ " << predecessor->address() << io::endl;
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << __TAB__ << "Register used: " << bv << " contains all of " << currentRegs_wl << " ? "<< !notContainsAllRegs << io::endl;
-				if(!_lightSlicing) {
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << __TAB__ << "Mem      used: ";
-					otawa::oslice::displayAddrs(elm::cerr, *memIn); elm::cerr << " contains all of ";
-					otawa::oslice::displayAddrs(elm::cerr, currentMems_wl); elm::cerr << "? " << !notContainsAllMems << io::endl;
-				}
-			}
-
-			if(notContainsAllRegs | notContainsAllMems | !currentBB_wl->isBasic()) {
-				if(_debugLevel & DISPLAY_SLICING_STAGES)
-					elm::cerr << __SOURCE_INFO__ << __RED__ << "Adding BB @ " << predecessor->address() << " to the working list." << __RESET__ << io::endl;
-				bv = bv | currentRegs_wl;
-				SLICER_REG_BB_END(*predecessor) = bv;
-				if(!_lightSlicing) {
-					*memIn = dfa::MemorySet().join(*memIn, currentMems_wl);
-					SLICER_MEM_BB_END(*predecessor) = memIn;
-				}
-				Inst* lastInstruction = 0;
-				if(predecessor->isBasic())
-					lastInstruction = predecessor->toBasic()->last();
-				WorkingElement *we = new WorkingElement(*predecessor, lastInstruction, currentRegs_wl, currentMems_wl);
-				workingList.add(we);
-			}
-			else
-				if(_debugLevel & DISPLAY_SLICING_STAGES)
-					elm::cerr << __SOURCE_INFO__ << __RED__ << "NOT adding BB @ " << predecessor->address() << " to the working list." << __RESET__ << io::endl;
-		}
-
-	} // end of the current working list
-}
-
-// check if any element in b is in a
-inline bool Slicer::interestingAddrs(otawa::dfa::MemorySet::t const & a, otawa::dfa::MemorySet::t const & b) {
-	dfa::MemorySet ms;
-	dfa::MemorySet::t intersection = ms.meet(a, b);
-	if(intersection == dfa::MemorySet::empty)
-		return false;
-
-	return true;
-}
-
-inline bool Slicer::interestingRegs(elm::BitVector const & a, elm::BitVector const & b) {
-	elm::BitVector c(a.size(), true);
-	c.clear(15); // ignore PC (ARM) cover 31->27
-	c.clear(14); // ignore LR (ARM) cover 31->25
-//	Processing bx lr @ 00200968
-//		Reg Def       = 00000000000000010
-//		Reg Use       = 00000000000000100
-
-	return !((a & b & c).isEmpty());
-}
-
+/**
+ * Build the sliced CFG collection.
+ */
 void Slicer::slicing(void) {
 	const CFGCollection& coll = **otawa::INVOLVED_CFGS(workspace());
 
-	// putting the block to remove in the working list
-	Vector<Block*> blocksToRemove;
-	for (CFGCollection::Iter c(coll); c(); c++) {
-		for (CFG::BlockIter v = c->blocks(); v(); v++) {
-			if (v->isBasic()) {
-				BasicBlock *bb = v->toBasic();
-				InstSet* setInst = SET_OF_REMAINED_INSTRUCTIONS(bb);
-				// if all the instruction are sliced
-				if (setInst->count() == 0) {
-					if(_debugLevel & DISPLAY_CFG_CREATION)
-						elm::cerr << __SOURCE_INFO__<< "all instructions are sliced in BB" << bb->index() << " @ " << bb->address() << io::endl;
-					// mark the BB sliced
-					TO_REMOVE(bb) = true;
-					blocksToRemove.add(bb);
-				}
-			} // if the block is basic
-		} // for each Block
-	} // for each CFG
-
-	while(blocksToRemove.count()) {
-		Block *b = blocksToRemove.pop();
-		if(_debugLevel & DISPLAY_CFG_CREATION)
-			elm::cerr << __SOURCE_INFO__ << "Popping BB " << b->index() << " of CFG " << b->cfg()->index() << " from the BB-removing working list" << io::endl;
-
-		predecessor_list_t predecessors;
-		Vector<Block*> successors;
-		// Collect the predecessors of the current block
-		// incoming edges exited in the original CFG
-		for (Block::EdgeIter in = b->ins(); in(); in++) { // just to be safe not to remove the element during iter ops.
-			// if the edge is not marked as removed, then we add the source of the edge to the list of predecessor
-			if(!TO_REMOVE(*in) && in->source() != b) {
-				predecessors.add(pair(in->source(),in->flags()));
-				// mark the incoming edge removed
-				TO_REMOVE(*in) = true;
-				if(_debugLevel & DISPLAY_CFG_CREATION)
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << "Removing an input edge " << *in << io::endl;
-			}
-			else {
-				if(_debugLevel & DISPLAY_CFG_CREATION)
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << *in << " has already been removed, ignored." << io::endl;
-			}
-		}
-		// now processing the predecessor of the current block due to the removals of the other blocks
-		predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(b);
-		if(edgeSources) {
-			for(predecessor_list_t::Iter in(*edgeSources); in(); in++) {
-				if(_debugLevel & DISPLAY_CFG_CREATION)
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << "Removing an input edge from " << (*in).fst << " to " << b << io::endl;
-				if((*in).fst != b) // if there is a self looping edge on a removed BB, we will remove this edge too, hence the predecessor is not added
-					predecessors.add(*in);
-				// remove the current block from the successors of the its predecessor
-				Vector<Block* > *edgeTargets = ARTIFICIAL_SUCCESSORS((*in).fst);
-				if(edgeTargets)
-					edgeTargets->remove(b);
-			}
-			delete edgeSources;
-			ARTIFICIAL_PREDECESSORS(b).remove();
-		}
-
-		// Collecting the successors of the current block
-		// now we process the out-going edges
-		for (Block::EdgeIter out = b->outs(); out(); out++) { // just to be safe not to remove the element during iter ops.
-			// if the edge is not yet marked removed, then we add the sink of the edge to sucessors
-			if(!TO_REMOVE(*out) && out->target() != b)
-				successors.add(out->sink());
-			TO_REMOVE(*out) = true;
-			if(_debugLevel & DISPLAY_CFG_CREATION)
-				elm::cerr << __SOURCE_INFO__ << __TAB__ << "Removing an output edge to " << *out << io::endl;
-		}
-		// now we process the successors of the current block due to the removals of the other blocks
-		Vector<Block* > *edgeTargets = ARTIFICIAL_SUCCESSORS(b);
-		if(edgeTargets) {
-			for(Vector<Block*>::Iter out(*edgeTargets); out(); out++) {
-				if(_debugLevel & DISPLAY_CFG_CREATION)
-					elm::cerr << __SOURCE_INFO__ << __TAB__ << "Removing an output edge to BB " << out->index() << io::endl;
-				if(*out != b) // if there is a self looping edge on a removed BB, we will remove this edge too, hence the predecessor is not added
-					successors.add(*out);
-				// remove the current block from the list of the predecessors of its successor
-				predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(*out);
-				if(edgeSources) {
-					//edgeSources->remove(b);
-					for(predecessor_list_t::Iter plti(*edgeSources); plti(); plti++) { // scan through each predecessor
-						if((*plti).fst == b)
-							edgeSources->remove(plti);
-					}
-				}
-			}
-			delete edgeTargets;
-			ARTIFICIAL_SUCCESSORS(b).remove();
-		}
-
-		// special case, only one out going edge and pointed to iself (infinite loop ... often seen in the systems with waits for the interrupts
-		if(b->countOuts() == 1 && b->outs()->sink() == b) {
-			if(_debugLevel & DISPLAY_CFG_CREATION)
-				elm::cerr << __SOURCE_INFO__ << "BB " << b->index() << " does not have any output edges but to himself, link it with the exit node" << io::endl;
-			successors.add(b->cfg()->exit()); // connect to the exit node
-		}
-
-		// ========= TO REMOVE =========
-		// actually this may not be necessary
-		// if the predecessor has the targets of the current block, remove the current block from the target
-		for (predecessor_list_t::Iter predecessor(predecessors); predecessor(); predecessor++) {
-			Vector<Block* > *edgeTargets = ARTIFICIAL_SUCCESSORS((*predecessor).fst);
-			if(!edgeTargets)
-				continue;
-			if(edgeTargets->contains(b)) {
-				if(_debugLevel & DISPLAY_CFG_CREATION)
-					elm::cerr << __SOURCE_INFO__ << "predecessor BB " << (*predecessor).fst->index() << " has a edge to current BB, removing...." << io::endl;
-				ASSERT(0);
-				edgeTargets->remove(b);
-			}
-		}
-		// if the successor has predecessor of the current block, remove the current block from the source
-		for (Vector<Block*>::Iter successor(successors); successor(); successor++) {
-			predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(*successor);
-			if(!edgeSources)
-				continue;
-			//edgeSources->remove(b);
-			for(predecessor_list_t::Iter plti(*edgeSources); plti(); plti++) { // scan through each predecessor
-				if((*plti).fst == b) {
-					if(_debugLevel & DISPLAY_CFG_CREATION)
-						elm::cerr << __SOURCE_INFO__ << "successor BB " << successor->index() << " has a edge to current BB, removing...." << io::endl;
-					ASSERT(0);
-					edgeSources->remove(plti);
-				}
-			}
-		}
-		// ========= TO REMOVE END =========
-
-		// now connect the predecessor with the successor
-		 // for each predecessor, need to wire the edge between the predecessor and its successor
-		for (predecessor_list_t::Iter predecessor(predecessors); predecessor(); predecessor++) {
-			for (Vector<Block*>::Iter successor(successors); successor(); successor++) {
-				// check if the successor is already linked with the predecessor
-				// first check the real link
-				bool foundRealEdge = false;
-				bool foundArtificialEdge = false;
-				Edge* realEdge = 0;
-				for(Block::EdgeIter ei = (*predecessor).fst->outs(); ei(); ei++) {
-					if(ei->target() == *successor && (*TO_REMOVE(*ei)) == false) {
-						foundRealEdge = true;
-						realEdge = *ei;
-						break;
-					}
-				}
-				// then check the artificial edge
-				Vector<Block* > *edgeTargets = ARTIFICIAL_SUCCESSORS((*predecessor).fst);
-				if(edgeTargets && edgeTargets->contains(*successor)) {
-					foundArtificialEdge = true;
-				}
-
-				// in this case, we need to remove the exiting edge, creating an artificial edge whose flag is a combination of
-				// the existing predecessor and current predecessor
-				if(foundRealEdge) {
-					// remove the existing real edge
-					TO_REMOVE(realEdge) = true;
-					t::uint32 existingFlag = realEdge->flags(); // extract the flag
-
-					if(_debugLevel & DISPLAY_CFG_CREATION) {
-						elm::cerr << __SOURCE_INFO__ << __TAB__ << "Already existing a real edge between CFG " << (*predecessor).fst->cfg()->index() << ", BB " << (*predecessor).fst->index() << " to BB " << successor->index() << ", need to remove" << io::endl;
-						elm::cout << __SOURCE_INFO__ << __TAB__ << __TAB__ << "exiting edge flag = " << existingFlag << io::endl;
-						elm::cout << __SOURCE_INFO__ << __TAB__ << __TAB__ << "new edge flag     = " << (*predecessor).snd << io::endl;
-					}
-
-					// add the successor edge from the predecessor as the replacement
-					if(!edgeTargets) {
-						edgeTargets = new Vector<Block* >();
-						ARTIFICIAL_SUCCESSORS((*predecessor).fst) = edgeTargets;
-					}
-					edgeTargets->add(*successor);
-
-					// similarly we add the predecessor with the desired exiting flag
-					predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(*successor);
-					if(!edgeSources) {
-						edgeSources = new predecessor_list_t();
-						ARTIFICIAL_PREDECESSORS(*successor) = edgeSources;
-					}
-					existingFlag = existingFlag | (*predecessor).snd;
-					edgeSources->add(pair((*predecessor).fst, existingFlag));
-				}
-				else if(foundArtificialEdge) {
-					t::uint32 existingFlag = 0;
-					// we need to find the predecessor!
-					predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(*successor);
-					for (predecessor_list_t::Iter edgeSource(*edgeSources); edgeSource(); edgeSource++) {
-						if((*edgeSource).fst == (*predecessor).fst) {
-							if(_debugLevel & DISPLAY_CFG_CREATION) {
-								elm::cerr << __SOURCE_INFO__ <<__TAB__ << "Already existing a artificial edge between CFG " << (*predecessor).fst->cfg()->index() << ", BB " << (*predecessor).fst->index() << " to BB " << successor->index() << ", need to remove" << io::endl;
-								elm::cout << __SOURCE_INFO__ <<__TAB__ << __TAB__ << "exiting edge flag = " << (*edgeSource).snd << io::endl;
-								elm::cout << __SOURCE_INFO__ <<__TAB__ << __TAB__ << "new edge flag     = " << (*predecessor).snd << io::endl;
-							}
-							existingFlag = (*edgeSource).snd | (*predecessor).snd;
-							edgeSources->remove(edgeSource);
-							break;
-						}
-					}
-					edgeSources->add(pair((*predecessor).fst, existingFlag));
-				}
-				else {
-					// make the wiring
-					if(_debugLevel & DISPLAY_CFG_CREATION)
-						elm::cerr << __SOURCE_INFO__ << __TAB__ << "Adding edge between BB " << (*predecessor).fst->index() << " to BB " << successor->index() << io::endl;
-					// connecting the predecessor with all of the successors
-					Vector<Block* > *edgeTargets = ARTIFICIAL_SUCCESSORS((*predecessor).fst);
-					// in case the EDGE_TARGET is not initialized
-					if(!edgeTargets) {
-						edgeTargets = new Vector<Block* >();
-						ARTIFICIAL_SUCCESSORS((*predecessor).fst) = edgeTargets;
-					}
-					edgeTargets->add(*successor);
-					predecessor_list_t *edgeSources = ARTIFICIAL_PREDECESSORS(*successor);
-					if(!edgeSources) {
-						edgeSources = new predecessor_list_t();
-						ARTIFICIAL_PREDECESSORS(*successor) = edgeSources;
-					}
-					edgeSources->add(*predecessor);
-				}
-			}
-		} // finish linking the predecessors and successors of the removal BB
-	} // end of the working list
-
 	for(CFGCollection::Iter c(coll); c(); c++) {
 		makeCFG(*c);
 	}
@@ -19,11 +19,22 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
 #include <elm/option/StringList.h>
+#include <elm/sys/StopWatch.h>
 #include <elm/sys/System.h>
+#include <elm/util/UniquePtr.h>
 
 #include <otawa/app/Application.h>
 #include <otawa/cfg/features.h>
+#include <otawa/ilp/Exporter.h>
 #include <otawa/ilp/System.h>
 #include <otawa/ipet/IPET.h>
 #include <otawa/script/Script.h>
@@ -67,7 +78,12 @@ using namespace elm::option;
  * * -f, --flowfacts PATH: OTAWA can not automatically found loops so this options is used
  * to design the file containing loop bounds; supported formats includes .ff or .ffx (@ref ff). Flowfacts allows also
  * to pass specific configuration for the flow execution of a program.
- * * -i, --dump-ilp: dump the ILP system (if any) to the standard output.
+ * * -i: dump the ILP system (if any) to the file TASK_ENTRY.lp (lp_solve format).
+ * * --dump-ilp PATH: dump the ILP system (if any) to the given file. The format is selected
+ * according to the file extension: .lp for lp_solve, .cplex or .lpt for CPLEX, .mps for fixed MPS,
+ * .fmps for free MPS. An additional .gz extension causes the output to be compressed.
+ * When the tasks are processed in parallel (--parallel-tasks), the file name is prefixed
+ * by the task entry followed by "-".
  * * -l, --list: list the configuration items of the used script.
  * * --load-param ID=VAL: set the load parameter named ID to the value VAL.
  * * --log LEVEL: select the log level (one of proc, deps, cfg, bb or inst).
@@ -81,6 +97,28 @@ using namespace elm::option;
  * * -v, --verbose: verbose display of the process (same as --log bb)
  * *-W, --wcet-stat: outputs detailed statistics about WCET.
  * * --work-dir PATH: change the working directory to PATH.
+ * * --server: serve WCET requests read from the standard input (see below).
+ * * --socket PATH: serve WCET requests on the UNIX socket PATH (see below).
+ *
+ * @par Server Mode
+ *
+ * With --server or --socket, owcet loads the executable once and answers a sequence
+ * of requests, one per line, keeping resident the workspace, the decoded instructions,
+ * the CFGs and the loaded plugins. The supported requests are:
+ * * wcet TASK [ID=VAL]... -- compute the WCET of TASK with the given script parameters
+ * (in addition to the -p parameters of the command line),
+ * * reset -- invalidate all features computed for the tasks,
+ * * quit -- stop the server.
+ *
+ * Each request is answered by one line, "OK task=TASK wcet=WCET time=TIMEus reuse=REUSE"
+ * or "ERROR message", where TIME is the processing time of the request and REUSE
+ * is one of full (same task and parameters: the previous result is returned),
+ * cfg (same task: only the analyses above the CFGs are computed again) or none.
+ * The CFGs are built with the command line configuration: the script parameters
+ * of a request only apply to the analyses working on the CFGs. With --socket,
+ * the connections are served one after the other. In server mode, the standard output
+ * is reserved to the answers: the output and the log of the analyses go to the standard
+ * error.
  *
  * @par Hints
  *
@@ -131,22 +169,54 @@ class OWCET: public Application {
 public:
 	OWCET(void): Application(
 		"owcet",
-		Version(1, 2, 0),
+		Version(1, 3, 0),
 		"Compute the WCET of task using a processor script (.osx)."
 		"H. Cassé <casse@irit.fr>",
 		"Copyright (c) IRIT - UPS <casse@irit.fr>"
 	),
 	params			(ListOption<string>		::Make(*this).cmd("-p")			.cmd("--param").description("parameter passed to the script").argDescription("IDENTIFIER=VALUE")),
 	script			(ValueOption<string>	::Make(*this).cmd("-s")			.cmd("--script").description("script used to compute WCET").argDescription("PATH")),
-	ilp_dump		(SwitchOption			::Make(*this).cmd("-i")			.cmd("--dump-ilp").description("dump ILP system to standard output")),
+	ilp_dump		(SwitchOption			::Make(*this).cmd("-i")			.description("dump ILP system to TASK.lp")),
+	ilp_path		(ValueOption<string>	::Make(*this).cmd("--dump-ilp")	.description("dump ILP system to PATH (format from extension: .lp, .cplex, .mps, .fmps, [.gz])").argDescription("PATH")),
 	list			(SwitchOption			::Make(*this).cmd("--list")		.cmd("-l").description("list configuration items")),
 	timed			(SwitchOption			::Make(*this).cmd("--timed")	.cmd("-t").description("display computation")),
 	display_stats	(SwitchOption			::Make(*this).cmd("-S")			.cmd("--display-stats").description("display statistics")),
 	//detailed_stats	(SwitchOption			::Make(*this).cmd("-D")			.cmd("--detailed-stats").description("output detail of statistics")),
-	wcet_stats		(SwitchOption			::Make(*this).cmd("-W")			.cmd("--wcet-stat").description("detailed statistics about WCET"))
+	wcet_stats		(SwitchOption			::Make(*this).cmd("-W")			.cmd("--wcet-stat").description("detailed statistics about WCET")),
+	server			(SwitchOption			::Make(*this).cmd("--server")	.description("serve WCET requests read from standard input")),
+	socket_path		(ValueOption<string>	::Make(*this).cmd("--socket")	.description("serve WCET requests on a UNIX socket").argDescription("PATH")),
+	warm(false),
+	cur_wcet(-1)
 	{ }
 
 protected:
+	virtual void work(PropList &props) {
+		if(!script)
+			throw option::OptionException("a script must be given !");
+		scriptPath();
+		if(server || socket_path) {
+			workspace()->provided(initial);
+
+			// the answers are the only output on stdout
+			OUTPUT(props) = &cerr.stream();
+			LOG(props) = &cerr.stream();
+			if(socket_path)
+				serveSocket(props);
+			else {
+				fflush(stdout);
+				int fd = dup(1);
+				FILE *out = fd < 0 ? nullptr : fdopen(fd, "w");
+				if(out == nullptr)
+					throw otawa::Exception(_ << "cannot open the answer output: " << strerror(errno));
+				dup2(2, 1);
+				serve(stdin, out, props);
+				fclose(out);
+			}
+		}
+		else
+			Application::work(props);
+	}
+
 	virtual void work (const string &entry, PropList &props) {
 
 		// set statistics option
@@ -158,49 +228,15 @@ protected:
 			throw option::OptionException("a script must be given !");
 
 		// fulfill the parameters
-		for(int i = 0; i < params.count(); i++) {
-			string param = params[i];
-			int idx = param.indexOf('=');
-			if(idx < 0)
-				cerr << "WARNING: argument " << param << " is malformed: VARIABLE=VALUE\n";
-			else
-				script::PARAM(props).add(pair(param.substring(0, idx), param.substring(idx + 1)));
-		}
-
-		// look for the script
-		Path path = *script;
-		if(!path.exists() && !path.isAbsolute()) {
-			Path file = *script;
-			if(file.extension() != "osx")
-				file = file.setExtension("osx");
-			bool found = false;
-			string paths = MANAGER.buildPaths("../../share/Otawa/scripts", "");
-			for(Path::PathIter p(paths); p(); p++) {
-				path = Path(*p) / file;
-				if(isVerbose())
-					cerr << "INFO: looking script in directory " << *p << io::endl;
-				if(path.exists()) {
-					found = true;
-					break;
-				}
-			}
-			if(!found)
-				throw elm::option::OptionException(_ << "cannot find script " << *script);
-		}
-		if(isVerbose())
-			cerr << "INFO: using script from " << path << io::endl;
+		for(int i = 0; i < params.count(); i++)
+			addParam(params[i], props);
 
 		// launch the script
 		if(list)
 			script::ONLY_CONFIG(props) = true;
 		if(timed)
 			script::TIME_STAT(props) = true;
-		if(ilp_dump)
-			ipet::EXPLICIT(props) = true;
-		TASK_ENTRY(props) = entry;
-		script::PATH(props) = path;
-		script::Script *scr = new script::Script();
-		workspace()->run(scr, props);
+		UniquePtr<script::Script> scr(launch(entry, props));
 
 		// process the list option
 		if(list) {
@@ -220,16 +256,23 @@ protected:
 		ot::time wcet = ipet::WCET(workspace());
 		if(wcet == -1)
 			cerr << "ERROR: no WCET computed (see errors above)." << io::endl;
-		else if(scr->version() == 1)
-			cout << "WCET[" << entry << "] = " << wcet << " cycles\n";
+		else {
+			result(_ << wcet << " cycles");
+			if(scr->version() == 1 && !isParallel())
+				cout << "WCET[" << entry << "] = " << wcet << " cycles\n";
+		}
 
 		// ILP dump
-		if(ilp_dump) {
+		if(ilp_dump || ilp_path) {
 			ilp::System *sys = ipet::SYSTEM(workspace());
 			if(sys) {
-				OutStream *out = elm::sys::System::createFile(entry + ".lp");
-				sys->dumpLPSolve(*out);
-				delete out;
+				Path path = entry + ".lp";
+				if(ilp_path)
+					path = taskPath(*ilp_path, entry);
+				ilp::format_t fmt = ilp::Exporter::formatOf(path);
+				if(fmt == ilp::DEFAULT)
+					fmt = ilp::LP_SOLVE;
+				ilp::Exporter(sys, fmt).write(path);
 			}
 		}
 
@@ -269,15 +312,301 @@ protected:
 	}
 
 private:
+
+	/**
+	 * Add a script parameter.
+	 * @param param		Parameter of the form ID=VALUE.
+	 * @param props		Property list to add to.
+	 */
+	void addParam(const string& param, PropList& props) {
+		int idx = param.indexOf('=');
+		if(idx < 0)
+			cerr << "WARNING: argument " << param << " is malformed: VARIABLE=VALUE\n";
+		else
+			script::PARAM(props).add(pair(param.substring(0, idx), param.substring(idx + 1)));
+	}
+
+	/**
+	 * Build the path of a file produced for a task. When the tasks are processed
+	 * in parallel, the task entry is prefixed to the file name to prevent the
+	 * tasks from writing the same file.
+	 * @param path	Path given on the command line.
+	 * @param entry	Task entry.
+	 * @return		Path for the task.
+	 */
+	Path taskPath(const string& path, const string& entry) {
+		if(!isParallel())
+			return path;
+		int i = path.lastIndexOf('/') + 1;
+		return path.substring(0, i) + entry + "-" + path.substring(i);
+	}
+
+	/**
+	 * Look for the script (only performed once). This is first called
+	 * before the tasks are processed, possibly concurrently.
+	 * @return	Script path.
+	 */
+	const Path& scriptPath(void) {
+		if(script_path)
+			return script_path;
+		Path path = *script;
+		if(!path.exists() && !path.isAbsolute()) {
+			Path file = *script;
+			if(file.extension() != "osx")
+				file = file.setExtension("osx");
+			bool found = false;
+			string paths = MANAGER.buildPaths("../../share/Otawa/scripts", "");
+			for(Path::PathIter p(paths); p(); p++) {
+				path = Path(*p) / file;
+				if(isVerbose())
+					cerr << "INFO: looking script in directory " << *p << io::endl;
+				if(path.exists()) {
+					found = true;
+					break;
+				}
+			}
+			if(!found)
+				throw elm::option::OptionException(_ << "cannot find script " << *script);
+		}
+		if(isVerbose())
+			cerr << "INFO: using script from " << path << io::endl;
+		script_path = path;
+		return script_path;
+	}
+
+	/**
+	 * Launch the script on the given task.
+	 * @param entry		Task entry.
+	 * @param props		Configuration properties.
+	 * @return			Launched script (to delete by the caller).
+	 */
+	script::Script *launch(const string& entry, PropList& props) {
+		TASK_ENTRY(props) = entry;
+		script::PATH(props) = scriptPath();
+		script::Script *scr = new script::Script();
+		workspace()->run(scr, props);
+		return scr;
+	}
+
+	/**
+	 * Serve the requests from the given input until end of file or quit.
+	 * @param in		Request input.
+	 * @param out		Answer output.
+	 * @param props		Configuration properties.
+	 * @return			True if the quit request has been received.
+	 */
+	bool serve(FILE *in, FILE *out, PropList& props) {
+		char *line = nullptr;
+		size_t size = 0;
+		bool quit = false;
+		while(!quit && getline(&line, &size, in) >= 0) {
+
+			// split the request
+			Vector<string> args;
+			for(char *p = line; *p != '\0';) {
+				while(*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+					p++;
+				char *q = p;
+				while(*q != '\0' && *q != ' ' && *q != '\t' && *q != '\n' && *q != '\r')
+					q++;
+				if(q != p)
+					args.add(string(p, q - p));
+				p = q;
+			}
+			if(args.isEmpty())
+				continue;
+
+			// process it
+			if(args[0] == "quit") {
+				fprintf(out, "OK\n");
+				quit = true;
+			}
+			else if(args[0] == "reset") {
+				restore(initial);
+				warm = false;
+				fprintf(out, "OK\n");
+			}
+			else if(args[0] == "wcet" && args.length() >= 2) {
+				Vector<string> ps;
+				for(int i = 2; i < args.length(); i++)
+					ps.add(args[i]);
+				string answer = request(args[1], ps, props);
+				fprintf(out, "%s\n", answer.toCString().chars());
+			}
+			else
+				fprintf(out, "ERROR bad request: %s\n", args[0].toCString().chars());
+			fflush(out);
+		}
+		free(line);
+		return quit;
+	}
+
+	/**
+	 * Serve the requests on the UNIX socket.
+	 * @param props		Configuration properties.
+	 */
+	void serveSocket(PropList& props) {
+		string path = *socket_path;
+		struct sockaddr_un addr;
+		if(path.length() >= int(sizeof(addr.sun_path)))
+			throw otawa::Exception(_ << "socket path too long: " << path);
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strcpy(addr.sun_path, path.toCString().chars());
+		int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if(fd < 0)
+			throw otawa::Exception(_ << "cannot create socket: " << strerror(errno));
+		::unlink(path.toCString().chars());
+		if(::bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || ::listen(fd, 4) < 0) {
+			::close(fd);
+			throw otawa::Exception(_ << "cannot listen on " << path << ": " << strerror(errno));
+		}
+		if(isVerbose())
+			cerr << "INFO: serving on " << path << io::endl;
+		::signal(SIGPIPE, SIG_IGN);
+
+		bool quit = false;
+		while(!quit) {
+			int cfd = ::accept(fd, nullptr, nullptr);
+			if(cfd < 0) {
+				if(errno == EINTR)
+					continue;
+				::close(fd);
+				throw otawa::Exception(_ << "cannot accept connection: " << strerror(errno));
+			}
+			FILE *in = fdopen(cfd, "r");
+			if(in == nullptr) {
+				::close(cfd);
+				continue;
+			}
+			int ofd = dup(cfd);
+			FILE *out = ofd < 0 ? nullptr : fdopen(ofd, "w");
+			if(out == nullptr) {
+				if(ofd >= 0)
+					::close(ofd);
+				fclose(in);
+				continue;
+			}
+			quit = serve(in, out, props);
+			fclose(in);
+			fclose(out);
+		}
+		::close(fd);
+		::unlink(path.toCString().chars());
+	}
+
+	/**
+	 * Compute the WCET for a request.
+	 * @param task		Task entry.
+	 * @param ps		Script parameters of the request.
+	 * @param props		Configuration properties.
+	 * @return			Answer to the request.
+	 */
+	string request(const string& task, const Vector<string>& ps, PropList& props) {
+		sys::StopWatch watch;
+		watch.start();
+		StringBuffer buf;
+		bool started = false;
+		try {
+			startTask(task);
+			started = true;
+			PropList rprops(props);
+			for(int i = 0; i < params.count(); i++)
+				addParam(params[i], rprops);
+			for(auto p: ps)
+				addParam(p, rprops);
+
+			// reuse the warm state
+			cstring reuse = "none";
+			ot::time wcet;
+			if(warm && task == cur_task && sameParams(ps)) {
+				reuse = "full";
+				wcet = cur_wcet;
+			}
+			else {
+				if(warm && task == cur_task) {
+					reuse = "cfg";
+					restore(task_feats);
+				}
+				else {
+					restore(initial);
+					TASK_ENTRY(rprops) = task;
+					workspace()->require(COLLECTED_CFG_FEATURE, rprops);
+					task_feats.clear();
+					workspace()->provided(task_feats);
+				}
+				warm = false;
+				delete launch(task, rprops);
+				wcet = ipet::WCET(workspace());
+				if(wcet == -1)
+					throw otawa::Exception("no WCET computed");
+				cur_task = task;
+				cur_params.clear();
+				for(auto p: ps)
+					cur_params.add(p);
+				cur_wcet = wcet;
+				warm = true;
+			}
+
+			watch.stop();
+			buf << "OK task=" << task << " wcet=" << wcet << " time=" << watch.delay().micros() << "us reuse=" << reuse;
+		}
+		catch(elm::Exception& e) {
+			warm = false;
+			buf << "ERROR " << e.message();
+		}
+		if(started)
+			completeTask();
+		return buf.toString();
+	}
+
+	/**
+	 * Test if the parameters are the ones of the last computed request.
+	 * @param ps	Parameters to test.
+	 * @return		True if they are the same, false else.
+	 */
+	bool sameParams(const Vector<string>& ps) const {
+		if(ps.length() != cur_params.length())
+			return false;
+		for(int i = 0; i < ps.length(); i++)
+			if(ps[i] != cur_params[i])
+				return false;
+		return true;
+	}
+
+	/**
+	 * Restore the workspace to the given list of features by invalidating
+	 * the features provided since.
+	 * @param feats		Features to keep.
+	 */
+	void restore(const Vector<const AbstractFeature *>& feats) {
+		Vector<const AbstractFeature *> cur;
+		workspace()->provided(cur);
+		for(auto f: cur)
+			if(!feats.contains(f) && workspace()->provides(*f))
+				workspace()->invalidate(*f);
+	}
+
 	ListOption<string> params;
 	ValueOption<string> script;
 	SwitchOption ilp_dump;
+	ValueOption<string> ilp_path;
 	SwitchOption list;
 	SwitchOption timed;
 	SwitchOption display_stats;
 	SwitchOption wcet_stats;
+	SwitchOption server;
+	ValueOption<string> socket_path;
 	string bin, task;
 
+	// server state
+	Path script_path;
+	Vector<const AbstractFeature *> initial, task_feats;
+	bool warm;
+	string cur_task;
+	Vector<string> cur_params;
+	ot::time cur_wcet;
+
 };
 
 OTAWA_RUN(OWCET);
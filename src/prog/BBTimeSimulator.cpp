@@ -19,6 +19,10 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include "config.h"
+#include <elm/data/HashMap.h>
+#include <elm/util/Pair.h>
+#include <otawa/cfg/features.h>
 #include <otawa/prog/Process.h>
 #include <otawa/tsim/BBTimeSimulator.h>
 #include <otawa/ipet/IPET.h>
@@ -44,13 +48,33 @@ p::declare BBTimeSimulator::reg = p::init("otawa::tsim::BBTimeSimulator", Versio
  * This processor compute the execution time of each basic block using the
  * provided simulator.
  *
+ * As each block is simulated from a reset state, its time only depends on its
+ * instructions: the blocks covering the same instructions (copies produced by
+ * virtualization or unrolling) are simulated only once. The distinct blocks are
+ * simulated concurrently (if OTAWA is compiled with concurrency), each thread
+ * working with its own clone of the simulator state.
+ *
  * @par Provided Features
  * @li @ref otawa::ipet::BB_TIME_FEATURE
  *
  * @par Required Feature
  * @li @ref otawa::REGISTER_USAGE_FEATURE
  */
-BBTimeSimulator::BBTimeSimulator(p::declare& r): BBProcessor(r), state(nullptr) {
+BBTimeSimulator::BBTimeSimulator(p::declare& r): BBProcessor(r), state(nullptr), mutex(nullptr) {
+}
+
+
+/**
+ * Simulate a block from a reset state.
+ * @param s		State to use.
+ * @param bb	Block to simulate.
+ * @return		Execution time of the block.
+ */
+int BBTimeSimulator::simulate(sim::State *s, BasicBlock *bb) {
+	sim::BasicBlockDriver driver(bb);
+	s->reset();
+	s->run(driver);
+	return s->cycle();
 }
 
 
@@ -60,10 +84,118 @@ void BBTimeSimulator::processBB(WorkSpace *fw, CFG *cfg, Block *b) {
 	if(!b->isBasic())
 		return;
 	BasicBlock *bb = b->toBasic();
-	sim::BasicBlockDriver driver(bb);
-	state->reset();
-	state->run(driver);
-	ipet::TIME(bb) = state->cycle();
+	ipet::TIME(bb) = simulate(state, bb);
+}
+
+
+/**
+ * Get a state from the pool (or a new clone if the pool is empty).
+ * @return	Simulator state.
+ */
+sim::State *BBTimeSimulator::take(void) {
+	if(mutex != nullptr)
+		mutex->lock();
+	sim::State *s;
+	if(pool.isEmpty())
+		s = state->clone();
+	else
+		s = pool.pop();
+	if(mutex != nullptr)
+		mutex->unlock();
+	return s;
+}
+
+
+/**
+ * Give back a state to the pool.
+ * @param s		Released state.
+ */
+void BBTimeSimulator::give(sim::State *s) {
+	if(mutex != nullptr)
+		mutex->lock();
+	pool.push(s);
+	if(mutex != nullptr)
+		mutex->unlock();
+}
+
+
+/**
+ * Simulate the distinct blocks concurrently.
+ */
+class BBTimeRunner: public sys::Runnable {
+public:
+	BBTimeRunner(BBTimeSimulator& sim, const Vector<BasicBlock *>& blocks, Vector<int>& times)
+		: _sim(sim), _blocks(blocks), _times(times), _next(0) { }
+
+	void run(void) override {
+		sim::State *s = _sim.take();
+		while(true) {
+			if(_sim.mutex != nullptr)
+				_sim.mutex->lock();
+			int i = _next++;
+			if(_sim.mutex != nullptr)
+				_sim.mutex->unlock();
+			if(i >= _blocks.length())
+				break;
+			_times[i] = _sim.simulate(s, _blocks[i]);
+		}
+		_sim.give(s);
+	}
+
+private:
+	BBTimeSimulator& _sim;
+	const Vector<BasicBlock *>& _blocks;
+	Vector<int>& _times;
+	int _next;
+};
+
+
+/**
+ */
+void BBTimeSimulator::processAll(WorkSpace *ws) {
+
+	// collect the distinct blocks (same address and size means same instructions)
+	HashMap<t::uint64, int> memo;
+	Vector<BasicBlock *> blocks;
+	Vector<Pair<BasicBlock *, int> > all;
+	for(auto g: cfgs())
+		for(auto b: *g)
+			if(b->isBasic()) {
+				BasicBlock *bb = b->toBasic();
+				t::uint64 key = (t::uint64(bb->address().offset()) << 32) | bb->size();
+				int i = memo.get(key, -1);
+				if(i < 0) {
+					i = blocks.length();
+					memo.put(key, i);
+					blocks.add(bb);
+				}
+				all.add(pair(bb, i));
+			}
+	if(logFor(LOG_CFG))
+		log << "\t" << blocks.length() << " distinct blocks to simulate out of " << all.length() << io::endl;
+
+	// simulate them
+	Vector<int> times(blocks.length());
+	for(int i = 0; i < blocks.length(); i++)
+		times.add(0);
+	BBTimeRunner runner(*this, blocks, times);
+#	ifdef OTAWA_CONC
+		if(!logFor(LOG_BB)) {
+			mutex = sys::Mutex::make();
+			WorkSpace::runAll(runner);
+			delete mutex;
+			mutex = nullptr;
+		}
+		else
+#	endif
+		runner.run();
+
+	// record the times
+	for(auto p: all) {
+		if(logFor(LOG_BB))
+			log << "\t\t" << p.fst << ": " << times[p.snd] << " cycles\n";
+		ipet::TIME(p.fst) = times[p.snd];
+	}
 }
 
 
@@ -82,8 +214,11 @@ void BBTimeSimulator::setup(WorkSpace *ws) {
 /**
  */
 void BBTimeSimulator::cleanup(WorkSpace *ws) {
-	// TODO delete state;
-	state = 0;
+	while(!pool.isEmpty())
+		pool.pop()->release();
+	if(state != nullptr)
+		state->release();
+	state = nullptr;
 }
 
 } }		// otawa::tsim
@@ -277,6 +277,75 @@ public:
  */
 
 
+/**
+ * @class WTODriver
+ * Driver of abstract interpretation following the weak topological order
+ * (@ref WTO) of the graph with the recursive iteration strategy of Bourdoncle:
+ * the vertices are processed in WTO order and a loop (component) is iterated
+ * until its head is stable before going on with the following vertices.
+ * This stabilizes inner loops before outer loops and avoids redundant joins
+ * and updates in loop nests.
+ *
+ * The interface is the same as @ref WorkListDriver and it may be used
+ * with @ref SimpleAI:
+ * @code
+ * SimpleAI<MyAdapter, WTODriver<MyDomain, CFGGraph, MyStore> > ana(adapter);
+ * @endcode
+ *
+ * The heads of the components are the widening points: when a head
+ * is processed again, the new state is widened with the previous one
+ * according to the widening policy W before being compared.
+ *
+ * @param D		Current domain (must implement @ref otawa::ai::Domain concept).
+ * @param G		Graph (must implement @ref otawa::ai::Graph concept, succs() included).
+ * @param S		Storage.
+ * @param W		Widening policy (@ref NoWidening or @ref DomainWidening).
+ * @ingroup ai
+ */
+
+/**
+ * @fn bool WTODriver::isWideningPoint(void) const;
+ * Test if the current vertex is a widening point.
+ * @return	True if the current vertex is the head of a component iterated again.
+ */
+
+/**
+ * @fn int WTODriver::iterationCount(void) const;
+ * Get the number of processed vertices.
+ * @return	Number of vertex iterations.
+ */
+
+/**
+ * @fn int WTODriver::componentIterationCount(void) const;
+ * Get the number of times a component has been iterated again.
+ * @return	Number of component iterations.
+ */
+
+/**
+ * @class NoWidening
+ * Widening policy for @ref WTODriver that performs no widening.
+ * @ingroup ai
+ */
+
+/**
+ * @class DomainWidening
+ * Widening policy for @ref WTODriver that calls the function widen(old, new)
+ * of the domain.
+ * @ingroup ai
+ */
+
+/**
+ * @class WTORanking
+ * Ranking function for @ref RankingAI that ranks the vertices according
+ * to their position in the weak topological order of the graph.
+ * @code
+ * WTORanking<CFGGraph> rank(graph);
+ * RankingAI<MyAdapter, WTORanking<CFGGraph> > ana(adapter, rank);
+ * @endcode
+ * @param G		Graph type.
+ * @ingroup ai
+ */
+
 /**
  * @class CFGGraph
  * BiDiGraph adapter implementation for CFG.
@@ -324,10 +393,17 @@ public:
  * until reaching a fixpoint.
  *
  * @param A		Actual type of the adapter.
+ * @param Dr	Driver type (default to @ref WorkListDriver, may be @ref WTODriver).
  *
  * @ingroup ai
  */
 
+/**
+ * @fn const Dr& SimpleAI::driver(void) const;
+ * Get the driver (for example, to get iteration statistics).
+ * @return	Used driver.
+ */
+
 /**
  * @fn void SimpleAI::run(void);
  * Performed the analysis using the given adapter, that is, basically produces for each vertex
@@ -362,6 +438,12 @@ public:
  * in the store of the adapter.
  */
 
+/**
+ * @fn int RankingAI::iterationCount(void) const;
+ * Get the number of processed vertices.
+ * @return	Number of vertex iterations.
+ */
+
 
 /**
  * @class PropertyRanking
@@ -392,6 +474,31 @@ int PropertyRanking::rankOf(const PropList& props) {
 p::id<int> RANK_OF("otawa::ai::RANK_OF", -1);
 
 
+/**
+ * Statistics of an analysis (see @ref Processor::STATS): number of processed
+ * vertices (blocks) until the fix-point is reached. This allows to compare
+ * the iteration strategies (ranked work-list or WTO).
+ *
+ * @par Hooks
+ * 	* Statistics property list of a processor.
+ *
+ * @ingroup ai
+ */
+p::id<int> ITERATION_COUNT("otawa::ai::ITERATION_COUNT", 0);
+
+
+/**
+ * Statistics of an analysis (see @ref Processor::STATS) using the WTO
+ * iteration strategy: number of times a component (loop) has been iterated again.
+ *
+ * @par Hooks
+ * 	* Statistics property list of a processor.
+ *
+ * @ingroup ai
+ */
+p::id<int> COMPONENT_ITERATION_COUNT("otawa::ai::COMPONENT_ITERATION_COUNT", 0);
+
+
 /**
  * This feature ensures that a ranking has been assigned to each of block of the
  * current CFG collection. The ranking value is an integer giving a priority (lesser
@@ -19,9 +19,14 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include "config.h"
 #include <elm/data/ListQueue.h>
+#include <elm/sys/Thread.h>
 #include <otawa/ai/CFGAnalyzer.h>
+#include <otawa/ai/features.h>
 #include <otawa/ai/RankedQueue.h>
+#include <otawa/ai/WTO.h>
+#include <otawa/prog/WorkSpace.h>
 
 namespace otawa { namespace ai {
 
@@ -124,6 +129,48 @@ State *Domain::join(State *s1, State *s2, Edge *e) {
 	return join(s1, s2);
 }
 
+/**
+ * Widen the state s1 with the state s2. This is called at the widening points
+ * of the analysis (heads of loops) when the analysis iterates again on a loop.
+ * The default implementation performs a join.
+ * @param s1	Previous state.
+ * @param s2	New state.
+ * @return		Widened state.
+ */
+State *Domain::widen(State *s1, State *s2) {
+	return join(s1, s2);
+}
+
+/**
+ * Called when an analyzer starts to hold the given state (stored as result of
+ * a block, as function summary or given to the user). A state may be acquired
+ * several times and is held until it is released as many times.
+ * The bottom and the top states are never acquired nor released.
+ * The default implementation does nothing (for domains with their
+ * own garbage collection, see CFGAnalyzer::collect()).
+ * @param s		Acquired state.
+ */
+void Domain::acquire(State *s) {
+}
+
+/**
+ * Called when an analyzer stops holding the given state. When all
+ * acquisitions of a state are released, the state may be freed.
+ * The default implementation does nothing.
+ * @param s		Released state.
+ */
+void Domain::release(State *s) {
+}
+
+/**
+ * Called by the analyzer between the processing of two blocks: the states
+ * built by the domain since the last call to flush() that are not acquired
+ * are no more used and may be freed (per-iteration arena).
+ * The default implementation does nothing.
+ */
+void Domain::flush() {
+}
+
 /**
  * Update the the state s according to the block v.
  * The default implementation does nothing: it returns the input state s.
@@ -230,6 +277,36 @@ void Domain::printTrace(State *s, io::StructuredOutput& out) {
 	out.write(0);
 }
 
+/**
+ * Test if the domain supports function summaries, that is, if hash()
+ * is implemented and consistent with equals(). Default implementation
+ * returns false.
+ * @return	True if summaries are supported, false else.
+ */
+bool Domain::implementsSummaries() {
+	return false;
+}
+
+/**
+ * Compute a hash code for the given state. Two states equal according
+ * to equals() must have the same hash code. Only called if
+ * implementsSummaries() returns true. Default implementation returns 0.
+ * @param s		State to compute hash for.
+ * @return		Hash code of s.
+ */
+t::hash Domain::hash(State *s) {
+	return 0;
+}
+
+/**
+ * Test if the domain functions (except printing and tracing) can be called
+ * concurrently from several threads. Default implementation returns false.
+ * @return	True if the domain is thread-safe, false else.
+ */
+bool Domain::implementsConcurrency() {
+	return false;
+}
+
 
 /**
  * @class CFGAnalyzer
@@ -253,6 +330,42 @@ void Domain::printTrace(State *s, io::StructuredOutput& out) {
  * * s^before_w->v = s[w]
  * * s^after_w->v = U(w->v, s[w])
  * 
+ * If the domain supports it (Domain::implementsSummaries()) and setSummaries()
+ * is called, the analysis is performed in summary mode: each function is
+ * analyzed separately for each distinct input state and the resulting
+ * output state is memoized (function summary). A change in a callee only
+ * causes the re-analysis of the callers using the changed summary. Inside
+ * a recursive component of the call graph, the calls are merged in one
+ * context per function to ensure termination. When the analysis of a caller
+ * does not use a context anymore, the summaries that are no more reachable
+ * from the entry function are released. The results s[v] are the join
+ * of the states of v over all the live contexts of its function.
+ * Domain::widen() is applied to the blocks reached by an edge going
+ * backward in rank order, to the inputs of the recursive contexts and
+ * to their outputs when they are analyzed again.
+ *
+ * By default, the blocks are processed in the order of their rank (see
+ * @ref RANKING_FEATURE). With setWTO(), the blocks are processed following
+ * the weak topological order (@ref WTO) of the program graph (including
+ * call and return edges) with the recursive iteration strategy: inner loops
+ * are stabilized before outer loops and Domain::widen() is applied to the
+ * heads of loops when they are iterated again.
+ *
+ * The analyzer follows a lifetime protocol for the states: it acquires
+ * (Domain::acquire()) the states it stores and releases them
+ * (Domain::release()) as soon as they are superseded, and it calls
+ * Domain::flush() between two block processings to let the domain reclaim
+ * the temporary states. The states returned by after() and before() are
+ * held until release() is called, and the results of the analysis are held
+ * until the analyzer is deleted: a user keeping a state after this must
+ * acquire it itself. Domains relying on a garbage collector can ignore
+ * this protocol and use collect().
+ *
+ * In summary mode, the pending analyses are performed by rounds: the
+ * analyses of a round only read the summaries of the previous rounds and,
+ * if the domain is thread-safe (Domain::implementsConcurrency()), they are
+ * performed concurrently. Tracing is not supported in summary mode.
+ * 
  * @ingroup ai
  */
 
@@ -271,12 +384,30 @@ CFGAnalyzer::CFGAnalyzer(Monitor& monitor, Domain& domain, State *entry):
 	s0(entry == nullptr ? dom.entry() : entry),
 	verbose(false),
 	verbose_inst(false),
-	trace(nullptr)
+	trace(nullptr),
+	summaries(false),
+	use_wto(false),
+	engine(nullptr),
+	scnt(0),
+	acnt(0),
+	icnt(0),
+	ccnt(0),
+	live(0),
+	hwm(0)
 {
+	hold(s0);
 }
 
-///
+/**
+ * Release all the states held by the analyzer.
+ */
 CFGAnalyzer::~CFGAnalyzer() {
+	for(int i = 0; i < states.length(); i++)
+		drop(states[i]);
+	for(HashMap<State *, int>::PairIter i(in_use); i(); i++)
+		for(int j = 0; j < (*i).snd; j++)
+			drop((*i).fst);
+	drop(s0);
 }
 
 
@@ -291,6 +422,550 @@ void CFGAnalyzer::setTrace(io::StructuredOutput& t) {
 }
 
 
+/**
+ * @fn void CFGAnalyzer::setSummaries(bool enabled);
+ * Enable or disable the summary mode. The summary mode is only used
+ * if the domain supports it (see Domain::implementsSummaries()).
+ * @param enabled	True to enable summary mode, false to disable it.
+ */
+
+/**
+ * @fn void CFGAnalyzer::setWTO(bool enabled);
+ * Select the processing order of blocks: WTO order with recursive iteration
+ * strategy if enabled, rank order else.
+ * @param enabled	True to use the WTO order.
+ */
+
+/**
+ * @fn int CFGAnalyzer::iterationCount() const;
+ * Get the number of block processings of the last analysis (not available
+ * in summary mode).
+ * @return	Number of processed blocks.
+ */
+
+/**
+ * @fn int CFGAnalyzer::componentIterationCount() const;
+ * Get the number of times a component has been iterated again by the last
+ * analysis in WTO order (see setWTO()).
+ * @return	Number of component iterations.
+ */
+
+/**
+ * Record the iteration counts of the last analysis in the given statistics
+ * (typically the @ref Processor::STATS of the processor running the analyzer):
+ * @ref ITERATION_COUNT and, in WTO order, @ref COMPONENT_ITERATION_COUNT.
+ * @param stats		Statistics to record in.
+ */
+void CFGAnalyzer::recordStats(PropList& stats) const {
+	ITERATION_COUNT(stats) = icnt;
+	if(use_wto)
+		COMPONENT_ITERATION_COUNT(stats) = ccnt;
+}
+
+/**
+ * @fn int CFGAnalyzer::heldStateCount() const;
+ * Get the number of states currently held (acquired) by the analyzer.
+ * @return	Number of held states.
+ */
+
+/**
+ * @fn int CFGAnalyzer::maxHeldStateCount() const;
+ * Get the high-water mark of the number of states held by the analyzer,
+ * that is, an estimation of the memory used by the analysis.
+ * @return	Maximum number of held states.
+ */
+
+/**
+ * @fn int CFGAnalyzer::summaryCount() const;
+ * Get the number of function summaries built by the last analysis
+ * in summary mode.
+ * @return	Number of summaries.
+ */
+
+/**
+ * @fn int CFGAnalyzer::analysisCount() const;
+ * Get the number of function analyses performed by the last analysis
+ * in summary mode.
+ * @return	Number of function analyses.
+ */
+
+
+/**
+ * Summary-based analysis engine.
+ */
+class CFGAnalyzer::SummaryEngine {
+public:
+
+	// analysis of a function for an input state
+	class Summary {
+	public:
+		Summary(CFG *g, State *s, t::hash h, State *bot, bool r):
+			cfg(g), in(s), out(bot), nout(bot), hash(h), states(g->count()), dirty(false), rec(r), live(true)
+			{ for(int i = 0; i < states.count(); i++) states[i] = bot; }
+		CFG *cfg;
+		State *in, *out, *nout;
+		t::hash hash;
+		AllocArray<State *> states;
+		Vector<Summary *> users, callees;
+		bool dirty, rec, live;
+	};
+
+	// call performed during the analysis of a summary
+	class Call {
+	public:
+		inline Call(void): user(nullptr), callee(nullptr), in(nullptr), hash(0), used(nullptr), rec(false) { }
+		inline Call(Summary *u, CFG *g, State *s, t::hash h, Summary *m, bool r):
+			user(u), callee(g), in(s), hash(h), used(m), rec(r) { }
+		Summary *user;
+		CFG *callee;
+		State *in;
+		t::hash hash;
+		Summary *used;
+		bool rec;
+	};
+
+	SummaryEngine(CFGAnalyzer& analyzer):
+		an(analyzer),
+		dom(analyzer.dom),
+		cfgs(analyzer.cfgs),
+		sums(cfgs->count()),
+		recs(cfgs->count()),
+		scc(cfgs->count()),
+		recursive(cfgs->count()),
+		wpoints(cfgs->countBlocks()),
+		mutex(nullptr),
+		next(0),
+		calls(nullptr),
+		conc(false),
+		root(nullptr),
+		retired(false)
+	{
+		for(int i = 0; i < recs.count(); i++)
+			recs[i] = nullptr;
+		computeSCCs();
+		computeWideningPoints();
+	}
+
+	~SummaryEngine() {
+		for(int i = 0; i < sums.count(); i++)
+			for(auto s: sums[i])
+				release(s);
+		for(int i = 0; i < recs.count(); i++)
+			if(recs[i] != nullptr)
+				release(recs[i]);
+	}
+
+	void process() {
+
+		// perform the rounds
+		root = make(cfgs->entry(), an.s0, dom.hash(an.s0), false);
+		sums[root->cfg->index()].add(root);
+		mark(root);
+		while(!pending.isEmpty()) {
+			round = pending;
+			pending.clear();
+			for(auto s: round)
+				s->dirty = false;
+			AllocArray<Vector<Call> > cs(round.length());
+			calls = &cs;
+			run();
+			calls = nullptr;
+			for(int i = 0; i < round.length(); i++)
+				merge(round[i], cs[i]);
+			if(retired)
+				prune();
+		}
+		round.clear();
+
+		// build the results
+		for(int i = 0; i < sums.count(); i++)
+			for(auto s: sums[i])
+				record(s);
+		for(int i = 0; i < recs.count(); i++)
+			if(recs[i] != nullptr)
+				record(recs[i]);
+	}
+
+	void collect(state_collector_t f) {
+		for(int i = 0; i < sums.count(); i++)
+			for(auto s: sums[i])
+				collect(s, f);
+		for(int i = 0; i < recs.count(); i++)
+			if(recs[i] != nullptr)
+				collect(recs[i], f);
+		if(calls != nullptr)
+			for(int i = 0; i < calls->count(); i++)
+				for(auto c: (*calls)[i])
+					f(c.in);
+	}
+
+	// perform the analyses of the current round
+	void run() {
+#		ifdef OTAWA_CONC
+			if(round.length() > 1 && !an.verbose && dom.implementsConcurrency()) {
+				conc = true;
+				mutex = sys::Mutex::make();
+				next = 0;
+				Runner runner(*this);
+				WorkSpace::runAll(runner);
+				delete mutex;
+				mutex = nullptr;
+				conc = false;
+				return;
+			}
+#		endif
+		for(int i = 0; i < round.length(); i++)
+			analyze(round[i], (*calls)[i]);
+	}
+
+private:
+
+#	ifdef OTAWA_CONC
+	class Runner: public sys::Runnable {
+	public:
+		Runner(SummaryEngine& engine): e(engine) { }
+		virtual void run(void) {
+			while(true) {
+				e.mutex->lock();
+				int i = e.next++;
+				e.mutex->unlock();
+				if(i >= e.round.length())
+					return;
+				e.analyze(e.round[i], (*e.calls)[i]);
+			}
+		}
+	private:
+		SummaryEngine& e;
+	};
+#	endif
+
+	// compute the SCC of the call graph (iterative Tarjan algorithm)
+	void computeSCCs() {
+		int n = cfgs->count();
+		AllocArray<Vector<int> > succ(n);
+		for(int i = 0; i < n; i++)
+			for(auto v: *cfgs->get(i))
+				if(v->isSynth() && v->toSynth()->callee() != nullptr) {
+					int j = v->toSynth()->callee()->index();
+					if(j == i)
+						recursive.set(i);
+					if(!succ[i].contains(j))
+						succ[i].add(j);
+				}
+
+		AllocArray<int> index(n), low(n);
+		for(int i = 0; i < n; i++)
+			index[i] = -1;
+		BitVector on(n);
+		Vector<int> stack, comp;
+		Vector<Pair<int, int> > todo;
+		int cnt = 0, sc = 0;
+		for(int r = 0; r < n; r++) {
+			if(index[r] >= 0)
+				continue;
+			index[r] = low[r] = cnt++;
+			stack.push(r);
+			on.set(r);
+			todo.push(pair(r, 0));
+			while(!todo.isEmpty()) {
+				Pair<int, int>& top = todo[todo.length() - 1];
+				int v = top.fst;
+				if(top.snd < succ[v].length()) {
+					int w = succ[v][top.snd++];
+					if(index[w] < 0) {
+						index[w] = low[w] = cnt++;
+						stack.push(w);
+						on.set(w);
+						todo.push(pair(w, 0));
+					}
+					else if(on.bit(w))
+						low[v] = min(low[v], index[w]);
+				}
+				else {
+					todo.pop();
+					if(!todo.isEmpty()) {
+						int u = todo[todo.length() - 1].fst;
+						low[u] = min(low[u], low[v]);
+					}
+					if(low[v] == index[v]) {
+						comp.clear();
+						int w;
+						do {
+							w = stack.pop();
+							on.clear(w);
+							scc[w] = sc;
+							comp.add(w);
+						} while(w != v);
+						if(comp.length() > 1)
+							for(auto c: comp)
+								recursive.set(c);
+						sc++;
+					}
+				}
+			}
+		}
+	}
+
+	// the widening points are the sinks of the edges going backward in rank order
+	// (any cycle of a CFG contains at least one of them)
+	void computeWideningPoints() {
+		for(auto g: *cfgs)
+			for(auto v: *g)
+				for(auto e: v->inEdges())
+					if(RANK_OF(e->source()) >= RANK_OF(v)) {
+						wpoints.set(v->id());
+						break;
+					}
+	}
+
+	// work-list of the blocks of a CFG in rank order
+	class CFGQueue {
+		class RankComparator {
+		public:
+			typedef Block *t;
+			inline int doCompare(Block *b1, Block *b2) const { return RANK_OF(b1) - RANK_OF(b2); }
+		};
+	public:
+		CFGQueue(CFG *g): bs(g->count()) { }
+		inline operator bool() const { return !q.isEmpty(); }
+		void put(Block *b) { if(!bs.bit(b->index())) { bs.set(b->index()); q.put(b); } }
+		Block *get() { auto b = q.get(); bs.clear(b->index()); return b; }
+	private:
+		BinomialQueue<Block *, RankComparator> q;
+		BitVector bs;
+	};
+
+	// analyze a function in the context of the given summary
+	void analyze(Summary *sum, Vector<Call>& cs) {
+		if(an.verbose)
+			an.mon.log << "\tanalyzing " << sum->cfg->label() << (sum->rec ? " (recursive context)" : "") << io::endl;
+		for(int i = 0; i < sum->states.count(); i++)
+			an.assign(sum->states[i], an.bot);
+		CFGQueue todo(sum->cfg);
+		todo.put(sum->cfg->entry());
+		while(todo) {
+			auto v = todo.get();
+			State *s;
+			if(!conc)
+				dom.flush();
+
+			// entry block
+			if(v->isEntry())
+				s = sum->in;
+
+			// other blocks
+			else {
+				s = an.bot;
+				for(auto e: v->inEdges())
+					s = dom.join(s, dom.update(e, sum->states[e->source()->index()]), e);
+				if(!v->isSynth())
+					s = dom.update(v, s);
+				else if(v->toSynth()->callee() == nullptr)
+					s = an.top;
+				else if(s != an.bot && !dom.equals(s, an.bot))
+					s = call(sum, v->toSynth()->callee(), s, cs);
+			}
+
+			// record the new value
+			if(wpoints.bit(v->id()) && s != sum->states[v->index()])
+				s = dom.widen(sum->states[v->index()], s);
+			if(s == sum->states[v->index()] || dom.equals(s, sum->states[v->index()]))
+				continue;
+			an.assign(sum->states[v->index()], s);
+			for(auto e: v->outEdges())
+				todo.put(e->sink());
+		}
+		an.assign(sum->nout, sum->states[sum->cfg->exit()->index()]);
+	}
+
+	// get the output of a call using the current summaries
+	State *call(Summary *sum, CFG *g, State *s, Vector<Call>& cs) {
+		if(recursive.bit(g->index()) && scc[g->index()] == scc[sum->cfg->index()]) {
+			Summary *r = recs[g->index()];
+			an.hold(s);
+			cs.add(Call(sum, g, s, 0, r, true));
+			return r == nullptr ? an.bot : r->out;
+		}
+		t::hash h = dom.hash(s);
+		Summary *r = find(g, s, h);
+		an.hold(s);
+		cs.add(Call(sum, g, s, h, r, false));
+		return r == nullptr ? an.bot : r->out;
+	}
+
+	// commit the results of an analysis
+	void merge(Summary *sum, Vector<Call>& cs) {
+		an.acnt++;
+		if(sum->rec && sum->nout != sum->out)
+			an.assign(sum->nout, dom.widen(sum->out, sum->nout));
+		if(!dom.equals(sum->nout, sum->out)) {
+			an.assign(sum->out, sum->nout);
+			for(auto u: sum->users)
+				mark(u);
+		}
+		Vector<Summary *> old = sum->callees;
+		sum->callees.clear();
+		for(auto& c: cs) {
+			Summary *r = c.used;
+
+			// recursive call: merge the input states
+			if(c.rec) {
+				r = recs[c.callee->index()];
+				if(r == nullptr) {
+					r = make(c.callee, c.in, 0, true);
+					recs[c.callee->index()] = r;
+					mark(r);
+				}
+				else {
+					State *in = dom.widen(r->in, dom.join(r->in, c.in));
+					if(!dom.equals(in, r->in)) {
+						an.assign(r->in, in);
+						mark(r);
+					}
+				}
+			}
+
+			// common call: create the summary if needed
+			else if(r == nullptr) {
+				r = find(c.callee, c.in, c.hash);
+				if(r == nullptr) {
+					r = make(c.callee, c.in, c.hash, false);
+					sums[c.callee->index()].add(r);
+					mark(r);
+				}
+			}
+
+			if(!r->users.contains(c.user))
+				r->users.add(c.user);
+			if(!sum->callees.contains(r))
+				sum->callees.add(r);
+			an.drop(c.in);
+		}
+		for(auto r: old)
+			if(!sum->callees.contains(r))
+				retired = true;
+	}
+
+	// release the summaries that are no more reachable from the root
+	// (their calling contexts have been retired by the callers)
+	void prune() {
+		retired = false;
+		for(int i = 0; i < sums.count(); i++)
+			for(auto s: sums[i])
+				s->live = false;
+		for(int i = 0; i < recs.count(); i++)
+			if(recs[i] != nullptr)
+				recs[i]->live = false;
+		Vector<Summary *> todo;
+		root->live = true;
+		todo.push(root);
+		while(!todo.isEmpty())
+			for(auto r: todo.pop()->callees)
+				if(!r->live) {
+					r->live = true;
+					todo.push(r);
+				}
+
+		// unlink the dead summaries
+		Vector<Summary *> kept;
+		for(auto s: pending)
+			if(s->live)
+				kept.add(s);
+		pending = kept;
+		for(int i = 0; i < sums.count(); i++)
+			for(auto s: sums[i])
+				if(s->live)
+					clean(s);
+		for(int i = 0; i < recs.count(); i++)
+			if(recs[i] != nullptr && recs[i]->live)
+				clean(recs[i]);
+
+		// release them
+		for(int i = 0; i < sums.count(); i++) {
+			kept.clear();
+			for(auto s: sums[i])
+				if(s->live)
+					kept.add(s);
+				else
+					release(s);
+			sums[i] = kept;
+		}
+		for(int i = 0; i < recs.count(); i++)
+			if(recs[i] != nullptr && !recs[i]->live) {
+				release(recs[i]);
+				recs[i] = nullptr;
+			}
+	}
+
+	// remove the released summaries from the users of a summary
+	void clean(Summary *sum) {
+		Vector<Summary *> kept;
+		for(auto u: sum->users)
+			if(u->live)
+				kept.add(u);
+		sum->users = kept;
+	}
+
+	Summary *make(CFG *g, State *s, t::hash h, bool rec) {
+		Summary *r = new Summary(g, an.bot, h, an.bot, rec);
+		an.assign(r->in, s);
+		return r;
+	}
+
+	void release(Summary *sum) {
+		an.drop(sum->in);
+		an.drop(sum->out);
+		an.drop(sum->nout);
+		for(int i = 0; i < sum->states.count(); i++)
+			an.drop(sum->states[i]);
+		delete sum;
+	}
+
+	Summary *find(CFG *g, State *s, t::hash h) {
+		for(auto r: sums[g->index()])
+			if(r->hash == h && (r->in == s || dom.equals(r->in, s)))
+				return r;
+		return nullptr;
+	}
+
+	void mark(Summary *sum) {
+		if(!sum->dirty) {
+			sum->dirty = true;
+			pending.add(sum);
+		}
+	}
+
+	void record(Summary *sum) {
+		an.scnt++;
+		for(auto v: *sum->cfg)
+			an.assign(an.states[v->id()], dom.join(an.states[v->id()], sum->states[v->index()]));
+	}
+
+	void collect(Summary *sum, state_collector_t f) {
+		f(sum->in);
+		f(sum->out);
+		f(sum->nout);
+		for(int i = 0; i < sum->states.count(); i++)
+			f(sum->states[i]);
+	}
+
+	CFGAnalyzer& an;
+	Domain& dom;
+	const CFGCollection *cfgs;
+	AllocArray<Vector<Summary *> > sums;
+	AllocArray<Summary *> recs;
+	AllocArray<int> scc;
+	BitVector recursive, wpoints;
+	Vector<Summary *> pending, round;
+	sys::Mutex *mutex;
+	int next;
+	AllocArray<Vector<Call> > *calls;
+	bool conc;
+	Summary *root;
+	bool retired;
+};
+
+
 /**
  * Perform the analysis.
  */
@@ -303,8 +978,6 @@ void CFGAnalyzer::process() {
 	// initialize
 	cfgs = otawa::COLLECTED_CFG_FEATURE.get(mon.workspace());
 	ASSERTP(cfgs, "otawa::COLLECTED_CFG_FEATURE must be required first!");
-	if(trace != nullptr)
-		beginTrace();
 	State **buf = new State *[cfgs->countBlocks()];
 	states.set(cfgs->countBlocks(), buf);
 	if(verbose) {
@@ -315,12 +988,138 @@ void CFGAnalyzer::process() {
 	for(int i = 0; i < states.length(); i++)
 		states[i] = bot;
 
+	// summary mode
+	if(summaries && dom.implementsSummaries()) {
+		scnt = 0;
+		acnt = 0;
+		SummaryEngine e(*this);
+		engine = &e;
+		e.process();
+		engine = nullptr;
+		if(mon.logFor(Monitor::LOG_FUN))
+			mon.log << "\t" << scnt << " summaries, " << acnt << " function analyses\n";
+	}
+	else if(!use_wto) {
+		Queue todo(cfgs);
+		processGlobal(todo);
+	}
+	else {
+		WTOQueue todo(cfgs);
+		processGlobal(todo);
+		ccnt = todo.componentIterationCount();
+		if(mon.logFor(Monitor::LOG_FUN))
+			mon.log << "\t" << ccnt << " component iterations\n";
+	}
+	if(mon.logFor(Monitor::LOG_FUN) && !(summaries && dom.implementsSummaries()))
+		mon.log << "\t" << icnt << " block iterations\n";
+	if(mon.logFor(Monitor::LOG_FUN))
+		mon.log << "\t" << int(hwm) << " held states at most\n";
+}
+
+
+/**
+ * Hold a state: the state is acquired from the domain.
+ * @param s		Held state.
+ */
+void CFGAnalyzer::hold(State *s) {
+	if(s == bot || s == top || s == nullptr)
+		return;
+	dom.acquire(s);
+	int n = ++live, m = hwm;
+	while(n > m && !hwm.compare_exchange_weak(m, n))
+		;
+}
+
+
+/**
+ * Stop holding a state: the state is released to the domain.
+ * @param s		Dropped state.
+ */
+void CFGAnalyzer::drop(State *s) {
+	if(s == bot || s == top || s == nullptr)
+		return;
+	live--;
+	dom.release(s);
+}
+
+
+/**
+ * Inform the domain that the temporary states are no more used.
+ */
+void CFGAnalyzer::flush() {
+	dom.flush();
+	is = bot;
+	es = bot;
+}
+
+
+/**
+ * Collect the states of the summaries (summary mode).
+ * @param f		Collector function.
+ */
+void CFGAnalyzer::collectSummaries(state_collector_t f) {
+	engine->collect(f);
+}
+
+
+/**
+ * Work-list following the WTO of the program graph where a call block
+ * is followed by the entry of the callee and the exit of a function
+ * is followed by the successors of its callers.
+ */
+class WTOQueue {
+public:
+	WTOQueue(const CFGCollection *cfgs): wto(cfgs->countBlocks()), blocks(cfgs->countBlocks()), sched(nullptr) {
+		for(auto g: *cfgs)
+			for(auto v: *g) {
+				blocks[v->id()] = v;
+				if(v->isSynth() && v->toSynth()->callee() != nullptr)
+					wto.add(v->id(), v->toSynth()->callee()->entry()->id());
+				else if(v->isExit())
+					for(auto c: v->cfg()->callers())
+						for(auto e: c->outEdges())
+							wto.add(v->id(), e->sink()->id());
+				else
+					for(auto e: v->outEdges())
+						wto.add(v->id(), e->sink()->id());
+			}
+		wto.build(cfgs->entry()->entry()->id());
+		sched = new WTO::Scheduler(wto);
+	}
+	~WTOQueue() { delete sched; }
+	inline operator bool() const { return !sched->isEmpty(); }
+	inline void put(Block *v) { sched->put(v->id()); }
+	inline Block *get() { return blocks[sched->get()]; }
+	inline bool isWideningPoint() const { return sched->isWideningPoint(); }
+	inline int componentIterationCount() const { return sched->componentIterationCount(); }
+private:
+	WTO wto;
+	AllocArray<Block *> blocks;
+	WTO::Scheduler *sched;
+};
+
+static inline bool isWideningPoint(const Queue& q) { return false; }
+static inline bool isWideningPoint(const WTOQueue& q) { return q.isWideningPoint(); }
+
+
+/**
+ * Perform the analysis with a global working list over all blocks
+ * of the program.
+ * @param todo	Work-list to use.
+ */
+template <class Q>
+void CFGAnalyzer::processGlobal(Q& todo) {
+	if(trace != nullptr)
+		beginTrace();
+
 	// prepare the queue
-	//ListQueue<Block *> todo;
-	Queue todo(cfgs);
+	icnt = 0;
+	ccnt = 0;
 	todo.put(cfgs->entry()->entry());
 	while(todo) {
 		auto v = todo.get();
+		icnt++;
+		flush();
 		if(verbose) {
 			mon.log << "\tprocessing " << v << " (" << v->cfg()->label() << ")\n";
 			if(verbose_inst)
@@ -390,13 +1189,15 @@ void CFGAnalyzer::process() {
 			dom.print(is, mon.log);
 			mon.log << io::endl;
 		}
+		if(isWideningPoint(todo) && is != states[v->id()])
+			is = dom.widen(states[v->id()], is);
 		if(is == states[v->id()] || dom.equals(is, states[v->id()]))
 			/* nothing to push */;
 		else {
-			states[v->id()] = is;
+			assign(states[v->id()], is);
 			if(v->isExit())
 				for(auto c: v->cfg()->callers()) {
-					states[c->id()] = is;
+					assign(states[c->id()], is);
 					for(auto e: c->outEdges()) {
 						todo.put(e->sink());
 						if(verbose)
@@ -502,6 +1303,35 @@ void CFGAnalyzer::doTrace(Block *v, cstring t, State *s) {
 }
 
 
+/**
+ * Hold a state on behalf of the user until it is passed to release().
+ * A state may be used several times and has to be released as many times.
+ * @param s		Used state.
+ */
+void CFGAnalyzer::use(State *s) {
+	if(s == bot || s == top || s == nullptr)
+		return;
+	hold(s);
+	in_use.put(s, in_use.get(s, 0) + 1);
+}
+
+/**
+ * Release a state returned by before() or after() (or passed to use()).
+ * Releasing a state that is not used does nothing.
+ * @param s		Released state.
+ */
+void CFGAnalyzer::release(State *s) {
+	int n = in_use.get(s, 0);
+	if(n == 0)
+		return;
+	if(n == 1)
+		in_use.remove(s);
+	else
+		in_use.put(s, n - 1);
+	drop(s);
+}
+
+
 /**
  * @fn State *CFGAnalyzer::before(Edge *e);
  * Get the state before the given edge.
@@ -518,7 +1348,7 @@ void CFGAnalyzer::doTrace(Block *v, cstring t, State *s) {
  */
 State *CFGAnalyzer::after(Edge *e) {
 	is = dom.update(e, states[e->source()->id()]);
-	in_use.add(is);
+	use(is);
 	return is;
 }
 
@@ -540,7 +1370,7 @@ State *CFGAnalyzer::before(Block *b) {
 		es = dom.update(e, states[e->source()->id()]);
 		is = dom.join(is, es);
 	}
-	in_use.add(is);
+	use(is);
 	return is;
 }
 
@@ -0,0 +1,391 @@
+/*
+ *	WTO class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <otawa/ai/WTO.h>
+
+namespace otawa { namespace ai {
+
+/**
+ * @class WTO
+ * Weak Topological Order (WTO) of a graph as defined by F. Bourdoncle
+ * ("Efficient chaotic iteration strategies with widenings", 1993).
+ *
+ * A WTO is a hierarchical ordering of the vertices where each component
+ * (a strongly connected sub-graph) is headed by a vertex, its head, and
+ * each edge going backward in the order targets the head of a component
+ * containing its source. Iterating the components until their head is
+ * stable (recursive iteration strategy) stabilizes inner loops before
+ * outer loops and the heads are the only required widening points.
+ *
+ * The vertices are designed by their index in [0, count()). The graph
+ * is given by the add() of its edges (or by make()) and the WTO is
+ * computed by build(). The WTO is then represented as a flat sequence
+ * of vertices where each head at position i is followed by the vertices
+ * of its component up to position endOf(i) (excluded).
+ *
+ * @ingroup ai
+ */
+
+
+/**
+ * Build an empty WTO.
+ * @param count		Number of vertices.
+ */
+WTO::WTO(int count): _succs(count), _pos(count), _heads(count) {
+	for(int i = 0; i < count; i++)
+		_pos[i] = -1;
+}
+
+
+///
+WTO::~WTO() {
+	for(auto p: _parts)
+		delete p;
+}
+
+
+/**
+ * Add an edge to the graph.
+ * @param v		Source vertex.
+ * @param w		Sink vertex.
+ */
+void WTO::add(int v, int w) {
+	_succs[v].add(w);
+}
+
+
+/**
+ * @fn void WTO::make(const G& graph);
+ * Build the WTO of a graph, starting from its entry. The graph G must provide
+ * entry(), count(), index(), succs() and sinkOf() (like CFGGraph).
+ * @param graph		Graph to build WTO for.
+ */
+
+
+/**
+ * Compute the WTO from the given entry vertex. Only the vertices
+ * reachable from entry are part of the WTO.
+ *
+ * This is the algorithm of Bourdoncle based on Tarjan SCC algorithm
+ * but written with an explicit stack to support big graphs.
+ *
+ * @param entry		Entry vertex.
+ */
+void WTO::build(int entry) {
+	static const int done = type_info<int>::max;
+
+	// a frame of the visit (sub >= 0 for component building)
+	class Frame {
+	public:
+		inline Frame(void): v(-1), i(0), head(0), loop(false), part(-1), sub(-1) { }
+		inline Frame(int _v, int h, int p): v(_v), i(0), head(h), loop(false), part(p), sub(-1) { }
+		int v, i, head;
+		bool loop;
+		int part, sub;
+	};
+
+	AllocArray<int> dfn(count());
+	for(int i = 0; i < count(); i++)
+		dfn[i] = 0;
+	Vector<int> stack;
+	Vector<Frame> frames;
+	int num = 0;
+
+	// prepare the root partition
+	_parts.add(new Vector<int>());
+	_partHead.add(-1);
+	stack.push(entry);
+	dfn[entry] = ++num;
+	frames.push(Frame(entry, num, 0));
+
+	while(!frames.isEmpty()) {
+		Frame& f = frames[frames.length() - 1];
+
+		// visit the successors
+		if(f.i < _succs[f.v].length()) {
+			int w = _succs[f.v][f.i++];
+			if(f.sub >= 0) {
+				if(dfn[w] == 0) {
+					stack.push(w);
+					dfn[w] = ++num;
+					frames.push(Frame(w, num, f.sub));
+				}
+			}
+			else if(dfn[w] == 0) {
+				int p = f.part;
+				stack.push(w);
+				dfn[w] = ++num;
+				frames.push(Frame(w, num, p));
+			}
+			else if(dfn[w] <= f.head) {
+				f.head = dfn[w];
+				f.loop = true;
+			}
+			continue;
+		}
+
+		// end of the visit
+		if(f.sub < 0 && f.head == dfn[f.v]) {
+			dfn[f.v] = done;
+			int e = stack.pop();
+			if(f.loop) {
+				while(e != f.v) {
+					dfn[e] = 0;
+					e = stack.pop();
+				}
+				f.sub = _parts.length();
+				_parts.add(new Vector<int>());
+				_partHead.add(f.v);
+				f.i = 0;
+				continue;
+			}
+			_parts[f.part]->add(f.v);
+		}
+		else if(f.sub >= 0)
+			_parts[f.part]->add(-f.sub - 1);
+
+		// return to the caller frame
+		int h = f.head;
+		frames.pop();
+		if(!frames.isEmpty()) {
+			Frame& c = frames[frames.length() - 1];
+			if(c.sub < 0 && h <= c.head) {
+				c.head = h;
+				c.loop = true;
+			}
+		}
+	}
+
+	// flatten the partitions
+	flatten(0);
+}
+
+
+/**
+ * Flatten the given partition in the order (partitions are recorded
+ * in reverse order).
+ * @param part	Partition to flatten.
+ */
+void WTO::flatten(int part) {
+	Vector<int>& p = *_parts[part];
+	for(int i = p.length() - 1; i >= 0; i--) {
+		int pos = _order.length();
+		if(p[i] >= 0) {
+			_order.add(p[i]);
+			_end.add(pos + 1);
+			_pos[p[i]] = pos;
+		}
+		else {
+			int sub = -p[i] - 1, h = _partHead[sub];
+			_order.add(h);
+			_end.add(pos + 1);
+			_pos[h] = pos;
+			_heads.set(h);
+			flatten(sub);
+			_end[pos] = _order.length();
+		}
+	}
+}
+
+
+/**
+ * @fn int WTO::count() const;
+ * Get the number of vertices of the graph.
+ * @return	Vertex count.
+ */
+
+/**
+ * @fn int WTO::length() const;
+ * Get the number of vertices in the WTO (reachable from the entry).
+ * @return	WTO length.
+ */
+
+/**
+ * @fn int WTO::at(int i) const;
+ * Get the vertex at the given position.
+ * @param i		Position in the WTO.
+ * @return		Vertex at position i.
+ */
+
+/**
+ * @fn int WTO::endOf(int i) const;
+ * Get the position following the component headed by the vertex at position i
+ * or i + 1 if this vertex is not a head.
+ * @param i		Position in the WTO.
+ * @return		End position of the component.
+ */
+
+/**
+ * @fn int WTO::positionOf(int v) const;
+ * Get the position of a vertex in the WTO.
+ * @param v		Looked vertex.
+ * @return		Position of v or -1 if v is not reachable.
+ */
+
+/**
+ * @fn bool WTO::contains(int v) const;
+ * Test if a vertex is part of the WTO.
+ * @param v		Tested vertex.
+ * @return		True if v is reachable from the entry, false else.
+ */
+
+/**
+ * @fn bool WTO::isHead(int v) const;
+ * Test if a vertex is the head of a component.
+ * @param v		Tested vertex.
+ * @return		True if v is a head, false else.
+ */
+
+
+/**
+ * Print the WTO with the parenthesized notation of Bourdoncle.
+ * @param out	Stream to output to.
+ */
+void WTO::print(io::Output& out) const {
+	Vector<int> ends;
+	for(int i = 0; i < _order.length(); i++) {
+		while(!ends.isEmpty() && ends[ends.length() - 1] == i) {
+			out << ')';
+			ends.pop();
+		}
+		if(i != 0)
+			out << ' ';
+		if(isHead(_order[i])) {
+			out << '(';
+			ends.push(_end[i]);
+		}
+		out << _order[i];
+	}
+	while(!ends.isEmpty()) {
+		out << ')';
+		ends.pop();
+	}
+}
+
+
+/**
+ * @class WTO::Scheduler
+ * Work-list following the recursive iteration strategy of a WTO:
+ * the vertices are taken in WTO order and, at the end of a component,
+ * the component is iterated again while its head has been put back.
+ * Only the vertices that have been put are returned.
+ *
+ * @ingroup ai
+ */
+
+
+/**
+ * Build the scheduler.
+ * @param wto	WTO to follow (must be built).
+ */
+WTO::Scheduler::Scheduler(const WTO& wto):
+	_wto(wto), _dirty(wto.count()), _cur(0), _pending(0), _cnt(0), _ccnt(0), _widen(false)
+{
+}
+
+
+/**
+ * Put a vertex in the work-list. Vertices not in the WTO are ignored.
+ * @param v		Put vertex.
+ */
+void WTO::Scheduler::put(int v) {
+	if(_wto.contains(v) && !_dirty.bit(v)) {
+		_dirty.set(v);
+		_pending++;
+	}
+}
+
+
+/**
+ * Get the next vertex to process.
+ * @return	Next vertex or -1 if there is no more vertex.
+ */
+int WTO::Scheduler::get() {
+	while(_pending != 0) {
+
+		// end of component: iterate again if the head is put back
+		if(!_comps.isEmpty() && _cur >= _wto.endOf(_comps[_comps.length() - 1].fst)) {
+			Pair<int, int>& c = _comps[_comps.length() - 1];
+			if(_dirty.bit(_wto.at(c.fst))) {
+				c.snd++;
+				_ccnt++;
+				_cur = c.fst;
+			}
+			else
+				_comps.pop();
+			continue;
+		}
+
+		// end of WTO: only reached if vertices are put against the WTO order
+		if(_cur >= _wto.length()) {
+			_cur = 0;
+			continue;
+		}
+
+		// next vertex
+		int p = _cur++, v = _wto.at(p);
+		bool again = false;
+		if(_wto.isHead(v)) {
+			if(!_comps.isEmpty() && _comps[_comps.length() - 1].fst == p)
+				again = _comps[_comps.length() - 1].snd > 0;
+			else
+				_comps.push(pair(p, 0));
+		}
+		if(_dirty.bit(v)) {
+			_dirty.clear(v);
+			_pending--;
+			_widen = again;
+			_cnt++;
+			return v;
+		}
+	}
+	return -1;
+}
+
+
+/**
+ * @fn bool WTO::Scheduler::isEmpty() const;
+ * Test if there are vertices to process.
+ * @return	True if there is no more vertex to process, false else.
+ */
+
+/**
+ * @fn bool WTO::Scheduler::isWideningPoint() const;
+ * Test if the last vertex returned by get() is a head whose component
+ * is iterated again, that is, a point where widening has to be applied.
+ * @return	True if widening has to be applied.
+ */
+
+/**
+ * @fn int WTO::Scheduler::iterationCount() const;
+ * Get the number of vertices returned by get().
+ * @return	Number of processed vertices.
+ */
+
+/**
+ * @fn int WTO::Scheduler::componentIterationCount() const;
+ * Get the number of component iterations, that is, the number of times
+ * a component has been iterated again because its head was not stable.
+ * @return	Number of component iterations.
+ */
+
+} }	// otawa::ai
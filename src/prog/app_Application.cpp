@@ -19,14 +19,19 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include "config.h"
+#include <elm/data/Array.h>
 #include <elm/io/ansi.h>
+#include <elm/sys/StopWatch.h>
 #include <elm/sys/System.h>
+#include <elm/sys/Thread.h>
 #include <otawa/app/Application.h>
 #include <otawa/cfgio/Output.h>
 #include <otawa/proc/ProcessorPlugin.h>
 #include <otawa/stats/features.h>
 #include <otawa/util/SymAddress.h>
 #include <otawa/prog/Manager.h>
+#include <otawa/prog/TextDecoder.h>
 
 #include "../../include/otawa/flowfact/FlowFactLoader.h"
 
@@ -96,7 +101,22 @@ namespace otawa {
  * @li -h|--help -- option help display,
  * @li --load-param ID=VALUE -- add a load parameter (passed to the manager load command)
  * @li --log one of proc, deps, cfg, bb or inst -- select level of log
- * @li -v|--verbose -- verbose mode activation.
+ * @li -v|--verbose -- verbose mode activation,
+ * @li --parallel-tasks -- process the tasks concurrently (see below),
+ * @li --share FEATURE -- with --parallel-tasks, compute FEATURE once for all tasks
+ * (only for features storing their data in the process).
+ *
+ * @par Parallel Tasks
+ *
+ * With --parallel-tasks and several task entries, the tasks are processed concurrently
+ * (if OTAWA is compiled with concurrency support), each one in its own workspace built
+ * on the same process. The task-independent features whose data is stored in the process
+ * (@ref DECODED_TEXT, the flow facts and the features given with --share) are computed
+ * once, before the tasks are launched, and shared by the task workspaces. The per-task analyses
+ * (CFG building, loops, cache, etc) are performed in the workspace of each task.
+ * In this mode, the application should report the result of a task with result() instead of
+ * printing it: at the end, a table gives, for each task, its status, its result and its
+ * processing time.
  *
  * In addition, you can also defines your own options using the @ref elm::option classes:
  * @code
@@ -297,6 +317,8 @@ Application::Application(const Make& make):
 	record_stats(option::SwitchOption::Make(this).cmd("--stats").help("outputs available statistics in work directory")),
 	log_for(option::ListOption<string>::Make(this).cmd("--log-for").help("only apply logging to the given processor")),
 	dump_for(option::ListOption<string>::Make(this).cmd("--dump-for").help("dump results of the named analyzes").arg("ANALYSIS NAME")),
+	parallel_tasks(option::SwitchOption::Make(this).cmd("--parallel-tasks").help("process the tasks concurrently, each one in its own workspace")),
+	share(option::ListOption<string>::Make(this).cmd("--share").help("with --parallel-tasks, feature computed once and shared by all tasks").arg("FEATURE")),
 	log_level(*this),
 	props2(0),
 	ws(0)
@@ -450,6 +472,10 @@ void Application::complete(PropList& props) {
  * @throw	elm::Exception	For any found error.
  */
 void Application::work(PropList &props) {
+	if(isParallel()) {
+		workAll(props);
+		return;
+	}
 	for(int i = 0; i < _args.count(); i++) {
 		startTask(_args[i]);
 		work(_args[i], *props2);
@@ -458,6 +484,206 @@ void Application::work(PropList &props) {
 }
 
 
+/**
+ * A task processed in parallel.
+ */
+class Application::Task {
+public:
+	inline Task(void): ws(nullptr), time(0) { }
+	string entry;
+	Address addr;
+	WorkSpace *ws;
+	string res, err;
+	t::int64 time;
+};
+
+
+/**
+ * Runnable processing the tasks one after the other.
+ */
+class Application::TaskRunner: public sys::Runnable {
+public:
+	TaskRunner(Application& app, AllocArray<Task>& tasks, const Vector<const AbstractFeature *>& shared)
+		: _app(app), _tasks(tasks), _shared(shared), _next(0), _mutex(nullptr)
+	{
+#		ifdef OTAWA_CONC
+			_mutex = sys::Mutex::make();
+#		endif
+	}
+
+	~TaskRunner(void) {
+		if(_mutex != nullptr)
+			delete _mutex;
+	}
+
+	inline const Vector<const AbstractFeature *>& shared(void) const { return _shared; }
+	inline void lock(void) { if(_mutex != nullptr) _mutex->lock(); }
+	inline void unlock(void) { if(_mutex != nullptr) _mutex->unlock(); }
+
+	void run(void) override {
+		while(true) {
+			lock();
+			int i = _next++;
+			unlock();
+			if(i >= _tasks.count())
+				break;
+			if(_tasks[i].err.isEmpty())
+				_app.runTask(_tasks[i], *this);
+		}
+	}
+
+private:
+	Application& _app;
+	AllocArray<Task>& _tasks;
+	const Vector<const AbstractFeature *>& _shared;
+	int _next;
+	sys::Mutex *_mutex;
+};
+
+thread_local Application::Task *Application::cur_task = nullptr;
+
+
+// count the properties of a property list
+static int countProps(const PropList *props) {
+	int cnt = 0;
+	for(PropList::Iter prop(props); prop(); prop++)
+		cnt++;
+	return cnt;
+}
+
+
+/**
+ * Process the tasks concurrently (--parallel-tasks option).
+ * The flow facts are loaded before launching the tasks and shared.
+ * Only the features storing their data in the process or in the program
+ * files can be shared: a feature given with --share that adds properties
+ * to the workspace (like @ref COLLECTED_CFG_FEATURE) is rejected.
+ * @param props		Configuration properties.
+ */
+void Application::workAll(PropList& props) {
+
+	// compute the shared features
+	Vector<const AbstractFeature *> shared;
+	shared.add(&DECODED_TEXT);
+	for(auto name: share) {
+		AbstractIdentifier *id = AbstractIdentifier::find(name);
+		if(id == nullptr)
+			id = ProcessorPlugin::getIdentifier(name.toCString());
+		if(id == nullptr || !p::is_feature(id))
+			throw option::OptionException(_ << "unknown feature \"" << name << "\"");
+		shared.add(static_cast<const AbstractFeature *>(id));
+	}
+	ws->require(DECODED_TEXT, props);
+	for(int i = 1; i < shared.length(); i++) {
+		int cnt = countProps(ws);
+		ws->require(*shared[i], props);
+		if(countProps(ws) != cnt)
+			throw option::OptionException(_ << "feature \"" << shared[i]->name()
+				<< "\" stores its data in the workspace and cannot be shared");
+	}
+
+	// the flow facts are stored on the instructions of the process:
+	// they are loaded once, out of the tasks, and never removed by a task
+	ws->require(FLOW_FACTS_FEATURE, props);
+	shared.add(&FLOW_FACTS_FEATURE);
+	shared.add(&MKFF_PRESERVATION_FEATURE);
+
+	// prepare the tasks
+	AllocArray<Task> tasks(_args.count());
+	for(int i = 0; i < _args.count(); i++) {
+		tasks[i].entry = _args[i];
+		try {
+			tasks[i].addr = parseAddress(_args[i]);
+		}
+		catch(otawa::Exception& e) {
+			tasks[i].err = e.message();
+		}
+	}
+
+	// process them
+	TaskRunner runner(*this, tasks, shared);
+	WorkSpace::runAll(runner);
+
+	// output the results
+	cout << "TASK\tSTATUS\tTIME (ms)\tRESULT\n";
+	for(int i = 0; i < tasks.count(); i++) {
+		cout << tasks[i].entry;
+		if(!tasks[i].err.isEmpty())
+			cout << "\terror\t-\t" << tasks[i].err << io::endl;
+		else
+			cout << "\tok\t" << (tasks[i].time / 1000) << "\t" << tasks[i].res << io::endl;
+	}
+}
+
+
+/**
+ * Process a task in its own workspace.
+ * @param task		Processed task.
+ * @param runner	Current runner.
+ */
+void Application::runTask(Task& task, TaskRunner& runner) {
+	sys::StopWatch sw;
+	sw.start();
+	cur_task = &task;
+	task.ws = new WorkSpace(ws);
+	task.ws->name(task.entry);
+	if(work_dir)
+		task.ws->workDir(sys::Path(*work_dir) / task.entry);
+	for(auto f: runner.shared())
+		task.ws->share(*f);
+	try {
+		runner.lock();
+		PropList tprops(props);
+		runner.unlock();
+		TASK_ADDRESS(tprops) = task.addr;
+		if(record_stats)
+			Processor::COLLECT_STATS(tprops) = true;
+		work(task.entry, tprops);
+
+		// statistics use the shared configuration
+		if(record_stats) {
+			runner.lock();
+			try {
+				stats();
+			}
+			catch(elm::Exception& e) {
+				task.err = e.message();
+			}
+			runner.unlock();
+		}
+	}
+	catch(elm::Exception& e) {
+		task.err = e.message();
+	}
+	delete task.ws;
+	task.ws = nullptr;
+	cur_task = nullptr;
+	sw.stop();
+	task.time = sw.delay().micros();
+}
+
+
+/**
+ * Record the result of the current task. In parallel mode (see isParallel()),
+ * the results are displayed in a table at the end of the processing of the tasks.
+ * Else, this function does nothing.
+ * @param value		Result of the task.
+ */
+void Application::result(const string& value) {
+	if(cur_task != nullptr)
+		cur_task->res = value;
+}
+
+
+/**
+ * @fn bool Application::isParallel(void) const;
+ * Test if the tasks are processed in parallel (option --parallel-tasks with
+ * several tasks). In this case, work(const string&, PropList&) is called
+ * concurrently, each task having its own workspace.
+ * @return	True if the tasks are processed in parallel.
+ */
+
+
 /**
  * Start the processing of the task corresponding to the entry.
  * @param entry	Entry to process.
@@ -572,10 +798,16 @@ void Application::work(const string& entry, PropList &props) {
 
 
 /**
- * @fn WorkSpace *Application::workspace(void);
- * Provide the current workspace.
+ * Provide the current workspace. When the tasks are processed in parallel,
+ * this is the workspace of the task processed by the current thread.
  * @return	Current workspace.
  */
+WorkSpace *Application::workspace(void) const {
+	if(cur_task != nullptr)
+		return cur_task->ws;
+	else
+		return ws;
+}
 
 
 /**
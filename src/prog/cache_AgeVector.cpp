@@ -0,0 +1,228 @@
+/*
+ *	AgeVector class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <otawa/cache/cat2/AgeVector.h>
+
+namespace otawa {
+
+namespace {
+
+// free lists of age vectors by size class (16 bytes granularity)
+class AgePool {
+public:
+	~AgePool(void) {
+		for(int i = 0; i < heads.length(); i++)
+			while(heads[i]) {
+				void *a = heads[i];
+				heads[i] = next(a);
+				::operator delete(a);
+			}
+	}
+
+	static inline void *next(void *a)
+		{ void *n; memcpy(&n, a, sizeof(n)); return n; }
+	static inline void link(void *a, void *n)
+		{ memcpy(a, &n, sizeof(n)); }
+
+	Vector<void *> heads;
+};
+
+thread_local AgePool pool;
+
+inline int classOf(int bytes) {
+	return bytes <= 0 ? 0 : (bytes - 1) >> 4;
+}
+
+}	// local
+
+/**
+ * @class AgeVector
+ * Storage and operations of the age vectors used by the abstract cache states
+ * of the CAT2 analyses (MUSTProblem, PERSProblem and MAYProblem).
+ *
+ * An age vector records for each cache block of a set its age, from 0 (newest)
+ * to A - 1 (oldest), -1 meaning that the block is not in the set (PERSProblem
+ * uses also A to represent a wiped block). As the associativity A is usually
+ * small, the ages are stored as bytes when A <= max_assoc: this divides by 4 the
+ * memory of the states and the join and update operations are written as
+ * branch-free loops that the compiler can turn in SIMD code. For larger
+ * associativities (fully associative caches), the ages are stored as int.
+ * The width is selected when the vector is made and the operations dispatch
+ * once per vector on it.
+ *
+ * The vectors are allocated by size classes of 16 bytes and the released vectors
+ * are kept in per-thread free lists to be re-used by the next states of the fix
+ * point computation. As the vector does not record its size, the size has to be
+ * passed to all operations and the vector released explicitly with free().
+ */
+
+
+/**
+ * @typedef AgeVector::age_t
+ * Type of an age in a vector of bytes.
+ */
+
+
+/**
+ * @typedef AgeVector::wide_t
+ * Type of an age in a vector for associativities greater than max_assoc.
+ */
+
+
+/**
+ * Allocate memory for an age vector (content is undefined).
+ * @param bytes	Size in bytes.
+ * @return		Allocated memory.
+ */
+void *AgeVector::alloc(int bytes) {
+	int c = classOf(bytes);
+	if(c < pool.heads.length() && pool.heads[c]) {
+		void *a = pool.heads[c];
+		pool.heads[c] = AgePool::next(a);
+		return a;
+	}
+	return ::operator new((c + 1) << 4);
+}
+
+
+/**
+ * Release the memory of an age vector allocated by alloc().
+ * @param p		Released memory.
+ * @param bytes	Size in bytes (as passed to alloc()).
+ */
+void AgeVector::release(void *p, int bytes) {
+	int c = classOf(bytes);
+	while(pool.heads.length() <= c)
+		pool.heads.add(nullptr);
+	AgePool::link(p, pool.heads[c]);
+	pool.heads[c] = p;
+}
+
+
+/**
+ * @fn void AgeVector::make(int size, int A, int init);
+ * Allocate the ages and initialize them.
+ * @param size	Number of blocks.
+ * @param A		Associativity (selects the width of the ages).
+ * @param init	Initial age of the blocks.
+ */
+
+/**
+ * @fn void AgeVector::copy(const AgeVector& v, int size);
+ * Allocate the ages as a copy of another vector.
+ * @param v		Copied vector.
+ * @param size	Number of blocks.
+ */
+
+/**
+ * @fn void AgeVector::free(int size);
+ * Release the ages.
+ * @param size	Number of blocks.
+ */
+
+/**
+ * @fn int AgeVector::operator[](int i) const;
+ * Get an age.
+ * @param i		Block index.
+ * @return		Block age.
+ */
+
+/**
+ * @fn void AgeVector::set(int i, int a);
+ * Set an age.
+ * @param i		Block index.
+ * @param a		New age.
+ */
+
+/**
+ * @fn void AgeVector::fill(int size, int init);
+ * Set all ages of the vector.
+ * @param size	Number of blocks.
+ * @param init	Age to set.
+ */
+
+/**
+ * @fn void AgeVector::assign(const AgeVector& v, int size);
+ * Copy an age vector of the same width into this one.
+ * @param v		Source vector.
+ * @param size	Number of blocks.
+ */
+
+/**
+ * @fn bool AgeVector::equals(const AgeVector& v, int size) const;
+ * Test if two age vectors of the same width are equal.
+ * @param v		Compared vector.
+ * @param size	Number of blocks.
+ * @return		True if they are equal, false else.
+ */
+
+/**
+ * @fn void AgeVector::minAge(const AgeVector& v, int size);
+ * Set the minimum of the ages of this vector and of v, the absent blocks (-1) being
+ * considered as older than any age (MUST intersection and MAY union).
+ * @param v		Second vector.
+ * @param size	Number of blocks.
+ */
+
+/**
+ * @fn void AgeVector::maxAge(const AgeVector& v, int size);
+ * Set the maximum of the ages of this vector and of v, the absent blocks (-1) being
+ * considered as older than any age (MUST union).
+ * @param v		Second vector.
+ * @param size	Number of blocks.
+ */
+
+/**
+ * @fn void AgeVector::maxKnown(const AgeVector& v, int size);
+ * Set the maximum of the ages of this vector and of v, the absent blocks (-1) being
+ * considered as younger than any age (PERS union).
+ * @param v		Second vector.
+ * @param size	Number of blocks.
+ */
+
+/**
+ * @fn void AgeVector::ageAll(int size, int A);
+ * Increment the age of all present blocks, the blocks reaching age A
+ * being removed (LRU update on a miss).
+ * @param size	Number of blocks.
+ * @param A		Associativity.
+ */
+
+/**
+ * @fn void AgeVector::ageYounger(int size, int limit);
+ * Increment the age of the present blocks whose age is less than limit
+ * (LRU update on a hit).
+ * @param size	Number of blocks.
+ * @param limit	Limit age (in [0, A]).
+ */
+
+/**
+ * @fn void AgeVector::ageKept(int size, int limit, int A);
+ * Increment the age of the present and not wiped (age A) blocks whose age
+ * is less than limit (PERS update).
+ * @param size	Number of blocks.
+ * @param limit	Limit age (A + 1 to age all kept blocks).
+ * @param A		Associativity.
+ */
+
+}	// otawa
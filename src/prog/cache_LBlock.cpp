@@ -58,10 +58,11 @@ LBlock::LBlock(LBlockSet *lbset, BasicBlock *bb, Inst *inst, t::uint32 size, int
 
 
 /**
+ * The l-blocks are built in the memory of their l-block set and destroyed
+ * with it: the destructor does not release any memory.
  */
 LBlock::~LBlock(void) {
-	delete this;
-};
+}
 
 
 /**
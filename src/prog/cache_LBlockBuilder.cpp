@@ -20,6 +20,8 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include "config.h"
+#include <new>
 #include <elm/assert.h>
 #include <elm/data/HashMap.h>
 #include <elm/data/Array.h>
@@ -36,6 +38,7 @@
 #include <otawa/proc/ProcessorException.h>
 #include <otawa/ipet/IPET.h>
 #include <otawa/cfg/CFGCollector.h>
+#include <otawa/prog/WorkSpace.h>
 
 namespace otawa { namespace cache {
 
@@ -65,7 +68,8 @@ p::declare LBlockBuilder::reg = p::init("otawa::util::LBlockBuilder", Version(1,
 /**
  * Build a new l-block builder.
  */
-LBlockBuilder::LBlockBuilder(AbstractRegistration& r): BBProcessor(r), lbsets(nullptr), cache(nullptr), mem(nullptr) {
+LBlockBuilder::LBlockBuilder(AbstractRegistration& r)
+:	BBProcessor(r), lbsets(nullptr), cache(nullptr), mem(nullptr), mutex(nullptr) {
 }
 
 
@@ -91,7 +95,7 @@ void LBlockBuilder::setup(WorkSpace *fw) {
 	LBLOCKS(fw) = lbsets;
 	for(int i = 0; i < cache->rowCount(); i++) {
 		lbsets[i] = new LBlockSet(i, cache);
-		new LBlock(lbsets[i], 0, 0, 0, 0, 0);
+		new(lbsets[i]->alloc()) LBlock(lbsets[i], 0, 0, 0, 0, 0);
 		ASSERT(lbsets[i]->cacheBlockCount() == 1);
 	}
 }
@@ -104,53 +108,117 @@ void LBlockBuilder::cleanup(WorkSpace *fw) {
 
 	// Add end blocks
 	for(int i = 0; i < cache->rowCount(); i++)
-		new LBlock(lbsets[i], 0, 0, 0, lbsets[i]->cacheBlockCount(), 0);
+		new(lbsets[i]->alloc()) LBlock(lbsets[i], 0, 0, 0, lbsets[i]->cacheBlockCount(), 0);
 }
 
 
 /**
- * Add an lblock to the lblock lists.
+ * Record an l-block of a basic block: it is the first pass of the l-block
+ * building that only depends on the block and on the cache and memory
+ * description and can be performed concurrently.
  * @param bb		Basic block containing the l-block.
- * @param inst		Starting instruction of L-Block to create..
- * @param index		Index in the BB lblock table.
- * @paramlblocks	BB lblock table.
+ * @param inst		Starting instruction of L-Block to create.
+ * @param addr		Address of the l-block.
+ * @param scan		Scan to add the l-block to.
  */
-void LBlockBuilder::addLBlock(BasicBlock *bb, Inst *inst, int& index, AllocArray<LBlock*> *lblocks, Address addr) {
+void LBlockBuilder::addItem(BasicBlock *bb, Inst *inst, Address addr, Scan& scan) {
+	Item item;
+	item.inst = inst;
+	item.addr = addr;
 
 	// test if the l-block is cacheable
-	// Address addr = inst->address();
 	const hard::Bank *bank = mem->get(addr);
 	if(!bank)
-		log << "WARNING: no memory bank for code at " << addr << ": block considered as cached.\n";
-	else if(!bank->isCached()) {
-		if(isVerbose())
-			log << "\t\t\t\t" << "INFO: block " << addr << " not cached.\n";
-		return;
-	}
-
-	// compute the cache block ID
-	LBlockSet *lbset = lbsets[cache->set(addr)];
-	ot::mask block = cache->block(addr);
+		item.status = NO_BANK;
+	else if(!bank->isCached())
+		item.status = NOT_CACHED;
+	else
+		item.status = CACHED;
 
-	int cid = block_map.get(block, -1);
-	if(cid < 0) {
-		cid = lbset->cacheBlockCount();
-		block_map.put(block, cid);
-	}
+	// compute the cache block
+	item.set = cache->set(addr);
+	item.block = cache->block(addr);
 
 	// Compute the size
 	Address top = (addr + cache->blockMask() +1) & ~cache->blockMask();
 	if(top > bb->address() + bb->size())
 		top = bb->address() + bb->size();
+	item.size = top - addr;
 
-	// Build the lblock
-	LBlock *lblock = new LBlock(lbset, bb, inst, top - addr, cid, addr);
-	lblocks->set(index, lblock);
-	if(logFor(LOG_BB))
-		log << "\t\t\t\tblock at " << addr << " size " << top-addr
-			<< " (cache block " << cache->round(addr)
-			<< ", cid = " << cid << ")\n";
-	index++;
+	scan.items.add(item);
+}
+
+
+/**
+ * Scan the instructions of a basic block to find its l-blocks.
+ * @param bb	Scanned basic block.
+ * @param scan	Scan to add the l-blocks to.
+ */
+void LBlockBuilder::scan(BasicBlock *bb, Scan& scan) {
+	hard::Cache::set_t set = cache->set(bb->first()->address()) - 1;
+	for(BasicBlock::InstIter inst = bb->insts(); inst(); inst++) {
+		if(set != cache->set(inst->address())) {
+			set = cache->set(inst->address());
+			addItem(bb, *inst, inst->address(), scan);
+		}
+
+		if(set != cache->set(inst->address() + inst->size() - 1)) { // in case an instruction crosses cache-block
+			set = cache->set(inst->address() + inst->size() - 1);
+			addItem(bb, *inst, cache->round(inst->address().offset() + inst->size() - 1), scan);
+		}
+	}
+	scan.bbs.add(pair(bb, scan.items.length()));
+}
+
+
+/**
+ * Build the l-blocks and the BB_LBLOCKS tables of the scanned basic blocks
+ * (second pass of the l-block building, to be performed sequentially
+ * in the block order to keep the l-block and cache block numbering).
+ * @param scan	Scan of the basic blocks.
+ */
+void LBlockBuilder::build(const Scan& scan) {
+	int i = 0;
+	for(auto p: scan.bbs) {
+		BasicBlock *bb = p.fst;
+
+		// allocate the BB lblock table (un-cached blocks are not counted)
+		int n = 0;
+		for(int j = i; j < p.snd; j++)
+			if(scan.items[j].status != NOT_CACHED)
+				n++;
+		AllocArray<LBlock*> *lblocks = new AllocArray<LBlock*>(n);
+		BB_LBLOCKS(bb) = lblocks;
+
+		// build the l-blocks
+		int index = 0;
+		for(; i < p.snd; i++) {
+			const Item& item = scan.items[i];
+			if(item.status == NO_BANK)
+				log << "WARNING: no memory bank for code at " << item.addr << ": block considered as cached.\n";
+			else if(item.status == NOT_CACHED) {
+				if(isVerbose())
+					log << "\t\t\t\t" << "INFO: block " << item.addr << " not cached.\n";
+				continue;
+			}
+
+			// compute the cache block ID
+			LBlockSet *lbset = lbsets[item.set];
+			int cid = block_map.get(item.block, -1);
+			if(cid < 0) {
+				cid = lbset->cacheBlockCount();
+				block_map.put(item.block, cid);
+			}
+
+			// Build the lblock
+			LBlock *lblock = new(lbset->alloc()) LBlock(lbset, bb, item.inst, item.size, cid, item.addr);
+			lblocks->set(index++, lblock);
+			if(logFor(LOG_BB))
+				log << "\t\t\t\tblock at " << item.addr << " size " << item.size
+					<< " (cache block " << cache->round(item.addr)
+					<< ", cid = " << cid << ")\n";
+		}
+	}
 }
 
 
@@ -164,36 +232,81 @@ void LBlockBuilder::processBB(WorkSpace *fw, CFG *cfg, Block *b) {
 	// Do not process entry and exit
 	if (!b->isBasic())
 		return;
-	BasicBlock *bb = b->toBasic();
 
-	// Allocate the BB lblock table
-	int num_lblocks =
-		((bb->address().offset() + bb->size() + cache->blockMask()) >> cache->blockBits())
-		- (bb->address().offset() >> cache->blockBits());
-	AllocArray<LBlock*> *lblocks = new AllocArray<LBlock*>(num_lblocks);
-	BB_LBLOCKS(bb) = lblocks;
+	Scan s;
+	scan(b->toBasic(), s);
+	build(s);
+}
 
-	// Traverse instruction
-	int index = 0;
-	hard::Cache::set_t set = cache->set(bb->first()->address()) - 1;
-	for(BasicBlock::InstIter inst = bb->insts(); inst(); inst++) {
-		if(set != cache->set(inst->address())) {
-			set = cache->set(inst->address());
-			addLBlock(bb, *inst, index, lblocks, inst->address());
-		}
 
-		if(set != cache->set(inst->address() + inst->size() - 1)) { // in case an instruction crosses cache-block
-			set = cache->set(inst->address() + inst->size() - 1);
-			addLBlock(bb, *inst, index, lblocks, cache->round(inst->address().offset() + inst->size() - 1));
+/**
+ * Scan the CFGs concurrently.
+ */
+class LBlockScanner: public sys::Runnable {
+public:
+	LBlockScanner(LBlockBuilder& builder, const CFGCollection& cfgs, AllocArray<LBlockBuilder::Scan>& scans)
+		: _builder(builder), _cfgs(cfgs), _scans(scans), _next(0) { }
+
+	void run(void) override {
+		while(true) {
+			if(_builder.mutex != nullptr)
+				_builder.mutex->lock();
+			int i = _next++;
+			if(_builder.mutex != nullptr)
+				_builder.mutex->unlock();
+			if(i >= _cfgs.count())
+				break;
+			for(auto b: *_cfgs[i])
+				if(b->isBasic())
+					_builder.scan(b->toBasic(), _scans[i]);
 		}
 	}
-	// ASSERT(index == num_lblocks); // to make sure the last instruction falls to the last LBlock created // however, blocks may not be cached.
-	// if the BB is not fully cached (existing un-cached segments, create a new LBlock AllocArray and re-assign to the BB_LBLOCKS
-	if(index != num_lblocks) {
-		AllocArray<LBlock*> *lblocks2 = new AllocArray<LBlock*>(index);
-		for(int i = 0; i < index; i++)
-			lblocks2->set(i, lblocks->get(i));
-		BB_LBLOCKS(bb) = lblocks2;
+
+private:
+	LBlockBuilder& _builder;
+	const CFGCollection& _cfgs;
+	AllocArray<LBlockBuilder::Scan>& _scans;
+	int _next;
+};
+
+
+/**
+ * The l-blocks are built in two passes: (a) the CFGs are scanned concurrently
+ * to find the l-blocks of their basic blocks and (b) the l-blocks are built
+ * in the CFG order (to get the same numbering as a sequential build), each set
+ * storing its l-blocks in a contiguous memory area.
+ */
+void LBlockBuilder::processAll(WorkSpace *ws) {
+
+	// scan the CFGs
+	AllocArray<Scan> scans(cfgs().count());
+	LBlockScanner scanner(*this, cfgs(), scans);
+#	ifdef OTAWA_CONC
+		mutex = sys::Mutex::make();
+		WorkSpace::runAll(scanner);
+		delete mutex;
+		mutex = nullptr;
+#	else
+		scanner.run();
+#	endif
+
+	// reserve the l-blocks (with the end block)
+	AllocArray<int> counts(cache->rowCount());
+	for(int i = 0; i < counts.count(); i++)
+		counts[i] = 1;
+	for(int i = 0; i < scans.count(); i++)
+		for(auto item: scans[i].items)
+			if(item.status != NOT_CACHED)
+				counts[item.set]++;
+	for(int i = 0; i < counts.count(); i++)
+		lbsets[i]->reserve(counts[i]);
+
+	// build the l-blocks
+	for(int i = 0; i < scans.count(); i++) {
+		if(logFor(LOG_CFG))
+			log << "\tprocess CFG " << cfgs()[i]->label() << io::endl;
+		build(scans[i]);
+		scans[i].clear();
 	}
 }
 
@@ -68,11 +68,55 @@ int LBlockSet::add(LBlock *lblock){
  * Build a l-block set.
  * @param line	Cache row of the l-block set.
  */
-LBlockSet::LBlockSet(int line, const hard::Cache *cache): linenumber(line), cblock_count(0), _cache(cache) {
+LBlockSet::LBlockSet(int line, const hard::Cache *cache)
+:	linenumber(line), cblock_count(0), _cache(cache), _free(nullptr), _avail(0) {
 	ASSERT(line >= 0);
 }
 
 
+/**
+ * Destroy the l-blocks of the set and release their memory.
+ */
+LBlockSet::~LBlockSet(void) {
+	for(auto lb: listelbc)
+		lb->~LBlock();
+	for(auto c: chunks)
+		::operator delete(c);
+}
+
+
+/**
+ * Ensure that the n next l-blocks allocated by alloc() are contiguous
+ * in memory. If the current chunk is too small, a new one is allocated and
+ * the rest of the current chunk is not used.
+ * @param n		Number of l-blocks to reserve.
+ */
+void LBlockSet::reserve(int n) {
+	if(_avail >= n)
+		return;
+	_free = static_cast<char *>(::operator new(n * sizeof(LBlock)));
+	chunks.add(_free);
+	_avail = n;
+}
+
+
+/**
+ * Allocate the memory for a new l-block of this set. The l-blocks are
+ * allocated by chunks owned by the set and have to be built with the
+ * placement new: new(lbset->alloc()) LBlock(lbset, ...). They are destroyed
+ * and their memory released with the set.
+ * @return	Memory for the l-block.
+ */
+void *LBlockSet::alloc(void) {
+	if(_avail == 0)
+		reserve(16);
+	void *p = _free;
+	_free += sizeof(LBlock);
+	_avail--;
+	return p;
+}
+
+
 /**
  * Get a number for a new l-block in the set.
  * Used internally to build l-blocks.
@@ -234,15 +234,15 @@ void CFGTransformer::transform(CFG *g, CFGMaker& m) {
 	for(CFG::BlockIter b = g->blocks(); b(); b++) {
 		Block *nb = transform(*b);
 		if(nb)
-			bmap.put(*b, nb);
+			map(*b, nb);
 	}
 
 	// clone edges
 	for(CFG::BlockIter src = g->blocks(); src(); src++) {
-		Block *nsrc = bmap.get(*src, 0);
+		Block *nsrc = get(*src);
 		if(nsrc) {
 			for(Block::EdgeIter e = src->outs(); e(); e++) {
-				Block *nsnk = bmap.get(e->sink(), 0);
+				Block *nsnk = get(e->sink());
 				if(nsnk)
 					transform(*e);
 			}
@@ -274,7 +274,7 @@ Block *CFGTransformer::transform(Block *b) {
  * @return		New CFG edge.
  */
 Edge *CFGTransformer::transform(Edge *e) {
-	return clone(bmap.get(e->source()), e, bmap.get(e->sink()));
+	return clone(get(e->source()), e, get(e->sink()));
 }
 
 /**
@@ -285,7 +285,8 @@ Edge *CFGTransformer::transform(Edge *e) {
  * @param nb	New CFG block.
  */
 void CFGTransformer::map(Block *ob, Block *nb) {
-	bmap.put(ob, nb);
+	ASSERTP(ob->index() < bmap.length(), "block not part of the transformed CFG");
+	bmap[ob->index()] = nb;
 }
 
 /**
@@ -310,7 +311,7 @@ CFGMaker *CFGTransformer::get(CFG *cfg) {
  * @return		New CFG block.
  */
 Block *CFGTransformer::get(Block *b) {
-	return bmap.get(b);
+	return b->index() < bmap.length() ? bmap[b->index()] : nullptr;
 }
 
 /**
@@ -320,7 +321,7 @@ Block *CFGTransformer::get(Block *b) {
  * @return		True if it is mapped, false else.
  */
 bool CFGTransformer::isMapped(Block *b) {
-	return bmap.hasKey(b);
+	return get(b) != nullptr;
 }
 
 /**
@@ -371,10 +372,12 @@ void CFGTransformer::commit(WorkSpace *ws) {
 void CFGTransformer::install(CFG *cfg, CFGMaker& maker) {
 	cur = &maker;
 	bmap.clear();
-	bmap.put(cfg->entry(), maker.entry());
-	bmap.put(cfg->exit(), maker.exit());
+	for(int i = 0; i < cfg->count(); i++)
+		bmap.add(nullptr);
+	map(cfg->entry(), maker.entry());
+	map(cfg->exit(), maker.exit());
 	if(!no_unknown && cfg->unknown())
-		bmap.put(cfg->unknown(), maker.unknown());
+		map(cfg->unknown(), maker.unknown());
 }
 
 /**
@@ -67,12 +67,9 @@ LoopManager::~LoopManager() {
  * @param b		Block to get the loop for.
  */
 Loop *Loop::of(Block *b) {
-	if(LOOP_HEADER(b))
-		return ID(b);
-	else if(ENCLOSING_LOOP_HEADER(b) == nullptr)
-		return ID(b->cfg());
-	else
-		return ID(ENCLOSING_LOOP_HEADER(b));
+	LoopForest *f = LOOP_FOREST(b->cfg());
+	ASSERTP(f != nullptr, "LOOP_INFO_FEATURE is required");
+	return f->loopOf(b);
 }
 
 /**
@@ -109,8 +106,8 @@ Loop *Loop::top(CFG *cfg) {
  * Build a loop headed by the given block.
  * @param h		Block head of the loop.
  */
-Loop::Loop(Block *h): _h(h) {
-	Block *p = ENCLOSING_LOOP_HEADER(_h);
+Loop::Loop(Block *h): _h(h), _f(LOOP_FOREST(h->cfg())) {
+	Block *p = _f->parentOf(_h);
 	if(p == nullptr)
 		_p = top(_h->cfg());
 	else
@@ -118,14 +115,16 @@ Loop::Loop(Block *h): _h(h) {
 	_p->_c.add(this);
 	_d = _p->_d + 1;
 	ID(_h) = this;
+	_f->setLoop(_h, this);
 }
 
 /**
  * Build a top-level loop.
  * @param cfg	CFG of the top-level loop.
  */
-Loop::Loop(CFG *cfg): _h(cfg->entry()), _p(nullptr), _d(0) {
+Loop::Loop(CFG *cfg): _h(cfg->entry()), _f(LOOP_FOREST(cfg)), _p(nullptr), _d(0) {
 	ID(cfg) = this;
+	_f->setLoop(_h, this);
 }
 
 
@@ -354,7 +353,7 @@ void Loop::BackIter::select() {
  * @return	List of vector exit edges.
  */
 const Vector<Edge *>& Loop::exits() const {
-	return **EXIT_LIST(_h);
+	return _f->exitsOf(_h);
 }
 
 
@@ -402,8 +401,9 @@ protected:
 	void makeLoop(Block *b) {
 		if(Loop::ID(b) != nullptr)
 			return;
-		if(ENCLOSING_LOOP_HEADER(b) != nullptr)
-			makeLoop(ENCLOSING_LOOP_HEADER(b));
+		Block *p = LOOP_FOREST(b->cfg())->parentOf(b);
+		if(p != nullptr)
+			makeLoop(p);
 		new Loop(b);
 	}
 
@@ -411,6 +411,9 @@ protected:
 		if(Loop::isHeader(b) || b->isEntry()) {
 			delete Loop::ID(b);
 			Loop::ID(b).remove();
+			LoopForest *f = LOOP_FOREST(cfg);
+			if(f != nullptr)
+				f->setLoop(b, nullptr);
 		}
 	}
 
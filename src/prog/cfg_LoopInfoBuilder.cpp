@@ -20,25 +20,22 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-//#define OTAWA_IDFA_DEBUG
+#include <elm/data/Array.h>
 #include <elm/data/Vector.h>
-#include <elm/data/SortedList.h>
+#include <elm/util/BitVector.h>
 #include <otawa/cfg.h>
 #include <otawa/cfg/features.h>
-#include <otawa/dfa/BitSet.h>
-#include <otawa/dfa/IterativeDFA.h>
 #include <otawa/prog/WorkSpace.h>
-#include <otawa/proc/BBProcessor.h>
+#include <otawa/proc/ConcurrentCFGProcessor.h>
 
 using namespace elm;
 using namespace otawa;
-using namespace otawa::dfa;
 
 namespace otawa {
 
 /*
- * Cleaner used to clear the ENCLOSING_LOOP_HEADER identifier when the
- * LOOP_INFO_FEATURE is invalidated.
+ * Cleaner used to clear the properties and the loop forests of the
+ * LOOP_INFO_FEATURE when it is invalidated.
  */
 class LoopInfoCleaner: public elm::Cleaner {
 public:
@@ -50,17 +47,14 @@ protected:
 		for(CFGCollection::Iter cfg(cfgc); cfg(); cfg++) {
 			for(CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
 				for (BasicBlock::EdgeIter outedge = bb->outs(); outedge(); outedge++) {
-					if (LOOP_EXIT_EDGE(*outedge)) {
-						if (EXIT_LIST(LOOP_EXIT_EDGE(*outedge))) {
-							delete EXIT_LIST(LOOP_EXIT_EDGE(*outedge));
-							EXIT_LIST(LOOP_EXIT_EDGE(*outedge)).remove();
-						}
-						LOOP_EXIT_EDGE(*outedge).remove();
-					}
+					LOOP_EXIT_EDGE(*outedge).remove();
+					LOOP_ENTRY(*outedge).remove();
 				} // for each outedge
-				if(ENCLOSING_LOOP_HEADER(*bb).exists())
-					ENCLOSING_LOOP_HEADER(*bb).remove();
+				EXIT_LIST(*bb).remove();
+				ENCLOSING_LOOP_HEADER(*bb).remove();
 			} // for each bb
+			delete LOOP_FOREST(*cfg);
+			LOOP_FOREST(*cfg).remove();
 		}
 	}
 private:
@@ -72,6 +66,16 @@ private:
  * For each basic block, provides the loop which the basicblock belongs to.
  * For each edge exiting from a loop, provides the header of the exited loop.
  *
+ * The loop nesting forest is built in the way of P. Havlak ("Nesting of
+ * reducible and irreducible loops", 1997): the headers are visited from
+ * the innermost to the outermost and the body of each loop is found by
+ * walking backward from the sources of its back edges (the edges whose
+ * sink dominates the source), the already built inner loops being collapsed
+ * on their header with a union-find structure. This gives a time almost
+ * linear in the size of the CFG. The CFGs are processed concurrently.
+ * The forest is kept as a @ref LoopForest on each CFG (@ref LOOP_FOREST) and
+ * answers the loop queries of @ref Loop in constant time.
+ *
  * @par Configuration
  * none
  *
@@ -85,34 +89,15 @@ private:
  * @par Statistics
  * none
  */
-class LoopInfoBuilder: public CFGProcessor {
+class LoopInfoBuilder: public ConcurrentCFGProcessor {
 public:
 	static p::declare reg;
 	LoopInfoBuilder();
 protected:
+	void processWorkSpace(otawa::WorkSpace *ws) override;
 	void processCFG(otawa::WorkSpace*, otawa::CFG*) override;
-private:
-	void buildLoopExitList(otawa::CFG* cfg);
-	bool fst;
 };
 
-
-/**
- * @class LoopInfoProblem
- *
- * This class defines an Iterative DFA problem for detecting which loop
- * contains a BB.
- * @par
- * Let a CFG, in OTAWA meaning, is <V, E, e>, tuple made of block vertices, edges
- * and entry point. The iterative DFA problem is defined by:
- * @li OUT(v) = { } initially
- * @li GEN(v) = { } if exist (w, v) in E /\ v dom w
- * @li GEN(v) = { w / (v, w) in E /\ w dom v } else
- * @li KILL(v) = { v / exists (w, v) in E /\ v dom w }
- *
- * And represents the set of
- */
-
 /**
  * This feature asserts that the loop info of the task is available in
  * the framework.
@@ -122,6 +107,7 @@ private:
  * @li @ref LOOP_ENTRY (@ref Block)
  * @li @ref LOOP_EXIT (@ref Edge)
  * @li @ref EXIT_LIST (@ref Block)
+ * @li @ref LOOP_FOREST (@ref CFG)
  */
 p::feature LOOP_INFO_FEATURE("otawa::LOOP_INFO_FEATURE", new Maker<LoopInfoBuilder>());
 
@@ -176,148 +162,114 @@ p::id<Block*>& LOOP_EXIT_EDGE = LOOP_EXIT;
 p::id<elm::Vector<Edge *> *> EXIT_LIST("otawa::EXIT_LIST", 0);
 
 
-// LoopInfoProblem class
-class LoopInfoProblem {
-
-	class DominanceOrder {
- 	public:
-		typedef Block *t;
-
-		DominanceOrder(void): _info(0) { }
-		DominanceOrder(DomInfo& info): _info(&info) { }
-		void set(DomInfo& info) { _info = &info; }
-
- 		inline int doCompare(Block *bb1, Block *bb2) const {
- 			if(_info->dom(bb1, bb2))
- 				return +1;
- 			else if(_info->dom(bb2, bb1))
- 				return -1;
- 			else
- 				return 0;
- 		}
- 	private:
- 		DomInfo *_info;
- 	};
-
-public:
-
-	LoopInfoProblem(CFG& cfg, DomInfo& info);
- 	inline dfa::BitSet *empty(void) const;
- 	dfa::BitSet *gen(Block *bb) const;
- 	dfa::BitSet *kill(Block *bb) const;
- 	bool equals(dfa::BitSet *set1, dfa::BitSet *set2) const;
- 	void reset(dfa::BitSet *set) const;
- 	void merge(dfa::BitSet *dst, dfa::BitSet *src) const;
- 	void set(dfa::BitSet *dst, dfa::BitSet *src) const;
- 	void add(dfa::BitSet *dst, dfa::BitSet *src) const;
- 	void diff(dfa::BitSet *dst, dfa::BitSet *src);
- 	inline int count(void) const;
- 	inline Block *get(int index) const;
- 	inline void free(dfa::BitSet *set) { delete set; }
-#ifndef NDEBUG
- 	void dump(elm::io::Output& out, dfa::BitSet *set);
-#endif
-
-private:
-	DomInfo& d;
-	/*DominanceOrder dorder;
-	CompareManager<Block *, DominanceOrder> dman;*/
-	SortedList<Block *, DominanceOrder > headersLList;
-	Vector<Block *> hdrs;
+/**
+ * Loop nesting forest of a CFG, providing in constant time the loop
+ * information of its blocks.
+ *
+ * @par Hooks
+ * @li @ref CFG
+ * @ingroup cfg
+ */
+p::id<LoopForest *> LOOP_FOREST("otawa::LOOP_FOREST", nullptr);
 
-};
 
-/* Constructors/Methods for LoopInfoProblem */
-LoopInfoProblem::LoopInfoProblem(CFG& cfg, DomInfo& info): d(info) {
-	headersLList.comparator().set(info);
-
-	/*
-	 * Find all the headers of the CFG
-	 * Adds them in a SORTED list
-	 */
-	for (CFG::BlockIter bb = cfg.blocks(); bb(); bb++)
-		if(!bb->isEntry() && LOOP_HEADER(*bb))
-			headersLList.add(*bb);
-
-	/* Converting to Vector, because a linked list is not very practical ... */
-	for(const auto h: headersLList)
-		hdrs.add(h);
-}
+/**
+ * @class LoopForest
+ * Loop nesting forest of a CFG as produced by @ref LOOP_INFO_FEATURE.
+ * The loops are identified by their header and the forest is stored in
+ * arrays indexed by the block indexes so that the queries are performed
+ * in constant time. It also records the @ref Loop objects built by
+ * @ref EXTENDED_LOOP_FEATURE, the top-level loop being recorded on the
+ * entry block.
+ * @ingroup cfg
+ */
 
-inline dfa::BitSet* LoopInfoProblem::empty(void) const {
-		return new dfa::BitSet(hdrs.length());
-}
 
-dfa::BitSet* LoopInfoProblem::gen(Block *bb) const {
-		dfa::BitSet *result = empty();
-		for(Block::EdgeIter edge = bb->outs(); edge(); edge++)
-			if(bb != edge->target()			// not for single BB loop
-			&& d.dom(edge->target(), bb))
-				result->add(hdrs.indexOf(edge->target()));
-		return result;
+/**
+ * Build an empty forest (no block is in a loop).
+ * @param cfg	Concerned CFG.
+ */
+LoopForest::LoopForest(CFG *cfg):
+	_cfg(cfg),
+	_hdr(cfg->count()),
+	_parent(cfg->count()),
+	_depth(cfg->count()),
+	_exits(cfg->count()),
+	_loops(cfg->count())
+{
+	for(int i = 0; i < cfg->count(); i++) {
+		_hdr[i] = nullptr;
+		_parent[i] = nullptr;
+		_depth[i] = 0;
+		_exits[i] = nullptr;
+		_loops[i] = nullptr;
+	}
 }
 
-dfa::BitSet* LoopInfoProblem::kill(Block *bb) const {
-		dfa::BitSet *result = empty();
-		if(LOOP_HEADER(bb))
-			result->add(hdrs.indexOf(bb));
-		return result;
-}
 
-bool LoopInfoProblem::equals(dfa::BitSet *set1, dfa::BitSet *set2) const {
-		return set1->equals(*set2);
+/**
+ */
+LoopForest::~LoopForest() {
+	for(int i = 0; i < _exits.count(); i++)
+		if(_exits[i] != nullptr)
+			delete _exits[i];
 }
 
-void LoopInfoProblem::reset(dfa::BitSet *set) const {
-		set->empty();
-}
 
-void LoopInfoProblem::merge(dfa::BitSet *dst, dfa::BitSet *src) const {
-		*dst += *src;
-}
+/**
+ * @fn CFG *LoopForest::cfg() const;
+ * Get the CFG of the forest.
+ * @return	Forest CFG.
+ */
 
-void LoopInfoProblem::set(dfa::BitSet *dst, dfa::BitSet *src) const {
-		*dst = *src;
-}
+/**
+ * @fn Block *LoopForest::headerOf(Block *v) const;
+ * Get the header of the innermost loop containing a block.
+ * @param v		Looked block.
+ * @return		v if it is a loop header, the header of its loop else or
+ * 				null if v is not in a loop.
+ */
 
-void LoopInfoProblem::add(dfa::BitSet *dst, dfa::BitSet *src) const {
-		*dst += *src;
-}
+/**
+ * @fn Block *LoopForest::parentOf(Block *h) const;
+ * Get the header of the parent loop of a loop.
+ * @param h		Loop header.
+ * @return		Parent loop header or null for an outermost loop.
+ */
 
-void LoopInfoProblem::diff(dfa::BitSet *dst, dfa::BitSet *src) {
-		*dst -= *src;
-}
+/**
+ * @fn int LoopForest::depthOf(Block *v) const;
+ * Get the nesting depth of a block.
+ * @param v		Looked block.
+ * @return		Number of loops containing v (0 if v is not in a loop).
+ */
 
-inline int LoopInfoProblem::count(void) const {
-		return hdrs.length();
-}
+/**
+ * @fn const Vector<Edge *>& LoopForest::exitsOf(Block *h) const;
+ * Get the exit edges of a loop, that is, the edges whose @ref LOOP_EXIT is h.
+ * @param h		Loop header.
+ * @return		Loop exit edges.
+ */
 
-inline Block* LoopInfoProblem::get(int index) const {
-		return hdrs[index];
-}
+/**
+ * @fn Loop *LoopForest::loopOf(Block *v) const;
+ * Get the innermost loop containing a block (only when
+ * @ref EXTENDED_LOOP_FEATURE is available).
+ * @param v		Looked block.
+ * @return		Innermost loop of v or the top-level loop.
+ */
 
-#ifndef NDEBUG
-/* Dump the content of a bit set.
-*/
-	void LoopInfoProblem::dump(elm::io::Output& out, dfa::BitSet *set) {
-			bool first = true;
-			out << "{ ";
-			for(int i = 0; i < hdrs.length(); i++)
-				if(set->contains(i)) {
-					if(first)
-						first = false;
-					else
-						out << ", ";
-					out << hdrs[i]->index();
-				}
-			out << " }";
-	}
-#endif
+/**
+ * @fn void LoopForest::setLoop(Block *h, Loop *l);
+ * Record the loop object of a loop.
+ * @param h		Loop header (entry block for the top-level loop).
+ * @param l		Loop object (null to remove it).
+ */
 
 
 p::declare LoopInfoBuilder::reg =
-	p::init("otawa::LoopInfoBuilder", Version(2, 0, 0))
-	.extend<CFGProcessor>()
+	p::init("otawa::LoopInfoBuilder", Version(2, 1, 0))
+	.base(ConcurrentCFGProcessor::reg)
 	.require(DOMINANCE_FEATURE)
 	.require(LOOP_HEADERS_FEATURE)
 	.provide(LOOP_INFO_FEATURE)
@@ -326,90 +278,134 @@ p::declare LoopInfoBuilder::reg =
 
 /* Constructors/Methods for LoopInfoBuilder */
 
-LoopInfoBuilder::LoopInfoBuilder(): CFGProcessor(reg), fst(true) {
+LoopInfoBuilder::LoopInfoBuilder(): ConcurrentCFGProcessor(reg) {
 }
 
 
-/*
- * Annotate each loop-header with the list of edges exiting the loop.
+/**
+ * Compute the loop forests of the CFGs and install the cleaner releasing
+ * them when the feature is invalidated.
  */
- void LoopInfoBuilder::buildLoopExitList(otawa::CFG* cfg) {
- 	for(CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
- 		for (BasicBlock::EdgeIter outedge = bb->outs(); outedge(); outedge++) {
- 			if (LOOP_EXIT_EDGE(*outedge)) {
- 				if (!EXIT_LIST(LOOP_EXIT_EDGE(*outedge))) {
- 					EXIT_LIST(LOOP_EXIT_EDGE(*outedge)) = new elm::Vector<Edge*>();
- 				}
-				EXIT_LIST(LOOP_EXIT_EDGE(*outedge))->add(*outedge);
- 			}
- 		}
- 	}
- }
+void LoopInfoBuilder::processWorkSpace(otawa::WorkSpace *ws) {
+	ConcurrentCFGProcessor::processWorkSpace(ws);
+	addCleaner(LOOP_INFO_FEATURE, new LoopInfoCleaner(ws));
+}
+
+
+// find the representative of a block in the union-find structure
+static Block *find(AllocArray<Block *>& rep, Block *v) {
+	Block *r = v;
+	while(rep[r->index()] != r)
+		r = rep[r->index()];
+	while(rep[v->index()] != r) {
+		Block *n = rep[v->index()];
+		rep[v->index()] = r;
+		v = n;
+	}
+	return r;
+}
+
 
 void LoopInfoBuilder::processCFG(otawa::WorkSpace* fw, otawa::CFG* cfg) {
-	int i;
+	DomInfo *dom = DOMINANCE_FEATURE.get(fw);
+	int n = cfg->count();
+	LoopForest *forest = new LoopForest(cfg);
+	LOOP_FOREST(cfg) = forest;
 
-	// computes set of headers
-	LoopInfoProblem prob(*cfg, *DOMINANCE_FEATURE.get(fw));
-	if (prob.count() == 0)
+	// collect the headers, outer headers first (a header is found after its dominators)
+	Vector<Block *> hdrs;
+	BitVector done(n);
+	Vector<Block *> todo;
+	todo.push(cfg->entry());
+	done.set(cfg->entry()->index());
+	while(todo) {
+		Block *v = todo.pop();
+		if(!v->isEntry() && LOOP_HEADER(v))
+			hdrs.add(v);
+		for(auto e: v->outEdges())
+			if(!done.bit(e->sink()->index())) {
+				done.set(e->sink()->index());
+				todo.push(e->sink());
+			}
+	}
+	for(auto v: *cfg)
+		if(!done.bit(v->index()) && !v->isEntry() && LOOP_HEADER(v))
+			hdrs.add(v);
+	if(hdrs.isEmpty())
 		return;
-	IterativeDFA<LoopInfoProblem, dfa::BitSet, CFG, Successor> dfa(prob, cfg, cfg->exit());
-	dfa.compute();
-
-	// compute enclosing loop header for each BB
-	for(CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
 
-		// enclosing loop header is the first element of set
-		// (headers are sorted according by increasing domination)
-		dfa::BitSet::Iterator bit(*dfa.outSet(*bb));
-		if (bit()) {
-			ENCLOSING_LOOP_HEADER(*bb) = prob.get(*bit);
-			if (logFor(LOG_BLOCK))
-				cerr << "\t\t\tloop of " << *bb << " is " << ENCLOSING_LOOP_HEADER(*bb) << io::endl;
+	// build the loop bodies, inner loops first
+	AllocArray<Block *> rep(n), encl(n);
+	for(auto v: *cfg) {
+		rep[v->index()] = v;
+		encl[v->index()] = nullptr;
+	}
+	for(int i = hdrs.length() - 1; i >= 0; i--) {
+		Block *h = hdrs[i];
+		for(auto e: h->inEdges())
+			if(e->source() != h && dom->dom(h, e->source()))
+				todo.push(e->source());
+		while(todo) {
+			Block *y = find(rep, todo.pop());
+			if(y == h)
+				continue;
+			encl[y->index()] = h;
+			rep[y->index()] = h;
+			for(auto e: y->inEdges())
+				if(dom->dom(h, e->source()))
+					todo.push(e->source());
 		}
 	}
 
-	// add blocks themselves to the outing sets
-	for (i = 0; i < prob.count(); i++)
-		dfa.outSet(prob.get(i))->add(i);
-
-	// compute loop exit edges
-	for (CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
-
-		// compute loop entry
-		if(LOOP_HEADER(*bb)) {
-            EXIT_LIST(*bb) = new elm::Vector<Edge*>();
-            for (auto e: bb->inEdges())
-                if (!BACK_EDGE(e))
-                    LOOP_ENTRY(e) = *bb;
-        }
-
-		// process block in loops
-		if (ENCLOSING_LOOP_HEADER(*bb) || LOOP_HEADER(*bb))
-			for(Block::EdgeIter outedge = bb->outs(); outedge(); outedge++) {
-				// result = out set of edge source - out set of edge target
-				// result = { headers dominating source but not target }
-				dfa::BitSet *targetSet = dfa.outSet(outedge->target());
-				dfa::BitSet result(*dfa.outSet(*bb));
-				result.remove(*targetSet);
-
-				// last bit is the left outermost header
-				int h = -1;
-				for(dfa::BitSet::Iterator bit(result); bit(); bit++)
-					h = *bit;
-				if(h >= 0)
-					LOOP_EXIT_EDGE(*outedge) = prob.get(h);
-			}
+	// fill the forest and record enclosing loop header of each block
+	for(auto h: hdrs) {
+		Block *p = encl[h->index()];
+		forest->_hdr[h->index()] = h;
+		forest->_parent[h->index()] = p;
+		forest->_depth[h->index()] = p == nullptr ? 1 : forest->_depth[p->index()] + 1;
+		forest->_exits[h->index()] = new elm::Vector<Edge *>();
 	}
+	for(auto v: *cfg)
+		if(encl[v->index()] != nullptr) {
+			if(forest->_hdr[v->index()] == nullptr)
+				forest->_hdr[v->index()] = encl[v->index()];
+			ENCLOSING_LOOP_HEADER(v) = encl[v->index()];
+			if (logFor(LOG_BLOCK))
+				cerr << "\t\t\tloop of " << v << " is " << encl[v->index()] << io::endl;
+		}
 
-	// build loop exit lists
-	buildLoopExitList(cfg);
+	// compute loop entries
+	for(auto h: hdrs) {
+		EXIT_LIST(h) = forest->_exits[h->index()];
+		for (auto e: h->inEdges())
+			if (!BACK_EDGE(e))
+				LOOP_ENTRY(e) = h;
+	}
 
-	if(fst) { // only add the cleaner for the first time
-		addCleaner(LOOP_INFO_FEATURE, new LoopInfoCleaner(fw));
-		fst = false;
+	// compute loop exit edges: the outermost loop of the source not containing the sink
+	for(auto v: *cfg) {
+		Block *a = forest->headerOf(v);
+		if(a == nullptr)
+			continue;
+		for(auto e: v->outEdges()) {
+			Block *p = a, *q = forest->headerOf(e->sink()), *x = nullptr;
+			while(q != nullptr && forest->depthOf(q) > forest->depthOf(p))
+				q = forest->parentOf(q);
+			while(p != nullptr && (q == nullptr || forest->depthOf(p) > forest->depthOf(q))) {
+				x = p;
+				p = forest->parentOf(p);
+			}
+			while(p != q) {
+				x = p;
+				p = forest->parentOf(p);
+				q = forest->parentOf(q);
+			}
+			if(x != nullptr) {
+				LOOP_EXIT_EDGE(e) = x;
+				forest->_exits[x->index()]->add(e);
+			}
+		}
 	}
 }
 
 }	// otawa
-
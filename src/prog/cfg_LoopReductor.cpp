@@ -19,6 +19,7 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <elm/data/Array.h>
 #include <elm/data/HashMap.h>
 #include <elm/data/SortedList.h>
 #include <elm/util/misc.h>
@@ -49,6 +50,10 @@ namespace otawa {
 
 /**
  * @class LoopReductor
+ * Remove the irreducible loops of the CFGs by duplicating blocks.
+ * Each pass computes the loops containing each block with one DFS and
+ * splits the first irreducible loop found: the passes are repeated until
+ * no more irreducible loop remains.
  *
  * @par Configuration
  * none
@@ -83,7 +88,6 @@ LoopReductor::LoopReductor(p::declare& r)
 Identifier<Block*> LoopReductor::DUPLICATE_OF("otawa::LoopReductor::DUPLICATE_OF", 0);
 Identifier<bool> LoopReductor::MARK("otawa::LoopReductor::MARK", false);
 
-Identifier<dfa::BitSet*> LoopReductor::IN_LOOPS("otawa::LoopReductor::IN_LOOPS", 0);
 
 #ifdef DO_DEBUG
 	static Identifier<bool> TO_DUMP("", false);
@@ -123,12 +127,12 @@ void LoopReductor::processWorkSpace(otawa::WorkSpace *ws) {
 
 		// duplicate graph
 		CFGMaker& maker = *vcfgvec.get(i);
-		HashMap<Block *, Block *> map;
+		AllocArray<Block *> map(g->count());
 		for(CFG::BlockIter v = g->blocks(); v(); v++)
-			map.put(*v, clone(maker, *v));
+			map[v->index()] = clone(maker, *v);
 		for(CFG::BlockIter v = g->blocks(); v(); v++)
 			for(Block::EdgeIter e = v->outs(); e(); e++)
-				maker.add(map.get(*v), map.get(e->sink()), new Edge(e->flags()));
+				maker.add(map[v->index()], map[e->sink()->index()], new Edge(e->flags()));
 
 		// iterate until irreducible loops are processed
 		Vector<dfa::BitSet *> L;
@@ -145,10 +149,9 @@ void LoopReductor::processWorkSpace(otawa::WorkSpace *ws) {
 	#		endif
 
 			// cleanup
-			for(CFG::BlockIter v = maker.blocks(); v(); v++) {
-				delete IN_LOOPS(*v);
-				v->removeProp(IN_LOOPS);
-			}
+			for(int j = 0; j < in_loops.length(); j++)
+				delete in_loops[j];
+			in_loops.clear();
 			for(loops_t::Iter l(L); l(); l++)
 				delete *l;
 
@@ -307,7 +310,7 @@ bool LoopReductor::reduce(CFGMaker& G, loops_t& L) {
 						// if w ∉ l ∧ w ∉ C ∧ IL(h) ⊆ IL(w) then
 						if(!l->contains(w->index())
 						&& !C.contains(w->index())
-						&& IN_LOOPS(w)->includes(**IN_LOOPS(h))) {
+						&& inLoops(w)->includes(*inLoops(h))) {
 
 								// W ← W ∪ { w }
 								W.add(w);
@@ -373,7 +376,7 @@ bool LoopReductor::reduce(CFGMaker& G, loops_t& L) {
 
 					// for (w, v) ∈ E ∧ v ∉ IL(w) do
 					for(Block::EdgeIter e = v->ins(); e(); e++)
-						if(!IN_LOOPS(e->source())->contains(v->index())) {
+						if(!inLoops(e->source())->contains(v->index())) {
 							Block *w = e->source();
 
 							// E' ← E' ∪ { (σ(w), σ(v)) }; D ← D ∪ { (w, v) }
@@ -424,8 +427,8 @@ static inline bool mostlyIncludes(dfa::BitSet& SS, dfa::BitSet& IL, Block *w) {
 
 
 /**
- * Compute IN_LOOPS properties and computes the list
- * of loop entries.
+ * Compute the sets of loops containing each block (indexed
+ * by block index) and computes the list of loop entries.
  * @param maker	CFG to work on.
  * @param L		To store found loops.
  */
@@ -438,12 +441,14 @@ void LoopReductor::computeInLoops(CFGMaker& G, loops_t &L) {
 	S.add(pair(G.entry(), G.entry()->outs()));
 	dfa::BitSet SS(G.count());
 	SS.add(G.entry()->index());
+	AllocArray<int> pos(G.count());
+	pos[G.entry()->index()] = 0;
 	// L ← ∅
 	L.clear();
 
 	// for v ∈ V do IL(v) ← ∅
-	for(CFG::BlockIter v = G.blocks(); v(); v++)
-		IN_LOOPS(*v) = new dfa::BitSet(G.count());
+	for(int i = 0; i < G.count(); i++)
+		in_loops.add(new dfa::BitSet(G.count()));
 
 	// while S ≠ [] do
 	while(S) {
@@ -473,6 +478,7 @@ void LoopReductor::computeInLoops(CFGMaker& G, loops_t &L) {
 				// push(w, {(w, u) ∈ E})
 				S.push(pair(w, w->outs()));
 				SS.add(w->index());
+				pos[w->index()] = S.length() - 1;
 
 				// D ← D ∪ { v }
 				D.add(w->index());
@@ -481,13 +487,12 @@ void LoopReductor::computeInLoops(CFGMaker& G, loops_t &L) {
 			}
 
 			// if w ∈ S then -- loop found
-			int p;
-			for(p = S.length() - 1; p >= 0 && S[p].fst != w; p--);
+			int p = SS.contains(w->index()) ? pos[w->index()] : -1;
 			if(p >= 0) {
 				DEBUG("loop found at " << w->index() << io::endl);
 
 				// if ¬∃ l ∈ L ∧ h ∈ L then
-				if(!IN_LOOPS(w)->contains(w->index())) {
+				if(!inLoops(w)->contains(w->index())) {
 
 					// L ← L ∪ { { w } }
 					dfa::BitSet *hs = new dfa::BitSet(G.count());
@@ -495,48 +500,48 @@ void LoopReductor::computeInLoops(CFGMaker& G, loops_t &L) {
 					L.add(hs);
 
 					// IL(w) ← IL(w) ∪ { w }
-					IN_LOOPS(w)->add(w->index());
+					inLoops(w)->add(w->index());
 				}
 
 				// for u  ∈ S[w, v] do IL(u) ← IL(w)
 				for(int i = p; i < S.length(); i++)
-					IN_LOOPS(S[i].fst)->add(**IN_LOOPS(w));
+					inLoops(S[i].fst)->add(*inLoops(w));
 			}
 
 			// else if IL(w) ⊆ S then -- path join
-			else if(mostlyIncludes(SS, **IN_LOOPS(w), w)) {
+			else if(mostlyIncludes(SS, *inLoops(w), w)) {
 				DEBUG("join found at " << w->index() << io::endl);
 
 				// if ∃ h = last{u ∈ S ∧ u ∈ IL(w)} then
 				int h;
-				for(h = S.length() - 1; h >= 0 && !IN_LOOPS(w)->contains(S[h].fst->index()); h--);
+				for(h = S.length() - 1; h >= 0 && !inLoops(w)->contains(S[h].fst->index()); h--);
 				if(h >= 0)
 					// for u ∈ S[h, w] do IL(u) ← IL[h]
 					for(int u = h; u < S.length(); u++)
-						IN_LOOPS(S[u].fst)->add(**IN_LOOPS(S[h].fst));
+						inLoops(S[u].fst)->add(*inLoops(S[h].fst));
 			}
 
 			// irreducible loop
 			else {
-				DEBUG("IL(" << w->index() << ") = " << **IN_LOOPS(w) << io::endl);
+				DEBUG("IL(" << w->index() << ") = " << *inLoops(w) << io::endl);
 				DEBUG("irreducible found at " << w->index() << io::endl);
 
 				// if ∃h = last{u ∈ S ∧ u ∈ IL(w) } then
 				int h;
-				for(h = S.length() - 1; h >= 0 && !IN_LOOPS(w)->contains(S[h].fst->index()); h--)
+				for(h = S.length() - 1; h >= 0 && !inLoops(w)->contains(S[h].fst->index()); h--)
 					;
 				DEBUG("h = " << S[h] << io::endl);
 				if(h >= 0)
 
 					// for u ∈ S[h, w] do IL(u) ← IL[h]
 					for(int u = h; u < S.length(); u++)
-						IN_LOOPS(S[u].fst)->add(**IN_LOOPS(S[h].fst));
+						inLoops(S[u].fst)->add(*inLoops(S[h].fst));
 
 				// IL(w) ← IL(w) ∪ { w }
-				IN_LOOPS(w)->add(w->index());
+				inLoops(w)->add(w->index());
 
 				// let nh = IL(w) \ S in
-				dfa::BitSet nh = dfa::BitSet(**IN_LOOPS(w));
+				dfa::BitSet nh = dfa::BitSet(*inLoops(w));
 				nh.remove(SS);
 
 				// let wl = ∪{l ∈ L ∧ l ∩ nh ≠ ∅ } l ∪ { w } in
@@ -564,15 +569,15 @@ void LoopReductor::computeInLoops(CFGMaker& G, loops_t &L) {
 	// closure of headers
 	for(loops_t::Iter l(L); l(); l++) {
 		for(dfa::BitSet::Iterator h(**l); h(); h++)
-			IN_LOOPS(G.at(*h))->add(**l);
+			inLoops(G.at(*h))->add(**l);
 		if(logFor(LOG_BLOCK))
 			log << "\t\tloop headed by " << **l << io::endl;
 	}
 	for(CFG::BlockIter v = G.blocks(); v(); v++) {
-		for(dfa::BitSet::Iterator h(**IN_LOOPS(*v)); h(); h++)
-			IN_LOOPS(*v)->add(**IN_LOOPS(G.at(*h)));
+		for(dfa::BitSet::Iterator h(*inLoops(*v)); h(); h++)
+			inLoops(*v)->add(*inLoops(G.at(*h)));
 		if(logFor(LOG_BLOCK))
-			log << "\t\t" << *v << " in " << **IN_LOOPS(*v) << io::endl;
+			log << "\t\t" << *v << " in " << *inLoops(*v) << io::endl;
 	}
 }
 
@@ -162,9 +162,9 @@ void PostDominance::destroyCFG(WorkSpace *ws, CFG *g) {
 
 /**
  */
-p::declare PostDominance::reg = p::init("otawa::PostDominance", Version(2, 0, 0))
+p::declare PostDominance::reg = p::init("otawa::PostDominance", Version(2, 1, 0))
 	.provide(POSTDOMINANCE_FEATURE)
-	.base(CFGProcessor::reg)
+	.base(ConcurrentCFGProcessor::reg)
 	.maker<PostDominance>();
 
 /**
@@ -178,7 +178,7 @@ p::declare PostDominance::reg = p::init("otawa::PostDominance", Version(2, 0, 0)
  * @par Required Features
  * @li @ref COLLECTED_CFG_FEATURE
  */
-PostDominance::PostDominance(p::declare& r): CFGProcessor(reg) {
+PostDominance::PostDominance(p::declare& r): ConcurrentCFGProcessor(r) {
 }
 
 /**
@@ -19,16 +19,22 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include <elm/avl/Map.h>
-#include <elm/io/BlockInStream.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <elm/data/HashMap.h>
-#include <elm/util/UniquePtr.h>
+#include <elm/data/Vector.h>
 #include <elm/util/Pair.h>
-#include <elm/xom/dtd.h>
 
 #include <otawa/cfg/features.h>
 #include <otawa/cfgio/features.h>
 #include <otawa/cfgio/Input.h>
+#include <otawa/cfgio/Output.h>
 #include <otawa/proc/Processor.h>
 #include <otawa/prog/Process.h>
 #include <otawa/prog/TextDecoder.h>
@@ -38,112 +44,518 @@ namespace otawa { namespace cfgio {
 
 using namespace elm;
 
-// CFG file DTD
-static dtd::Element entry("entry", dtd::EMPTY);
-static dtd::IDAttribute entry_id(entry, "id", dtd::REQUIRED);
-static dtd::Element exit("exit", dtd::EMPTY);
-static dtd::IDAttribute exit_id(exit, "id", dtd::REQUIRED);
+// error during the read of a CFG file
+class FormatException: public otawa::Exception {
+public:
+	FormatException(const string& msg): otawa::Exception(msg) { }
+};
 
-static dtd::Element bb("bb", dtd::ignored);
-static dtd::IDAttribute bb_id(bb, "id", dtd::REQUIRED);
-static dtd::Attribute<t::uint32> address(bb, "address", 0, dtd::STRICT);
-static dtd::Attribute<t::uint32> size(bb, "size", 0, dtd::STRICT);
-static dtd::RefAttribute<CFGMaker> call(bb, "call", dtd::STRICT | dtd::FORWARD);
 
-static dtd::Element edge("edge", dtd::ignored);
-static dtd::RefAttribute<BasicBlock *> source(edge, "source", dtd::STRICT | dtd::REQUIRED);
-static dtd::RefAttribute<BasicBlock *> target(edge, "target", dtd::STRICT | dtd::REQUIRED);
+// read-only memory mapping of a file
+class MappedFile {
+public:
+	MappedFile(const sys::Path& path): _base(nullptr), _size(0) {
+		int fd = ::open(path.toString().toCString().chars(), O_RDONLY);
+		if(fd < 0)
+			throw FormatException(_ << "cannot open " << path << ": " << strerror(errno));
+		struct stat st;
+		if(::fstat(fd, &st) < 0) {
+			::close(fd);
+			throw FormatException(_ << "cannot open " << path << ": " << strerror(errno));
+		}
+		_size = st.st_size;
+		if(_size != 0) {
+			void *p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(p == MAP_FAILED) {
+				::close(fd);
+				throw FormatException(_ << "cannot map " << path << ": " << strerror(errno));
+			}
+			_base = static_cast<const char *>(p);
+		}
+		::close(fd);
+	}
 
-static dtd::Element property("property", dtd::ignored);
+	~MappedFile(void) {
+		if(_base != nullptr)
+			::munmap(const_cast<char *>(_base), _size);
+	}
 
-static dtd::Element cfg("cfg", (*property, entry, *bb, exit, *edge));
-static dtd::IDAttribute cfg_id(cfg, "id", dtd::STRICT | dtd::REQUIRED);
-static dtd::Attribute<t::uint32> cfg_address(cfg, "address", dtd::STRICT | dtd::REQUIRED);
+	inline const char *begin(void) const { return _base; }
+	inline const char *end(void) const { return _base + _size; }
+	inline t::size size(void) const { return _size; }
+
+private:
+	const char *_base;
+	t::size _size;
+};
 
-static dtd::Element cfg_collection("cfg-collection", (*property, cfg, *cfg));
 
-// CFG factory
-class CFGFactory: public dtd::Factory {
+// streaming XML scanner (only start and end of elements are reported)
+class XMLScanner {
 public:
 
-	CFGFactory(WorkSpace *workspace)
-		: ws(workspace), g(nullptr), v(nullptr) { }
+	// piece of the scanned text
+	class Token {
+	public:
+		inline Token(void): p(nullptr), n(0) { }
+		inline Token(const char *_p, int _n): p(_p), n(_n) { }
+		inline bool equals(const char *s) const { return int(strlen(s)) == n && strncmp(p, s, n) == 0; }
+		inline string toString(void) const { return string(p, n); }
+		const char *p;
+		int n;
+	};
+
+	typedef enum {
+		START,
+		END,
+		DONE
+	} event_t;
+
+	XMLScanner(const char *begin, const char *end): p(begin), e(end), line(1), pending_end(false), ev(DONE) { }
+
+	// go to the next event
+	event_t next(void) {
+		attrs.clear();
+		if(pending_end) {
+			pending_end = false;
+			return ev = END;
+		}
+		while(true) {
+
+			// skip text
+			while(p < e && *p != '<') {
+				if(*p == '\n')
+					line++;
+				p++;
+			}
+			if(p >= e)
+				return ev = DONE;
+			p++;
+
+			// comments, processing instructions and declarations
+			if(p < e && *p == '!') {
+				if(e - p >= 3 && p[1] == '-' && p[2] == '-')
+					skip("-->");
+				else if(e - p >= 8 && strncmp(p, "![CDATA[", 8) == 0)
+					skip("]]>");
+				else
+					skip(">");
+				continue;
+			}
+			if(p < e && *p == '?') {
+				skip("?>");
+				continue;
+			}
+
+			// end of element
+			if(p < e && *p == '/') {
+				p++;
+				scanName(_name);
+				skipSpaces();
+				expect('>');
+				return ev = END;
+			}
+
+			// start of element
+			scanName(_name);
+			while(true) {
+				skipSpaces();
+				if(p >= e)
+					error("unexpected end of file");
+				if(*p == '>') {
+					p++;
+					break;
+				}
+				if(*p == '/') {
+					p++;
+					expect('>');
+					pending_end = true;
+					break;
+				}
+				Pair<Token, Token> a;
+				scanName(a.fst);
+				skipSpaces();
+				expect('=');
+				skipSpaces();
+				if(p >= e || (*p != '"' && *p != '\''))
+					error("attribute value expected");
+				char q = *p++;
+				const char *b = p;
+				while(p < e && *p != q) {
+					if(*p == '\n')
+						line++;
+					p++;
+				}
+				if(p >= e)
+					error("unterminated attribute value");
+				a.snd = Token(b, p - b);
+				p++;
+				attrs.add(a);
+			}
+			return ev = START;
+		}
+	}
+
+	// current element name
+	inline string name(void) const { return _name.toString(); }
+	inline bool is(const char *n) const { return _name.equals(n); }
+
+	// test if an attribute is set
+	bool isSet(const char *id) const {
+		for(int i = 0; i < attrs.length(); i++)
+			if(attrs[i].fst.equals(id))
+				return true;
+		return false;
+	}
+
+	// get an attribute value (or an empty string)
+	string attr(const char *id) const {
+		for(int i = 0; i < attrs.length(); i++)
+			if(attrs[i].fst.equals(id))
+				return decode(attrs[i].snd);
+		return "";
+	}
+
+	// get an unsigned attribute value
+	t::uint64 number(const char *id) const {
+		string v = attr(id);
+		if(v.isEmpty())
+			error(_ << "attribute " << id << " required in " << name());
+		const char *s = v.toCString().chars();
+		char *end;
+		t::uint64 r = strtoull(s, &end, 0);
+		if(*end != '\0' || end == s)
+			error(_ << "bad number in attribute " << id << ": " << v);
+		return r;
+	}
+
+	// raise an error
+	void error(const string& msg) const {
+		throw FormatException(_ << "line " << line << ": " << msg);
+	}
+
+private:
 
-	~CFGFactory() {
+	void skip(const char *t) {
+		int n = strlen(t);
+		while(e - p >= n && strncmp(p, t, n) != 0) {
+			if(*p == '\n')
+				line++;
+			p++;
+		}
+		if(e - p < n)
+			error("unexpected end of file");
+		p += n;
+	}
+
+	inline void skipSpaces(void) {
+		while(p < e && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+			if(*p == '\n')
+				line++;
+			p++;
+		}
+	}
+
+	void expect(char c) {
+		if(p >= e || *p != c)
+			error(_ << "'" << c << "' expected");
+		p++;
+	}
+
+	void scanName(Token& n) {
+		const char *b = p;
+		while(p < e && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n'
+		&& *p != '>' && *p != '/' && *p != '=')
+			p++;
+		if(p == b)
+			error("name expected");
+		n = Token(b, p - b);
+	}
+
+	string decode(const Token& v) const {
+		if(memchr(v.p, '&', v.n) == nullptr)
+			return v.toString();
+		StringBuffer buf;
+		for(int i = 0; i < v.n; i++) {
+			if(v.p[i] != '&') {
+				buf << v.p[i];
+				continue;
+			}
+			int j = i + 1;
+			while(j < v.n && v.p[j] != ';')
+				j++;
+			Token ent(v.p + i + 1, j - i - 1);
+			if(ent.equals("amp"))
+				buf << '&';
+			else if(ent.equals("lt"))
+				buf << '<';
+			else if(ent.equals("gt"))
+				buf << '>';
+			else if(ent.equals("quot"))
+				buf << '"';
+			else if(ent.equals("apos"))
+				buf << '\'';
+			else if(ent.n > 1 && ent.p[0] == '#') {
+				string num = ent.toString();
+				if(ent.n > 2 && ent.p[1] == 'x')
+					buf << char(strtoul(num.substring(2).toCString().chars(), nullptr, 16));
+				else
+					buf << char(strtoul(num.substring(1).toCString().chars(), nullptr, 10));
+			}
+			else
+				error(_ << "unknown entity &" << ent.toString() << ";");
+			i = j;
+		}
+		return buf.toString();
+	}
+
+	const char *p, *e;
+	int line;
+	bool pending_end;
+	event_t ev;
+	Token _name;
+	Vector<Pair<Token, Token> > attrs;
+};
+
+
+// builder of the CFG makers
+class CFGBuilder {
+public:
+	CFGBuilder(WorkSpace *workspace): ws(workspace) { }
+
+	~CFGBuilder(void) {
 		for(auto g: gs)
 			delete g;
 	}
 
-	void begin(elm::dtd::Element &element) override {
-		if(element == cfg) {
-			g = new CFGMaker(ws->findInstAt(*cfg_address));
-			gs.add(g);
+	// start a new CFG
+	CFGMaker *cfg(Address a) {
+		Inst *i = ws->findInstAt(a);
+		if(i == nullptr)
+			throw FormatException(_ << "no instruction at CFG address " << a);
+		CFGMaker *g = new CFGMaker(i);
+		gs.add(g);
+		return g;
+	}
+
+	// add a basic block
+	Block *basic(CFGMaker *g, Address a, t::uint32 size) {
+		Vector<Inst *> is;
+		Address ea = Address(a.offset() + size);
+		for(auto i = ws->findInstAt(a); i != nullptr && i->address() < ea; i = i->nextInst())
+			is.add(i);
+		if(is.isEmpty())
+			throw FormatException(_ << "no instruction for block at " << a);
+		Block *v = new BasicBlock(is.detach());
+		g->add(v);
+		return v;
+	}
+
+	// build the collection
+	CFGCollection *build(void) {
+		CFGCollection *coll = new CFGCollection();
+		for(auto m: gs)
+			coll->add(m->build());
+		return coll;
+	}
+
+	WorkSpace *ws;
+	Vector<CFGMaker *> gs;
+};
+
+
+// read a CFG collection in XML
+static CFGCollection *readXML(WorkSpace *ws, const MappedFile& file) {
+	XMLScanner scan(file.begin(), file.end());
+	CFGBuilder builder(ws);
+	HashMap<string, CFGMaker *> cfgs;
+	HashMap<string, Block *> blocks;
+	Vector<Pair<SynthBlock *, Pair<CFGMaker *, string> > > calls;
+	CFGMaker *g = nullptr;
+	int depth = 0;
+
+	for(auto ev = scan.next(); ev != XMLScanner::DONE; ev = scan.next()) {
+		if(ev == XMLScanner::END) {
+			depth--;
+			if(depth == 1)
+				g = nullptr;
+			continue;
 		}
-		else if(element == bb) {
-			if(call.isSet()) {
-				auto c = new otawa::SynthBlock();
-				if(call.done())
-					g->call(c, **call);
+		depth++;
+		// collection and CFG
+		if(depth == 1) {
+			if(!scan.is("cfg-collection"))
+				scan.error(_ << "cfg-collection expected but " << scan.name() << " found");
+		}
+		else if(depth == 2) {
+			if(!scan.is("cfg"))
+				continue;
+			g = builder.cfg(Address(scan.number("address")));
+			cfgs.put(scan.attr("id"), g);
+		}
+
+		// blocks and edges
+		else if(depth == 3 && g != nullptr) {
+			Block *v = nullptr;
+			if(scan.is("entry"))
+				v = g->entry();
+			else if(scan.is("exit"))
+				v = g->exit();
+			else if(scan.is("bb")) {
+				if(scan.isSet("call")) {
+					SynthBlock *c = new SynthBlock();
+					string callee = scan.attr("call");
+					CFGMaker *cg = cfgs.get(callee, nullptr);
+					if(cg != nullptr)
+						g->call(c, *cg);
+					else {
+						g->call(c, static_cast<CFG *>(nullptr));
+						if(!callee.isEmpty())
+							calls.add(pair(c, pair(g, callee)));
+					}
+					v = c;
+				}
+				else if(scan.isSet("address"))
+					v = builder.basic(g, Address(scan.number("address")), scan.number("size"));
 				else
-					g->call(c, nullptr);
-				v = c;
+					v = g->unknown();
 			}
-			else {
-				Vector<Inst *> is;
-				Address ea = Address(*address + *size);
-				for(auto i = ws->findInstAt(*address);
-				i != nullptr && i->address() < ea;
-				i = i->nextInst())
-					is.add(i);
-				v = new BasicBlock(is.detach());
-				g->add(v);
+			else if(scan.is("edge")) {
+				Block *src = blocks.get(scan.attr("source"), nullptr);
+				Block *snk = blocks.get(scan.attr("target"), nullptr);
+				if(src == nullptr || snk == nullptr)
+					scan.error("undefined edge source or target");
+				t::uint32 flags = 0;
+				if(scan.attr("taken") == "yes")
+					flags |= Edge::TAKEN;
+				if(scan.attr("not-taken") == "yes")
+					flags |= Edge::NOT_TAKEN;
+				g->add(src, snk, new Edge(flags));
 			}
+			if(v != nullptr)
+				blocks.put(scan.attr("id"), v);
 		}
-		else if(element == entry)
-			v = g->entry();
-		else if(element == exit)
-			v = g->exit();
 	}
 
-	void end(elm::dtd::Element &element) override {
-		if(element == cfg)
-			g = nullptr;
-		else if(element == bb || element == entry || element == exit)
-			v = nullptr;
+	// fix the forward calls
+	for(auto c: calls) {
+		CFGMaker *cg = cfgs.get(c.snd.snd, nullptr);
+		if(cg == nullptr)
+			throw FormatException(_ << "undefined called CFG " << c.snd.snd);
+		c.snd.fst->fix(c.fst, cg);
 	}
 
-	void* getRef(elm::dtd::Element &element) override {
-		if(element == cfg)
-			return g;
-		else if(element == bb || element == entry || element == exit)
-			return v;
-		else
-			return nullptr;
+	if(builder.gs.isEmpty())
+		throw FormatException("no CFG found");
+	return builder.build();
+}
+
+
+// varint reader of the binary format
+class BinaryScanner {
+public:
+	BinaryScanner(const char *begin, const char *end)
+		: p(reinterpret_cast<const t::uint8 *>(begin)), e(reinterpret_cast<const t::uint8 *>(end)) { }
+
+	t::uint64 get(void) {
+		t::uint64 r = 0;
+		int s = 0;
+		while(true) {
+			if(p >= e)
+				throw FormatException("unexpected end of file");
+			t::uint8 b = *p++;
+			if(s < 64)
+				r |= t::uint64(b & 0x7f) << s;
+			s += 7;
+			if((b & 0x80) == 0)
+				return r;
+		}
 	}
 
-	void* getPatchRef(elm::dtd::AbstractAttribute &attr) override {
-		if(attr == call)
-			return new Pair<CFGMaker *, Block *>(g, v);
-		else
-			return nullptr;
+	inline t::int64 getSigned(void) {
+		t::uint64 v = get();
+		return t::int64(v >> 1) ^ -t::int64(v & 1);
 	}
 
-	void patch(elm::dtd::AbstractAttribute &attr, void *object, void *ref) override {
-		if(attr == call) {
-			auto p = static_cast<Pair<CFGMaker *, Block *> *>(object);
-			auto c = static_cast<SynthBlock *>(p->snd);
-			p->fst->fix(c, static_cast<CFGMaker *>(ref));
-			delete p;
-		}
+	inline int getIndex(int max) {
+		t::uint64 v = get();
+		if(v >= t::uint64(max))
+			throw FormatException(_ << "index " << v << " out of bounds");
+		return int(v);
 	}
 
-	WorkSpace *ws;
-	CFGMaker *g;
-	Block *v;
-	Vector<CFGMaker *> gs;
+private:
+	const t::uint8 *p, *e;
 };
 
 
+// read a CFG collection in binary format
+static CFGCollection *readBinary(WorkSpace *ws, const MappedFile& file) {
+	BinaryScanner scan(file.begin() + 4, file.end());
+	t::uint64 version = scan.get();
+	if(version != t::uint64(Output::binary_version))
+		throw FormatException(_ << "unsupported version " << version);
+	CFGBuilder builder(ws);
+
+	// allocate the CFGs
+	int cnt = scan.getIndex(type_info<int>::max);
+	if(cnt == 0)
+		throw FormatException("no CFG found");
+	Vector<Pair<SynthBlock *, Pair<CFGMaker *, int> > > calls;
+	Vector<Block *> blocks;
+	for(int i = 0; i < cnt; i++) {
+		Address prev = Address(scan.get());
+		CFGMaker *g = builder.cfg(prev);
+
+		// read the blocks
+		int bcnt = scan.getIndex(type_info<int>::max);
+		blocks.clear();
+		blocks.add(g->entry());
+		blocks.add(g->exit());
+		for(int j = 0; j < bcnt; j++)
+			switch(scan.get()) {
+			case 0: {
+					Address a = Address(prev.offset() + scan.getSigned());
+					blocks.add(builder.basic(g, a, scan.get()));
+					prev = a;
+				}
+				break;
+			case 1: {
+					SynthBlock *c = new SynthBlock();
+					int callee = scan.getIndex(cnt + 1);
+					if(callee != 0 && callee - 1 < i)
+						g->call(c, *builder.gs[callee - 1]);
+					else {
+						g->call(c, static_cast<CFG *>(nullptr));
+						if(callee != 0)
+							calls.add(pair(c, pair(g, callee - 1)));
+					}
+					blocks.add(c);
+				}
+				break;
+			case 2:
+				blocks.add(g->unknown());
+				break;
+			default:
+				throw FormatException("bad block kind");
+			}
+
+		// read the edges
+		int ecnt = scan.getIndex(type_info<int>::max);
+		for(int j = 0; j < ecnt; j++) {
+			Block *src = blocks[scan.getIndex(blocks.length())];
+			Block *snk = blocks[scan.getIndex(blocks.length())];
+			g->add(src, snk, new Edge(scan.get()));
+		}
+	}
+
+	// fix the forward calls
+	for(auto c: calls)
+		c.snd.fst->fix(c.fst, builder.gs[c.snd.snd]);
+	return builder.build();
+}
+
+
 /**
  * @addtogroup cfgio
  *
@@ -151,26 +563,35 @@ public:
  * The cfgio::Input provides the processor to construct CFGCollection (which is stored to INVOLVED_CFG(props)) from an XML file.
  * The XML file can be generated by using the cfgio::Output processor, or written by hand.
  * Users can use the manually created XML file to create CFGs of the desired topologies.
- * To create BasicBlock which does not exist in the program, one has to include the instruction with the address at 0xCAFEBABE to indicate
- * that such BasicBlock is created from scratch.
+ * The blocks are made of the instructions of the program: a @c bb element with an address
+ * must also give the size in bytes of the block (a missing size is reported as a format error),
+ * a @c bb element with a @c call attribute is a synthetic block calling the identified CFG
+ * (empty for an unknown callee) and a @c bb element without address nor call is the unknown
+ * block of the CFG, as written by cfgio::Output.
  * @code
  * 	<?xml version="1.0" encoding="UTF-8"?>
  * 	<cfg-collection>
- * 		<cfg id="test1">
+ * 		<cfg id="test1" address="0x8000">
  * 			<entry id="0"/>
- * 			<bb id="1"><inst address="0xCAFEBABE"/></bb>
- * 			<bb id="2"><inst address="0xCAFEBABE"/></bb>
- * 			<bb id="3"><inst address="0xCAFEBABE"/></bb>
- * 			<exit id="4" />
+ * 			<bb id="1" address="0x8000" size="8"/>
+ * 			<bb id="2" address="0x8008" size="4"/>
+ * 			<bb id="3" address="0x800c" size="12"/>
+ * 			<bb id="4"/>
+ * 			<exit id="5" />
  * 			<edge source="0" target="1"/>
- * 			<edge source="1" target="2"/>
- * 			<edge source="1" target="3"/>
+ * 			<edge source="1" target="2" not-taken="yes"/>
+ * 			<edge source="1" target="3" taken="yes"/>
  * 			<edge source="2" target="3"/>
- * 			<edge source="3" target="4"/>
+ * 			<edge source="2" target="4" taken="yes"/>
+ * 			<edge source="3" target="5"/>
  * 		</cfg>
  * 	</cfg-collection>
  * @endcode
  *
+ * The file may also be in the binary format produced by cfgio::Output (see @ref cfgio-binary),
+ * recognized by its first bytes. In both cases, the file is mapped in memory and read in one pass
+ * (no document tree is built), in time linear with its size.
+ *
  * otawa::cfgio::FROM can be used to specified the PATH of the XML file to be read (the defualt is main.xml).
  * @code
  * your_program --add-prop otawa::cfgio::FROM=PATH_TO_YOUR_XML_FILE
@@ -209,30 +630,22 @@ void Input::configure(const PropList& props) {
  *
  */
 void Input::processWorkSpace(WorkSpace *ws) {
-	CFGFactory factory(ws);
-
-	// open the document
-	xom::Builder builder;
-	xom::Document *doc = builder.build(path.toString().toCString());
-	if(!doc)
-		throw ProcessorException(*this, _ << " cannot open " << path);
-
-	// get the top element
-	xom::Element *top = doc->getRootElement();
-//#	if 0
-	dtd::Parser parser(factory, cfg_collection);
 	try {
-		parser.parse(top);
-		coll = new CFGCollection();
-		for(auto m: factory.gs) {
-			auto g = m->build();
-			coll->add(g);
+		MappedFile file(path);
+		if(file.size() >= 4 && strncmp(file.begin(), "OCFG", 4) == 0) {
+			if(logFor(LOG_DEPS))
+				log << "\treading binary CFG from " << path << io::endl;
+			coll = readBinary(ws, file);
+		}
+		else {
+			if(logFor(LOG_DEPS))
+				log << "\treading XML CFG from " << path << io::endl;
+			coll = readXML(ws, file);
 		}
 	}
-	catch(dtd::Exception& e) {
+	catch(FormatException& e) {
 		throw ProcessorException(*this, _ << "format error in " << path << ": " << e.message());
 	}
-//#	endif
 }
 
 /**
@@ -18,8 +18,8 @@
  *	along with OTAWA; if not, write to the Free Software
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
+#include <elm/data/Array.h>
 #include <elm/io/OutFileStream.h>
-#include <elm/xom/Serializer.h>
 
 #include <otawa/cfgio/Output.h>
 #include <otawa/ipet/features.h>
@@ -68,6 +68,15 @@ p::id<Path> OUTPUT("otawa::cfgio::OUTPUT");
  */
 p::id<bool> LINE_INFO("otawa::cfgio::LINE_INFO", false);
 
+
+/**
+ * Select the binary format for the output of otawa::cfgio::Output (see @ref cfgio-binary).
+ * If not set, the binary format is also selected if the output path has the extension
+ * "ocfg".
+ * @ingroup cfgio
+ */
+p::id<bool> BINARY("otawa::cfgio::BINARY", false);
+
 /**
  * @defgroup cfgio	CFG Input / Output
  *
@@ -80,43 +89,94 @@ p::id<bool> LINE_INFO("otawa::cfgio::LINE_INFO", false);
  * @code
  * 	otawa-config --libs --rpath cfgio
  * @endcode
+ *
+ * @section cfgio-binary Binary Format
+ *
+ * To cache CFG collections between runs, the CFGs may also be stored in a compact
+ * binary format (select it with otawa::cfgio::BINARY or with the "ocfg" file extension)
+ * that is loaded by cfgio::Input in time linear with the file size. All numbers
+ * are unsigned LEB128 varints (7 bits per byte, least significant first,
+ * bit 7 set while more bytes follow) and signed numbers are zigzag-encoded. The file is:
+ * @code
+ * 	file ::= "OCFG" version cfg_count cfg*
+ * 	cfg ::= address block_count block* edge_count edge*
+ * 	block ::= 0 address_delta size		-- basic block
+ * 	       |  1 callee					-- synthetic block (callee is CFG index + 1, 0 if unknown)
+ * 	       |  2							-- unknown block
+ * 	edge ::= source sink flags
+ * @endcode
+ * The current version is 1. The CFG address is the address of the first instruction
+ * of the CFG, the address delta of a basic block is signed and relative to the previous
+ * basic block (the first one to the CFG address). The edge sources and sinks are
+ * numbered 0 for the entry, 1 for the exit and then 2, 3, ... in the order of the blocks.
+ * Edge flags are the ones of otawa::Edge.
  */
 
 /**
  * @class Output
- * Output the current CFG collection in XML matching the DTD ${OTAWA_HOME}/share/Otawa/dtd/cfg.dtd .
+ * Output the current CFG collection in XML matching the DTD ${OTAWA_HOME}/share/Otawa/dtd/cfg.dtd
+ * or in the binary format (see @ref cfgio-binary).
+ *
+ * The XML is directly written to the output while the CFGs are traversed (the only
+ * buffered part is the list of edges of the current CFG).
  *
  * @par Configuration
  * @li @ref otawa::cfgio::INCLUDE -- include the identifier whose name is given in the output.
  * @li @ref otawa::cfgio::OUTPUT -- path to output file to (if not defined, output to standard output).
  * @li @ref otawa::cfgio::LINE_INFO -- emit source line information on output.
+ * @li @ref otawa::cfgio::BINARY -- use the binary format.
  * @ingroup cfgio
  */
 
 /**
  */
-Output::Output(void): BBProcessor(reg), root(0), cfg_node(0), last_bb(0), all(false), no_insts(false), line_info(false) {
+Output::Output(void): BBProcessor(reg), out(nullptr), all(false), no_insts(false), line_info(false), binary(false) {
 }
 
 
 /**
  * Generate ID for a CFG.
+ * @param out	Stream to output to.
  * @param cfg	CFG to generate ID for.
- * @return		ID of the CFG.
  */
-string Output::id(CFG *cfg) {
-	return _ << '_' << cfg->index();
+void Output::id(io::Output& out, CFG *cfg) {
+	out << '_' << cfg->index();
 }
 
 
 /**
  * Generate ID for a BB.
+ * @param out	Stream to output to.
  * @param bb	BB to generate ID for.
- * @return		ID for the BB.
  */
-string Output::id(Block *bb) {
-	string suff;
-	return _ << '_' << bb->cfg()->index() << '-' << bb->index();
+void Output::id(io::Output& out, Block *bb) {
+	out << '_' << bb->cfg()->index() << '-' << bb->index();
+}
+
+
+/**
+ * Output a string escaping the XML special characters.
+ * @param out	Stream to output to.
+ * @param s		String to output.
+ */
+void Output::escape(io::Output& out, cstring s) {
+	const char *p = s.chars(), *q = p;
+	for(; *q != '\0'; q++) {
+		cstring e;
+		switch(*q) {
+		case '&':	e = "&amp;"; break;
+		case '<':	e = "&lt;"; break;
+		case '>':	e = "&gt;"; break;
+		case '"':	e = "&quot;"; break;
+		default:	continue;
+		}
+		if(q != p)
+			out.stream().write(p, q - p);
+		out << e;
+		p = q + 1;
+	}
+	if(q != p)
+		out.stream().write(p, q - p);
 }
 
 
@@ -124,79 +184,72 @@ string Output::id(Block *bb) {
  */
 void Output::processCFG(WorkSpace *ws, CFG *cfg) {
 
-	// build the CFG node
-	cfg_node = new xom::Element("cfg");
-	root->appendChild(cfg_node);
-	string addr = _ << "0x" << cfg->address();
-	string label = cfg->label();
-	string num = _ << cfg->index();
-	string _id = id(cfg);
-	cfg_node->addAttribute(new xom::Attribute("id", _id.asNullTerminated()));
-	cfg_node->addAttribute(new xom::Attribute("address", addr.asNullTerminated()));
-	cfg_node->addAttribute(new xom::Attribute("label", label.asNullTerminated()));
-	cfg_node->addAttribute(new xom::Attribute("number", num.asNullTerminated()));
-	processProps(cfg_node, *cfg);
-
-	// build the entry BB
-	xom::Element *entry = new xom::Element("entry");
-	cfg_node->appendChild(entry);
-	string entry_id = id(cfg->entry());
-	entry->addAttribute(new xom::Attribute("id", entry_id.asNullTerminated()));
-	last_bb = cfg_node->getChildCount();
+	// output the CFG node
+	io::Output& out = *this->out;
+	out << "\t<cfg id=\"";
+	id(out, cfg);
+	out << "\" address=\"0x" << cfg->address() << "\" label=\"";
+	escape(out, cfg->label().toCString());
+	out << "\" number=\"" << cfg->index() << "\">\n";
+	processProps(out, *cfg, 2);
+
+	// output the entry BB
+	out << "\t\t<entry id=\"";
+	id(out, cfg->entry());
+	out << "\"/>\n";
 
 	// usual processing
+	edges.reset();
 	BBProcessor::processCFG(ws, cfg);
 
-	// add the exit node
-	xom::Element *exit = new xom::Element("exit");
-	cfg_node->insertChild(exit, last_bb);
-	string exit_id = id(cfg->exit());
-	exit->addAttribute(new xom::Attribute("id", exit_id.asNullTerminated()));
+	// output the exit node and the edges
+	out << "\t\t<exit id=\"";
+	id(out, cfg->exit());
+	out << "\"/>\n";
+	out << edges.toString();
+	out << "\t</cfg>\n";
 }
 
 
 /**
  */
 void Output::processBB(WorkSpace *ws, CFG *cfg, Block *b) {
+	io::Output& out = *this->out;
 
 	// add the basic
 	if(!b->isEnd()) {
 
 		// make the BB element
-		xom::Element *bb_node = new xom::Element("bb");
-		string _id = id(b);
-		string num = _ << b->index();
-		cfg_node->insertChild(bb_node, last_bb++);
-		bb_node->addAttribute(new xom::Attribute("id", _id.asNullTerminated()));
-		bb_node->addAttribute(new xom::Attribute("number", num.asNullTerminated()));
+		out << "\t\t<bb id=\"";
+		id(out, b);
+		out << "\" number=\"" << b->index() << '"';
 
 		// basic block specialization
 		if(b->isBasic()) {
 			BasicBlock *bb = b->toBasic();
-			string addr = _ << "0x" << bb->address();
-			string size = _ << bb->size();
-			bb_node->addAttribute(new xom::Attribute("address", addr.asNullTerminated()));
-			bb_node->addAttribute(new xom::Attribute("size", size.asNullTerminated()));
+			out << " address=\"0x" << bb->address() << "\" size=\"" << bb->size() << '"';
 		}
 		else if(b->isSynth()) {
 			CFG *cfg = b->toSynth()->callee();
-			bb_node->addAttribute(new xom::Attribute("call", !cfg ? "" : id(cfg).asNullTerminated()));
+			out << " call=\"";
+			if(cfg)
+				id(out, cfg);
+			out << '"';
 		}
-		processProps(bb_node, *b);
+		out << ">\n";
+		processProps(out, *b, 3);
 
 		// make the list of instruction
 		if(b->isBasic() && !no_insts)
 			for(BasicBlock::InstIter inst= b->toBasic()->insts(); inst(); inst++) {
-				xom::Element *inst_node = new xom::Element("inst");
-				bb_node->appendChild(inst_node);
-				string addr = _ << "0x" << inst->address();
-				inst_node->addAttribute(new xom::Attribute("address", addr.asNullTerminated()));
+				out << "\t\t\t<inst address=\"0x" << inst->address() << '"';
 				Option<Pair<cstring, int> > line_info = ws->process()->getSourceLine(inst->address());
 				if(line_info) {
-					string line = _ << (*line_info).snd;
-					inst_node->addAttribute(new xom::Attribute("file", (*line_info).fst));
-					inst_node->addAttribute(new xom::Attribute("line", line.asNullTerminated()));
+					out << " file=\"";
+					escape(out, (*line_info).fst);
+					out << "\" line=\"" << (*line_info).snd << '"';
 				}
+				out << "/>\n";
 			}
 
 		// generate the line information
@@ -206,26 +259,30 @@ void Output::processBB(WorkSpace *ws, CFG *cfg, Block *b) {
 				Option<Pair<cstring, int> > line = ws->process()->getSourceLine(inst->address());
 				if(line && *line != cur) {
 					cur = line;
-					xom::Element *line_node = new xom::Element("line");
-					bb_node->appendChild(line_node);
-					line_node->addAttribute(new xom::Attribute("file", cur.fst));
-					string line = _ << cur.snd;
-					line_node->addAttribute(new xom::Attribute("line", line.asNullTerminated()));
+					out << "\t\t\t<line file=\"";
+					escape(out, cur.fst);
+					out << "\" line=\"" << cur.snd << "\"/>\n";
 				}
 			}
 		}
 
+		out << "\t\t</bb>\n";
 	}
 
 	// add the output edges
 	for(Block::EdgeIter edge = b->outs(); edge(); edge++) {
-		xom::Element *edge_node = new xom::Element("edge");
-		cfg_node->appendChild(edge_node);
-		string source = id(edge->source());
-		edge_node->addAttribute(new xom::Attribute("source", source.asNullTerminated()));
-		string target = id(edge->target());
-		edge_node->addAttribute(new xom::Attribute("target", target.asNullTerminated()));
-		processProps(edge_node, **edge);
+		edges << "\t\t<edge source=\"";
+		id(edges, edge->source());
+		edges << "\" target=\"";
+		id(edges, edge->target());
+		edges << '"';
+		if(edge->flags() & Edge::TAKEN)
+			edges << " taken=\"yes\"";
+		if(edge->flags() & Edge::NOT_TAKEN)
+			edges << " not-taken=\"yes\"";
+		edges << ">\n";
+		processProps(edges, **edge, 3);
+		edges << "\t\t</edge>\n";
 	}
 }
 
@@ -251,6 +308,7 @@ void Output::configure(const PropList& props) {
 	path = cfgio::OUTPUT(props);
 	no_insts = NO_INSTS(props);
 	line_info = LINE_INFO(props);
+	binary = BINARY(props) || (path && path.extension() == "ocfg");
 }
 
 
@@ -263,15 +321,9 @@ void Output::processWorkSpace(WorkSpace *ws) {
 		for(avl::Set<const AbstractIdentifier *>::Iter id(ids); id(); id++)
 			log << "\tproperty " << id->name() << " include in the output\n";
 
-	// build the root node
-	root = new xom::Element("cfg-collection");
-
-	// normal processing
-	BBProcessor::processWorkSpace(ws);
-
 	// open output
 	io::OutFileStream *file = 0;
-	io::OutStream *out = &io::out;
+	io::OutStream *stream = &io::out;
 	if(path) {
 		file = new OutFileStream(path);
 		if(!file->isReady()) {
@@ -279,14 +331,24 @@ void Output::processWorkSpace(WorkSpace *ws) {
 			delete file;
 			throw ProcessorException(*this, _ << "cannot open \"" << path << "\": " << msg);
 		}
-		out = file;
+		stream = file;
 	}
-
-	// output the XML
-	xom::Document doc(root);
-	xom::Serializer serial(*out);
-	serial.write(&doc);
-	serial.flush();
+	io::Output out(*stream);
+	this->out = &out;
+
+	// binary output
+	if(binary)
+		writeBinary(*stream, **INVOLVED_CFGS(ws));
+
+	// XML output
+	else {
+		out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+		out << "<cfg-collection>\n";
+		BBProcessor::processWorkSpace(ws);
+		out << "</cfg-collection>\n";
+	}
+	out.flush();
+	this->out = nullptr;
 
 	// close file if needed
 	if(file)
@@ -296,27 +358,117 @@ void Output::processWorkSpace(WorkSpace *ws) {
 
 /**
  * Output the properties.
- * @param parent	Parent element.
+ * @param out		Stream to output to.
  * @param props		Properties to output.
+ * @param indent	Indentation level.
  */
-void Output::processProps(xom::Element *parent, const PropList& props) {
+void Output::processProps(io::Output& out, const PropList& props, int indent) {
 	for(PropList::Iter prop(props); prop(); prop++)
 
 		if((all/* && prop->id()->name()*/) || ids.contains(prop->id())) {
+			for(int i = 0; i < indent; i++)
+				out << '\t';
+			out << "<property identifier=\"";
+			escape(out, prop->id()->name().toCString());
+			out << "\">";
+			StringBuffer buf;
+			prop->id()->print(buf, *prop);
+			escape(out, buf.toString().toCString());
+			out << "</property>\n";
+		}
+}
 
-			// make node
-			xom::Element *prop_node = new xom::Element("property");
-			parent->appendChild(prop_node);
 
-			// add identifier attribute
-			prop_node->addAttribute(new xom::Attribute("identifier", prop->id()->name().asNullTerminated()));
+/**
+ * Output a varint (see @ref cfgio-binary).
+ * @param buf	Buffer to output to.
+ * @param v		Value to output.
+ */
+static void putVarint(Vector<char>& buf, t::uint64 v) {
+	while(v >= 0x80) {
+		buf.add(char(v | 0x80));
+		v >>= 7;
+	}
+	buf.add(char(v));
+}
+
 
-			// add value
-			StringBuffer buf;
-			prop->id()->print(buf, *prop);
-			string s = buf.toString();
-			prop_node->appendChild(s.asNullTerminated());
+/**
+ * Output a signed varint (see @ref cfgio-binary).
+ * @param buf	Buffer to output to.
+ * @param v		Value to output.
+ */
+static void putSigned(Vector<char>& buf, t::int64 v) {
+	putVarint(buf, (t::uint64(v) << 1) ^ t::uint64(v >> 63));
+}
+
+
+/**
+ * Write the CFG collection in binary format (see @ref cfgio-binary).
+ * @param stream	Stream to output to.
+ * @param coll		CFG collection to output.
+ */
+void Output::writeBinary(io::OutStream& stream, const CFGCollection& coll) {
+	Vector<char> buf;
+	buf.add('O');
+	buf.add('C');
+	buf.add('F');
+	buf.add('G');
+	putVarint(buf, binary_version);
+	putVarint(buf, coll.count());
+	for(auto g: coll) {
+
+		// number the blocks
+		AllocArray<int> num(g->count());
+		int n = 2;
+		for(auto v: *g)
+			if(v->isEntry())
+				num[v->index()] = 0;
+			else if(v->isExit())
+				num[v->index()] = 1;
+			else
+				num[v->index()] = n++;
+
+		// output the blocks
+		Address prev = g->address();
+		putVarint(buf, prev.offset());
+		putVarint(buf, n - 2);
+		for(auto v: *g) {
+			if(v->isEnd())
+				continue;
+			if(v->isBasic()) {
+				putVarint(buf, 0);
+				BasicBlock *bb = v->toBasic();
+				putSigned(buf, t::int64(bb->address().offset()) - t::int64(prev.offset()));
+				putVarint(buf, bb->size());
+				prev = bb->address();
+			}
+			else if(v->isSynth()) {
+				putVarint(buf, 1);
+				CFG *c = v->toSynth()->callee();
+				putVarint(buf, c == nullptr ? 0 : c->index() + 1);
+			}
+			else
+				putVarint(buf, 2);
 		}
+
+		// output the edges
+		int ecnt = 0;
+		for(auto v: *g)
+			ecnt += v->countOuts();
+		putVarint(buf, ecnt);
+		for(auto v: *g)
+			for(auto e: v->outEdges()) {
+				putVarint(buf, num[e->source()->index()]);
+				putVarint(buf, num[e->sink()->index()]);
+				putVarint(buf, e->flags());
+			}
+
+		// flush the buffer
+		if(stream.write(&buf[0], buf.length()) < 0)
+			throw ProcessorException(*this, _ << "cannot write to " << path << ": " << stream.lastErrorMessage());
+		buf.clear();
+	}
 }
 
 
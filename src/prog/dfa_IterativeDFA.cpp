@@ -90,6 +90,13 @@ namespace otawa { namespace dfa {
  * done
  * @endcode
  * 
+ * In the implementation, the BB are visited in reverse post-order of the
+ * traversal direction and only the BB whose predecessors OUT have changed
+ * are re-computed: the pending BB are recorded in a bit vector indexed by
+ * their rank in this order and are processed in sweeps over the ranks. For
+ * reducible CFGs, this makes the number of sweeps bounded by the loop nesting
+ * depth plus 2 for most classic problems.
+ *
  * Notice that thanks to Iter type paremeter, we may have forward or backward
  * traversal of the CFG (IN may be union of predecessors or of successors).
  * 
@@ -19,6 +19,7 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include "config.h"
 #include <stdio.h>
 
 #include <elm/checksum/Fletcher.h>
@@ -28,12 +29,14 @@
 #include <elm/xom/XIncluder.h>
 #include <elm/io/BlockInStream.h>
 #include <elm/sys/Path.h>
+#include <elm/sys/Thread.h>
 
 #include <otawa/flowfact/features.h>
 #include <otawa/hard/Platform.h>
 #include <otawa/prop/DeletableProperty.h>
 #include <otawa/prog/File.h>
 #include <otawa/prog/Process.h>
+#include <otawa/prog/Symbol.h>
 #include <otawa/prog/WorkSpace.h>
 #include <otawa/flowfact/FlowFactLoader.h>
 
@@ -545,6 +548,16 @@ extern int fft_line;
  * @li @ref otawa::FLOW_FACTS_MANDATORY -- if set to true, the processing fails if one loop bound is not available
  * 		(default to false).
  *
+ * @par Performances
+ * The symbols of the program are indexed once before the flow facts are loaded and
+ * the source line lookups are memoized so that big flow fact files, referencing
+ * many times the same labels or lines, are resolved in constant time per entry.
+ * When several XML flow fact files are given, they are parsed concurrently
+ * (parsing and XInclude resolution) and then applied in the order of the paths.
+ * The XML documents are released as soon as they have been applied.
+ * The context-free loop bounds are merged per loop header and applied in bulk
+ * once all files have been read.
+ *
  * @see
  * 		@ref f4 for more details on the flow facts files.
  * @ingroup ff
@@ -629,13 +642,24 @@ void FlowFactLoader::load(WorkSpace *ws, const Path& path) {
 void FlowFactLoader::processWorkSpace(WorkSpace *ws) {
 	_fw = ws;
 
+	// release the loading resources, even on error
+	class Release {
+	public:
+		inline Release(FlowFactLoader& loader): _loader(loader) { }
+		inline ~Release(void) { _loader.release(); }
+	private:
+		FlowFactLoader& _loader;
+	} guard(*this);
+
 	// lines available ?
 	lines_available = ws->isProvided(SOURCE_LINE_FEATURE);
 
 	// Build the F4 file path
-	if(paths)
+	if(paths) {
+		parseAll();
 		for(int i = 0; i < paths.length(); i++)
 			load(ws, paths[i]);
+	}
 	else {
 		bool done = false;
 		Vector<sys::Path> to_test;
@@ -683,6 +707,91 @@ void FlowFactLoader::processWorkSpace(WorkSpace *ws) {
 			ContextualPath cpath;
 			scanXBody(nodes[i], cpath);
 		}
+
+	// apply the loop bounds
+	applyLoops();
+}
+
+
+/**
+ * Parser of XML flow fact files run concurrently.
+ */
+class FFXParser: public sys::Runnable {
+public:
+	FFXParser(const Vector<Path>& paths, AllocArray<xom::Document *>& docs, AllocArray<string>& errs)
+		: _paths(paths), _docs(docs), _errs(errs), _next(0), _mutex(nullptr)
+	{
+#		ifdef OTAWA_CONC
+			_mutex = sys::Mutex::make();
+#		endif
+	}
+
+	~FFXParser(void) {
+		if(_mutex != nullptr)
+			delete _mutex;
+	}
+
+	void run(void) override {
+		while(true) {
+			if(_mutex != nullptr)
+				_mutex->lock();
+			int i = _next++;
+			if(_mutex != nullptr)
+				_mutex->unlock();
+			if(i >= _paths.length())
+				break;
+
+			// errors are recorded to be thrown in the calling thread
+			xom::Document *doc = nullptr;
+			try {
+				xom::Builder builder;
+				doc = builder.build(_paths[i].toString().asSysString());
+				if(doc != nullptr)
+					xom::XIncluder::resolveInPlace(doc);
+			}
+			catch(elm::Exception& e) {
+				if(doc != nullptr)
+					delete doc;
+				doc = nullptr;
+				_errs[i] = e.message();
+			}
+			_docs[i] = doc;
+		}
+	}
+
+private:
+	const Vector<Path>& _paths;
+	AllocArray<xom::Document *>& _docs;
+	AllocArray<string>& _errs;
+	int _next;
+	sys::Mutex *_mutex;
+};
+
+
+/**
+ * Parse concurrently the XML flow fact files if there are several ones.
+ */
+void FlowFactLoader::parseAll(void) {
+	Vector<Path> xpaths;
+	for(auto p: paths)
+		if(p.extension() == "ffx" || p.extension() == "xml")
+			xpaths.add(p);
+	if(xpaths.length() < 2)
+		return;
+	AllocArray<xom::Document *> docs(xpaths.length());
+	for(int i = 0; i < docs.count(); i++)
+		docs[i] = nullptr;
+	AllocArray<string> errs(xpaths.length());
+	FFXParser parser(xpaths, docs, errs);
+	WorkSpace::runAll(parser);
+	for(int i = 0; i < docs.count(); i++)
+		if(docs[i] != nullptr)
+			parsed.put(xpaths[i].toString(), docs[i]);
+	for(int i = 0; i < errs.count(); i++)
+		if(!errs[i].isEmpty())
+			throw ProcessorException(*this, _ << "cannot load \"" << xpaths[i] << "\": " << errs[i]);
+	if(logFor(LOG_DEPS))
+		log << "\t" << xpaths.length() << " XML flow fact files parsed concurrently\n";
 }
 
 
@@ -746,12 +855,10 @@ void FlowFactLoader::onWarning(const string& message) {
 void FlowFactLoader::onIgnoreEntry(string name) {
 
 	// look for the symbol
-	for(Process::FileIter file(workspace()->process()); file(); file++) {
-		Symbol *sym = file->findSymbol(name);
-		if(sym) {
-			IGNORE_ENTRY(sym) = true;
-			return;
-		}
+	Symbol *sym = workspace()->process()->findSymbol(name);
+	if(sym) {
+		IGNORE_ENTRY(sym) = true;
+		return;
 	}
 
 	// else produces a warning
@@ -773,6 +880,33 @@ void FlowFactLoader::onLoop(address_t addr, int count, int total, int min, const
 	if(!inst)
 		onError(_ << "unmarked loop because instruction at " << addr << " not found");
 
+	// context-free bounds are recorded to be applied in bulk
+	if(!path) {
+		LoopBound b = loops.get(inst, LoopBound());
+		if(count > b.max)
+			b.max = count;
+		if(total >= 0)
+			b.total = total;
+		if(min >= 0)
+			b.min = min;
+		loops.put(inst, b);
+		if(logFor(LOG_BB)) {
+			if(count >= 0)
+				log << "\t(MAX_ITERATION," << inst->address() << ") = " << count << io::endl;
+			if(total >= 0)
+				log << "\t(TOTAL_ITERATION," << inst->address() << ") = " << total << io::endl;
+			if(min >= 0)
+				log << "\t(MIN_ITERATION," << inst->address() << ") = " << min << io::endl;
+		}
+		return;
+	}
+
+	// contextual bounds may depend on the context-free ones
+	if(loops.hasKey(inst)) {
+		applyLoop(inst, loops.get(inst, LoopBound()));
+		loops.remove(inst);
+	}
+
 	// put the max iteration
 	if(count >= 0) {
 		int max = path(MAX_ITERATION, inst);
@@ -800,6 +934,48 @@ void FlowFactLoader::onLoop(address_t addr, int count, int total, int min, const
 }
 
 
+/**
+ * Apply the context-free bounds of a loop.
+ * @param inst	Loop header instruction.
+ * @param bound	Bounds to apply.
+ */
+void FlowFactLoader::applyLoop(Inst *inst, const LoopBound& bound) {
+	if(bound.max >= 0 && MAX_ITERATION(inst) < bound.max)
+		MAX_ITERATION(inst) = bound.max;
+	if(bound.total >= 0)
+		TOTAL_ITERATION(inst) = bound.total;
+	if(bound.min >= 0)
+		MIN_ITERATION(inst) = bound.min;
+}
+
+
+/**
+ * Apply in one pass the context-free loop bounds collected from the
+ * flow fact files: several bounds on the same loop are merged before
+ * the properties of the instruction are accessed.
+ */
+void FlowFactLoader::applyLoops(void) {
+	for(HashMap<Inst *, LoopBound>::PairIter i(loops); i(); i++)
+		applyLoop((*i).fst, (*i).snd);
+	if(logFor(LOG_DEPS))
+		log << "\t" << loops.count() << " loop bounds applied\n";
+	loops.clear();
+}
+
+
+/**
+ * Release the loading resources (parsed documents, indexes and
+ * pending bounds).
+ */
+void FlowFactLoader::release(void) {
+	for(auto doc: parsed)
+		delete doc;
+	parsed.clear();
+	line_index.clear();
+	loops.clear();
+}
+
+
 
 /**
  * This method is called to count haw many conflict are present into an element.
@@ -1303,22 +1479,38 @@ void FlowFactLoader::scanEdge(xom::Element* edge,  ContextualPath& cpath  ){
  */
 void FlowFactLoader::loadXML(const string& path) {
 
-	// open the file
-	xom::Builder builder;
-	xom::Document *doc = builder.build(path.asSysString());
-	if(!doc)
-		throw ProcessorException(*this, _ << "cannot open " << path);
+	// already parsed?
+	xom::Document *doc = parsed.get(path, nullptr);
+	if(doc != nullptr)
+		parsed.remove(path);
 
-	// perform inclusion
-	xom::XIncluder::resolveInPlace(doc);
+	// else open the file
+	else {
+		xom::Builder builder;
+		doc = builder.build(path.asSysString());
+		if(!doc)
+			throw ProcessorException(*this, _ << "cannot open " << path);
+
+		// perform inclusion
+		xom::XIncluder::resolveInPlace(doc);
+	}
 
 	// scan the root element
 	xom::Element *root = doc->getRootElement();
 	ASSERT(root);
-	if(root->getLocalName() != "flowfacts")
+	if(root->getLocalName() != "flowfacts") {
+		delete doc;
 		throw ProcessorException(*this, _ << "bad flow fact format in " << path);
+	}
 	ContextualPath cpath;
-	scanXBody(root, cpath);
+	try {
+		scanXBody(root, cpath);
+	}
+	catch(...) {
+		delete doc;
+		throw;
+	}
+	delete doc;
 }
 
 
@@ -2288,16 +2480,23 @@ MemArea FlowFactLoader::addressOf(const string& file, int line) {
 	if(!lines_available)
 		onError("the current loader does not provide source line information");
 
+	// already resolved?
+	string key = _ << file << ':' << line;
+	if(line_index.hasKey(key))
+		return line_index.get(key, MemArea::null);
+
 	Vector<Pair<Address, Address> > addresses;
  	workSpace()->process()->getAddresses(file.toCString(), line, addresses);
  	if(!addresses) {
 		warn(_ << "cannot find the source line " << file << ":" << line);
+		line_index.put(key, MemArea::null);
 		return MemArea::null;
 	}
 
  	MemArea area(addresses[0].fst, addresses[0].snd);
  	for (int i = 1; i < addresses.length(); ++i)
  		area.join(MemArea(addresses[i].fst, addresses[i].snd));
+	line_index.put(key, area);
 
 	if (logFor(LOG_DEPS))
 		log << "\t" << file << ":" << line << " is " << area << io::endl;
@@ -81,6 +81,13 @@ void AbstractConstraint::setLabel(const string& label) {
 }
 
 
+/**
+ */
+void AbstractConstraint::setConstant(double k) {
+	_cst = k;
+}
+
+
 /**
  */
 double AbstractConstraint::coefficient(Var *var) const {
@@ -313,8 +320,10 @@ void AbstractSystem::exportLP(io::Output& out) {
  */
 void AbstractSystem::dumpSolution(io::Output& out) {
 	for(FragTable<AbstractVar *>::Iter var(vars); var(); var++)
-		if(*var)
-			out << var->name() << " = " << valueOf(*var) << io::endl;
+		if(*var) {
+			var->print(out);
+			out << " = " << valueOf(*var) << io::endl;
+		}
 }
 
 
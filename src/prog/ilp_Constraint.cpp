@@ -115,6 +115,60 @@ void Constraint::sub(const Expression& e) {
 }
 
 
+/**
+ * Change the constant (right part) of the constraint. The default
+ * implementation is based on sub() and constant() but ILP plugins may
+ * provide a more efficient one.
+ * @param k		New constant.
+ */
+void Constraint::setConstant(double k) {
+	sub(k - constant());
+}
+
+
+/**
+ * Change the coefficient of a variable in the left part of the constraint.
+ * The default implementation is based on add() and coefficient() but ILP
+ * plugins may provide a more efficient one.
+ * @param var	Variable to change coefficient of.
+ * @param coef	New coefficient.
+ */
+void Constraint::setCoefficient(Var *var, double coef) {
+	ASSERT(var);
+	add(coef - coefficient(var), var);
+}
+
+
+/**
+ * @fn const Desc& Constraint::desc(void) const;
+ * Get the description of the constraint, used to build lazily a label
+ * when the constraint has no explicit label.
+ * @return	Constraint description (may be null).
+ */
+
+
+/**
+ * @fn void Constraint::setDesc(const Desc& desc);
+ * Set the description of the constraint. Its textual form is only built
+ * if the system is dumped.
+ * @param desc	New description.
+ */
+
+
+/**
+ * Print the label of the constraint: the explicit label if any, or
+ * the label built from the description.
+ * @param out	Output stream.
+ */
+void Constraint::printLabel(io::Output& out) const {
+	const string& l = label();
+	if(l)
+		out << l;
+	else
+		out << _desc;
+}
+
+
 /**
  */
 io::Output& operator<<(io::Output& out, const Term& t) {
@@ -122,8 +176,8 @@ io::Output& operator<<(io::Output& out, const Term& t) {
 		out << '0';
 	else if(!t.fst)
 		out << t.snd;
-	else if(t.fst->name())
-		out << t.snd << ' ' << t.fst->name();
+	else if(t.fst->name() || t.fst->desc())
+		out << t.snd << ' ' << *t.fst;
 	else
 		out << t.snd << " x" << (void *)t.fst;
 	return out;
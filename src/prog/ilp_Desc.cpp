@@ -0,0 +1,186 @@
+/*
+ *	ilp::Desc class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <otawa/ilp/Desc.h>
+
+namespace otawa { namespace ilp {
+
+/**
+ * @class Desc
+ * Compact description of an ILP variable or of an ILP constraint. Instead of
+ * building a textual name when the object is created (that is costly
+ * for systems containing millions of variables), the producer only records
+ * a kind and up to two integer identifiers and a context string (that is
+ * shared, not copied). The textual name is only built when the system
+ * is dumped or exported.
+ *
+ * The kind is an object implementing Desc::Kind that is used to produce
+ * the textual name. Usually, it is a static object of the producer
+ * (see FormatKind for a ready-to-use kind).
+ *
+ * @ingroup ilp
+ */
+
+
+/**
+ * @fn Desc::Desc(void);
+ * Build a null description.
+ */
+
+
+/**
+ * @fn Desc::Desc(const Kind& kind, int fst, int snd, const string& ctx);
+ * Build a description.
+ * @param kind	Kind of the description.
+ * @param fst	First identifier.
+ * @param snd	Second identifier (optional).
+ * @param ctx	Context name (optional).
+ */
+
+
+/**
+ * @fn Desc::Desc(const Kind& kind, int fst, const string& ctx);
+ * Build a description with only one identifier.
+ * @param kind	Kind of the description.
+ * @param fst	First identifier.
+ * @param ctx	Context name.
+ */
+
+
+/**
+ * @fn const Kind *Desc::kind(void) const;
+ * Get the kind of the description.
+ * @return	Description kind or null.
+ */
+
+
+/**
+ * @fn int Desc::first(void) const;
+ * Get the first identifier of the description.
+ * @return	First identifier (-1 if not set).
+ */
+
+
+/**
+ * @fn int Desc::second(void) const;
+ * Get the second identifier of the description.
+ * @return	Second identifier (-1 if not set).
+ */
+
+
+/**
+ * @fn const string& Desc::context(void) const;
+ * Get the context name of the description.
+ * @return	Context name.
+ */
+
+
+/**
+ * @fn bool Desc::isNull(void) const;
+ * Test if the description is null.
+ * @return	True if it is null, false else.
+ */
+
+
+/**
+ * @fn void Desc::print(io::Output& out) const;
+ * Print the textual name corresponding to the description.
+ * Print nothing for a null description.
+ * @param out	Output stream.
+ */
+
+
+/**
+ * Build the textual name corresponding to the description.
+ * @return	Textual name (empty for a null description).
+ */
+string Desc::make(void) const {
+	if(!_kind)
+		return "";
+	StringBuffer buf;
+	_kind->print(buf, *this);
+	return buf.toString();
+}
+
+
+/**
+ * @class Desc::Kind
+ * Kind of a description: in charge of translating a description into
+ * a textual name.
+ */
+
+
+/**
+ */
+Desc::Kind::~Kind(void) {
+}
+
+
+/**
+ * @fn void Desc::Kind::print(io::Output& out, const Desc& desc) const;
+ * Print the textual name of the given description.
+ * @param out	Output stream.
+ * @param desc	Description to print.
+ */
+
+
+/**
+ * @class FormatKind
+ * Description kind built from a format string. The format is output
+ * as is except for the following escape sequences:
+ * @li %1 -- first identifier,
+ * @li %2 -- second identifier,
+ * @li %c -- context name,
+ * @li %% -- a single '%' character.
+ *
+ * As an example, "x%1_%c" with first identifier 3 and context "main"
+ * produces "x3_main".
+ *
+ * @ingroup ilp
+ */
+
+
+/**
+ * Build a format kind.
+ * @param format	Used format (must remain alive as long as the kind).
+ */
+FormatKind::FormatKind(cstring format): _fmt(format) {
+}
+
+
+/**
+ */
+void FormatKind::print(io::Output& out, const Desc& desc) const {
+	for(int i = 0; i < _fmt.length(); i++)
+		if(_fmt[i] != '%' || i + 1 == _fmt.length())
+			out << _fmt[i];
+		else {
+			i++;
+			switch(_fmt[i]) {
+			case '1':	out << desc.first(); break;
+			case '2':	out << desc.second(); break;
+			case 'c':	out << desc.context(); break;
+			default:	out << _fmt[i]; break;
+			}
+		}
+}
+
+} } // otawa::ilp
@@ -0,0 +1,741 @@
+/*
+ *	ilp::Exporter class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "config.h"
+#include <math.h>
+#include <string.h>
+#ifdef OTAWA_ZLIB
+#	include <zlib.h>
+#endif
+#include <elm/data/Array.h>
+#include <elm/sys/System.h>
+#include <elm/util/UniquePtr.h>
+#include <otawa/base.h>
+#include <otawa/ilp/Exporter.h>
+#include <otawa/ilp/System.h>
+
+namespace otawa { namespace ilp {
+
+/**
+ * Output stream accumulating the written bytes in a big buffer
+ * before passing them to the actual stream.
+ */
+class BufferedStream: public io::OutStream {
+public:
+	BufferedStream(io::OutStream& out, int size)
+		: _out(out), _buf(new char[size]), _size(size), _p(0) { }
+	~BufferedStream(void) { flush(); delete [] _buf; }
+
+	int write(const char *buffer, int size) override {
+		if(_p + size > _size) {
+			dump();
+			if(size > _size)
+				return _out.write(buffer, size);
+		}
+		memcpy(_buf + _p, buffer, size);
+		_p += size;
+		return size;
+	}
+
+	int flush(void) override {
+		dump();
+		return _out.flush();
+	}
+
+private:
+	void dump(void) {
+		if(_p)
+			_out.write(_buf, _p);
+		_p = 0;
+	}
+
+	io::OutStream& _out;
+	char *_buf;
+	int _size, _p;
+};
+
+
+/**
+ * Stream escaping any non-C character as _xx (xx being the hexadecimal
+ * ASCII code) so that names of variables can be used as identifiers
+ * by the ILP solvers.
+ */
+class CIDStream: public io::OutStream {
+public:
+	CIDStream(io::OutStream& out, bool no_exp = false)
+		: _out(out), _fst(true), _no_exp(no_exp) { }
+
+	int write(const char *buffer, int size) override {
+		for(int i = 0; i < size; i++)
+			put(buffer[i]);
+		return size;
+	}
+
+	int flush(void) override { return 0; }
+
+private:
+	void put(char c) {
+		if(((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'
+			|| (c >= '0' && c <= '9' && !_fst))
+		&& !(_fst && _no_exp && (c == 'e' || c == 'E')))
+			_out.write(&c, 1);
+		else {
+			static const char *digits = "0123456789abcdef";
+			char b[3] = { '_', digits[(c >> 4) & 0xf], digits[c & 0xf] };
+			_out.write(b, 3);
+		}
+		_fst = false;
+	}
+
+	io::OutStream& _out;
+	bool _fst, _no_exp;
+};
+
+
+#ifdef OTAWA_ZLIB
+/**
+ * Output stream compressing its output with GZip.
+ */
+class GZipStream: public io::OutStream {
+public:
+	GZipStream(const sys::Path& path) {
+		_file = gzopen(path.toString().toCString().chars(), "wb");
+		if(!_file)
+			throw otawa::Exception(_ << "cannot open " << path);
+	}
+	~GZipStream(void) { gzclose(_file); }
+	int write(const char *buffer, int size) override { return gzwrite(_file, buffer, size); }
+	int flush(void) override { return 0; }
+private:
+	gzFile _file;
+};
+#endif
+
+
+/**
+ * @class Exporter
+ * Exporter of ILP systems to files in format understood by ILP solvers.
+ * Supported formats includes @ref LP_SOLVE, @ref CPLEX, @ref FIXED_MPS
+ * and @ref FREE_MPS.
+ *
+ * The exporter is designed to handle very big systems: the output is
+ * accumulated in a big buffer before being written to the actual stream
+ * and the names of the variables are derived on the fly, during the output,
+ * from the variable names or descriptions (see ilp::Desc): no renamed
+ * copy of the variable names is built. For fixed MPS, the names are limited
+ * to 8 characters and therefore the columns are named by their index: systems
+ * with 10 millions variables or constraints or more must be exported in free MPS.
+ *
+ * When the output is performed to a path ending with ".gz", the output is
+ * compressed with GZip (if OTAWA has been compiled with zlib support).
+ *
+ * @ingroup ilp
+ */
+
+
+/**
+ * Build an exporter.
+ * @param sys			System to export.
+ * @param format		Output format (if DEFAULT, CPLEX is used).
+ * @param buffer_size	Size of the write buffer.
+ */
+Exporter::Exporter(System *sys, format_t format, int buffer_size)
+: _sys(sys), _fmt(format), _size(buffer_size) {
+	if(_fmt == DEFAULT)
+		_fmt = CPLEX;
+}
+
+
+/**
+ * @fn format_t Exporter::format(void) const;
+ * Get the output format.
+ * @return	Output format.
+ */
+
+
+/**
+ * @fn void Exporter::setFormat(format_t format);
+ * Change the output format.
+ * @param format	New output format.
+ */
+
+
+/**
+ * Export the system to the given stream.
+ * @param out	Stream to output to.
+ */
+void Exporter::write(io::OutStream& out) {
+	BufferedStream buf(out, _size);
+	io::Output output(buf);
+	_index.clear();
+	_vars.clear();
+	switch(_fmt) {
+	case LP_SOLVE:	writeLPSolve(output); break;
+	case CPLEX:		writeCPlex(output); break;
+	case FIXED_MPS:	writeMPS(output, false); break;
+	case FREE_MPS:	writeMPS(output, true); break;
+	case MOSEK:		buf.flush(); _sys->dumpMOSEK(out); break;
+	default:		ASSERTP(false, "unsupported ILP export format"); break;
+	}
+	buf.flush();
+}
+
+
+/**
+ * Export the system to the given file. If the path ends with ".gz",
+ * the output is compressed. On error, the partially written file is removed.
+ * @param path		Path of the file to write to.
+ * @throw otawa::Exception	If the file cannot be created, if the compression
+ * 							is not supported or if the system cannot be exported
+ * 							in the current format.
+ */
+void Exporter::write(const sys::Path& path) {
+	if(_fmt == FIXED_MPS)
+		checkFixedMPS();
+	UniquePtr<io::OutStream> out;
+	if(isCompressed(path)) {
+#		ifdef OTAWA_ZLIB
+			out = new GZipStream(path);
+#		else
+			throw otawa::Exception(_ << "cannot compress " << path << ": no compression support");
+#		endif
+	}
+	else
+		try {
+			out = sys::System::createFile(path);
+		}
+		catch(sys::SystemException& e) {
+			throw otawa::Exception(_ << "cannot open " << path << ": " << e.message());
+		}
+	try {
+		write(*out);
+	}
+	catch(elm::Exception&) {
+		out = nullptr;
+		try {
+			path.remove();
+		}
+		catch(sys::SystemException&) {
+		}
+		throw;
+	}
+}
+
+
+/**
+ * Test if the given path requires compression.
+ * @param path	Path to test.
+ * @return		True if the output must be compressed, false else.
+ */
+bool Exporter::isCompressed(const sys::Path& path) {
+	return path.extension() == "gz";
+}
+
+
+/**
+ * Test if the exporter supports compression.
+ * @return	True if compression is supported, false else.
+ */
+bool Exporter::supportsCompression(void) {
+#	ifdef OTAWA_ZLIB
+		return true;
+#	else
+		return false;
+#	endif
+}
+
+
+/**
+ * Get the output format from the extension of the given path
+ * (a ".gz" extension is ignored):
+ * @li .lp -- @ref LP_SOLVE,
+ * @li .cplex, .lpt -- @ref CPLEX,
+ * @li .mps -- @ref FIXED_MPS,
+ * @li .fmps -- @ref FREE_MPS,
+ * @li .mosek, .opf -- @ref MOSEK.
+ * @param path	Path to look extension in.
+ * @return		Matching format or DEFAULT if the extension is unknown.
+ */
+format_t Exporter::formatOf(const sys::Path& path) {
+	sys::Path p = path;
+	if(isCompressed(p))
+		p = p.withoutExt();
+	string ext = p.extension();
+	if(ext == "lp")
+		return LP_SOLVE;
+	else if(ext == "cplex" || ext == "lpt")
+		return CPLEX;
+	else if(ext == "mps")
+		return FIXED_MPS;
+	else if(ext == "fmps")
+		return FREE_MPS;
+	else if(ext == "mosek" || ext == "opf")
+		return MOSEK;
+	else
+		return DEFAULT;
+}
+
+
+/**
+ * Get the index of a variable, allocating a new one at first call.
+ * @param var	Variable to get index for.
+ * @return		Variable index.
+ */
+int Exporter::index(Var *var) {
+	int i = _index.get(var, -1);
+	if(i < 0) {
+		i = _vars.length();
+		_index.put(var, i);
+		_vars.add(var);
+	}
+	return i;
+}
+
+
+/**
+ * Write the name of a variable.
+ * @param out	Output stream.
+ * @param var	Variable to output.
+ */
+void Exporter::writeName(io::Output& out, Var *var) {
+	int i = index(var);
+	if(_fmt == FIXED_MPS)
+		out << 'C' << i;
+	else if(!var->name() && !var->desc())
+		out << "_x" << i;
+	else {
+		CIDStream s(out.stream(), _fmt == CPLEX);
+		io::Output o(s);
+		if(var->name())
+			o << var->name();
+		else
+			o << var->desc();
+	}
+}
+
+
+/**
+ * Write a numeric value (as an integer if it is integral).
+ * @param out	Output stream.
+ * @param val	Value to output.
+ */
+void Exporter::writeValue(io::Output& out, double val) {
+	if(fabs(val) < 1e15 && val == double(t::int64(val)))
+		out << t::int64(val);
+	else
+		out << val;
+}
+
+
+/**
+ * Write a term.
+ * @param out	Output stream.
+ * @param var	Variable of the term.
+ * @param coef	Coefficient of the term.
+ * @param fst	True if it is the first term of the expression.
+ */
+void Exporter::writeTerm(io::Output& out, Var *var, double coef, bool fst) {
+	if(coef < 0) {
+		out << "- ";
+		if(coef != -1) {
+			writeValue(out, -coef);
+			out << ' ';
+		}
+	}
+	else {
+		if(!fst)
+			out << "+ ";
+		if(coef != 1) {
+			writeValue(out, coef);
+			out << ' ';
+		}
+	}
+	writeName(out, var);
+}
+
+
+/**
+ * Test if the constraint is a bound, that is, a constraint with only
+ * one term with coefficient 1.
+ * @param cons	Constraint to test.
+ * @param var	Set to the variable of the bound.
+ * @return		True if it is a bound, false else.
+ */
+bool Exporter::isBound(Constraint *cons, Var *& var) {
+	int cnt = 0;
+	for(Constraint::TermIterator term(cons); term(); term++) {
+		if((*term).snd != 1)
+			return false;
+		var = (*term).fst;
+		cnt++;
+	}
+	return cnt == 1;
+}
+
+
+/**
+ * Export in LPSolve format.
+ * @param out	Output stream.
+ */
+void Exporter::writeLPSolve(io::Output& out) {
+	out << "/* IPET system */\n";
+
+	// Output the objective function
+	out << "max:";
+	bool fst = true;
+	for(System::ObjTermIterator term(_sys); term(); term++)
+		if((*term).fst && (*term).snd) {
+			out << ' ';
+			writeTerm(out, (*term).fst, (*term).snd, fst);
+			fst = false;
+		}
+	out << ";\n";
+
+	// Output the constraints
+	for(System::ConstIterator cons(_sys); cons(); cons++) {
+
+		// print positives
+		bool pos = false;
+		fst = true;
+		for(Constraint::TermIterator term(*cons); term(); term++)
+			if((*term).snd > 0) {
+				if(!fst)
+					out << ' ';
+				writeTerm(out, (*term).fst, (*term).snd, fst);
+				pos = true;
+				fst = false;
+			}
+		if(fst)
+			out << '0';
+
+		// print negative constant
+		double k = cons->constant();
+		if(k < 0) {
+			if(pos)
+				out << " + ";
+			writeValue(out, -k);
+		}
+
+		// print comparator
+		out << ' ' << cons->comparator();
+
+		// print negatives
+		bool neg = false;
+		fst = true;
+		for(Constraint::TermIterator term(*cons); term(); term++)
+			if((*term).snd < 0) {
+				out << ' ';
+				writeTerm(out, (*term).fst, -(*term).snd, fst);
+				neg = true;
+				fst = false;
+			}
+
+		// print positive constant
+		if(!neg && k <= 0)
+			out << " 0";
+		else if(k > 0 || (k == 0 && !neg)) {
+			if(neg)
+				out << " +";
+			out << ' ';
+			writeValue(out, k);
+		}
+
+		// end of constraint
+		out << ';';
+		if(cons->label() || cons->desc()) {
+			out << "\t/* ";
+			cons->printLabel(out);
+			out << "*/";
+		}
+		out << '\n';
+	}
+
+	// Output int constraints
+	for(int i = 0; i < _vars.length(); i++)
+		switch(_vars[i]->type()) {
+		case Var::INT:	out << "int "; writeName(out, _vars[i]); out << ";\n"; break;
+		case Var::BIN:	out << "bin "; writeName(out, _vars[i]); out << ";\n"; break;
+		default:		break;
+		}
+}
+
+
+/**
+ * Export in CPlex format.
+ * @param out	Output stream.
+ */
+void Exporter::writeCPlex(io::Output& out) {
+
+	// dump the objective function
+	out << "\\* Objective function *\\\n";
+	out << "Maximize\n";
+	bool fst = true;
+	for(System::ObjTermIterator term(_sys); term(); term++)
+		if((*term).fst && (*term).snd) {
+			out << ' ';
+			writeTerm(out, (*term).fst, (*term).snd, fst);
+			out << '\n';
+			fst = false;
+		}
+	out << "\n\n";
+
+	// dump the constraints
+	out << "\\* Constraints *\\\n";
+	out << "Subject To\n";
+	Var *var;
+	for(System::ConstIterator cons(_sys); cons(); cons++) {
+		if(isBound(*cons, var))
+			continue;
+		fst = true;
+		for(Constraint::TermIterator term(*cons); term(); term++)
+			if((*term).snd) {
+				out << ' ';
+				writeTerm(out, (*term).fst, (*term).snd, fst);
+				fst = false;
+			}
+		if(fst)
+			out << " 0 ";
+		out << ' ' << cons->comparator() << ' ';
+		writeValue(out, cons->constant());
+		out << '\n';
+	}
+	out << "\n\n";
+
+	// dump the bounds
+	out << "\\* Variable bounds *\\\n";
+	out << "Bounds\n";
+	for(System::ConstIterator cons(_sys); cons(); cons++)
+		if(isBound(*cons, var)) {
+			out << ' ';
+			writeName(out, var);
+			out << ' ' << cons->comparator() << ' ';
+			writeValue(out, cons->constant());
+			out << '\n';
+		}
+	out << "\n\n";
+
+	// dump the integer variable definition
+	out << "\\* Integer definitions *\\\n";
+	out << "Integer\n";
+	for(int i = 0; i < _vars.length(); i++)
+		if(_vars[i]->type() == Var::INT) {
+			out << ' ';
+			writeName(out, _vars[i]);
+			out << '\n';
+		}
+	out << "\n\n";
+	out << "Binary\n";
+	for(int i = 0; i < _vars.length(); i++)
+		if(_vars[i]->type() == Var::BIN) {
+			out << ' ';
+			writeName(out, _vars[i]);
+			out << '\n';
+		}
+	out << "\n\n";
+
+	// dump end
+	out << "End\n";
+}
+
+
+/**
+ * Entry of the MPS matrix.
+ */
+class MPSEntry {
+public:
+	inline MPSEntry(void): col(0), row(0), coef(0) { }
+	inline MPSEntry(int c, int r, double k): col(c), row(r), coef(k) { }
+	int col, row;
+	double coef;
+};
+
+
+/**
+ * Output a field of a MPS file: in fixed format, the field is padded
+ * with spaces up to the given width.
+ */
+class MPSField {
+public:
+	inline MPSField(char prefix, int index, int width, bool free)
+		: p(prefix), i(index), w(width), f(free) { }
+	char p;
+	int i, w;
+	bool f;
+};
+
+io::Output& operator<<(io::Output& out, const MPSField& f) {
+	out << f.p << f.i;
+	if(f.f)
+		out << ' ';
+	else {
+		int n = 2;
+		for(int i = f.i; i >= 10; i /= 10)
+			n++;
+		for(; n < f.w; n++)
+			out << ' ';
+	}
+	return out;
+}
+
+
+static const int MPS_MAX_INDEX = 10000000;
+
+/**
+ * Check that the system can be exported in fixed MPS: names are limited
+ * to 8 characters, that is, a letter and 7 digits.
+ * @throw otawa::Exception	If the system has too many variables or constraints.
+ */
+void Exporter::checkFixedMPS(void) {
+	if(_sys->countVars() >= MPS_MAX_INDEX || _sys->countConstraints() >= MPS_MAX_INDEX)
+		throw otawa::Exception(_ << "system too big for fixed MPS names ("
+			<< _sys->countVars() << " variables, " << _sys->countConstraints()
+			<< " constraints): use free MPS instead");
+}
+
+
+/**
+ * Export in MPS format. The system is transposed (MPS is column-oriented)
+ * in a single table of (column, row, coefficient) triplets sorted by
+ * column with a counting sort.
+ * @param out	Output stream.
+ * @param free	True for free MPS, false for fixed MPS.
+ * @throw otawa::Exception	If the system has too many variables or constraints
+ * 							to be named in fixed MPS.
+ */
+void Exporter::writeMPS(io::Output& out, bool free) {
+	static const int OBJ = -1;
+	cstring sep = free ? " " : "  ";
+	// in fixed MPS, the fields start at columns 5, 15 and 25
+	cstring marker = free ? "    MARKER 'MARKER' " : "    MARKER    'MARKER'  ";
+	Vector<MPSEntry> entries;
+	Vector<Pair<int, double> > rhs;
+
+	if(!free)
+		checkFixedMPS();
+
+	// header
+	if(free)
+		out << "NAME IPET\n";
+	else
+		out << "NAME          IPET\n";
+	out << "OBJSENSE\n    MAX\n";
+
+	// rows and matrix entries
+	out << "ROWS\n N  obj\n";
+	for(System::ObjTermIterator term(_sys); term(); term++)
+		if((*term).fst && (*term).snd)
+			entries.add(MPSEntry(index((*term).fst), OBJ, (*term).snd));
+	int r = 0;
+	for(System::ConstIterator cons(_sys); cons(); cons++, r++) {
+		switch(cons->comparator()) {
+		case Constraint::LT:
+		case Constraint::LE:	out << " L  "; break;
+		case Constraint::EQ:	out << " E  "; break;
+		case Constraint::GT:
+		case Constraint::GE:	out << " G  "; break;
+		default:				ASSERTP(false, "unsupported comparator"); break;
+		}
+		out << 'R' << r << '\n';
+		for(Constraint::TermIterator term(*cons); term(); term++)
+			if((*term).snd)
+				entries.add(MPSEntry(index((*term).fst), r, (*term).snd));
+		if(cons->constant())
+			rhs.add(pair(r, cons->constant()));
+	}
+
+	// sort by column (counting sort)
+	AllocArray<int> start(_vars.length() + 1);
+	for(int i = 0; i <= _vars.length(); i++)
+		start[i] = 0;
+	for(int i = 0; i < entries.length(); i++)
+		start[entries[i].col + 1]++;
+	for(int i = 1; i <= _vars.length(); i++)
+		start[i] += start[i - 1];
+	AllocArray<MPSEntry> sorted(entries.length());
+	for(int i = 0; i < entries.length(); i++)
+		sorted[start[entries[i].col]++] = entries[i];
+	entries.clear();
+
+	// output the columns
+	out << "COLUMNS\n";
+	bool in_int = false;
+	for(int i = 0; i < sorted.length();) {
+		int c = sorted[i].col;
+		bool is_int = _vars[c]->type() != Var::FLOAT;
+		if(is_int != in_int) {
+			out << marker << (is_int ? "'INTORG'\n" : "'INTEND'\n");
+			in_int = is_int;
+		}
+		while(i < sorted.length() && sorted[i].col == c) {
+
+			// merge duplicate entries
+			int r = sorted[i].row;
+			double k = 0;
+			for(; i < sorted.length() && sorted[i].col == c && sorted[i].row == r; i++)
+				k += sorted[i].coef;
+			if(!k)
+				continue;
+
+			// output the entry
+			out << "    ";
+			if(free)
+				writeName(out, _vars[c]);
+			else
+				out << MPSField('C', c, 8, false);
+			out << sep;
+			if(r == OBJ)
+				out << (free ? "obj " : "obj     ");
+			else
+				out << MPSField('R', r, 8, free);
+			if(!free)
+				out << "  ";
+			writeValue(out, k);
+			out << '\n';
+		}
+	}
+	if(in_int)
+		out << marker << "'INTEND'\n";
+
+	// output the right-hand sides
+	out << "RHS\n";
+	for(int i = 0; i < rhs.length(); i++) {
+		out << (free ? "    RHS " : "    RHS       ") << MPSField('R', rhs[i].fst, 8, free);
+		if(!free)
+			out << "  ";
+		writeValue(out, rhs[i].snd);
+		out << '\n';
+	}
+
+	// output the bounds
+	out << "BOUNDS\n";
+	for(int i = 0; i < _vars.length(); i++)
+		if(_vars[i]->type() != Var::FLOAT) {
+			out << (_vars[i]->type() == Var::BIN ? " BV " : " PL ") << (free ? "BND " : "BND       ");
+			if(free)
+				writeName(out, _vars[i]);
+			else
+				out << MPSField('C', i, 8, false);
+			out << '\n';
+		}
+	out << "ENDATA\n";
+}
+
+} } // otawa::ilp
@@ -19,6 +19,7 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <otawa/ilp/Exporter.h>
 #include <otawa/ilp/Output.h>
 #include <otawa/ipet/features.h>
 #include <elm/sys/System.h>
@@ -42,12 +43,16 @@ p::feature OUTPUT_FEATURE("otawa::ilp::OUTPUT_FEATURE", p::make<Output>());
 
 /**
  * Select the output format to build the @ref OUTPUT_FEATURE.
- * Accepted values includes @ref ilp::LP_SOLVE (1), @ref ilp::CPLEX (2) or @ref::ilp::MOSEK (3).
+ * Accepted values includes @ref ilp::LP_SOLVE (1), @ref ilp::CPLEX (2), @ref::ilp::MOSEK (3),
+ * @ref ilp::FIXED_MPS (4) or @ref ilp::FREE_MPS (5). If not set, the format
+ * is guessed from the extension of @ref OUTPUT_PATH (see Exporter::formatOf())
+ * and defaults to @ref ilp::LP_SOLVE.
  */
 Identifier<format_t> OUTPUT_FORMAT("otawa::ilp::OUTPUT_FORMAT", LP_SOLVE);
 
 /**
  * Select the file to perform the output during build of @ref OUTPUT_FEATURE.
+ * If the path ends with ".gz", the output is compressed.
  */
 Identifier<sys::Path> OUTPUT_PATH("otawa::ilp::OUTPUT_PATH", "");
 
@@ -61,7 +66,8 @@ Identifier<elm::io::OutStream *> OUTPUT("otawa::ilp::OUTPUT", 0);
  * @class Output
  * This processor provides an output of the built ILP system.
  * Possible output includes standard output, any stream output or file.
- * The supported output format are LP_SOLVE, CPLEX or MOSEK.
+ * The supported output format are LP_SOLVE, CPLEX, MOSEK, FIXED_MPS
+ * or FREE_MPS (see ilp::Exporter).
  */
 
 p::declare Output::reg = p::init("otawa::ilp::Output", Version(1, 0, 0))
@@ -83,7 +89,10 @@ Output::~Output(void) {
  */
 void Output::configure(const PropList &props) {
 	Processor::configure(props);
-	format = OUTPUT_FORMAT(props);
+	if(props.hasProp(OUTPUT_FORMAT))
+		format = OUTPUT_FORMAT(props);
+	else
+		format = DEFAULT;
 	stream = ilp::OUTPUT(props);
 	path = OUTPUT_PATH(props);
 }
@@ -92,15 +101,12 @@ void Output::configure(const PropList &props) {
  */
 void Output::setup(WorkSpace *ws) {
 	if(!stream) {
-		if(path)
-			try {
-				stream = sys::System::createFile(path);
-				do_free = true;
-				if(logFor(LOG_FILE))
-					log << "INFO: outputting to " << path << io::endl;
-			} catch(elm::sys::SystemException& e) {
-				throw ProcessorException(*this, _ << "cannot open " << path << ": " << e.message());
-			}
+		if(path) {
+			if(Exporter::isCompressed(path) && !Exporter::supportsCompression())
+				throw ProcessorException(*this, _ << "cannot compress " << path << ": no compression support");
+			if(logFor(LOG_FILE))
+				log << "INFO: outputting to " << path << io::endl;
+		}
 		else {
 			stream = &io::out;
 			if(logFor(LOG_FILE))
@@ -116,7 +122,20 @@ void Output::setup(WorkSpace *ws) {
 void Output::processWorkSpace(WorkSpace *ws) {
 	ilp::System *system = ipet::SYSTEM(ws);
 	ASSERT(system);
-	system->dump(format, *stream);
+	if(stream)
+		system->dump(format == DEFAULT ? LP_SOLVE : format, *stream);
+	else
+		try {
+			format_t f = format;
+			if(f == DEFAULT)
+				f = Exporter::formatOf(path);
+			if(f == DEFAULT)
+				f = LP_SOLVE;
+			Exporter(system, f).write(path);
+		}
+		catch(otawa::Exception& e) {
+			throw ProcessorException(*this, e.message());
+		}
 }
 
 /**
@@ -136,6 +155,8 @@ namespace elm {
 		value("LP_SOLVE", otawa::ilp::LP_SOLVE),
 		value("CPLEX", otawa::ilp::CPLEX),
 		value("MOSEK", otawa::ilp::MOSEK),
+		value("FIXED_MPS", otawa::ilp::FIXED_MPS),
+		value("FREE_MPS", otawa::ilp::FREE_MPS),
 		last()
 	};
 }
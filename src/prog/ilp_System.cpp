@@ -19,38 +19,12 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include <elm/avl/Set.h>
+#include <otawa/ilp/Exporter.h>
 #include <otawa/ilp/System.h>
 #include <math.h>
 
 namespace otawa { namespace ilp {
 
-/**
- * Assistant to perform ILP system dump.
- */
-class Dumper {
-public:
-	Dumper(void): vcnt(0) { }
-
-	string name(ilp::Var *var) {
-		string r = var->name();
-		if(!r) {
-			r = map.get(var, "");
-			if(!r) {
-				r = _ << "x" << vcnt;
-				map.put(var, r);
-				vcnt++;
-			}
-		}
-		return r;
-	}
-
-private:
-	int vcnt;
-	HashMap<Var *, string> map;
-};
-
-
 /**
  * @class System
  * An ILP system is a colletion of ILP constraint that may maximize or minimize
@@ -164,6 +138,64 @@ string System::lastErrorMessage(void) {
  */
 
 
+/**
+ * Get the coefficient of a variable in the objective function.
+ * The default implementation traverses the objective function terms and is
+ * therefore linear in the size of the objective function: a user performing
+ * many changes should index the coefficients itself (as ipet::WhatIf does).
+ * @param var	Variable to look for.
+ * @return		Coefficient of the variable (0 if not used).
+ * @since ILP 1.4 interface.
+ */
+double System::objectCoef(Var *var) {
+	double k = 0;
+	for(ObjTermIterator t(this); t(); t++)
+		if((*t).fst == var)
+			k += (*t).snd;
+	return k;
+}
+
+
+/**
+ * Change in place the coefficient of a variable in the objective function.
+ * Combined with Constraint::setConstant() and Constraint::setCoefficient(),
+ * this allows to modify an already built system and to resolve it with
+ * resolve() instead of building a new system.
+ * @param var	Variable to change coefficient of.
+ * @param coef	New coefficient.
+ * @since ILP 1.4 interface.
+ */
+void System::setObjectCoef(Var *var, double coef) {
+	addObjectFunction(coef - objectCoef(var), var);
+}
+
+
+/**
+ * Solve again the system after in-place modifications (objective
+ * coefficients, constraint constants or coefficients). ILP plugins
+ * supporting warm start (see supportsWarmStart()) override this function
+ * to restart from the last found solution. As a default, call solve().
+ * @param ws	Current workspace.
+ * @param mon	Monitor to use.
+ * @return		True if the resolution is successful, false else.
+ * @since ILP 1.4 interface.
+ */
+bool System::resolve(WorkSpace *ws, otawa::Monitor& mon) {
+	return solve(ws, mon);
+}
+
+
+/**
+ * Test if the system supports warm start in resolve().
+ * As a default, return false.
+ * @return	True if warm start is supported, false else.
+ * @since ILP 1.4 interface.
+ */
+bool System::supportsWarmStart(void) {
+	return false;
+}
+
+
 /**
  * Return the owner plugin. As a default, return null.
  * @return	Owner plugin.
@@ -184,156 +216,19 @@ void System::dump(format_t fmt, elm::io::OutStream& out) {
 	case LP_SOLVE:	dumpLPSolve(out); break;
 	case CPLEX:		dumpCPlex(out); break;
 	case MOSEK:		dumpMOSEK(out); break;
+	case FIXED_MPS:
+	case FREE_MPS:	Exporter(this, fmt).write(out); break;
 	default:		ASSERTP(false, "Unsopported ILP system format."); break;
 	}
 }
 
 
-/**
- * Output an identifier as a C identifier.
- * Non-C symbols are escaped to _xx where xx is the hexadecimal ASCII code.
- * @param out	Output to output to.
- * @param in	Identifier to output.
- */
-class CID: public string {
-public:
-	inline CID(string s): string(s) { }
-};
-io::Output& operator<<(io::Output& out, const CID& id) {
-	io::IntFormat fmt = io::IntFormat().hex().width(2).pad(0);
-	if(!id)
-		return out;
-	int i = 0;
-	if(id[0] >= '0' && id[0] <= '9') {
-		i = 1;
-		out << '_' << fmt(id[0]);
-	}
-	for(; i < id.length(); i++) {
-		if((id[i] >= '0' && id[i] <= '9')
-		|| (id[i] >= 'a' && id[i] <= 'z')
-		|| (id[i] >= 'A' && id[i] <= 'Z')
-		|| id[i] == '_')
-			out << id[i];
-		else
-			out << '_' << fmt(id[i]);
-	}
-	return out;
-}
-
-
-/**
- * Print a term.
- * @param out		Output to use.
- * @param term		Term to display.
- * @param dumper	Dumper assistant.
- * @param fst		True if the term is the first of the expression.
- */
-static void printTerm(io::Output& out, Term term, Dumper& dumper, bool fst) {
-	double val = term.snd;
-	if(!val)
-		return;
-	if(val < 0) {
-		out << "- ";
-		if(val != -1)
-			out << -val << ' ';
-	}
-	else {
-		if(!fst)
-			out << "+ ";
-		if(val != 1)
-			out << val << ' ';
-	}
-	out << CID(dumper.name(term.fst));
-}
-
-
 /**
  * Dump in LPSolve format.
- * @param _out	Output stream.
+ * @param out	Output stream.
  */
-void System::dumpLPSolve(io::OutStream& _out) {
-	Dumper dumper;
-	io::Output out(_out);
-	out << "/* IPET system */\n";
-	avl::Set<Var *> vars;
-
-	// Output the objective function
-	out << "max:";
-	bool fst = true;
-	for (ObjTermIterator term(this); term(); term++) {
-		out << ' ';
-		printTerm(out, *term, dumper, fst);
-		vars.add((*term).fst);
-		fst = false;
-	}
-	out << ";\n";
-
-	// Output the constraints
-	for(dyndata::Iter<Constraint *> cons(constraints()); cons(); cons++) {
-
-		// print positives
-		bool pos = false;
-		fst = true;
-		for(dyndata::Iter<Term> term(cons->terms()); term(); term++) {
-			if((*term).snd > 0) {
-				if(!fst)
-					out << ' ';
-				printTerm(out, *term, dumper, fst);
-				vars.add((*term).fst);
-				pos = true;
-				fst = false;
-			}
-		}
-		if(fst)
-			out << '0';
-
-		// print negative constant
-		if(cons->constant() < 0) {
-			if(pos)
-				out << " + ";
-			out << -cons->constant();
-		}
-
-		// print comparator
-		out << ' ' << cons->comparator();
-
-		// print negatives
-		bool neg = false;
-		fst = true;
-		for(dyndata::Iter<Term> term(cons->terms()); term(); term++)
-			if((*term).snd < 0) {
-				out << ' ';
-				printTerm(out, Term((*term).fst, -(*term).snd), dumper, fst);
-				vars.add((*term).fst);
-				neg = true;
-				fst = false;
-			}
-
-		// print positive constant
-		if(!neg && cons->constant() <= 0)
-			out << " 0";
-		else if(cons->constant() > 0 || (cons->constant() == 0 && !neg)) {
-			if(neg)
-				out << " +";
-			out << ' ' << cons->constant();
-		}
-
-		// end of constraint
-		out << ";";
-		const string& label = cons->label();
-		if(label)
-			out << "\t/* " << label << "*/";
-		out << io::endl;
-	}
-
-	// Output int constraints
-	for(avl::Set<Var *>::Iter var(vars); var(); var++)
-		switch(var->type()) {
-		case Var::INT:		out << "int " << CID(dumper.name(*var)) << ";\n"; break;
-		case Var::FLOAT:	break;
-		case Var::BIN:		out << "bin " << CID(dumper.name(*var)) << ";\n"; break;
-		default:			break;
-		}
+void System::dumpLPSolve(io::OutStream& out) {
+	Exporter(this, LP_SOLVE).write(out);
 }
 
 
@@ -463,160 +358,10 @@ void System::dumpMOSEK(OutStream& _out) {
 
 /**
  * Dump system in CPlex format.
- * @param _out	Output stream to use.
+ * @param out	Output stream to use.
  */
-void System::dumpCPlex(OutStream& _out) {
-	io::Output out(_out);
-	HashMap<Var*, String*> rename;
-	int idx = 0;
-	/* Rename the variables for cplex */
-
-
-	out << "\\* Objective function *\\\n";
-	out << "Maximize\n";
-	/* dump the objective function */
-
-	for (ObjTermIterator term(this); term(); term++) {
-		t::int32 val = lrint((*term).snd);
-		if (!rename.hasKey((*term).fst)) {
-			rename.put((*term).fst, new String((_ << "x" << idx)));
-			idx++;
-		}
-		if (val == 0)
-			continue;
-
-		out << " ";
-		if (val == 1) {
-			out << "+" << *rename.get((*term).fst, 0);
-		} else if (val == -1) {
-			out << "-" << *rename.get((*term).fst, 0);
-		} else {
-			out << io::sign(val) << " " << *rename.get((*term).fst, 0);
-		}
-		out << "\n";
-	}
-	out << "\n\n";
-
-	// dump the constraints
-	out << "\\* Constraints *\\\n";
-	out << "Subject To\n";
-	for (ConstIterator cons2(this); cons2(); cons2++) {
-		bool bound = true;
-		int numvar = 0;
-		for (Constraint::TermIterator term(*cons2); term(); term++) {
-			if ((*term).snd != 1)
-				bound = false;
-			numvar++;
-		}
-		if (numvar != 1)
-			bound = false;
-
-		if (bound)
-			continue;
-
-		for (Constraint::TermIterator term(*cons2); term(); term++) {
-			t::int32 val = lrint((*term).snd);
-			if (!rename.hasKey((*term).fst)) {
-				rename.put((*term).fst, new String((_ << "x" << idx)));
-				idx++;
-			}
-			if (val == 0)
-				continue;
-
-			out << " ";
-			if (val == 1) {
-				out << "+" << *rename.get((*term).fst, 0);
-			} else if (val == -1) {
-				out << "-" << *rename.get((*term).fst, 0);
-			} else {
-				out << io::sign(val) << " " << *rename.get((*term).fst, 0);
-			}
-
-		}
-		switch(cons2->comparator()) {
-			case Constraint::LT:
-				out << " < ";
-				break;
-			case Constraint::LE:
-				out << " <= ";
-				break;
-			case Constraint::EQ:
-				out << " = ";
-				break;
-			case Constraint::GE:
-				out << " >= ";
-				break;
-			case Constraint::GT:
-				out << " > ";
-				break;
-			default:
-				out << " ?? ";;
-				break;
-		}
-
-		out << cons2->constant() << "\n";
-	}
-	out << "\n\n";
-
-	// dump the bounds
-	out << "\\* Variable bounds *\\\n";
-	out << "Bounds\n";
-	for (ConstIterator cons2(this); cons2(); cons2++) {
-		bool bound = true;
-		int numvar = 0;
-		Var *var;
-		for (Constraint::TermIterator term(*cons2); term(); term++) {
-			if ((*term).snd != 1)
-				bound = false;
-			numvar++;
-			var = (*term).fst;
-		}
-		if (numvar != 1)
-			bound = false;
-
-		if (!bound)
-			continue;
-
-		out << " " << *rename.get(var, 0);
-		switch(cons2->comparator()) {
-			case Constraint::LT:
-				out << " < ";
-				break;
-			case Constraint::LE:
-				out << " <= ";
-				break;
-			case Constraint::EQ:
-				out << " = ";
-				break;
-			case Constraint::GE:
-				out << " >= ";
-				break;
-			case Constraint::GT:
-				out << " > ";
-				break;
-			default:
-				out << " ?? ";;
-				break;
-		}
-
-		out << cons2->constant() << "\n";
-	}
-	out << "\n\n";
-
-	// dump the integer variable definition
-	out << "\\* Integer definitions *\\\n";
-	out << "Integer\n";
-	for(HashMap<Var*, String*>::Iter item(rename); item(); item++) {
-		String *str = *item;
-		out << " ";
-		out << *str;
-		delete str;
-		out << "\n";
-	}
-	out << "\n\n";
-
-	// dump end
-	out << "End\n";
+void System::dumpCPlex(OutStream& out) {
+	Exporter(this, CPLEX).write(out);
 }
 
 
@@ -631,6 +376,8 @@ bool System::hasDump(format_t fmt) {
 		case LP_SOLVE:
 		case CPLEX:
 		case MOSEK:
+		case FIXED_MPS:
+		case FREE_MPS:
 			return true;
 			break;
 		default:
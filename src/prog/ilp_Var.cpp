@@ -73,6 +73,23 @@ namespace otawa { namespace ilp {
  */
 
 
+/**
+ * @fn const Desc& Var::desc(void) const;
+ * Get the description of the variable, used to build lazily a name
+ * when the variable has no explicit name.
+ * @return	Variable description (may be null).
+ */
+
+
+/**
+ * @fn void Var::setDesc(const Desc& desc);
+ * Set the description of the variable. This is a cheap alternative
+ * to explicit naming: the textual name is only built if the system
+ * is dumped.
+ * @param desc	New description.
+ */
+
+
 /**
  */
 Var::~Var(void) {
@@ -80,12 +97,15 @@ Var::~Var(void) {
 
 
 /**
- * Print the name of the variable.
+ * Print the name of the variable. If the variable has no explicit name,
+ * the name is built from its description.
  * @param out	Output to use.
  */
 void Var::print(io::Output& out) {
 	if(_name)
 		out << _name;
+	else if(_desc)
+		out << _desc;
 	else
 		out << '_' << (void *)this;
 }
@@ -38,6 +38,9 @@
 
 namespace otawa { namespace ipet {
 
+// lazy constraint label
+static ilp::FormatKind conflict_kind("conflict from constraint  %1");
+
 /**
  * @class FlowFactConflictConstraintBuilder
  * This processor allows using extern flow facts in an IPET system.
@@ -818,6 +821,8 @@ void FlowFactConflictConstraintBuilder::processBBConflict  (WorkSpace *ws ){
 					if(_explicit) label = _ << "conflict from constraint  " <<idConflict;
 					if (ok && conflictListEvalTohead.nbEdges()>0 &&  conflictListEvalTohead.nbEdges() == carE){
 						otawa::ilp::Constraint *cons = system->newConstraint(label, otawa::ilp::Constraint::LE);		
+						if(!_explicit)
+							cons->setDesc(ilp::Desc(conflict_kind, idConflict));
 						cons->addRight((carE-1)*s);
 						cout << "conflict "<< idConflict <<" (carE-1)*s " <<(carE-1)*s << " s = "<< s << " cardE = "<< carE << " id conflict "<<idConflict<<  " AnnotatedEdges  " <<  conflictListEvalTohead.nbEdges() << endl;
 
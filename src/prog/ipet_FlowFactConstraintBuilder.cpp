@@ -35,6 +35,13 @@
 
 namespace otawa { namespace ipet {
 
+// lazy constraint labels
+static ilp::FormatKind
+	loop_kind("loop constraint on BB %1/%c"),
+	unrolled_kind("unrolled loop constraint for BB %1/%c"),
+	total_kind("total loop constraint for BB %1/%c"),
+	zero_kind("0-execution for total loop constraint for BB %1/%c");
+
 /**
  * @class FlowFactConstraintBuilder
  * This processor allows using extern flow facts in an IPET system.
@@ -139,6 +146,9 @@ void FlowFactConstraintBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
 			if(_explicit)
 				label = _ << "loop constraint on " << bb;
 			otawa::ilp::Constraint *cons = system->newConstraint(label, otawa::ilp::Constraint::LE);
+			if(!_explicit)
+				cons->setDesc(ilp::Desc(loop_kind, bb->index(), cfg->label()));
+			MAX_CONSTRAINT(bb) = cons;
 			for(Block::EdgeIter edge = bb->ins(); edge(); edge++) {
 				ASSERT(edge->source());
 				otawa::ilp::Var *var = VAR(*edge);
@@ -165,6 +175,8 @@ void FlowFactConstraintBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
 				if(_explicit)
 					label = _ << "unrolled loop constraint for " << bb;
 				otawa::ilp::Constraint *cons0 = system->newConstraint(label, otawa::ilp::Constraint::EQ);
+				if(!_explicit)
+					cons0->setDesc(ilp::Desc(unrolled_kind, bb->index(), cfg->label()));
 				for(int i = 0; i < (-min); i++) {
 					for(Block::EdgeIter edge = bb->ins(); edge(); edge++) {
 						ASSERT(edge->source());
@@ -180,6 +192,8 @@ void FlowFactConstraintBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
 			if(_explicit)
 				label = _ << "loop constraint on " << bb;
 			otawa::ilp::Constraint *cons = system->newConstraint(label, otawa::ilp::Constraint::GE);
+			if(!_explicit)
+				cons->setDesc(ilp::Desc(loop_kind, bb->index(), cfg->label()));
 			for(Block::EdgeIter edge = bb->ins(); edge(); edge++) {
 				ASSERT(edge->source());
 				otawa::ilp::Var *var = VAR(*edge);
@@ -206,6 +220,12 @@ void FlowFactConstraintBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
 			if(_explicit)
 				label = _ << "0-execution for total loop constraint for " << bb;
 			otawa::ilp::Constraint *zero = system->newConstraint(label, otawa::ilp::Constraint::LE);
+			if(!_explicit) {
+				cons->setDesc(ilp::Desc(total_kind, bb->index(), cfg->label()));
+				zero->setDesc(ilp::Desc(zero_kind, bb->index(), cfg->label()));
+			}
+			TOTAL_CONSTRAINT(bb) = cons;
+			TOTAL_ZERO_CONSTRAINT(bb) = zero;
 
 			// 0 <= total
 			// 0 <= 0
@@ -234,6 +254,15 @@ void FlowFactConstraintBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
 }
 
 
+/**
+ */
+void FlowFactConstraintBuilder::cleanup(WorkSpace *ws) {
+	addCleaner(FLOW_FACTS_CONSTRAINTS_FEATURE, new BBRemover<ilp::Constraint *>(ws, MAX_CONSTRAINT));
+	addCleaner(FLOW_FACTS_CONSTRAINTS_FEATURE, new BBRemover<ilp::Constraint *>(ws, TOTAL_CONSTRAINT));
+	addCleaner(FLOW_FACTS_CONSTRAINTS_FEATURE, new BBRemover<ilp::Constraint *>(ws, TOTAL_ZERO_CONSTRAINT));
+}
+
+
 /**
  */
 void FlowFactConstraintBuilder::configure(const PropList& props) {
@@ -245,9 +274,47 @@ void FlowFactConstraintBuilder::configure(const PropList& props) {
 /**
  * This feature asserts that constraints tied to the flow fact information
  * has been added to the ILP system.
+ *
+ * @par Properties
+ * @li @ref MAX_CONSTRAINT
+ * @li @ref TOTAL_CONSTRAINT
+ * @li @ref TOTAL_ZERO_CONSTRAINT
  */
 p::feature FLOW_FACTS_CONSTRAINTS_FEATURE("otawa::ipet::FLOW_FACTS_CONSTRAINTS_FEATURE", p::make<FlowFactConstraintBuilder>());
 
+
+/**
+ * Constraint bounding the maximum number of iterations of a loop,
+ * put on the loop header. The entry edges of the loop have as coefficient
+ * the opposite of the loop bound.
+ *
+ * @par Feature
+ * @li @ref FLOW_FACTS_CONSTRAINTS_FEATURE
+ */
+p::id<ilp::Constraint *> MAX_CONSTRAINT("otawa::ipet::MAX_CONSTRAINT", nullptr);
+
+
+/**
+ * Constraint bounding the total number of iterations of a loop,
+ * put on the loop header. The total bound is the constant of the constraint.
+ *
+ * @par Feature
+ * @li @ref FLOW_FACTS_CONSTRAINTS_FEATURE
+ */
+p::id<ilp::Constraint *> TOTAL_CONSTRAINT("otawa::ipet::TOTAL_CONSTRAINT", nullptr);
+
+
+/**
+ * Constraint preventing the back edges of a loop to be taken if the loop
+ * is not entered, for a total number of iterations bound, put on the loop
+ * header. The entry edges of the loop have as coefficient the opposite of
+ * the total bound.
+ *
+ * @par Feature
+ * @li @ref FLOW_FACTS_CONSTRAINTS_FEATURE
+ */
+p::id<ilp::Constraint *> TOTAL_ZERO_CONSTRAINT("otawa::ipet::TOTAL_ZERO_CONSTRAINT", nullptr);
+
 }
 
 } // otawa::ipet
@@ -77,9 +77,13 @@ protected:
  * This processor ensures that each basic block and each edge of the CFG
  * has a variable associated with a @ref ipet::VAR annotation.
  *
+ * Unless explicit naming is required, variables are not named but only
+ * described (see ilp::Desc): the textual name is only built when the ILP
+ * system is dumped.
+ *
  * @par Configuration
- * @li @ref ipet::EXPLICIT : use explicit name (takes more to compute but
- * provides more meaningful variable names).
+ * @li @ref ipet::EXPLICIT : use explicit name (takes more to compute and
+ * to store but names are available even without dumping the system).
  * @li @ref RECURSIVE : add function names to the explicit variable names.
  *
  * @par Provided Features
@@ -92,6 +96,17 @@ void VarAssignment::setup(WorkSpace *ws) {
 }
 
 
+static FormatKind block_kind("x%1_%c"), edge_kind("e%1_%2_%c");
+
+
+/**
+ */
+void VarAssignment::processCFG(WorkSpace *ws, CFG *cfg) {
+	_label = cfg->label();
+	BBProcessor::processCFG(ws, cfg);
+}
+
+
 /**
  */
 void VarAssignment::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
@@ -100,13 +115,15 @@ void VarAssignment::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
 	if(!VAR(bb)) {
 		String name = "";
 		if(_explicit) {
-		        if (FORCE_NAME(bb)) {
-		                name = **FORCE_NAME(bb);
-		        } else {
-			        name = makeNodeVar(bb, cfg);
-                        }
-                }
-		VAR(bb) = sys->newVar(name);
+			if(FORCE_NAME(bb))
+				name = **FORCE_NAME(bb);
+			else
+				name = makeNodeVar(bb, cfg);
+		}
+		ilp::Var *v = sys->newVar(name);
+		if(!name)
+			v->setDesc(Desc(block_kind, bb->index(), _label));
+		VAR(bb) = v;
 	}
 
 	// Check out edges
@@ -114,13 +131,15 @@ void VarAssignment::processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
 		if(!VAR(*edge)) {
 			String name = "";
 			if(_explicit) {
-			        if (FORCE_NAME(*edge)) {
-			              name = **FORCE_NAME(*edge);
-                                } else {
-				      name = makeEdgeVar(*edge, cfg);
-                                }
-                        }
-			VAR(*edge) = sys->newVar(name);
+				if(FORCE_NAME(*edge))
+					name = **FORCE_NAME(*edge);
+				else
+					name = makeEdgeVar(*edge, cfg);
+			}
+			ilp::Var *v = sys->newVar(name);
+			if(!name)
+				v->setDesc(Desc(edge_kind, edge->source()->index(), edge->target()->index(), _label));
+			VAR(*edge) = v;
 		}
 	}
 
@@ -0,0 +1,339 @@
+/*
+ *	ipet::WhatIf class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <otawa/cfg.h>
+#include <otawa/cfg/Dominance.h>
+#include <otawa/ilp.h>
+#include <otawa/ipet/features.h>
+#include <otawa/ipet/WhatIf.h>
+#include <otawa/proc/ProcessorException.h>
+
+namespace otawa { namespace ipet {
+
+/**
+ * @class WhatIf
+ * This class supports "what-if" queries on an already computed WCET:
+ * it allows to compute the WCET after changing the execution times of some
+ * blocks or edges, or some loop bounds, without rebuilding the ILP system.
+ * The changes are applied in place to the ILP system (objective function
+ * coefficients and constraint constants or coefficients), the system
+ * is solved again (with warm start if the ILP plugin supports it) and the
+ * changes are undone to come back to the original system.
+ *
+ * This allows, for example, to explore a set of memory configurations
+ * at the cost of one system build and N cheap resolutions:
+ * @code
+ *	WhatIf wi(ws);
+ *	Vector<WhatIf::Query> qs;
+ *	for(auto lat: latencies) {
+ *		WhatIf::Query q(_ << "latency=" << lat);
+ *		for(auto b: blocks)
+ *			q.setTime(b, timeFor(b, lat));
+ *		qs.add(q);
+ *	}
+ *	Vector<ot::time> wcets;
+ *	wi.solve(qs, wcets);
+ * @endcode
+ *
+ * Each query is applied relatively to the original system (the changes
+ * of a query are not visible to the following queries). The coefficients
+ * of the objective function are indexed by variable at the first change
+ * so that a change costs a constant time whatever the size of the system:
+ * the objective function must not be modified by other means while the
+ * WhatIf object is used.
+ *
+ * @par Required Features
+ * @li @ref ipet::WCET_FEATURE
+ * @li @ref ipet::FLOW_FACTS_CONSTRAINTS_FEATURE (for loop bounds changes)
+ *
+ * @ingroup ipet
+ */
+
+
+/**
+ * @class WhatIf::Query
+ * A query for WhatIf, that is, a set of changes of block times,
+ * edge times or loop bounds.
+ */
+
+
+/**
+ * Build an empty query.
+ * @param name	Name of the query (for user convenience).
+ */
+WhatIf::Query::Query(const string& name): _name(name) {
+}
+
+
+/**
+ * @fn const string& WhatIf::Query::name(void) const;
+ * Get the name of the query.
+ * @return	Query name.
+ */
+
+
+/**
+ * @fn bool WhatIf::Query::isEmpty(void) const;
+ * Test if the query does not contain any change.
+ * @return	True if the query is empty, false else.
+ */
+
+
+/**
+ * Change the execution time of a block. As in the object function built
+ * by @ref BasicObjectFunctionBuilder, the time is charged on the entering
+ * edges that have no time of their own.
+ * @param b		Changed block.
+ * @param t		New execution time.
+ * @return		Current query.
+ */
+WhatIf::Query& WhatIf::Query::setTime(Block *b, ot::time t) {
+	_changes.add(Change(BLOCK_TIME, b, nullptr, t));
+	return *this;
+}
+
+
+/**
+ * Change the execution time of an edge.
+ * @param e		Changed edge.
+ * @param t		New execution time.
+ * @return		Current query.
+ */
+WhatIf::Query& WhatIf::Query::setTime(Edge *e, ot::time t) {
+	_changes.add(Change(EDGE_TIME, nullptr, e, t));
+	return *this;
+}
+
+
+/**
+ * Change the maximum iteration bound of a loop.
+ * The loop must already have a maximum bound in the ILP system.
+ * @param h		Loop header.
+ * @param max	New maximum iteration bound.
+ * @return		Current query.
+ */
+WhatIf::Query& WhatIf::Query::setMaxBound(Block *h, int max) {
+	_changes.add(Change(MAX_BOUND, h, nullptr, max));
+	return *this;
+}
+
+
+/**
+ * Change the total iteration bound of a loop.
+ * The loop must already have a total bound in the ILP system.
+ * @param h		Loop header.
+ * @param total	New total iteration bound.
+ * @return		Current query.
+ */
+WhatIf::Query& WhatIf::Query::setTotalBound(Block *h, int total) {
+	_changes.add(Change(TOTAL_BOUND, h, nullptr, total));
+	return *this;
+}
+
+
+/**
+ * Build a what-if query solver.
+ * @param ws	Workspace providing WCET_FEATURE.
+ * @param mon	Monitor used to solve the ILP system.
+ */
+WhatIf::WhatIf(WorkSpace *ws, Monitor& mon): _ws(ws), _sys(SYSTEM(ws)), _mon(mon), _indexed(false), _cnt(0) {
+	ASSERTP(ws->provides(WCET_FEATURE), "WhatIf requires WCET_FEATURE");
+	ASSERT(_sys);
+}
+
+
+/**
+ * @fn ilp::System *WhatIf::system(void) const;
+ * Get the underlying ILP system.
+ * @return	ILP system.
+ */
+
+
+/**
+ * @fn int WhatIf::solveCount(void) const;
+ * Get the number of resolutions performed by this object.
+ * @return	Resolution count.
+ */
+
+
+/**
+ * Compute the WCET for the given query. After the call, the ILP system
+ * is restored to its original state but the solution of the ILP system
+ * is the one of the query.
+ * @param query		Query to solve.
+ * @return			Computed WCET or -1 if the resolution failed.
+ */
+ot::time WhatIf::solve(const Query& query) {
+	for(auto c: query._changes)
+		apply(c);
+	ot::time wcet = resolve();
+	restore();
+	if(_mon.logFor(Monitor::LOG_PROC))
+		_mon.log << "\twhat-if " << query.name() << ": WCET = " << wcet << io::endl;
+	return wcet;
+}
+
+
+/**
+ * Solve a batch of queries. At the end, the ILP system is solved again
+ * in its original state to keep the workspace consistent.
+ * @param queries	Queries to solve.
+ * @param wcets		Receives the WCET of each query (in the same order).
+ */
+void WhatIf::solve(const Vector<Query>& queries, Vector<ot::time>& wcets) {
+	for(auto q: queries)
+		wcets.add(solve(q));
+	if(!queries.isEmpty())
+		resolve();
+}
+
+
+/**
+ * Apply a change to the ILP system.
+ * @param change	Change to apply.
+ */
+void WhatIf::apply(const Query::Change& change) {
+	switch(change.kind) {
+
+	case Query::BLOCK_TIME:
+		for(auto e: change.block->inEdges())
+			if(TIME(e) < 0)
+				set(nullptr, VAR(e), change.val);
+		break;
+
+	case Query::EDGE_TIME:
+		set(nullptr, VAR(change.edge), change.val);
+		break;
+
+	case Query::MAX_BOUND: {
+			ilp::Constraint *cons = MAX_CONSTRAINT(change.block);
+			ASSERTP(cons, "no maximum bound for loop at " << change.block);
+			setEntryCoefs(cons, change.block, -change.val);
+		}
+		break;
+
+	case Query::TOTAL_BOUND: {
+			ilp::Constraint *cons = TOTAL_CONSTRAINT(change.block);
+			ASSERTP(cons, "no total bound for loop at " << change.block);
+			set(cons, nullptr, change.val);
+			ilp::Constraint *zero = TOTAL_ZERO_CONSTRAINT(change.block);
+			if(zero)
+				setEntryCoefs(zero, change.block, -change.val);
+		}
+		break;
+	}
+}
+
+
+/**
+ * Set the coefficients of the entry edges of a loop in the given constraint.
+ * @param cons	Constraint to modify.
+ * @param h		Loop header.
+ * @param k		New coefficient.
+ */
+void WhatIf::setEntryCoefs(ilp::Constraint *cons, Block *h, double k) {
+	for(auto e: h->inEdges())
+		if(!Dominance::dominates(h, e->source()))
+			set(cons, VAR(e), k);
+}
+
+
+/**
+ * Change a coefficient or a constant of the system and record the
+ * old value for restoration.
+ * @param cons	Changed constraint (null for the objective function).
+ * @param var	Changed variable (null for the constraint constant).
+ * @param k		New value.
+ */
+void WhatIf::set(ilp::Constraint *cons, ilp::Var *var, double k) {
+	if(cons == nullptr) {
+		ASSERT(var);
+		if(!_indexed)
+			index();
+		_undo.add(Undo(nullptr, var, _obj.get(var, 0)));
+		setObject(var, k);
+	}
+	else if(var == nullptr) {
+		_undo.add(Undo(cons, nullptr, cons->constant()));
+		cons->setConstant(k);
+	}
+	else {
+		_undo.add(Undo(cons, var, cons->coefficient(var)));
+		cons->setCoefficient(var, k);
+	}
+}
+
+
+/**
+ * Index the coefficients of the objective function by variable.
+ */
+void WhatIf::index(void) {
+	for(ilp::System::ObjTermIterator t(_sys); t(); t++)
+		_obj.put((*t).fst, _obj.get((*t).fst, 0) + (*t).snd);
+	_indexed = true;
+}
+
+
+/**
+ * Change the coefficient of a variable in the objective function
+ * and keep the index up to date.
+ * @param var	Changed variable.
+ * @param k		New coefficient.
+ */
+void WhatIf::setObject(ilp::Var *var, double k) {
+	double o = _obj.get(var, 0);
+	if(k != o) {
+		_sys->addObjectFunction(k - o, var);
+		_obj.put(var, k);
+	}
+}
+
+
+/**
+ * Undo the changes in reverse order.
+ */
+void WhatIf::restore(void) {
+	while(!_undo.isEmpty()) {
+		Undo u = _undo.pop();
+		if(u.cons == nullptr)
+			setObject(u.var, u.val);
+		else if(u.var == nullptr)
+			u.cons->setConstant(u.val);
+		else
+			u.cons->setCoefficient(u.var, u.val);
+	}
+}
+
+
+/**
+ * Solve again the ILP system.
+ * @return	Computed WCET or -1.
+ */
+ot::time WhatIf::resolve(void) {
+	_cnt++;
+	if(!_sys->resolve(_ws, _mon)) {
+		_mon.log << "ERROR: " << _sys->lastErrorMessage() << io::endl;
+		return -1;
+	}
+	return ot::time(_sys->value());
+}
+
+} }	// otawa::ipet
@@ -22,6 +22,7 @@
 
 #include <elm/sys/Plugger.h>
 #include <elm/sys/Path.h>
+#include <elm/sys/Thread.h>
 #include <otawa/proc/ProcessorPlugin.h>
 #include <otawa/proc/Registry.h>
 //#include <otawa/otawa.h>
@@ -39,6 +40,23 @@ static elm::sys::Plugger plugger(OTAWA_PROC_NAME, OTAWA_PROC_VERSION);
 static bool initialized_paths = false;
 
 
+// serialize the plugin loading (tasks run concurrently)
+class PluginLock {
+public:
+	inline PluginLock(void) { if(mutex() != nullptr) mutex()->lock(); }
+	inline ~PluginLock(void) { if(mutex() != nullptr) mutex()->unlock(); }
+private:
+	static elm::sys::Mutex *mutex(void) {
+#		ifdef OTAWA_CONC
+			static elm::sys::Mutex *m = elm::sys::Mutex::make();
+			return m;
+#		else
+			return nullptr;
+#		endif
+	}
+};
+
+
 // error handling
 class ProcessorBase: public ErrorBase {
 public:
@@ -150,6 +168,13 @@ void ProcessorPlugin::init(void) {
  * @return		Built processor or null if the processor cannot be found.
  */
 ProcessorPlugin *ProcessorPlugin::get(string name) {
+	PluginLock lock;
+	return plug(name);
+}
+
+
+// find a plugin (the plugin lock must be held)
+ProcessorPlugin *ProcessorPlugin::plug(string name) {
 	if(!initialized_paths)
 		init();
 
@@ -181,6 +206,7 @@ ProcessorPlugin *ProcessorPlugin::get(string name) {
  * @return		True if the plug-in is plugged, false else.
  */
 bool ProcessorPlugin::isPlugged(string name) {
+	PluginLock lock;
 
 	// get canonical name
 	string cname = makeCanonical(name);
@@ -196,6 +222,7 @@ bool ProcessorPlugin::isPlugged(string name) {
  * @param path	Path to add.
  */
 void ProcessorPlugin::addPath(const elm::sys::Path& path) {
+	PluginLock lock;
 	if(!initialized_paths)
 		init();
 	plugger.addPath(path);
@@ -207,6 +234,7 @@ void ProcessorPlugin::addPath(const elm::sys::Path& path) {
  * @param path	Path to remove.
  */
 void ProcessorPlugin::removePath(const elm::sys::Path& path) {
+	PluginLock lock;
 	if(!initialized_paths)
 		init();
 	plugger.removePath(path);
@@ -219,9 +247,10 @@ void ProcessorPlugin::removePath(const elm::sys::Path& path) {
  * @return		An instance of the processor or NULL if it cannot be found.
  */
 Processor *ProcessorPlugin::getProcessor(string name) {
+	PluginLock lock;
 	const AbstractRegistration *reg = Registry::find(name);
 	if(!reg) {
-		ProcessorPlugin *plugin = get(name);
+		ProcessorPlugin *plugin = plug(name);
 		if(plugin)
 			reg = Registry::find(name);
 	}
@@ -255,8 +284,9 @@ AbstractFeature *ProcessorPlugin::getFeature(string name) {
  * @return		Found identifier or null.
  */
 AbstractIdentifier *ProcessorPlugin::getIdentifier(string name) {
+	PluginLock lock;
 	AbstractIdentifier *id = AbstractIdentifier::find(name);
-	if(!id && get(name))
+	if(!id && plug(name))
 		id = AbstractIdentifier::find(name);
 	return id;
 }
@@ -267,6 +297,7 @@ AbstractIdentifier *ProcessorPlugin::getIdentifier(string name) {
  * @param error_handler		New error handler.
  */
 void ProcessorPlugin::setErrorHandler(ErrorHandler *error_handler) {
+	PluginLock lock;
 	base.setErrorHandler(error_handler);
 }
 
@@ -19,6 +19,7 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include "config.h"
 #include <elm/deprecated.h>
 #include <elm/stree/SegmentBuilder.h>
 #include <elm/xom.h>
@@ -32,6 +33,7 @@
 #include <otawa/prog/FixedTextDecoder.h>
 #include <otawa/proc/Feature.h>
 #include <otawa/prog/File.h>
+#include <otawa/cpp/Unmangler.h>
 
 using namespace elm;
 
@@ -208,7 +210,10 @@ void SimState::setReg(hard::Register *r, t::uint32 v) {
  * @param program	The program file creating this process.
  */
 Process::Process(Manager *manager, const PropList& props, File *program)
-: prog(0), man(manager), smap(0) {
+: prog(0), man(manager), smap(0), smutex(nullptr), sindexed(false), uindexed(false) {
+#	ifdef OTAWA_CONC
+		smutex = sys::Mutex::make();
+#	endif
 	addProps(props);
 	if(prog)
 		addFile(prog);
@@ -270,19 +275,17 @@ Process::Process(Manager *manager, const PropList& props, File *program)
 
 
 /**
- * Find the address of the given label. For performing it, it looks iteratively
- * one each file of the process until finding it.
+ * Find the address of the given label. The label may be a symbol name or,
+ * for C++ programs, a demangled symbol name (see @ref findSymbol()).
  * @param label		Label to find.
  * @return			Found address or null.
  */
 address_t Process::findLabel(const string& label) {
-	address_t result = Address::null;
-	for(FileIter file(this); file(); file++) {
-		result = file->findLabel(label);
-		if(!result.isNull())
-			break;
-	}
-	return result;
+	Symbol *sym = findSymbol(label);
+	if(sym == nullptr)
+		return Address::null;
+	else
+		return sym->address();
 }
 
 
@@ -314,6 +317,20 @@ Segment *Process::findSegmentAt(Address addr) const {
 }
 
 
+/**
+ * @fn bool Process::read(Address at, T& val) const;
+ * Read a value from the content of the segments provided by the loader
+ * (see @ref Segment::setBytes()). This access is inline and bounds-checked
+ * and does not involve any virtual call. It is used by the default get()
+ * implementations so that a loader attaching the segment views does not need
+ * to implement them.
+ * @param at	Address of the value.
+ * @param val	Read value.
+ * @return		True if the value has been read, false if the address does not
+ * 				match a segment whose content is available.
+ */
+
+
 /**
  * @fn File *Process::program(void) const;
  * Get the program file, that is, the startup executable of the process.
@@ -386,6 +403,7 @@ void Process::addFile(File *file) {
 	if(!_files)
 		prog = file;
 	_files.add(file);
+	clearIndex();
 }
 
 
@@ -394,8 +412,9 @@ void Process::addFile(File *file) {
 Process::~Process(void) {
 	for(FileIter file(this); file(); file++)
 		delete *file;
-	if(smap)
-		delete smap;
+	clearIndex();
+	if(smutex != nullptr)
+		delete smutex;
 }
 
 
@@ -458,18 +477,34 @@ void Process::provide(AbstractFeature& feature) {
 
 
 /**
- * Find the symbol matching the given name.
+ * Find the symbol matching the given name. If no symbol has exactly this name,
+ * the symbol whose demangled name (C++ programs) matches is looked.
+ *
+ * The lookup uses an index of the symbols of the process files that is built
+ * at the first lookup and rebuilt when a file is added. This method may be
+ * called concurrently.
+ *
  * @param name	Symbol name to look for.
  * @return		Found symbol or null.
  */
 Symbol *Process::findSymbol(const String& name) {
-	Symbol *result = 0;
+	if(!sindexed)
+		indexSymbols();
+	Symbol *result = snames.get(name, nullptr);
+	if(result != nullptr)
+		return result;
+
+	// symbols added after the indexing
 	for(FileIter file(this); file(); file++) {
 		result = file->findSymbol(name);
 		if(result)
-			break;
+			return result;
 	}
-	return result;
+
+	// look in demangled names
+	if(!uindexed)
+		indexUnmangled();
+	return unames.get(name, nullptr);
 }
 
 
@@ -479,10 +514,24 @@ Symbol *Process::findSymbol(const String& name) {
  * @return			Found symbol or null.
  */
 Symbol *Process::findSymbolAt(const Address& address) {
-	if(!smap) {
+	if(!sindexed)
+		indexSymbols();
+	return smap->get(address.offset(), 0);
+}
+
+
+/**
+ * Build the index of symbols by name and by address.
+ */
+void Process::indexSymbols(void) {
+	if(smutex != nullptr)
+		smutex->lock();
+	if(!sindexed) {
 		stree::SegmentBuilder<Address::offset_t, Symbol *> builder(0);
 		for(Process::FileIter file(this); file(); file++)
-			for(File::SymIter sym(*file); sym(); sym++)
+			for(File::SymIter sym(*file); sym(); sym++) {
+				if(!snames.hasKey(sym->name()))
+					snames.put(sym->name(), *sym);
 				if(sym->size())
 					switch(sym->kind()) {
 					case Symbol::DATA:
@@ -492,6 +541,53 @@ Symbol *Process::findSymbolAt(const Address& address) {
 					default:
 						break;
 					}
+			}
+		smap = new stree::Tree<Address::offset_t, Symbol *>();
+		builder.make(*smap);
+		sindexed = true;
+	}
+	if(smutex != nullptr)
+		smutex->unlock();
+}
+
+
+/**
+ * Build the index of symbols by demangled names.
+ */
+void Process::indexUnmangled(void) {
+	if(smutex != nullptr)
+		smutex->lock();
+	if(!uindexed) {
+		for(Process::FileIter file(this); file(); file++)
+			for(File::SymIter sym(*file); sym(); sym++)
+				if(sym->name().startsWith("_Z"))
+					try {
+						String name = cpp::Unmangler::base.unmangle(sym->name());
+						if(!unames.hasKey(name))
+							unames.put(name, *sym);
+					}
+					catch(cpp::UnmanglingException& e) {
+					}
+		uindexed = true;
+	}
+	if(smutex != nullptr)
+		smutex->unlock();
+}
+
+
+/**
+ * Clear the symbol indexes.
+ */
+void Process::clearIndex(void) {
+	sindexed = false;
+	uindexed = false;
+	snames.clear();
+	unames.clear();
+	if(smap != nullptr) {
+		delete smap;
+		smap = nullptr;
+	}
+}
 		smap = new stree::Tree<Address::offset_t, Symbol *>();
 		builder.make(*smap);
 	}
@@ -512,7 +608,8 @@ Symbol *Process::findSymbolAt(const Address& address) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, t::int8& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -528,7 +625,8 @@ void Process::get(Address at, t::int8& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, t::uint8& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -544,7 +642,8 @@ void Process::get(Address at, t::uint8& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, t::int16& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -560,7 +659,8 @@ void Process::get(Address at, t::int16& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, t::uint16& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -576,7 +676,8 @@ void Process::get(Address at, t::uint16& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, t::int32& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -592,7 +693,8 @@ void Process::get(Address at, t::int32& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, t::uint32& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -608,7 +710,8 @@ void Process::get(Address at, t::uint32& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, t::int64& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -624,7 +727,8 @@ void Process::get(Address at, t::int64& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, t::uint64& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -640,7 +744,8 @@ void Process::get(Address at, t::uint64& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, Address& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -656,7 +761,8 @@ void Process::get(Address at, Address& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, float& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -672,7 +778,8 @@ void Process::get(Address at, float& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, double& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
@@ -688,7 +795,8 @@ void Process::get(Address at, double& val) {
  * 		@ref MEMORY_ACCESS_FEATURE is provided.
  */
 void Process::get(Address at, long double& val) {
-	throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
+	if(!read(at, val))
+		throw UnsupportedFeatureException(this, MEMORY_ACCESS_FEATURE);
 }
 
 
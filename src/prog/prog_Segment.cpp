@@ -60,7 +60,10 @@ Segment::Segment(
 	_name(name),
 	_address(address),
 	_size(size),
-	map(new ProgItem *[MAP_SIZE(size)])
+	map(new ProgItem *[MAP_SIZE(size)]),
+	_bytes(nullptr),
+	_blen(0),
+	_swap(false)
 {
 	// Removed : segment with 0 size seems to be normal
 	// ASSERTP(size, "zero size segment");
@@ -121,6 +124,63 @@ Segment::~Segment(void) {
  */
 
 
+/**
+ * Give to the segment a view on its initialized content. This view is usually
+ * provided by the loader and may point directly in the loaded program file:
+ * it must remain valid as long as the segment exists.
+ * Only the initialized part of the segment is covered: a .bss segment has no view
+ * and a .data segment with a .bss tail has a view shorter than the segment.
+ * Once set, the content of the segment can be read with read() without calling
+ * the loader.
+ * @param bytes			Content of the segment.
+ * @param length		Length of the initialized content (at most the segment size).
+ * @param big_endian	True if the content is stored in big endian, false for little endian.
+ */
+void Segment::setBytes(const t::uint8 *bytes, ot::size length, bool big_endian) {
+#	if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		bool host_big = true;
+#	else
+		bool host_big = false;
+#	endif
+	_bytes = bytes;
+	_blen = min(length, _size);
+	_swap = big_endian != host_big;
+}
+
+
+/**
+ * @fn const t::uint8 *Segment::bytes(void) const;
+ * Get the view on the content of the segment.
+ * @return	Segment content or null if no view has been set.
+ */
+
+
+/**
+ * @fn ot::size Segment::bytesLength(void) const;
+ * Get the length of the view on the content of the segment.
+ * @return	Length of the initialized content (0 if no view has been set).
+ */
+
+
+/**
+ * @fn bool Segment::hasBytes(void) const;
+ * Test if a view on the content of the segment is available.
+ * @return	True if the segment content is available, false else.
+ */
+
+
+/**
+ * @fn bool Segment::read(const Address& addr, T& val) const;
+ * Read a value from the content of the segment. The bounds are checked
+ * and the bytes are put in the host order. This is an inline access that
+ * does not involve the loader.
+ * @param addr	Address of the read value.
+ * @param val	Read value.
+ * @return		True if the value has been read, false if the segment content
+ * 				is not available or the value is out of the initialized content.
+ */
+
+
 /**
  * @fn bool Segment::isInitialized(void) const;
  * Test if the segment is initialized.
@@ -707,6 +707,36 @@ bool WorkSpace::provides(cstring name) {
 }
 
 
+/**
+ * Get the list of currently provided features. This is useful to restore the
+ * workspace to a previous state by invalidating the features provided since.
+ * @param features	Filled with the provided features.
+ */
+void WorkSpace::provided(Vector<const AbstractFeature *>& features) const {
+	for(auto f: dep_map.keys())
+		features.add(f);
+}
+
+
+/**
+ * Consider the given feature as provided by the process, that is, without
+ * processor to invalidate. This is used to share, between workspaces
+ * built on the same process, the features whose data is stored in the process
+ * (like @ref DECODED_TEXT): the feature is computed once in a workspace
+ * and shared by the other ones.
+ *
+ * The caller is in charge of checking that the feature and the features it
+ * depends on do not store any data in the workspace itself (as
+ * @ref COLLECTED_CFG_FEATURE does): the workspaces sharing such a feature
+ * would consider it as provided without having its data.
+ * @param feature	Shared feature.
+ */
+void WorkSpace::share(const AbstractFeature& feature) {
+	if(!dep_map.hasKey(&feature))
+		dep_map.put(&feature, new Dependency());
+}
+
+
 /**
  * @fn bool WorkSpace::implements(const AbstractFeature& feature);
  * Test if a feature is provided.
@@ -152,6 +152,9 @@ Address ContextualPath::getEnclosingFunction(void) const {
  * a block, that is, the chaining of function, calls and loop iteration
  * driving to the block.
  * @p
+ * The contextual tree is indexed by (parent node, step) in a hash table
+ * so that looking a path costs O(depth) without any allocation.
+ * @p
  * Notice that the path must be precise while the matching is
  * performed on a blurred contextual tree. This means that
  * some parts of the contextual path may be ignored if an
@@ -183,26 +186,36 @@ const PropList& ContextualProperty::findProps(
 	const ContextualPath& path,
 	const AbstractIdentifier& id
 ) const {
-	Vector<const PropList *> stack;
 
-	// fill the stack
-	stack.push(&props);
+	// the deepest matching node defining the identifier wins
+	const PropList *res = &props;
 	const Node *node = &root;
-	for(const ContextualList *l = path.list(); l; l = &l->next())
-		for(inhstruct::Tree::Iter child(node); child; child++) {
-			Node *cur = (Node *)*child;
-			if(cur->step == l->step()) {
-				stack.push(cur);
-				node = cur;
-				break;
-			}
+	for(const ContextualList *l = path.list(); l; l = &l->next()) {
+		Node *cur = child(node, l->step());
+		if(cur != nullptr) {
+			node = cur;
+			if(cur->hasProp(id))
+				res = cur;
 		}
+	}
+	return *res;
+}
 
-	// find the identifier
-	for(int i = stack.count() - 1; i >= 0; i--)
-		if(stack[i]->hasProp(id))
-			return *stack[i];
-	return props;
+
+/**
+ * Get or create the child of a node for the given step.
+ * @param parent	Parent node.
+ * @param step		Step of the child.
+ * @return			Found or created child.
+ */
+ContextualProperty::Node *ContextualProperty::makeChild(Node *parent, const ContextualStep& step) {
+	Node *node = child(parent, step);
+	if(node == nullptr) {
+		node = new Node(step);
+		parent->add(node);
+		children.put(Key(parent, step), node);
+	}
+	return node;
 }
 
 
@@ -213,22 +226,8 @@ const PropList& ContextualProperty::findProps(
  */
 PropList& ContextualProperty::makeProps(const ContextualPath& path) {
 	Node *parent = &root;
-	for(const ContextualList *l = path.list(); l; l = &l->next()) {
-		bool found = false;
-		for(inhstruct::Tree::Iter child(parent); child; child++) {
-			Node *node = (Node *)*child;
-			if(node->step == l->step()) {
-				parent = node;
-				found = true;
-				break;
-			}
-		}
-		if(!found) {
-			Node *node = new Node(l->step());
-			parent->add(node);
-			parent = node;
-		}
-	}
+	for(const ContextualList *l = path.list(); l; l = &l->next())
+		parent = makeChild(parent, l->step());
 	return *parent;
 }
 
@@ -334,21 +333,8 @@ PropList& ContextualProperty::refProps(
 	// find top proplist and intermediate property
 	Property *prop = props.getProp(&id);
 	Node *parent = &root;
-	for(int i = path.count() - 1; i >= 0; i--) {
-		bool found = false;
-		for(inhstruct::Tree::Iter child(parent); child; child++) {
-			Node *node = (Node *)*child;
-			if(node->step == path[i]) {
-				parent = node;
-				found = true;
-				break;
-			}
-		}
-		if(!found) {
-			Node *node = new Node(path[i]);
-			parent->add(node);
-			parent = node;
-		}
+	for(const ContextualList *l = path.list(); l; l = &l->next()) {
+		parent = makeChild(parent, l->step());
 		Property *new_prop = parent->getProp(&id);
 		if(new_prop)
 			prop = new_prop;
@@ -19,6 +19,12 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <elm/data/Array.h>
 #include <elm/debug.h>
 #include <elm/sys/System.h>
 #include <elm/xom/Attribute.h>
@@ -275,10 +281,13 @@ p::declare Script::reg = p::init("otawa::script::Script", Version(1, 0, 0))
 // ScriptErrorHandler class
 class ScriptErrorHandler: public ErrorHandler {
 public:
-	ScriptErrorHandler(Output& _log): log(_log) { }
+	ScriptErrorHandler(Output& _log): errors(0), log(_log) { }
 	virtual void onError(error_level_t level, const string& message) {
 		log << getLevelString(level) << ": " << message << io::endl;
+		if(level >= level_error)
+			errors++;
 	}
+	int errors;
 
 private:
 	Output& log;
@@ -296,6 +305,18 @@ private:
  * @li @ref PARAM			parameter for the script interpretation
  * @li @ref ONLY_CONFIG		cause the processor to stop its work after the configuration item building (no XSLT processing)
  * @li @ref TIME_STAT		cause the script to generate computation for each executed step
+ * @li @ref CACHE			enable the transformed script cache in the default directory
+ * @li @ref CACHE_PATH		enable the transformed script cache in the given directory
+ *
+ * @par Cache
+ * The XSLT transformation of the script is the main part of its startup time. When enabled
+ * (with @ref CACHE or @ref CACHE_PATH), the transformed scripts are stored in a cache directory
+ * (@ref CACHE_PATH, as a default $XDG_CACHE_HOME/otawa/scripts or $HOME/.cache/otawa/scripts)
+ * with a name derived from the path, the modification time and the size of the script,
+ * the parameters and the global variables: a later run with the same script and the same
+ * parameters reads back the transformed script instead of performing the transformation.
+ * Transformations that raised errors are not stored. As the files included by the script
+ * are not part of the key, the cache has to be emptied when they are modified.
  *
  * @par Properties
  * This processor initialize the following properties before passing them
@@ -308,7 +329,7 @@ private:
 
 /**
  */
-Script::Script(void): Processor(reg), only_config(false), timed(false), _version(0) {
+Script::Script(void): Processor(reg), only_config(false), timed(false), use_cache(false), _version(0) {
 }
 
 
@@ -320,6 +341,8 @@ void Script::configure(const PropList &props) {
 	this->props = props;
 	only_config = ONLY_CONFIG(props);
 	timed = TIME_STAT(props);
+	cache_path = CACHE_PATH(props);
+	use_cache = CACHE(props) || cache_path;
 }
 
 
@@ -399,72 +422,95 @@ void Script::work(WorkSpace *ws) {
 		return;
 	}
 
-	// build XSL
-	xom::Element *root = new xom::Element("xsl:stylesheet", XSL_URI);
-	root->addAttribute(new xom::Attribute("version", XSL_URI, "1.0"));
-	xom::Document *xsl = new xom::Document(root);
-	xom::Element *temp = new xom::Element("xsl:template", XSL_URI);
-	root->appendChild(temp);
-	temp->addAttribute(new xom::Attribute("match", XSL_URI, "/"));
-	doc->removeChild(oroot);
-	temp->appendChild(oroot);
-
-	// prepare the work document
-	xom::Element *empty_root = new xom::Element("empty");
-	xom::Document *empty = new xom::Document(empty_root);
-
-	// build the parameter declaration
-	for(ItemIter item(*this); item(); item++) {
-
-		// single parameter
-		if(!item->multi) {
-			xom::Element *param = new xom::Element("xsl:param", XSL_URI);
-			root->appendChild(param);
-			param->addAttribute(new xom::Attribute("xsl:name", XSL_URI, item->name.toCString()));
-			if(item->deflt)
-				param->addAttribute(new xom::Attribute("xsl:select", XSL_URI, item->makeParam(item->deflt).toCString()));
+	// look in the cache
+	xom::Document *res = nullptr;
+	Path cache_file = cacheFile();
+	if(cache_file && cache_file.exists()) {
+		res = builder.build(cache_file.asSysString());
+		if(logFor(LOG_DEPS)) {
+			if(res)
+				log << "\tusing cached script " << cache_file << io::endl;
+			else
+				log << "\tbad cached script " << cache_file << io::endl;
 		}
-
-		// multi-parameter
-		else
-			for(auto p: PARAM.all(props))
-				if(p.fst == item->name) {
-					xom::Element *param_elt = new xom::Element(item->name.toCString());
-					empty_root->appendChild(param_elt);
-					if(logFor(LOG_PROC))
-						log << "\t" << item->name << " added with " << p.snd << io::endl;
-					param_elt->addAttribute(new xom::Attribute("value", item->makeParam(p.snd).toCString()));
-				}
 	}
 
-	//DEBUG(
-		OutStream *out = elm::sys::System::createFile("out.xml");
-		xom::Serializer serial(*out);
-		serial.write(xsl);
-		delete out;//);
-
-	// perform the transformation
-	xom::XSLTransform xslt(xsl);
-	declareGlobals(xslt);
-	ScriptErrorHandler handler(log);
-	xslt.setErrorHandler(&handler);
-	for(auto p: PARAM.all(props)) {
-		bool found = false;
+	// build the XSL and perform the transformation
+	if(!res) {
+
+		// build XSL
+		xom::Element *root = new xom::Element("xsl:stylesheet", XSL_URI);
+		root->addAttribute(new xom::Attribute("version", XSL_URI, "1.0"));
+		xom::Document *xsl = new xom::Document(root);
+		xom::Element *temp = new xom::Element("xsl:template", XSL_URI);
+		root->appendChild(temp);
+		temp->addAttribute(new xom::Attribute("match", XSL_URI, "/"));
+		doc->removeChild(oroot);
+		temp->appendChild(oroot);
+
+		// prepare the work document
+		xom::Element *empty_root = new xom::Element("empty");
+		xom::Document *empty = new xom::Document(empty_root);
+
+		// build the parameter declaration
 		for(ItemIter item(*this); item(); item++) {
-			if(!item->multi && item->name == p.fst) {
-				found = true;
-				xslt.setParameter(p.fst, item->makeParam(p.snd));
-				if(logFor(LOG_DEPS))
-					log << "\tadding argument \"" << p.fst << "\" to \"" << p.snd << "\"\n";
+
+			// single parameter
+			if(!item->multi) {
+				xom::Element *param = new xom::Element("xsl:param", XSL_URI);
+				root->appendChild(param);
+				param->addAttribute(new xom::Attribute("xsl:name", XSL_URI, item->name.toCString()));
+				if(item->deflt)
+					param->addAttribute(new xom::Attribute("xsl:select", XSL_URI, item->makeParam(item->deflt).toCString()));
 			}
+
+			// multi-parameter
+			else
+				for(auto p: PARAM.all(props))
+					if(p.fst == item->name) {
+						xom::Element *param_elt = new xom::Element(item->name.toCString());
+						empty_root->appendChild(param_elt);
+						if(logFor(LOG_PROC))
+							log << "\t" << item->name << " added with " << p.snd << io::endl;
+						param_elt->addAttribute(new xom::Attribute("value", item->makeParam(p.snd).toCString()));
+					}
 		}
-		if(!found)
-			warn(_ << "unknown configuration parameter: " << p.fst);
+
+		DEBUG(
+			OutStream *out = elm::sys::System::createFile("out.xml");
+			xom::Serializer serial(*out);
+			serial.write(xsl);
+			delete out;)
+
+		// perform the transformation
+		{
+			xom::XSLTransform xslt(xsl);
+			declareGlobals(xslt);
+			ScriptErrorHandler handler(log);
+			xslt.setErrorHandler(&handler);
+			for(auto p: PARAM.all(props)) {
+				bool found = false;
+				for(ItemIter item(*this); item(); item++) {
+					if(!item->multi && item->name == p.fst) {
+						found = true;
+						xslt.setParameter(p.fst, item->makeParam(p.snd));
+						if(logFor(LOG_DEPS))
+							log << "\tadding argument \"" << p.fst << "\" to \"" << p.snd << "\"\n";
+					}
+				}
+				if(!found)
+					warn(_ << "unknown configuration parameter: " << p.fst);
+			}
+			res = xslt.transformDocument(empty);
+			if(res != nullptr && cache_file && handler.errors == 0)
+				store(cache_file, res);
+		}
+		delete empty;
+		delete xsl;
 	}
-	xom::Document *res = xslt.transformDocument(empty);
-	delete empty;
-	delete xsl;
 	delete doc;
+	if(res == nullptr)
+		throw ProcessorException(*this, _ << "cannot transform the script " << path);
 	res->setBaseURI(path.toString().toCString());
 
 	// !!DEBUG!!
@@ -597,6 +643,100 @@ void Script::work(WorkSpace *ws) {
 };
 
 
+/**
+ * Compute the path of the cache file for the current script. The key is built
+ * from the script file identity (path, modification time and size) without
+ * reading it.
+ * @return			Cache file path or an empty path if the cache is disabled.
+ */
+Path Script::cacheFile(void) {
+	if(!use_cache)
+		return "";
+
+	// find the cache directory
+	Path dir = cache_path;
+	if(!dir) {
+		const char *p = getenv("XDG_CACHE_HOME");
+		if(p != nullptr && *p != '\0')
+			dir = Path(p) / "otawa" / "scripts";
+		else {
+			p = getenv("HOME");
+			if(p == nullptr || *p == '\0')
+				return "";
+			dir = Path(p) / ".cache" / "otawa" / "scripts";
+		}
+	}
+
+	// build the key text
+	struct stat st;
+	if(::stat(path.toString().toCString().chars(), &st) != 0)
+		return "";
+	StringBuffer buf;
+	buf << path.absolute() << '\n' << t::int64(st.st_mtime) << '\n' << t::int64(st.st_size);
+	for(auto p: PARAM.all(props))
+		buf << '\n' << p.fst << '=' << p.snd;
+	buf << '\n' << otawa::MANAGER.prefixPath() << '\n' << int(this->logLevel());
+	string key = buf.toString();
+
+	// hash it (FNV-1a)
+	t::uint64 h = 0xcbf29ce484222325ULL;
+	for(int i = 0; i < key.length(); i++) {
+		h ^= t::uint8(key[i]);
+		h *= 0x100000001b3ULL;
+	}
+	char name[17];
+	for(int i = 15; i >= 0; i--) {
+		name[i] = "0123456789abcdef"[h & 0xf];
+		h >>= 4;
+	}
+	name[16] = '\0';
+	return dir / string(_ << path.namePart() << '-' << name << ".xml");
+}
+
+
+/**
+ * Store a transformed script in the cache. Failures are only logged:
+ * the cache is an optimization.
+ * @param file	Cache file.
+ * @param res	Transformed script.
+ */
+void Script::store(const Path& file, xom::Document *res) {
+	try {
+		sys::System::makeDirs(file.parent());
+
+		// unique temporary file (scripts may run concurrently)
+		string pat = _ << file << ".XXXXXX";
+		AllocArray<char> buf(pat.length() + 1);
+		for(int i = 0; i < pat.length(); i++)
+			buf[i] = pat[i];
+		buf[pat.length()] = '\0';
+		int fd = mkstemp(&buf[0]);
+		if(fd < 0) {
+			if(logFor(LOG_DEPS))
+				log << "\tcannot cache the script: cannot create a temporary file for " << file << io::endl;
+			return;
+		}
+		::close(fd);
+		Path tmp = &buf[0];
+		OutStream *out = sys::System::createFile(tmp);
+		{
+			xom::Serializer serial(*out);
+			serial.write(res);
+			serial.flush();
+		}
+		delete out;
+		if(::rename(tmp.toString().toCString().chars(), file.toString().toCString().chars()) != 0)
+			tmp.remove();
+		else if(logFor(LOG_DEPS))
+			log << "\tscript cached in " << file << io::endl;
+	}
+	catch(sys::SystemException& e) {
+		if(logFor(LOG_DEPS))
+			log << "\tcannot cache the script: " << e.message() << io::endl;
+	}
+}
+
+
 /**
  * Handle an error.
  * @param node	Node causing the error.
@@ -735,5 +875,20 @@ Identifier<bool> ONLY_CONFIG("otawa::script::ONLY_CONFIG", false);
  */
 Identifier<bool> TIME_STAT("otawa::script::TIME_STAT", false);
 
+
+/**
+ * Enable the cache of transformed scripts in the default directory
+ * ($XDG_CACHE_HOME/otawa/scripts or $HOME/.cache/otawa/scripts).
+ * @ingroup script
+ */
+Identifier<bool> CACHE("otawa::script::CACHE", false);
+
+
+/**
+ * Enable the cache of transformed scripts in the given directory.
+ * @ingroup script
+ */
+Identifier<elm::sys::Path> CACHE_PATH("otawa::script::CACHE_PATH", "");
+
 } } // otawa::script
 
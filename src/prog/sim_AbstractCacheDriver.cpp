@@ -19,6 +19,9 @@ namespace otawa { namespace sim {
  * @li @ref DirectMappedCacheDriver
  * @li @ref LRUCacheDriver
  * @li @ref FIFOCacheDriver
+ *
+ * To simulate several cache configurations on the same trace, see
+ * @ref MultiCacheDriver.
  */
 
 
@@ -72,6 +75,8 @@ AbstractCacheDriver::AbstractCacheDriver(const hard::Cache *cache)
 : _cache(cache), lines(new tag_t[cache->blockCount()]) {
 	ASSERT(cache);
 	ASSERT(lines);
+	for(int i = 0; i < cache->blockCount(); i++)
+		lines[i] = ~tag_t(0);
 }
 
 
@@ -99,7 +104,7 @@ CacheDriver::result_t AbstractCacheDriver::access(
 			touch(i, line, tags);
 			return HIT;
 		}
-	replace(tag, _cache->wayCount(), tags);
+	replace(tag, line, tags);
 	return MISS;
 }
 
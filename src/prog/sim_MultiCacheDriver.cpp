@@ -0,0 +1,370 @@
+/*
+ *	MultiCacheDriver class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <string.h>
+#include <otawa/hard/Cache.h>
+#include <otawa/sim/MultiCacheDriver.h>
+
+namespace otawa { namespace sim {
+
+typedef t::uint32 tag_t;
+
+/*
+ * Mattson stack of the sets of a family of LRU caches sharing the same
+ * block size and set count: the position of a block in the stack of its
+ * set is its LRU age, and an access hits in every cache of the family
+ * whose way count is greater than this position. As a write miss does not
+ * change a cache without write allocation, such a cache cannot share its
+ * stack and gets its own one.
+ */
+class MultiCacheDriver::Stack {
+public:
+	Stack(int block_bits, int set_bits, bool allocate)
+		: bbits(block_bits), sbits(set_bits), depth(1), last(0), alloc(allocate), tags(nullptr), fill(nullptr), hist(nullptr) { }
+	~Stack(void) { clear(); }
+
+	inline bool matches(const hard::Cache *cache) const
+		{ return alloc && cache->doesWriteAllocate() && cache->blockBits() == bbits && cache->setBits() == sbits; }
+	inline void grow(int ways) { if(ways > depth) { depth = ways; clear(); } }
+
+	void reset(void) {
+		clear();
+		int sets = 1 << sbits;
+		tags = new tag_t[sets * depth];
+		fill = new int[sets];
+		for(int i = 0; i < sets; i++)
+			fill[i] = 0;
+		hist = new t::uint64[depth + 1];
+		for(int i = 0; i <= depth; i++)
+			hist[i] = 0;
+		last = depth;
+	}
+
+	// the age of an access is the oldest age of its blocks
+	void access(t::uint32 addr, t::uint32 size, bool write) {
+		if(tags == nullptr)
+			reset();
+		t::uint32 b = addr >> bbits, e = (addr + (size == 0 ? 0 : size - 1)) >> bbits;
+		int age = touch(b, write);
+		while(b != e) {
+			b++;
+			int a = touch(b, write);
+			if(a > age)
+				age = a;
+		}
+		hist[age]++;
+		last = age;
+	}
+
+	inline bool hit(int ways) const { return last < ways; }
+
+	t::uint64 hits(int ways) const {
+		t::uint64 r = 0;
+		if(hist != nullptr)
+			for(int i = 0; i < ways && i <= depth; i++)
+				r += hist[i];
+		return r;
+	}
+
+private:
+
+	// access a block and return its age before the access (depth if absent)
+	int touch(t::uint32 block, bool write) {
+		int set = block & ((1 << sbits) - 1);
+		tag_t tag = block >> sbits;
+		tag_t *s = tags + set * depth;
+		int n = fill[set];
+
+		// look the tag (no early exit to let the compiler vectorize)
+		int p = n;
+		for(int i = 0; i < n; i++)
+			p = s[i] == tag ? i : p;
+
+		// update the stack
+		int m = p;
+		if(p == n) {
+			if(write && !alloc)
+				return depth;
+			if(n < depth)
+				fill[set]++;
+			else
+				m = depth - 1;
+			p = depth;
+		}
+		memmove(s + 1, s, m * sizeof(tag_t));
+		s[0] = tag;
+		return p;
+	}
+
+	void clear(void) {
+		if(tags != nullptr) {
+			delete [] tags;
+			delete [] fill;
+			delete [] hist;
+			tags = nullptr;
+			fill = nullptr;
+			hist = nullptr;
+		}
+	}
+
+	int bbits, sbits, depth, last;
+	bool alloc;
+	tag_t *tags;
+	int *fill;
+	t::uint64 *hist;
+};
+
+
+/*
+ * FIFO cache (the sets are filled in order then the oldest block is replaced).
+ */
+class MultiCacheDriver::FIFO {
+public:
+	FIFO(const hard::Cache *cache)
+		: bbits(cache->blockBits()), sbits(cache->setBits()), ways(cache->wayCount()), alloc(cache->doesWriteAllocate()),
+		  last(false), cnt(0), tags(nullptr), fill(nullptr), next(nullptr) { }
+	~FIFO(void) { clear(); }
+
+	void reset(void) {
+		clear();
+		int sets = 1 << sbits;
+		tags = new tag_t[sets * ways];
+		fill = new int[sets];
+		next = new int[sets];
+		for(int i = 0; i < sets; i++)
+			fill[i] = next[i] = 0;
+		cnt = 0;
+		last = false;
+	}
+
+	// an access hits if all its blocks hit
+	void access(t::uint32 addr, t::uint32 size, bool write) {
+		if(tags == nullptr)
+			reset();
+		t::uint32 b = addr >> bbits, e = (addr + (size == 0 ? 0 : size - 1)) >> bbits;
+		bool found = touch(b, write);
+		while(b != e) {
+			b++;
+			found &= touch(b, write);
+		}
+		last = found;
+		if(found)
+			cnt++;
+	}
+
+	inline bool hit(void) const { return last; }
+	inline t::uint64 hits(void) const { return cnt; }
+
+private:
+
+	bool touch(t::uint32 block, bool write) {
+		int set = block & ((1 << sbits) - 1);
+		tag_t tag = block >> sbits;
+		tag_t *s = tags + set * ways;
+		int n = fill[set];
+		bool found = false;
+		for(int i = 0; i < n; i++)
+			found |= s[i] == tag;
+		if(found || (write && !alloc))
+			return found;
+		else if(n < ways)
+			s[fill[set]++] = tag;
+		else {
+			s[next[set]] = tag;
+			next[set] = (next[set] + 1) & (ways - 1);
+		}
+		return false;
+	}
+
+	void clear(void) {
+		if(tags != nullptr) {
+			delete [] tags;
+			delete [] fill;
+			delete [] next;
+			tags = nullptr;
+		}
+	}
+
+	int bbits, sbits, ways;
+	bool alloc, last;
+	t::uint64 cnt;
+	tag_t *tags;
+	int *fill, *next;
+};
+
+
+/**
+ * @class MultiCacheDriver
+ * Cache driver simulating several cache configurations in one pass over
+ * an access trace, typically to explore the design space of a cache.
+ *
+ * The LRU caches (and the direct-mapped caches, that are 1-way LRU caches)
+ * sharing the same block size and set count are simulated together with
+ * a Mattson stack: the LRU age of the accessed block is computed once
+ * and the access is a hit for each cache having more ways than this age.
+ * The FIFO caches are simulated separately. Other replacement policies
+ * are not supported (as for @ref AbstractCacheDriver).
+ *
+ * An access covering several blocks (according to its size) is a hit only
+ * if all its blocks hit, and it is counted once. A write miss does not load
+ * the block in the caches without write allocation
+ * (hard::Cache::doesWriteAllocate()).
+ *
+ * The result of access() is the one of the first added configuration;
+ * the other results are obtained with result() and the counts of hits
+ * and misses with hitCount() and missCount().
+ *
+ * @code
+ *	MultiCacheDriver driver;
+ *	for(auto c: caches)
+ *		driver.add(c);
+ *	for(auto a: trace)
+ *		driver.access(a, 4, CacheDriver::READ);
+ *	for(int i = 0; i < driver.count(); i++)
+ *		cout << driver.cache(i)->cacheSize() << ": " << driver.missCount(i) << io::endl;
+ * @endcode
+ */
+
+
+/**
+ * Build an empty multi-configuration driver.
+ */
+MultiCacheDriver::MultiCacheDriver(void): _cnt(0) {
+}
+
+
+/**
+ */
+MultiCacheDriver::~MultiCacheDriver(void) {
+	for(auto s: _stacks)
+		delete s;
+	for(auto f: _fifos)
+		delete f;
+}
+
+
+/**
+ * Add a cache configuration. The configurations must be added before
+ * any access or after a reset().
+ * @param cache		Added cache.
+ * @return			Index of the configuration or -1 if the replacement
+ * 					policy of the cache is not supported.
+ */
+int MultiCacheDriver::add(const hard::Cache *cache) {
+	ASSERT(cache);
+	ASSERTP(_cnt == 0, "MultiCacheDriver: configurations must be added before the accesses");
+	Conf conf;
+	conf.cache = cache;
+	if(cache->wayCount() == 1 || cache->replacementPolicy() == hard::Cache::LRU) {
+		for(auto s: _stacks)
+			if(s->matches(cache)) {
+				conf.stack = s;
+				break;
+			}
+		if(conf.stack == nullptr) {
+			conf.stack = new Stack(cache->blockBits(), cache->setBits(), cache->doesWriteAllocate());
+			_stacks.add(conf.stack);
+		}
+		conf.stack->grow(cache->wayCount());
+	}
+	else if(cache->replacementPolicy() == hard::Cache::FIFO) {
+		conf.fifo = new FIFO(cache);
+		_fifos.add(conf.fifo);
+	}
+	else
+		return -1;
+	_confs.add(conf);
+	return _confs.length() - 1;
+}
+
+
+/**
+ * Simulate an access for all configurations.
+ * @return	Result for the first configuration (or MISS if there is no configuration).
+ */
+CacheDriver::result_t MultiCacheDriver::access(address_t address, size_t size, action_t action) {
+	t::uint32 a = address.offset();
+	bool write = action == WRITE;
+	for(auto s: _stacks)
+		s->access(a, size, write);
+	for(auto f: _fifos)
+		f->access(a, size, write);
+	_cnt++;
+	if(_confs.isEmpty())
+		return MISS;
+	else
+		return result(0);
+}
+
+
+/**
+ * Get the result of the last access for a configuration.
+ * @param i		Configuration index.
+ * @return		HIT or MISS.
+ */
+CacheDriver::result_t MultiCacheDriver::result(int i) const {
+	const Conf& c = _confs[i];
+	bool hit = c.stack != nullptr ? c.stack->hit(c.cache->wayCount()) : c.fifo->hit();
+	return hit ? HIT : MISS;
+}
+
+
+/**
+ * Get the number of hits of a configuration.
+ * @param i		Configuration index.
+ * @return		Hit count.
+ */
+t::uint64 MultiCacheDriver::hitCount(int i) const {
+	const Conf& c = _confs[i];
+	if(c.stack != nullptr)
+		return c.stack->hits(c.cache->wayCount());
+	else
+		return c.fifo->hits();
+}
+
+
+/**
+ * @fn t::uint64 MultiCacheDriver::missCount(int i) const;
+ * Get the number of misses of a configuration.
+ * @param i		Configuration index.
+ * @return		Miss count.
+ */
+
+
+/**
+ * @fn t::uint64 MultiCacheDriver::accessCount(void) const;
+ * Get the number of simulated accesses.
+ * @return	Access count.
+ */
+
+
+/**
+ * Empty the simulated caches and reset the counters.
+ */
+void MultiCacheDriver::reset(void) {
+	for(auto s: _stacks)
+		s->reset();
+	for(auto f: _fifos)
+		f->reset();
+	_cnt = 0;
+}
+
+} } // otawa::sim
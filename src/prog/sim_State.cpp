@@ -40,6 +40,16 @@ State::~State(void) {
 }
 
 
+/**
+ * Release the state, that is, the state obtained from Simulator::instantiate()
+ * or from clone() once it is no more used. As a default, delete the state:
+ * simulators with a specific allocation of the states may override it.
+ */
+void State::release(void) {
+	delete this;
+}
+
+
 /**
  * @fn State *State::clone(void);
  * Build a copy of the current simulation state.
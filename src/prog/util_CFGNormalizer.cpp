@@ -81,18 +81,20 @@ void CFGNormalizer::transform(CFG *cfg, CFGMaker& maker) {
 	// find dead-end blocks
 	elm::ListQueue<Block *> wl;
 	wl.put(cfg->exit());
+	alive.add(cfg->exit()->index());
 
-	// propagate dead markers
+	// propagate dead markers (each block is put only once)
 	while(wl) {
 
 		// next block
 		Block *b = wl.get();
-		alive.add(b->index());
 
 		// propagate to predecessors
 		for(Block::EdgeIter e = b->ins(); e(); e++)
-			if(!alive.contains(e->source()->index()))
+			if(!alive.contains(e->source()->index())) {
+				alive.add(e->source()->index());
 				wl.put(e->source());
+			}
 	}
 
 	// find block unreachable from exit in reversed CFG
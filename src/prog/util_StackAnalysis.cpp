@@ -25,11 +25,14 @@
 #	define HAI_DEBUG
 #endif
 
+#include <atomic>
+#include "config.h"
 #include <otawa/dfa/State.h>
 #include <otawa/hard/Platform.h>
 #include <otawa/hard/Register.h>
 #include <otawa/proc/BBProcessor.h>
 #include <otawa/proc/CFGProcessor.h>
+#include <otawa/proc/ConcurrentCFGProcessor.h>
 #include <otawa/prog/File.h>
 #include <otawa/prog/sem.h>
 #include <otawa/stack/AccessedAddress.h>
@@ -399,87 +402,87 @@ const Value& Value::none	= bot,	/** undefined value */
 			Value::all 		= top;	/** any value */
 
 
+/*
+ * State of the stack analysis: a default value and a sorted flat array of
+ * (address, value) slots (registers first, then stack then absolute addresses).
+ * The slot array is shared between copies of the state and duplicated only
+ * when a shared state is modified (copy-on-write): this makes the state
+ * assignments of the fix point and the storage of the results cheap.
+ */
 class State {
 public:
 
 	class Node {
 	public:
-		friend class State;
-		inline Node(void): next(0), addr(Value::none) { }
-		inline Node(const Value& address, const Value& value)
-			: next(0), addr(address), val(value) { }
-		inline Node(const Node *node)
-			: next(0), addr(node->addr), val(node->val) { }
-	private:
-		Node *next;
+		inline Node(void): addr(Value::none) { }
+		inline Node(const Value& address, const Value& value): addr(address), val(value) { }
 		Value addr;
 		Value val;
 	};
 
-	State(const Value& def = Value::all): first(Value::none, def)
+	State(const Value& def = Value::all): _def(def), _slots(nullptr)
 		{ TRACED(cerr << "State(" << def << ")\n"); }
-	State(const State& state): first(Value::none, Value::all)
-		{ TRACED(cerr << "State("; state.print(cerr); cerr << ")\n"); copy(state); }
-	~State(void) { clear(); }
+	State(const State& state): _def(state._def), _slots(state._slots)
+		{ TRACED(cerr << "State("; state.print(cerr); cerr << ")\n"); if(_slots) _slots->rc++; }
+	~State(void) { release(); }
 
-	inline bool isBot(void) const { return first.addr == Value::none; }
+	inline bool isBot(void) const { return _def == Value::none; }
 	inline State& operator=(const State& state) { copy(state); return *this; }
 
 	void copy(const State& state) {
-		TRACED(cerr << "copy("; print(cerr); cerr << ", "; state.print(cerr); cerr << ") = ");
-		clear();
-		first = state.first;
-		for(Node *prev = &first, *cur = state.first.next; cur; cur = cur->next) {
-			prev->next = new Node(cur);
-			prev = prev->next;
-		}
-		TRACED(print(cerr); cerr << io::endl);
+		TRACED(cerr << "copy("; print(cerr); cerr << ", "; state.print(cerr); cerr << ")\n");
+		if(state._slots)
+			state._slots->rc++;
+		release();
+		_def = state._def;
+		_slots = state._slots;
 	}
 
 	void clear(void) {
-		for(Node *cur = first.next, *next;
-		cur;
-		cur = next) {
-			next = cur->next;
-			delete cur;
-		}
-		first.next = 0;
+		release();
 	}
 
 	void set(const Value& addr, const Value& val) {
 		TRACED(cerr << "set("; print(cerr); cerr << ", " << addr << ", " << val << ") = ");
-		Node *prev, *cur, *next;
-		if(first.val == Value::none) {
+		if(_def == Value::none) {
 			TRACED(print(cerr); cerr << io::endl);
 			return;
 		}
 
 		// consum all memory references
 		if(addr.kind() == ALL) {
-			for(prev = &first, cur = first.next; cur && cur->addr.kind() <= SP; prev = cur, cur = cur->next) ;
-			while(cur) {
-				next = cur->next;
-				delete cur;
-				cur = next;
+			int i = 0;
+			while(i < count() && _slots->tab[i].addr.kind() <= SP)
+				i++;
+			if(i < count()) {
+				own(0);
+				_slots->cnt = i;
 			}
-			prev->next = 0;
 		}
 
 		// find a value
 		else {
-			for(prev = &first, cur = first.next; cur && cur->addr < addr; prev = cur, cur = cur->next);
-			if(cur && cur->addr == addr) {
-				if(val.kind() != ALL)
-					cur->val = val;
+			int i = find(addr);
+			if(i < count() && _slots->tab[i].addr == addr) {
+				if(val.kind() != ALL) {
+					if(_slots->tab[i].val != val) {
+						own(0);
+						_slots->tab[i].val = val;
+					}
+				}
 				else {
-					prev->next = cur->next;
-					delete cur;
+					own(0);
+					for(i++; i < _slots->cnt; i++)
+						_slots->tab[i - 1] = _slots->tab[i];
+					_slots->cnt--;
 				}
 			}
 			else if(val.kind() != ALL) {
-				next = new Node(addr, val);
-				prev->next = next;
-				prev->next->next = cur;
+				own(1);
+				for(int j = _slots->cnt; j > i; j--)
+					_slots->tab[j] = _slots->tab[j - 1];
+				_slots->tab[i] = Node(addr, val);
+				_slots->cnt++;
 			}
 		}
 
@@ -487,84 +490,67 @@ public:
 	}
 
 	bool equals(const State& state) const {
-		if(first.val.kind() != state.first.val.kind())
+		if(_def.kind() != state._def.kind())
 			return false;
-		Node *cur = first.next, *cur2 = state.first.next;
-		while(cur && cur2) {
-			if(cur->addr != cur2->addr)
-				return false;
-			if(cur->val != cur->val)
+		if(_slots == state._slots)
+			return true;
+		if(count() != state.count())
+			return false;
+		for(int i = 0; i < count(); i++)
+			if(_slots->tab[i].addr != state._slots->tab[i].addr
+			|| _slots->tab[i].val != state._slots->tab[i].val)
 				return false;
-			cur = cur->next;
-			cur2 = cur2->next;
-		}
-		return cur == cur2;
+		return true;
 	}
 
 	void join(const State& state) {
 		TRACED(cerr << "join(\n\t"; print(cerr); cerr << ",\n\t";  state.print(cerr); cerr << "\n\t) = ");
 
 		// test none states
-		if(state.first.val == Value::none)
+		if(state._def == Value::none)
 			return;
-		if(first.val == Value::none) {
+		if(_def == Value::none) {
 			copy(state);
 			TRACED(print(cerr); cerr << io::endl;);
 			return;
 		}
+		if(_slots == state._slots)
+			return;
 
-		Node *prev = &first, *cur = first.next, *cur2 = state.first.next, *next;
-		while(cur && cur2) {
-
-			// addr1 < addr2 -> remove cur1
-			if(cur->addr < cur2->addr) {
-				prev->next = cur->next;
-				delete cur;
-				cur = prev->next;
-			}
-
-			// equality ? remove if join result in all
-			else if(cur->addr == cur2->addr) {
-				cur->val.join(cur2->val);
-				if(cur->val.kind() == ALL) {
-					prev->next = cur->next;
-					delete cur;
-					cur = prev->next;
-				}
-				else {
-					prev = cur;
-					cur = cur->next;
-					cur2 = cur2->next;
+		// only keep the common slots whose join is not all
+		Slots *r = nullptr;
+		for(int i = 0, j = 0; i < count() && j < state.count(); ) {
+			const Node& n1 = _slots->tab[i], & n2 = state._slots->tab[j];
+			if(n1.addr < n2.addr)
+				i++;
+			else if(n2.addr < n1.addr)
+				j++;
+			else {
+				Value v = n1.val;
+				v.join(n2.val);
+				if(v.kind() != ALL) {
+					if(!r)
+						r = new Slots(min(count(), state.count()));
+					r->tab[r->cnt++] = Node(n1.addr, v);
 				}
+				i++;
+				j++;
 			}
-
-			// addr1 > addr2 => remove cur2
-			else
-				cur2 = cur2->next;
-		}
-
-		// remove tail
-		prev->next = 0;
-		while(cur) {
-			next = cur->next;
-			delete cur;
-			cur = next;
 		}
+		release();
+		_slots = r;
 		TRACED(print(cerr); cerr << io::endl;);
 	}
 
 	void print(io::Output& out) const {
-		if(first.val == Value::none)
+		if(_def == Value::none)
 			out << '_';
 		else {
-			bool f =  true;
 			out << "{ ";
-			for(Node *cur = first.next; cur; cur = cur->next) {
-				if(f)
-					f = false;
-				else
+			for(int i = 0; i < count(); i++) {
+				if(i != 0)
 					out << ", ";
-				out << cur->addr << " = " << cur->val;
+				out << _slots->tab[i].addr << " = " << _slots->tab[i].val;
 			}
 			out << " }";
 		}
@@ -576,26 +562,75 @@ public:
 		case 2: { t::uint16 v; proc->get(addr, v); return Value(CST, v); }
 		case 4: { t::uint32 v; proc->get(addr, v); return Value(CST, v); }
 		}
-		return first.val;
+		return _def;
 	}
 
 	Value get(const Value& addr, Process *proc, int size) const {
-		Node * cur;
-		for(cur = first.next; cur && cur->addr < addr; cur = cur->next) ;
-		if(cur && cur->addr == addr)
-			return cur->val;
+		int i = find(addr);
+		if(i < count() && _slots->tab[i].addr == addr)
+			return _slots->tab[i].val;
 		if(addr.kind() == CST)
 			for(Process::FileIter file(proc); file(); file++)
 				for(File::SegIter seg(*file); seg(); seg++)
 					if(seg->contains(addr.value()))
 						return fromImage(addr.value(), proc, size);
-		return first.val;
+		return _def;
 	}
 
 	static const State EMPTY, FULL;
 
 private:
-	Node first;
+
+	class Slots {
+	public:
+		inline Slots(int c): rc(1), cnt(0), cap(c), tab(new Node[c]) { }
+		inline Slots(const Slots& s, int c): rc(1), cnt(s.cnt), cap(c), tab(new Node[c])
+			{ for(int i = 0; i < cnt; i++) tab[i] = s.tab[i]; }
+		inline ~Slots(void) { delete [] tab; }
+		std::atomic<int> rc;
+		int cnt, cap;
+		Node *tab;
+	};
+
+	inline int count(void) const { return _slots ? _slots->cnt : 0; }
+
+	// binary search of the first slot whose address is not less than addr
+	int find(const Value& addr) const {
+		int l = 0, h = count();
+		while(l < h) {
+			int m = (l + h) / 2;
+			if(_slots->tab[m].addr < addr)
+				l = m + 1;
+			else
+				h = m;
+		}
+		return l;
+	}
+
+	// ensure the slots are not shared and can receive n more slots
+	void own(int n) {
+		if(!_slots) {
+			_slots = new Slots(max(8, n));
+			return;
+		}
+		if(_slots->rc == 1 && _slots->cnt + n <= _slots->cap)
+			return;
+		int cap = _slots->cap;
+		if(_slots->cnt + n > cap)
+			cap = max(cap * 2, _slots->cnt + n);
+		Slots *s = new Slots(*_slots, cap);
+		release();
+		_slots = s;
+	}
+
+	void release(void) {
+		if(_slots && --_slots->rc == 0)
+			delete _slots;
+		_slots = nullptr;
+	}
+
+	Value _def;
+	Slots *_slots;
 };
 const State State::EMPTY(Value::none), State::FULL(Value::all);
 io::Output& operator<<(io::Output& out, const State& state) { state.print(out); return out; }
@@ -931,6 +966,7 @@ void StackAnalysis::processWorkSpace(WorkSpace *ws) {
 		for(CFG::BlockIter bb = cfg->blocks(); bb(); bb++) {
 			if(logFor(LOG_BLOCK))
 				log << "\t\t" << *bb << "[" << cfg->index() << "][" << cfg->index() << "]: " << *list.results[cfg->index()][bb->index()] << io::endl;
+			// only the slots reference is copied: the results share their slots
 			stack::STATE(*bb) = new stack::State(*list.results[cfg->index()][bb->index()]);
 	}
 }
@@ -992,7 +1028,17 @@ namespace stack {
 
 /**
  */
-Iter::Iter(WorkSpace *ws): otawa::sem::StateIter<Manager>(**MANAGER(ws)) {
+Iter::Iter(WorkSpace *ws): otawa::sem::StateIter<Manager>(**MANAGER(ws)), man(*MANAGER(ws)) {
+}
+
+
+/**
+ * Build an iterator using its own manager. As the manager keeps
+ * temporary data, this is the way to use several iterators
+ * concurrently (one manager per thread).
+ * @param manager	Manager to use.
+ */
+Iter::Iter(Manager& manager): otawa::sem::StateIter<Manager>(manager), man(&manager) {
 }
 
 
@@ -1013,6 +1059,7 @@ Manager::Manager(WorkSpace *ws) {
  */
 Manager::~Manager(void) {
 	delete _bot;
+	delete p;
 }
 
 /**
@@ -1091,14 +1138,18 @@ Manager::t Manager::updatePath(t s, sem::inst i) {
  * Provide accessed addresses from the stack analysis.
  * Basically, this means that it only provides address of type
  * @ref AccessedAddress::ANY or @ref AccessedAddress::SP.
+ *
+ * The CFGs are processed concurrently (if OTAWA is built with concurrency
+ * support): each CFG uses its own stack manager and statistics, the latter
+ * being summed at the end of the CFG.
  */
-class AddressBuilder: public BBProcessor {
+class AddressBuilder: public ConcurrentCFGProcessor {
 public:
 	static p::declare reg;
-	AddressBuilder(p::declare& r = reg): BBProcessor(r), do_stats(false) { }
+	AddressBuilder(p::declare& r = reg): ConcurrentCFGProcessor(r), do_stats(false), mutex(nullptr) { }
 
 	void configure(const PropList &props) {
-		BBProcessor::configure(props);
+		ConcurrentCFGProcessor::configure(props);
 		do_stats = STATS(props);
 	}
 
@@ -1108,23 +1159,48 @@ protected:
 		ss.abs = 0;
 		ss.sprel = 0;
 		ss.total = 0;
-		iter = new Iter(ws);
+#		ifdef OTAWA_CONC
+			mutex = sys::Mutex::make();
+#		endif
 	}
 
 	virtual void cleanup(WorkSpace *ws) {
 		if(do_stats)
 			ADDRESS_STATS(stats) = new address_stat_t(ss);
-		delete iter;
+#		ifdef OTAWA_CONC
+			delete mutex;
+			mutex = nullptr;
+#		endif
 	}
 
-	virtual void processBB(WorkSpace *ws, CFG *cfg, Block *bb) {
-		if(!bb->isBasic())
-			return;
-		Iter& i = *iter;
+	virtual void processCFG(WorkSpace *ws, CFG *cfg) {
+		Manager man(ws);
+		Iter i(man);
+		address_stat_t ls = { 0, 0, 0, 0 };
+		for(CFG::BlockIter bb = cfg->blocks(); bb(); bb++)
+			if(bb->isBasic())
+				processBB(bb->toBasic(), i, ls);
+
+		// merge the statistics
+#		ifdef OTAWA_CONC
+			mutex->lock();
+#		endif
+		ss.all += ls.all;
+		ss.abs += ls.abs;
+		ss.sprel += ls.sprel;
+		ss.total += ls.total;
+#		ifdef OTAWA_CONC
+			mutex->unlock();
+#		endif
+	}
+
+private:
+
+	void processBB(BasicBlock *bb, Iter& i, address_stat_t& ls) {
 
 		// collect addresses
 		Vector<AccessedAddress *> addrs;
-		for(i.start(bb->toBasic()); i(); i++)
+		for(i.start(bb); i(); i++)
 			if((*i).op == sem::LOAD || (*i).op == sem::STORE) {
 				bool is_store = (*i).op == sem::STORE;
 				int r = (*i).addr();
@@ -1132,13 +1208,13 @@ protected:
 				AccessedAddress *aa = nullptr;
 				switch(a.kind()) {
 				case NONE:
-				case ALL:	aa = new AccessedAddress(i.instruction(), is_store, AccessedAddress::ANY); ss.all++; break;
-				case SP:	aa = new SPAddress(i.instruction(), is_store, a.value()); ss.sprel++; break;
-				case CST:	aa = new AbsAddress(i.instruction(), is_store, a.value()); ss.abs++; break;
+				case ALL:	aa = new AccessedAddress(i.instruction(), is_store, AccessedAddress::ANY); ls.all++; break;
+				case SP:	aa = new SPAddress(i.instruction(), is_store, a.value()); ls.sprel++; break;
+				case CST:	aa = new AbsAddress(i.instruction(), is_store, a.value()); ls.abs++; break;
 				case REG:	ASSERT(false); break;
 				}
 				addrs.add(aa);
-				ss.total++;
+				ls.total++;
 			}
 
 		// improve the accessed addresses set
@@ -1150,14 +1226,13 @@ protected:
 		aa->set(addrs);
 	}
 
-private:
 	address_stat_t ss;
 	bool do_stats;
-	Iter *iter;
+	sys::Mutex *mutex;
 };
 
-p::declare AddressBuilder::reg = p::init("otawa::stack::AddressBuilder", Version(1, 0, 0))
-	.base(BBProcessor::reg)
+p::declare AddressBuilder::reg = p::init("otawa::stack::AddressBuilder", Version(1, 1, 0))
+	.base(ConcurrentCFGProcessor::reg)
 	.maker<AddressBuilder>()
 	.require(STACK_ANALYSIS_FEATURE)
 	.provide(ADDRESS_ANALYSIS_FEATURE)
@@ -0,0 +1,174 @@
+/*
+ *	Test of the summary mode of ai::CFGAnalyzer
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/HashMap.h>
+#include <elm/io.h>
+#include <otawa/ai/CFGAnalyzer.h>
+#include <otawa/ai/features.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+
+using namespace elm;
+using namespace otawa;
+
+static const int INF = type_info<int>::max;
+
+// interval of the number of executed blocks (infinite ascending chains)
+class Interval: public ai::State {
+public:
+	inline Interval(int l, int h): lo(l), hi(h) { }
+	int lo, hi;
+};
+
+class CounterDomain: public ai::Domain {
+public:
+	CounterDomain(void): bad(0), _bot(1, 0), _top(0, INF) { }
+	~CounterDomain(void) { for(auto s: states) delete s; }
+
+	ai::State *bot() override { return &_bot; }
+	ai::State *top() override { return &_top; }
+	ai::State *entry() override { return make(0, 0); }
+
+	bool equals(ai::State *s1, ai::State *s2) override {
+		Interval *i1 = get(s1), *i2 = get(s2);
+		return i1 == i2 || (!isBot(i1) && !isBot(i2) && i1->lo == i2->lo && i1->hi == i2->hi);
+	}
+
+	ai::State *join(ai::State *s1, ai::State *s2) override {
+		Interval *i1 = get(s1), *i2 = get(s2);
+		if(isBot(i1))
+			return s2;
+		else if(isBot(i2))
+			return s1;
+		else
+			return make(min(i1->lo, i2->lo), max(i1->hi, i2->hi));
+	}
+
+	ai::State *widen(ai::State *s1, ai::State *s2) override {
+		Interval *i1 = get(s1), *i2 = get(s2);
+		if(isBot(i1) || isBot(i2))
+			return join(s1, s2);
+		else
+			return make(i2->lo < i1->lo ? 0 : i1->lo, i2->hi > i1->hi ? INF : i1->hi);
+	}
+
+	ai::State *update(Edge *e, ai::State *s) override { return s; }
+
+	ai::State *update(Block *v, ai::State *s) override {
+		Interval *i = get(s);
+		if(!v->isBasic() || isBot(i))
+			return s;
+		return make(i->lo == INF ? INF : i->lo + 1, i->hi == INF ? INF : i->hi + 1);
+	}
+
+	// count the holders of each state
+	void acquire(ai::State *s) override { held.put(s, held.get(s, 0) + 1); }
+	void release(ai::State *s) override {
+		int n = held.get(s, 0);
+		if(n == 0)
+			bad++;
+		else if(n == 1)
+			held.remove(s);
+		else
+			held.put(s, n - 1);
+	}
+	inline int live() const { return held.count(); }
+
+	bool implementsSummaries() override { return true; }
+	t::hash hash(ai::State *s) override { Interval *i = get(s); return t::hash(i->lo) * 31 + t::hash(i->hi); }
+
+	inline Interval *get(ai::State *s) const { return static_cast<Interval *>(s); }
+	inline bool isBot(Interval *i) const { return i->lo > i->hi; }
+	int bad;
+
+private:
+	Interval *make(int lo, int hi) { Interval *i = new Interval(lo, hi); states.add(i); return i; }
+	Interval _bot, _top;
+	Vector<Interval *> states;
+	HashMap<ai::State *, int> held;
+};
+
+/**
+ * Run an analysis with infinite ascending chains in summary mode (that has
+ * to terminate thanks to widening) and check that the same blocks are reached
+ * as in the global WTO mode and that the loop headers are unbounded.
+ * The domain also counts the acquisitions and releases of each state to check
+ * that the analyzers hold no more state once deleted.
+ *
+ * Usage: test_summary BINARY
+ */
+class SummaryTest: public Application {
+public:
+	SummaryTest(void): Application(Make("test_summary")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(ai::RANKING_FEATURE);
+		require(LOOP_HEADERS_FEATURE);
+		CounterDomain dom;
+		int errors = 0;
+		{
+			ai::CFGAnalyzer global(*this, dom);
+			global.setWTO(true);
+			global.process();
+			ai::CFGAnalyzer summary(*this, dom);
+			summary.setSummaries(true);
+			summary.process();
+
+			for(auto g: *COLLECTED_CFG_FEATURE.get(workspace()))
+				for(auto v: *g) {
+					Interval *gi = dom.get(global.after(v)), *si = dom.get(summary.after(v));
+					if(dom.isBot(gi) != dom.isBot(si)) {
+						cerr << "ERROR: " << v << " in " << g << " is not reached in both modes\n";
+						errors++;
+					}
+					else if(v->isBasic() && LOOP_HEADER(v) && !dom.isBot(si) && si->hi != INF) {
+						cerr << "ERROR: loop header " << v << " in " << g << " is not widened in summary mode\n";
+						errors++;
+					}
+
+					// states given to the user (the same state may be used several times)
+					for(auto e: v->outEdges()) {
+						ai::State *s1 = summary.after(e), *s2 = summary.after(e);
+						summary.release(s1);
+						summary.release(s2);
+					}
+					global.release(global.before(v));
+				}
+			if(summary.summaryCount() == 0) {
+				cerr << "ERROR: no summary built\n";
+				errors++;
+			}
+		}
+
+		// all the states held by the analyzers must be released
+		if(dom.live() != 0 || dom.bad != 0) {
+			cerr << "ERROR: " << dom.live() << " states still held and " << dom.bad << " bad releases\n";
+			errors++;
+		}
+		if(errors != 0)
+			throw otawa::Exception(_ << errors << " errors in summary mode");
+	}
+
+};
+
+OTAWA_RUN(SummaryTest)
@@ -0,0 +1,153 @@
+/*
+ *	Comparison of the iteration strategies of the abstract interpretation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/io.h>
+#include <otawa/ai/ArrayStore.h>
+#include <otawa/ai/CFGGraph.h>
+#include <otawa/ai/RankingAI.h>
+#include <otawa/ai/SimpleAI.h>
+#include <otawa/ai/WTODriver.h>
+#include <otawa/ai/features.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+
+using namespace elm;
+using namespace otawa;
+
+// set of blocks (index modulo 63) met on the paths to a block (-1 if not reached)
+class ReachDomain {
+public:
+	typedef t::int64 t;
+	inline t init() const { return 0; }
+	inline t bot() const { return -1; }
+	inline t join(t x, t y) const { return x == -1 ? y : y == -1 ? x : x | y; }
+	inline bool equals(t x, t y) const { return x == y; }
+	inline void copy(t& x, t y) const { x = y; }
+	inline t widen(t x, t y) const { return join(x, y); }
+};
+
+class ReachAdapter {
+public:
+	typedef ReachDomain domain_t;
+	typedef ai::CFGGraph graph_t;
+	typedef ai::ArrayStore<ReachDomain, ai::CFGGraph> store_t;
+
+	ReachAdapter(CFG *g): _graph(g), _store(_domain, _graph), cnt(0) { }
+
+	void update(Block *v, ReachDomain::t& d) {
+		cnt++;
+		if(v->isEntry()) {
+			d = _domain.init();
+			return;
+		}
+		d = _domain.bot();
+		for(auto e: v->inEdges())
+			d = _domain.join(d, _store.get(e->source()));
+		if(d != _domain.bot())
+			d |= t::int64(1) << (v->index() % 63);
+	}
+
+	inline ReachDomain& domain() { return _domain; }
+	inline ai::CFGGraph& graph() { return _graph; }
+	inline store_t& store() { return _store; }
+	inline int count() const { return cnt; }
+
+private:
+	ReachDomain _domain;
+	ai::CFGGraph _graph;
+	store_t _store;
+	int cnt;
+};
+
+/**
+ * Check that the work-list, ranked and WTO iteration strategies reach the
+ * same fix point on the CFGs of a program (the test fails with code 1 else)
+ * and display their iteration counts.
+ *
+ * Usage: test_wto BINARY
+ */
+class WTOTest: public Application {
+public:
+	WTOTest(void): Application(Make("test_wto")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(ai::RANKING_FEATURE);
+		int errors = 0, wl_cnt = 0, rank_cnt = 0, wto_cnt = 0, wto_rank_cnt = 0;
+		for(auto g: *COLLECTED_CFG_FEATURE.get(workspace())) {
+
+			// work-list
+			ReachAdapter wl(g);
+			ai::SimpleAI<ReachAdapter> wl_ai(wl);
+			wl_ai.run();
+
+			// ranked queue
+			ReachAdapter rank(g);
+			ai::RankingAI<ReachAdapter> rank_ai(rank);
+			rank_ai.run();
+
+			// WTO driver
+			typedef ai::WTODriver<ReachDomain, ai::CFGGraph, ReachAdapter::store_t, ai::DomainWidening> driver_t;
+			ReachAdapter wto(g);
+			ai::SimpleAI<ReachAdapter, driver_t> wto_ai(wto);
+			wto_ai.run();
+
+			// WTO ranking
+			ReachAdapter wto_rank(g);
+			ai::WTORanking<ai::CFGGraph> ranking(wto_rank.graph());
+			ai::RankingAI<ReachAdapter, ai::WTORanking<ai::CFGGraph> > wto_rank_ai(wto_rank, ranking);
+			wto_rank_ai.run();
+
+			// compare the fix points (the exit is not computed by the work-list drivers)
+			for(auto v: *g) {
+				if(v->isExit())
+					continue;
+				ReachDomain::t r = wl.store().get(v);
+				if(r != rank.store().get(v) || r != wto.store().get(v) || r != wto_rank.store().get(v)) {
+					cerr << "ERROR: different results for " << v << " in " << g << io::endl;
+					errors++;
+				}
+			}
+			if(wto_ai.driver().iterationCount() < wto.count()) {
+				cerr << "ERROR: bad iteration count of WTODriver for " << g << io::endl;
+				errors++;
+			}
+			if(rank_ai.iterationCount() != rank.count()) {
+				cerr << "ERROR: bad iteration count of RankingAI for " << g << io::endl;
+				errors++;
+			}
+			wl_cnt += wl.count();
+			rank_cnt += rank.count();
+			wto_cnt += wto.count();
+			wto_rank_cnt += wto_rank.count();
+		}
+		if(errors != 0)
+			fail(1, _ << errors << " differences between the iteration strategies");
+		cout << "work-list: " << wl_cnt << " iterations\n"
+			 << "ranked: " << rank_cnt << " iterations\n"
+			 << "WTO: " << wto_cnt << " iterations\n"
+			 << "WTO ranked: " << wto_rank_cnt << " iterations\n";
+	}
+
+};
+
+OTAWA_RUN(WTOTest)
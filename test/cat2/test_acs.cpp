@@ -0,0 +1,210 @@
+/*
+ *	Test and benchmark of the CAT2 abstract cache states
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <elm/io.h>
+#include <elm/sys/StopWatch.h>
+#include <otawa/cache/cat2/MAYProblem.h>
+#include <otawa/cache/cat2/MUSTProblem.h>
+#include <otawa/cache/cat2/PERSProblem.h>
+
+using namespace elm;
+using namespace otawa;
+
+// reference implementation with int ages (as before the byte packing)
+class Ref {
+public:
+	typedef enum { MUST, MAY, PERS } kind_t;
+	Ref(kind_t k, int s, int a): kind(k), size(s), A(a), age(new int[s])
+		{ for(int i = 0; i < size; i++) age[i] = kind == MUST ? 0 : -1; }
+	Ref(const Ref& r): kind(r.kind), size(r.size), A(r.A), age(new int[r.size])
+		{ for(int i = 0; i < size; i++) age[i] = r.age[i]; }
+	~Ref(void) { delete [] age; }
+
+	void lub(const Ref& d) {
+		for(int i = 0; i < size; i++)
+			switch(kind) {
+			case MUST:	if(((age[i] < d.age[i]) && (age[i] != -1)) || (d.age[i] == -1)) age[i] = d.age[i]; break;
+			case MAY:	if(((age[i] > d.age[i]) && (d.age[i] != -1)) || (age[i] == -1)) age[i] = d.age[i]; break;
+			case PERS:	if((age[i] == -1) || ((age[i] < d.age[i]) && (d.age[i] != -1))) age[i] = d.age[i]; break;
+			}
+	}
+
+	void inject(int id, bool in_must) {
+		if(kind == PERS) {
+			for(int i = 0; i < size; i++)
+				if(in_must ? (age[i] < age[id]) && (age[i] != -1) && (age[i] != A) : (age[i] != -1) && (age[i] != A))
+					age[i]++;
+		}
+		else if(age[id] != -1) {
+			int a = age[id];
+			for(int i = 0; i < size; i++)
+				if((kind == MUST ? age[i] < a : age[i] <= a) && (age[i] != -1))
+					age[i]++;
+		}
+		else
+			for(int i = 0; i < size; i++) {
+				if(age[i] != -1)
+					age[i]++;
+				if(age[i] == A)
+					age[i] = -1;
+			}
+		age[id] = 0;
+	}
+
+	void addDamage(int id, int damage) {
+		if(age[id] == -1)
+			return;
+		age[id] += damage;
+		if(kind == PERS) {
+			if(age[id] > A)
+				age[id] = A;
+		}
+		else if(age[id] >= A)
+			age[id] = -1;
+	}
+
+	kind_t kind;
+	int size, A;
+	int *age;
+};
+
+template <class D>
+bool same(const Ref& r, const D& d) {
+	for(int i = 0; i < r.size; i++)
+		if(r.age[i] != d.age[i])
+			return false;
+	return true;
+}
+
+static const int size = 64, A = 8, wide_A = 200, states = 16;
+
+inline void inject(MUSTProblem::Domain& d, MUSTProblem::Domain *must, int id) { d.inject(id); }
+inline void inject(MAYProblem::Domain& d, MUSTProblem::Domain *must, int id) { d.inject(id); }
+inline void inject(PERSProblem::Item& d, MUSTProblem::Domain *must, int id) { d.inject(must, id); }
+
+// same random sequence on the reference and on the packed states
+template <class D>
+int check(Ref::kind_t kind, int A, int steps) {
+	Vector<Ref *> refs;
+	Vector<D *> ds;
+	for(int i = 0; i < states; i++) {
+		refs.add(new Ref(kind, size, A));
+		ds.add(new D(size, A));
+	}
+	int errors = 0;
+	srand(1);
+	for(int s = 0; s < steps; s++) {
+		int i = rand() % states, j = rand() % states, id = rand() % size;
+		bool in_must = kind == Ref::PERS ? rand() % 2 : refs[i]->age[id] != -1;
+		MUSTProblem::Domain must(size, A);
+		must.setAge(id, in_must ? 0 : -1);
+		switch(rand() % 4) {
+		case 0: {
+				int damage = 1 + rand() % 3;
+				refs[i]->addDamage(id, damage);
+				ds[i]->addDamage(id, damage);
+			}
+			break;
+		case 1:
+			refs[i]->lub(*refs[j]);
+			ds[i]->lub(*ds[j]);
+			break;
+		default:
+			refs[i]->inject(id, in_must);
+			inject(*ds[i], &must, id);
+			break;
+		}
+		if(!same(*refs[i], *ds[i]))
+			errors++;
+	}
+	for(int i = 0; i < states; i++) {
+		delete refs[i];
+		delete ds[i];
+	}
+	return errors;
+}
+
+// time the reference and the packed states on the same sequence
+template <class D>
+void bench(Ref::kind_t kind, cstring name, int steps) {
+	sys::StopWatch rw, dw;
+	rw.start();
+	{
+		Vector<Ref *> refs;
+		for(int i = 0; i < states; i++)
+			refs.add(new Ref(kind, size, A));
+		srand(2);
+		for(int s = 0; s < steps; s++) {
+			int i = rand() % states, j = rand() % states, id = rand() % size;
+			Ref r(*refs[i]);
+			r.lub(*refs[j]);
+			r.inject(id, true);
+			refs[i]->lub(r);
+		}
+		for(int i = 0; i < states; i++)
+			delete refs[i];
+	}
+	rw.stop();
+	dw.start();
+	{
+		MUSTProblem::Domain must(size, A);
+		Vector<D *> ds;
+		for(int i = 0; i < states; i++)
+			ds.add(new D(size, A));
+		srand(2);
+		for(int s = 0; s < steps; s++) {
+			int i = rand() % states, j = rand() % states, id = rand() % size;
+			D d(*ds[i]);
+			d.lub(*ds[j]);
+			inject(d, &must, id);
+			ds[i]->lub(d);
+		}
+		for(int i = 0; i < states; i++)
+			delete ds[i];
+	}
+	dw.stop();
+	cout << name << ": int " << rw.delay().micros() << "us, packed " << dw.delay().micros() << "us\n";
+}
+
+// usage: test_acs [-t [STEPS]] (-t times the states on STEPS random steps)
+int main(int argc, char **argv) {
+	bool timed = argc > 1 && string(argv[1]) == "-t";
+	int steps = timed && argc > 2 ? atoi(argv[2]) : 1000000;
+	int errors = 0;
+	errors += check<MUSTProblem::Domain>(Ref::MUST, A, 100000);
+	errors += check<MAYProblem::Domain>(Ref::MAY, A, 100000);
+	errors += check<PERSProblem::Item>(Ref::PERS, A, 100000);
+	errors += check<MUSTProblem::Domain>(Ref::MUST, wide_A, 100000);
+	errors += check<MAYProblem::Domain>(Ref::MAY, wide_A, 100000);
+	errors += check<PERSProblem::Item>(Ref::PERS, wide_A, 100000);
+	if(errors) {
+		cerr << "ERROR: " << errors << " differences with the reference implementation\n";
+		return 1;
+	}
+	cout << "packed states are identical to the reference\n";
+	if(!timed)
+		return 0;
+	bench<MUSTProblem::Domain>(Ref::MUST, "MUST", steps);
+	bench<MAYProblem::Domain>(Ref::MAY, "MAY", steps);
+	bench<PERSProblem::Item>(Ref::PERS, "PERS", steps);
+	return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ *	Test of the reduction of irreducible loops
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Array.h>
+#include <elm/data/Vector.h>
+#include <elm/io.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg.h>
+#include <otawa/cfg/LoopReductor.h>
+#include <otawa/dfa/BitSet.h>
+#include <otawa/prog/Process.h>
+#include <otawa/prog/TextDecoder.h>
+
+using namespace elm;
+using namespace otawa;
+
+// gives access to the reduction of a hand-made CFG collection
+class Reductor: public LoopReductor {
+public:
+	void reduce(WorkSpace *ws) { processWorkSpace(ws); commit(ws); }
+};
+
+// test if each retreating edge of a DFS targets a dominator of its source
+static bool isReducible(CFG *g) {
+	int n = g->count();
+
+	// compute the dominators
+	AllocArray<dfa::BitSet> dom(n);
+	for(auto v: *g) {
+		dom[v->index()] = dfa::BitSet(n);
+		if(v->isEntry())
+			dom[v->index()].add(v->index());
+		else
+			dom[v->index()].fill();
+	}
+	bool changed = true;
+	while(changed) {
+		changed = false;
+		for(auto v: *g)
+			if(!v->isEntry()) {
+				dfa::BitSet d(n);
+				d.fill();
+				for(auto e: v->inEdges())
+					d.mask(dom[e->source()->index()]);
+				d.add(v->index());
+				if(!d.equals(dom[v->index()])) {
+					dom[v->index()] = d;
+					changed = true;
+				}
+			}
+	}
+
+	// look for the retreating edges
+	dfa::BitSet done(n), on(n);
+	Vector<Pair<Block *, Block::EdgeIter> > S;
+	S.push(pair(g->entry(), g->entry()->outs()));
+	done.add(g->entry()->index());
+	on.add(g->entry()->index());
+	while(S) {
+		Block *v = S.top().fst;
+		Block::EdgeIter& e = S.top().snd;
+		if(e.ended()) {
+			on.remove(v->index());
+			S.pop();
+			continue;
+		}
+		Block *w = (*e)->sink();
+		e.next();
+		if(on.contains(w->index())) {
+			if(!dom[v->index()].contains(w->index()))
+				return false;
+		}
+		else if(!done.contains(w->index())) {
+			done.add(w->index());
+			on.add(w->index());
+			S.push(pair(w, w->outs()));
+		}
+	}
+	return true;
+}
+
+/**
+ * Build an irreducible CFG (loop b <-> c entered from a in both b and c)
+ * with the first instructions of the program, reduce it with LoopReductor
+ * and check that the result is reducible and that only one block has been
+ * duplicated (the test fails with code 1 else).
+ *
+ * Usage: test_reductor BINARY
+ */
+class ReductorTest: public Application {
+public:
+	ReductorTest(void): Application(Make("test_reductor")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(DECODED_TEXT);
+
+		// build the CFG: entry -> a, a -> b, a -> c, b -> c, c -> b, b -> d, d -> exit
+		Inst *i = workspace()->process()->start();
+		if(i == nullptr)
+			fail(1, "no start instruction");
+		CFGMaker maker(i);
+		Block *bs[4];
+		for(int j = 0; j < 4; j++) {
+			if(i == nullptr)
+				fail(1, "not enough instructions");
+			Vector<Inst *> is(1);
+			is.add(i);
+			bs[j] = new BasicBlock(is.detach());
+			maker.add(bs[j]);
+			i = i->nextInst();
+		}
+		Block *a = bs[0], *b = bs[1], *c = bs[2], *d = bs[3];
+		maker.add(maker.entry(), a, new Edge(Edge::NOT_TAKEN));
+		maker.add(a, b, new Edge(Edge::NOT_TAKEN));
+		maker.add(a, c, new Edge(Edge::TAKEN));
+		maker.add(b, c, new Edge(Edge::NOT_TAKEN));
+		maker.add(c, b, new Edge(Edge::TAKEN));
+		maker.add(b, d, new Edge(Edge::TAKEN));
+		maker.add(d, maker.exit(), new Edge(Edge::NOT_TAKEN));
+		CFG *g = maker.build();
+		CFGCollection coll;
+		coll.add(g);
+		if(isReducible(g))
+			fail(1, "the built CFG should be irreducible");
+
+		// reduce it
+		INVOLVED_CFGS(workspace()) = &coll;
+		Reductor reductor;
+		reductor.reduce(workspace());
+		const CFGCollection *res = INVOLVED_CFGS(workspace());
+		if(res == &coll || res->count() != 1)
+			fail(1, "bad reduced CFG collection");
+		CFG *rg = (*res)[0];
+		if(!isReducible(rg))
+			fail(1, "the reduced CFG is still irreducible");
+		if(rg->count() != g->count() + 1)
+			fail(1, _ << "bad block count after reduction: " << rg->count() << " instead of " << (g->count() + 1));
+		cout << "irreducible loop reduced: " << g->count() << " -> " << rg->count() << " blocks\n";
+	}
+
+};
+
+OTAWA_RUN(ReductorTest)
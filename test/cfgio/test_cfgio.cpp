@@ -0,0 +1,117 @@
+/*
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/HashMap.h>
+#include <otawa/app/Test.h>
+#include <otawa/cfg/features.h>
+#include <otawa/cfgio/features.h>
+#include <otawa/cfgio/Input.h>
+#include <otawa/cfgio/Output.h>
+
+using namespace elm;
+using namespace otawa;
+
+// round trip of the CFGs through cfgio::Output and cfgio::Input
+class TestCFGIO: public Test {
+public:
+	TestCFGIO(void): Test("test_cfgio") { }
+
+protected:
+
+	void generate(io::Output& out) override {
+		require(COLLECTED_CFG_FEATURE);
+		HashMap<string, int> full, xml;
+		signature(**INVOLVED_CFGS(workspace()), ~t::uint32(0), full);
+		signature(**INVOLVED_CFGS(workspace()), Edge::TAKEN | Edge::NOT_TAKEN, xml);
+
+		// the binary format keeps all the edge flags
+		roundTrip("test_cfgio.ocfg");
+		HashMap<string, int> binary_back;
+		signature(**INVOLVED_CFGS(workspace()), ~t::uint32(0), binary_back);
+		out << "binary: " << check(same(full, binary_back)) << io::endl;
+
+		// the XML format only keeps the taken and not-taken flags
+		roundTrip("test_cfgio.xml");
+		HashMap<string, int> xml_back;
+		signature(**INVOLVED_CFGS(workspace()), Edge::TAKEN | Edge::NOT_TAKEN, xml_back);
+		out << "xml: " << check(same(xml, xml_back)) << io::endl;
+	}
+
+private:
+
+	static cstring check(bool ok) { return ok ? "ok" : "failed"; }
+
+	// write the current CFGs and load them back
+	void roundTrip(sys::Path path) {
+		PropList props;
+		cfgio::OUTPUT(props) = path;
+		workspace()->run<cfgio::Output>(props);
+		cfgio::FROM(props) = path;
+		workspace()->run<cfgio::Input>(props);
+		path.remove();
+	}
+
+	// description of a block independent of its index
+	static string desc(Block *v) {
+		if(v->isEntry())
+			return _ << v->cfg()->address() << ":entry";
+		else if(v->isExit())
+			return _ << v->cfg()->address() << ":exit";
+		else if(v->isBasic())
+			return _ << v->cfg()->address() << ":bb:" << v->address() << ':' << v->toBasic()->size();
+		else if(v->isCall()) {
+			CFG *callee = v->toSynth()->callee();
+			if(callee == nullptr)
+				return _ << v->cfg()->address() << ":call:unknown";
+			else
+				return _ << v->cfg()->address() << ":call:" << callee->address();
+		}
+		else
+			return _ << v->cfg()->address() << ":unknown";
+	}
+
+	// count the blocks and the edges of the collection
+	static void signature(const CFGCollection& coll, t::uint32 mask, HashMap<string, int>& sig) {
+		for(auto g: coll) {
+			add(sig, _ << "cfg:" << g->address());
+			for(auto v: *g) {
+				add(sig, desc(v));
+				for(auto e: v->outEdges())
+					add(sig, _ << desc(e->source()) << " -> " << desc(e->sink()) << " / " << (e->flags() & mask));
+			}
+		}
+	}
+
+	static void add(HashMap<string, int>& sig, const string& item) {
+		sig.put(item, sig.get(item, 0) + 1);
+	}
+
+	static bool same(const HashMap<string, int>& s1, const HashMap<string, int>& s2) {
+		for(auto k: s1.keys())
+			if(s2.get(k, 0) != s1.get(k, 0))
+				return false;
+		for(auto k: s2.keys())
+			if(!s1.hasKey(k))
+				return false;
+		return true;
+	}
+
+};
+
+OTAWA_RUN(TestCFGIO);
@@ -0,0 +1,136 @@
+/*
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <otawa/app/Test.h>
+#include <otawa/etime/MaxPlusGraph.h>
+#include <otawa/hard/Processor.h>
+#include <otawa/parexegraph/GraphBBTime.h>
+#include <otawa/prog/Manager.h>
+
+using namespace elm;
+using namespace otawa;
+
+// events of the check: latency increases on distinct nodes and on a solid edge
+class Events {
+public:
+	Events(ParExeGraph& g): edge(nullptr) {
+		Vector<ParExeNode *> all;
+		for(ParExeGraph::PreorderIterator n(&g); n(); n++)
+			all.add(*n);
+		for(auto i: { 0, all.length() / 2, all.length() - 1 })
+			if(i >= 0 && !nodes.contains(all[i]))
+				nodes.add(all[i]);
+		for(int i = all.length() / 3; i < all.length() && edge == nullptr; i++)
+			for(ParExeGraph::Successor s(all[i]); s(); s++)
+				if(s.edge()->type() == ParExeEdge::SOLID) {
+					edge = s.edge();
+					break;
+				}
+	}
+
+	inline int count(void) const { return nodes.length() + (edge != nullptr ? 1 : 0); }
+
+	void set(int i, bool on) {
+		int d = on ? cost(i) : -cost(i);
+		if(i < nodes.length())
+			nodes[i]->setLatency(nodes[i]->latency() + d);
+		else
+			edge->setLatency(edge->latency() + d);
+	}
+
+private:
+	static int cost(int i) { return 2 + i; }
+	Vector<ParExeNode *> nodes;
+	ParExeEdge *edge;
+};
+
+// compare the closed form with the analysis of the graph for each configuration
+class MaxPlusChecker: public GraphBBTime<ParExeGraph> {
+public:
+	static p::declare reg;
+	MaxPlusChecker(AbstractRegistration& r = reg): GraphBBTime<ParExeGraph>(r), graphs(0), errors(0) { }
+	int graphs, errors;
+
+protected:
+
+	void processBB(WorkSpace *ws, CFG *cfg, Block *b) override {
+		if(!b->isBasic() || b->toBasic()->count() == 0)
+			return;
+		List<PathContext *> *ctxts = buildListOfPathContexts(b->toBasic());
+		for(List<PathContext *>::Iter ctxt(*ctxts); ctxt(); ctxt++)
+			check(*ctxt);
+	}
+
+private:
+
+	void check(PathContext *ctxt) {
+		ParExeGraph *g = new ParExeGraph(workspace(), _microprocessor, &_hw_resources, buildSequence(ctxt));
+		g->build();
+		Events evts(*g);
+		etime::MaxPlusGraph mpg(g, evts.count());
+		for(int i = 0; i < evts.count(); i++) {
+			evts.set(i, true);
+			mpg.probe(i);
+			evts.set(i, false);
+		}
+		if(mpg.build()) {
+			graphs++;
+			etime::MaxPlusGraph::mask_t all = (1 << evts.count()) - 1;
+			for(etime::MaxPlusGraph::mask_t c = 0; c <= all; c++) {
+				for(int i = 0; i < evts.count(); i++)
+					if(c & (1 << i))
+						evts.set(i, true);
+				ot::time t = g->analyze();
+				if(mpg.evaluate(c) != t || mpg.bound(0, all) < t)
+					errors++;
+				for(int i = 0; i < evts.count(); i++)
+					if(c & (1 << i))
+						evts.set(i, false);
+			}
+		}
+		delete g;
+	}
+};
+
+p::declare MaxPlusChecker::reg = p::init("MaxPlusChecker", Version(1, 0, 0))
+	.base(GraphBBTime<ParExeGraph>::reg)
+	.maker<MaxPlusChecker>();
+
+
+class TestMaxPlus: public Test {
+public:
+	TestMaxPlus(void): Test("test_maxplus") { }
+
+protected:
+
+	void prepare(PropList& props) override {
+		Test::prepare(props);
+		PROCESSOR_PATH(props) = "op1.xml";
+	}
+
+	void generate(io::Output& out) override {
+		require(hard::PROCESSOR_FEATURE);
+		MaxPlusChecker checker;
+		workspace()->run(&checker);
+		out << "closed form: " << (checker.graphs != 0 && checker.errors == 0 ? "ok" : "failed") << io::endl;
+	}
+
+};
+
+OTAWA_RUN(TestMaxPlus);
@@ -0,0 +1,132 @@
+/*
+ *	Benchmark of the flow fact loading
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/HashMap.h>
+#include <elm/io/OutFileStream.h>
+#include <elm/sys/StopWatch.h>
+#include <elm/sys/System.h>
+#include <otawa/app/Application.h>
+#include <otawa/flowfact/features.h>
+#include <otawa/prog/File.h>
+#include <otawa/prog/Process.h>
+#include <otawa/prog/Symbol.h>
+
+using namespace elm;
+using namespace elm::option;
+using namespace otawa;
+
+/**
+ * Generate a synthetic big flow fact file (alternating addresses and labels
+ * of the functions of the program), measure its loading time and check
+ * the loaded loop bounds (the maximum of the bounds given to each address).
+ * The generated files are removed at the end.
+ *
+ * Usage: test_ff [-n COUNT] [-f FILES] [-o PATH] BINARY
+ */
+class FFTest: public Application {
+public:
+	FFTest(void):
+		Application(Make("FFTest")),
+		count(ValueOption<int>::Make(*this).cmd("-n").description("number of generated flow facts").def(100000)),
+		files(ValueOption<int>::Make(*this).cmd("-f").description("number of generated flow fact files").def(1)),
+		prefix(ValueOption<string>::Make(*this).cmd("-o").description("prefix of generated files").def("test_ff"))
+	{ }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+
+		// collect the functions
+		Vector<Symbol *> funs;
+		for(Process::FileIter file(workspace()->process()); file(); file++)
+			for(File::SymIter sym(*file); sym(); sym++)
+				if((*sym)->kind() == Symbol::FUNCTION)
+					funs.add(*sym);
+		if(!funs)
+			throw otawa::Exception("no function in the program");
+
+		// generate the files (removed at the end, even on error)
+		class Cleaner {
+		public:
+			~Cleaner(void) {
+				for(auto p: paths)
+					try {
+						if(p.exists())
+							p.remove();
+					}
+					catch(sys::SystemException&) {
+					}
+			}
+			Vector<Path> paths;
+		} cleaner;
+		int n = 0;
+		HashMap<Address, int> expected;
+		for(int f = 0; f < *files; f++) {
+			Path path = _ << *prefix << f << ".ffx";
+			io::OutFileStream stream(path);
+			cleaner.paths.add(path);
+			if(!stream.isReady())
+				throw otawa::Exception(_ << "cannot create " << path);
+			io::Output out(stream);
+			out << "<?xml version=\"1.0\"?>\n<flowfacts>\n";
+			for(int i = f; i < *count; i += *files, n++) {
+				Symbol *sym = funs[i % funs.length()];
+				int max = i % 100 + 1;
+				if(expected.get(sym->address(), 0) < max)
+					expected.put(sym->address(), max);
+				if(i % 2 == 0)
+					out << "\t<loop address=\"0x" << io::hex(sym->address().offset()) << "\" maxcount=\"" << max << "\"/>\n";
+				else
+					out << "\t<loop label=\"" << sym->name() << "\" maxcount=\"" << max << "\"/>\n";
+			}
+			out << "</flowfacts>\n";
+			FLOW_FACTS_PATH.add(props, path);
+		}
+
+		// load them
+		sys::StopWatch watch;
+		watch.start();
+		workspace()->require(FLOW_FACTS_FEATURE, props);
+		watch.stop();
+		cout << n << " flow facts in " << *files << " file(s) loaded in "
+			 << watch.delay().micros() << "us\n";
+
+		// check the bounds
+		int errors = 0;
+		for(HashMap<Address, int>::PairIter i(expected); i(); i++) {
+			Inst *inst = workspace()->findInstAt((*i).fst);
+			if(inst == nullptr || MAX_ITERATION(inst) != (*i).snd) {
+				cerr << "ERROR: bad bound at " << (*i).fst << ": " << (inst == nullptr ? -1 : MAX_ITERATION(inst))
+					 << " instead of " << (*i).snd << io::endl;
+				errors++;
+			}
+		}
+		if(errors != 0)
+			throw otawa::Exception(_ << errors << " bad loop bounds");
+		cout << expected.count() << " loop bounds checked\n";
+	}
+
+private:
+	ValueOption<int> count, files;
+	ValueOption<string> prefix;
+};
+
+OTAWA_RUN(FFTest)
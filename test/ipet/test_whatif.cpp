@@ -0,0 +1,94 @@
+/*
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/HashMap.h>
+#include <otawa/app/Test.h>
+#include <otawa/cfg/features.h>
+#include <otawa/ilp.h>
+#include <otawa/ipet.h>
+#include <otawa/ipet/WhatIf.h>
+
+using namespace elm;
+using namespace otawa;
+
+// the output only records the checks so that the reference does not depend on the timing
+class TestWhatIf: public Test {
+public:
+	TestWhatIf(void): Test("test_whatif") { }
+
+protected:
+
+	void generate(io::Output& out) override {
+		require(ipet::WCET_FEATURE);
+		ot::time wcet = ipet::WCET(workspace());
+		ipet::WhatIf wi(workspace());
+		HashMap<ilp::Var *, double> before;
+		object(wi.system(), before);
+
+		// the empty query gives the original WCET
+		out << "empty: " << check(wi.solve(ipet::WhatIf::Query("empty")) == wcet) << io::endl;
+
+		// doubling every time doubles the WCET
+		ipet::WhatIf::Query twice("twice"), zero("zero");
+		for(auto v: COLLECTED_CFG_FEATURE.get(workspace())->blocks())
+			if(v->isBasic()) {
+				twice.setTime(v, 2 * ipet::TIME(v));
+				zero.setTime(v, 0);
+				for(auto e: v->inEdges())
+					if(ipet::TIME(e) >= 0) {
+						twice.setTime(e, 2 * ipet::TIME(e));
+						zero.setTime(e, 0);
+					}
+			}
+		out << "twice: " << check(wi.solve(twice) == 2 * wcet) << io::endl;
+
+		// the batch is solved relatively to the original system
+		Vector<ipet::WhatIf::Query> qs;
+		qs.add(zero);
+		qs.add(twice);
+		qs.add(ipet::WhatIf::Query("empty"));
+		Vector<ot::time> wcets;
+		wi.solve(qs, wcets);
+		out << "batch: " << check(wcets.length() == 3 && wcets[0] == 0 && wcets[1] == 2 * wcet && wcets[2] == wcet) << io::endl;
+
+		// the system is restored
+		HashMap<ilp::Var *, double> after;
+		object(wi.system(), after);
+		bool same = true;
+		for(auto v: before.keys())
+			same = same && after.get(v, 0) == before.get(v, 0);
+		for(auto v: after.keys())
+			same = same && before.hasKey(v);
+		out << "restored: " << check(same && ot::time(wi.system()->value()) == wcet) << io::endl;
+		out << "solves: " << check(wi.solveCount() == 6) << io::endl;
+	}
+
+private:
+
+	static cstring check(bool ok) { return ok ? "ok" : "failed"; }
+
+	static void object(ilp::System *sys, HashMap<ilp::Var *, double>& map) {
+		for(ilp::System::ObjTermIterator t(sys); t(); t++)
+			if((*t).snd != 0)
+				map.put((*t).fst, map.get((*t).fst, 0) + (*t).snd);
+	}
+
+};
+
+OTAWA_RUN(TestWhatIf);
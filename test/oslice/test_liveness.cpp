@@ -0,0 +1,144 @@
+/*
+ *	Comparison of the oslice liveness engine with a reference fix point
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Array.h>
+#include <elm/util/BitVector.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+#include <otawa/hard/Platform.h>
+#include <otawa/hard/Register.h>
+#include <otawa/oslice/Liveness.h>
+
+using namespace elm;
+using namespace otawa;
+
+/**
+ * Compare the register liveness computed by oslice::Liveness with a naive
+ * round-robin fix point on the whole program, the even registers being live
+ * at the end of the program.
+ *
+ * Usage: test_liveness BINARY
+ */
+class LivenessTest: public Application {
+public:
+	LivenessTest(void): Application(Make("test_liveness")) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		const CFGCollection& coll = **INVOLVED_CFGS(workspace());
+		int rn = workspace()->platform()->regCount(), bn = coll.countBlocks();
+		BitVector seed(rn);
+		for(int i = 0; i < rn; i += 2)
+			seed.set(i);
+
+		// engine
+		oslice::Liveness live(workspace(), coll, false);
+		live.seed(coll[0]->exit(), nullptr, seed, dfa::MemorySet::empty);
+		live.run();
+
+		// reference
+		AllocArray<BitVector> begin(bn), end(bn);
+		for(int i = 0; i < bn; i++) {
+			begin[i] = BitVector(rn);
+			end[i] = BitVector(rn);
+		}
+		BitVector reached(bn);
+		end[coll[0]->exit()->id()] = seed;
+		reached.set(coll[0]->exit()->id());
+		Vector<Block *> preds;
+		for(bool changed = true; changed;) {
+			changed = false;
+			for(auto g: coll)
+				for(auto v: *g) {
+					if(!reached.bit(v->id()))
+						continue;
+					BitVector r = end[v->id()];
+					if(v->isBasic())
+						transfer(v->toBasic(), r);
+					if(!begin[v->id()].includes(r)) {
+						begin[v->id()].applyOr(r);
+						changed = true;
+					}
+					preds.clear();
+					predecessors(v, preds);
+					for(auto w: preds) {
+						if(!reached.bit(w->id())) {
+							reached.set(w->id());
+							changed = true;
+						}
+						if(!end[w->id()].includes(begin[v->id()])) {
+							end[w->id()].applyOr(begin[v->id()]);
+							changed = true;
+						}
+					}
+				}
+		}
+
+		// compare
+		int errors = 0;
+		for(auto g: coll)
+			for(auto v: *g)
+				if(!live.regsAtEnd(v).equals(end[v->id()]) || !live.regsAtBegin(v).equals(begin[v->id()])) {
+					cerr << "ERROR: different liveness for " << v << " in " << g << ": "
+						 << live.regsAtBegin(v) << "/" << live.regsAtEnd(v) << " instead of "
+						 << begin[v->id()] << "/" << end[v->id()] << io::endl;
+					errors++;
+				}
+		if(errors != 0)
+			throw otawa::Exception(_ << errors << " blocks with a different liveness");
+	}
+
+private:
+
+	// backward transfer of a block
+	static void transfer(BasicBlock *bb, BitVector& regs) {
+		for(Inst *i = bb->last(); ; i = i->prevInst()) {
+			Array<hard::Register *> defs = i->writtenRegs(), uses = i->readRegs();
+			for(Array<hard::Register *>::Iter r(defs); r(); r++)
+				regs.clear(r->platformNumber());
+			for(Array<hard::Register *>::Iter r(uses); r(); r++)
+				regs.set(r->platformNumber());
+			if(i == bb->first())
+				break;
+		}
+	}
+
+	// predecessors crossing the calls (as the callee exit) and the entries (as the caller predecessors)
+	static void predecessors(Block *v, Vector<Block *>& preds) {
+		if(v->isEntry()) {
+			for(auto caller: v->cfg()->callers())
+				for(auto e: caller->inEdges())
+					preds.add(e->source());
+			return;
+		}
+		for(auto e: v->inEdges()) {
+			Block *w = e->source();
+			if(!w->isSynth())
+				preds.add(w);
+			else if(w->toSynth()->callee())
+				preds.add(w->toSynth()->callee()->exit());
+		}
+	}
+
+};
+
+OTAWA_RUN(LivenessTest)
@@ -0,0 +1,134 @@
+/*
+ *	Test of the multi-configuration cache driver
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <elm/io.h>
+#include <otawa/hard/Cache.h>
+#include <otawa/sim/AbstractCacheDriver.h>
+#include <otawa/sim/MultiCacheDriver.h>
+
+using namespace elm;
+using namespace otawa;
+using namespace otawa::sim;
+
+static hard::Cache *make(int block_bits, int set_bits, int way_bits, hard::Cache::replace_policy_t policy, bool allocate = true) {
+	hard::Cache *c = new hard::Cache();
+	c->setAccessTime(1);
+	c->setMissPenalty(10);
+	c->setBlockBits(block_bits);
+	c->setRowBits(set_bits);
+	c->setWayBits(way_bits);
+	c->setReplacePolicy(policy);
+	c->setWritePolicy(hard::Cache::WRITE_THROUGH);
+	c->setAllocate(allocate);
+	c->setWriteBufferSize(0);
+	c->setReadPortSize(1);
+	c->setWritePortSize(1);
+	return c;
+}
+
+// compare the driver with the single-cache drivers on a random trace of reads
+static int compare(int steps) {
+	Vector<hard::Cache *> caches;
+	caches.add(make(4, 4, 0, hard::Cache::LRU));
+	caches.add(make(4, 4, 1, hard::Cache::LRU));
+	caches.add(make(4, 4, 2, hard::Cache::LRU));
+	caches.add(make(4, 4, 3, hard::Cache::LRU));
+	caches.add(make(5, 3, 2, hard::Cache::LRU));
+	caches.add(make(4, 4, 1, hard::Cache::FIFO));
+	caches.add(make(4, 4, 2, hard::Cache::FIFO));
+
+	MultiCacheDriver driver;
+	Vector<CacheDriver *> refs;
+	for(auto c: caches) {
+		driver.add(c);
+		refs.add(AbstractCacheDriver::lookup(c));
+	}
+	Vector<t::uint64> hits;
+	for(int i = 0; i < caches.length(); i++)
+		hits.add(0);
+
+	// the reference drivers only access one block: split the accesses
+	int errors = 0;
+	srand(1);
+	for(int s = 0; s < steps; s++) {
+		t::uint32 a = 0x10000000 + (rand() % 4096) * 4;
+		int size = 1 << (rand() % 6);
+		driver.access(Address(a), size, CacheDriver::READ);
+		for(int i = 0; i < caches.length(); i++) {
+			t::uint32 bs = caches[i]->blockSize();
+			bool hit = true;
+			for(t::uint32 b = a & ~(bs - 1); b < a + size; b += bs)
+				hit = refs[i]->access(Address(b), 4, CacheDriver::READ) == CacheDriver::HIT && hit;
+			if(hit)
+				hits[i]++;
+			if(driver.result(i) != (hit ? CacheDriver::HIT : CacheDriver::MISS))
+				errors++;
+		}
+	}
+	for(int i = 0; i < caches.length(); i++)
+		if(driver.hitCount(i) != hits[i] || driver.missCount(i) != t::uint64(steps) - hits[i]) {
+			cerr << "ERROR: bad counts for configuration " << i << io::endl;
+			errors++;
+		}
+
+	for(auto r: refs)
+		delete r;
+	for(auto c: caches)
+		delete c;
+	return errors;
+}
+
+// write misses do not load the block without write allocation
+static int writes(void) {
+	hard::Cache *alloc = make(4, 4, 2, hard::Cache::LRU, true);
+	hard::Cache *no_alloc = make(4, 4, 2, hard::Cache::LRU, false);
+	hard::Cache *fifo = make(4, 4, 2, hard::Cache::FIFO, false);
+	MultiCacheDriver driver;
+	driver.add(alloc);
+	driver.add(no_alloc);
+	driver.add(fifo);
+	int errors = 0;
+	Address a(0x10000100);
+	driver.access(a, 4, CacheDriver::WRITE);
+	errors += driver.result(0) != CacheDriver::MISS || driver.result(1) != CacheDriver::MISS || driver.result(2) != CacheDriver::MISS;
+	driver.access(a, 4, CacheDriver::READ);
+	errors += driver.result(0) != CacheDriver::HIT || driver.result(1) != CacheDriver::MISS || driver.result(2) != CacheDriver::MISS;
+	driver.access(a, 4, CacheDriver::WRITE);
+	errors += driver.result(0) != CacheDriver::HIT || driver.result(1) != CacheDriver::HIT || driver.result(2) != CacheDriver::HIT;
+	if(errors != 0)
+		cerr << "ERROR: bad write allocation\n";
+	delete alloc;
+	delete no_alloc;
+	delete fifo;
+	return errors;
+}
+
+int main(int argc, char **argv) {
+	int steps = argc > 1 ? atoi(argv[1]) : 100000;
+	int errors = compare(steps) + writes();
+	if(errors) {
+		cerr << "ERROR: " << errors << " differences with the single-cache drivers\n";
+		return 1;
+	}
+	cout << "multi-cache driver is identical to the single-cache drivers\n";
+	return 0;
+}
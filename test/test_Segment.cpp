@@ -0,0 +1,97 @@
+/*
+ *	Segment content view unit testing
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <elm/test.h>
+#include <otawa/prog/Segment.h>
+
+using namespace otawa;
+
+int main(void) {
+CHECK_BEGIN("Segment")
+
+	// .data of 16 bytes whose 4 last bytes are a .bss tail
+	const t::uint8 bytes[20] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+		0x11, 0x12, 0x13, 0x14
+	};
+	Segment seg("data", Address(0x1000), 16, Segment::WRITABLE | Segment::INITIALIZED);
+	t::uint8 b;
+	t::uint16 h;
+	t::uint32 w;
+	t::uint64 d;
+
+	// no view
+	CHECK(!seg.hasBytes());
+	CHECK(!seg.read(Address(0x1000), w));
+
+	// little endian
+	seg.setBytes(bytes, 12, false);
+	CHECK(seg.hasBytes());
+	CHECK_EQUAL(seg.bytesLength(), ot::size(12));
+	CHECK(seg.read(Address(0x1000), b));
+	CHECK_EQUAL(b, t::uint8(0x01));
+	CHECK(seg.read(Address(0x1000), w));
+	CHECK_EQUAL(w, t::uint32(0x04030201));
+	CHECK(seg.read(Address(0x1002), h));
+	CHECK_EQUAL(h, t::uint16(0x0403));
+	CHECK(seg.read(Address(0x1004), d));
+	CHECK_EQUAL(d, t::uint64(0x0c0b0a0908070605ULL));
+	Address a;
+	CHECK(seg.read(Address(0x1000), a));
+	CHECK_EQUAL(a, Address(0x04030201));
+
+	// bounds
+	CHECK(seg.read(Address(0x1008), w));
+	CHECK(!seg.read(Address(0x1009), w));
+	CHECK(!seg.read(Address(0x1005), d));
+	CHECK(!seg.read(Address(0xfff), b));
+	CHECK(!seg.read(Address(0xffe), w));
+	CHECK(!seg.read(Address(0x1010), b));
+	CHECK(!seg.read(Address(1, 0x1000), w));
+
+	// .bss tail
+	CHECK(seg.read(Address(0x100b), b));
+	CHECK(!seg.read(Address(0x100c), b));
+	CHECK(!seg.read(Address(0x100e), h));
+
+	// view longer than the segment
+	seg.setBytes(bytes, 20, false);
+	CHECK_EQUAL(seg.bytesLength(), ot::size(16));
+	CHECK(seg.read(Address(0x100c), w));
+	CHECK_EQUAL(w, t::uint32(0x100f0e0d));
+	CHECK(!seg.read(Address(0x100d), w));
+
+	// big endian
+	seg.setBytes(bytes, 12, true);
+	CHECK(seg.read(Address(0x1000), b));
+	CHECK_EQUAL(b, t::uint8(0x01));
+	CHECK(seg.read(Address(0x1000), w));
+	CHECK_EQUAL(w, t::uint32(0x01020304));
+	CHECK(seg.read(Address(0x1002), h));
+	CHECK_EQUAL(h, t::uint16(0x0304));
+	CHECK(seg.read(Address(0x1004), d));
+	CHECK_EQUAL(d, t::uint64(0x05060708090a0b0cULL));
+	CHECK(!seg.read(Address(0x100a), w));
+
+CHECK_END
+}